@@ -161,6 +161,7 @@ option(QT_ENABLE_VERBOSE_DEPLOYMENT "Enable verbose deployment output" OFF)
 option(QT_DEBUG_FIND_PACKAGE "Print search paths when package not found" ON)
 option(QT_QML_GENERATE_QMLLS_INI "Generate qmlls.ini for QML language server" ON)
 option(QGC_ENABLE_QMLLINT "Enable automatic QML linting during build" OFF)
+option(QGC_QML_AOT_COMPILE "Compile QML bindings and functions to native code (uses qmlsc when available)" ON)
 
 set(QGC_QT_DISABLE_DEPRECATED_UP_TO "0x061000" CACHE STRING "Disable Qt APIs deprecated before this version")
 set(QGC_QT_ENABLE_STRICT_MODE_UP_TO "0x061000" CACHE STRING "Enable strict Qt API mode up to this version")
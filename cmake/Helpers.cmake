@@ -156,3 +156,84 @@ function(qgc_enable_ipo)
         message(STATUS "QGC: IPO/LTO disabled for ${CMAKE_BUILD_TYPE} build")
     endif()
 endfunction()
+
+# ----------------------------------------------------------------------------
+# qgc_set_qml_compiler
+# Selects how the QML of a module is compiled. Must be called after the target
+# is created and before qt_add_qml_module, qt_target_qml_sources reads the
+# compiler executable when it sets up the cache generation.
+# qmlcachegen compiles whatever it can type check to C++ and falls back to
+# byte code for the rest. qmlsc is used instead when Qt provides it, with
+# direct calls between compiled functions.
+# Args: QML module target
+# ----------------------------------------------------------------------------
+function(qgc_set_qml_compiler target)
+    if(NOT QGC_QML_AOT_COMPILE)
+        set_property(TARGET ${target} APPEND PROPERTY QT_QMLCACHEGEN_ARGUMENTS "--only-bytecode")
+    elseif(TARGET Qt6::qmlsc)
+        set_property(TARGET ${target} PROPERTY QT_QMLCACHEGEN_EXECUTABLE qmlsc)
+        set_property(TARGET ${target} APPEND PROPERTY QT_QMLCACHEGEN_ARGUMENTS "--direct-calls")
+    endif()
+    set_property(TARGET ${target} PROPERTY _qgc_qml_compiler_set TRUE)
+endfunction()
+
+# ----------------------------------------------------------------------------
+# qgc_config_qml_compiler
+# Adds a qgc_qml_aot target which builds the compiled QML of every module
+# below a directory. Modules which did not call qgc_set_qml_compiler are
+# reported, they are compiled with the Qt defaults.
+# Args: Top level directory to search for QML module targets
+# ----------------------------------------------------------------------------
+function(qgc_config_qml_compiler directory)
+    function(_qgc_collect_targets _dir _out)
+        get_property(_targets DIRECTORY "${_dir}" PROPERTY BUILDSYSTEM_TARGETS)
+        get_property(_subdirs DIRECTORY "${_dir}" PROPERTY SUBDIRECTORIES)
+        foreach(_subdir IN LISTS _subdirs)
+            _qgc_collect_targets("${_subdir}" _subtargets)
+            list(APPEND _targets ${_subtargets})
+        endforeach()
+        set(${_out} ${_targets} PARENT_SCOPE)
+    endfunction()
+
+    _qgc_collect_targets("${directory}" _all_targets)
+
+    set(_qml_targets)
+    set(_cache_targets)
+    foreach(_target IN LISTS _all_targets)
+        get_target_property(_type ${_target} TYPE)
+        if(_type STREQUAL "UTILITY" OR _type STREQUAL "INTERFACE_LIBRARY")
+            continue()
+        endif()
+        get_target_property(_uri ${_target} QT_QML_MODULE_URI)
+        if(NOT _uri)
+            continue()
+        endif()
+
+        list(APPEND _qml_targets ${_target})
+        get_target_property(_compiler_set ${_target} _qgc_qml_compiler_set)
+        if(NOT _compiler_set)
+            message(AUTHOR_WARNING "QGC: ${_target} does not call qgc_set_qml_compiler before qt_add_qml_module")
+        endif()
+
+        # The compiled QML lives in the _qmlcache object library, fall back to the module for modules without QML files
+        if(TARGET ${_target}_qmlcache)
+            list(APPEND _cache_targets ${_target}_qmlcache)
+        else()
+            list(APPEND _cache_targets ${_target})
+        endif()
+    endforeach()
+
+    if(NOT QGC_QML_AOT_COMPILE)
+        message(STATUS "QGC: QML compiled to byte code only")
+    elseif(TARGET Qt6::qmlsc)
+        message(STATUS "QGC: QML compiled ahead-of-time with qmlsc")
+    else()
+        message(STATUS "QGC: QML compiled ahead-of-time with qmlcachegen")
+    endif()
+
+    list(LENGTH _qml_targets _count)
+    add_custom_target(qgc_qml_aot COMMENT "Compiled ${_count} QML modules")
+    if(_cache_targets)
+        add_dependencies(qgc_qml_aot ${_cache_targets})
+    endif()
+endfunction()
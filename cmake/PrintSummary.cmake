@@ -77,6 +77,7 @@ OptionOutput("Use build caching                     " QGC_USE_CACHE)
 OptionOutput("Enable testing                        " QGC_BUILD_TESTING)
 OptionOutput("Enable QML debugging                  " QGC_DEBUG_QML)
 OptionOutput("Enable QML linting                    " QGC_ENABLE_QMLLINT)
+OptionOutput("Ahead-of-time compile QML            " QGC_QML_AOT_COMPILE)
 OptionOutput("Enable 3D Viewer                      " QGC_VIEWER3D)
 OptionOutput("Enable Bluetooth links                " QGC_ENABLE_BLUETOOTH)
 OptionOutput("Enable ZeroConf compatibility         " QGC_ZEROCONF_ENABLED)
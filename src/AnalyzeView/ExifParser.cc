@@ -62,6 +62,31 @@ bool _readIFDTagValue(const QByteArray& buf, size_t ifdOffset, bool isLittleEndi
     return false;
 }
 
+qsizetype headerSize(QByteArrayView data)
+{
+    if ((data.size() < 2) || (static_cast<uchar>(data[0]) != 0xFF) || (static_cast<uchar>(data[1]) != 0xD8)) {
+        return -1;
+    }
+
+    // Walk the marker segments which precede the image data
+    qsizetype offset = 2;
+    while ((offset + 4) <= data.size()) {
+        const uchar marker = static_cast<uchar>(data[offset + 1]);
+        if ((static_cast<uchar>(data[offset]) != 0xFF) || (marker == 0xDA)) {
+            // Lost sync or reached the start of scan without an APP1 segment
+            return -1;
+        }
+
+        const qsizetype segmentEnd = offset + 2 + qFromBigEndian<quint16>(data.constData() + offset + 2);
+        if (marker == 0xE1) {
+            return segmentEnd;
+        }
+        offset = segmentEnd;
+    }
+
+    return -1;
+}
+
 QDateTime readTime(const QByteArray& buffer)
 {
     // Check for JPEG SOI marker (Start of Image)
@@ -118,17 +143,35 @@ QDateTime readTime(const QByteArray& buffer)
 bool write(QByteArray &buf, const GeoTagWorker::CameraFeedbackPacket &geotag)
 {
     QByteArray app1Header("\xff\xe1", 2);
-    uint32_t app1HeaderInd = buf.indexOf(app1Header);
+    const qsizetype app1Index = buf.indexOf(app1Header);
+    if (app1Index < 0) {
+        qCWarning(ExifParserLog) << "APP1 marker not found in JPEG file";
+        return false;
+    }
+    uint32_t app1HeaderInd = app1Index;
     uint16_t *conversionPointer = reinterpret_cast<uint16_t *>(buf.mid(app1HeaderInd + 2, 2).data());
     uint16_t app1Size = *conversionPointer;
     uint16_t app1SizeEndian = qFromBigEndian(app1Size) + 0xa5;  // change wrong endian
     QByteArray tiffHeader("\x49\x49\x2A", 3);
-    uint32_t tiffHeaderInd = buf.indexOf(tiffHeader);
+    const qsizetype tiffIndex = buf.indexOf(tiffHeader);
+    if ((tiffIndex < 0) || ((tiffIndex + 10) > buf.size())) {
+        qCWarning(ExifParserLog) << "TIFF header not found in EXIF data";
+        return false;
+    }
+    uint32_t tiffHeaderInd = tiffIndex;
     conversionPointer = reinterpret_cast<uint16_t *>(buf.mid(tiffHeaderInd + 8, 2).data());
     uint16_t numberOfTiffFields  = *conversionPointer;
     uint32_t nextIfdOffsetInd = tiffHeaderInd + 10 + 12 * (numberOfTiffFields);
+    if ((nextIfdOffsetInd + 16) > buf.size()) {
+        qCWarning(ExifParserLog) << "IFD0 extends past the end of the buffer";
+        return false;
+    }
     conversionPointer = reinterpret_cast<uint16_t *>(buf.mid(nextIfdOffsetInd, 2).data());
     uint16_t nextIfdOffset = *conversionPointer;
+    if ((tiffHeaderInd + nextIfdOffset) > buf.size()) {
+        qCWarning(ExifParserLog) << "IFD1 offset is past the end of the buffer";
+        return false;
+    }
 
     // Definition of useful unions and structs
     union char2uint32_u {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QtCore/QByteArrayView>
 #include <QtCore/QLoggingCategory>
 
 #include "GeoTagWorker.h"
@@ -10,6 +11,14 @@ Q_DECLARE_LOGGING_CATEGORY(ExifParserLog)
 
 namespace ExifParser
 {
+    /// @return Number of bytes from the start of a JPEG file up to the end of its EXIF APP1 segment, -1 if the
+    ///         data doesn't start with a JPEG header containing an APP1 segment. readTime and write only look at
+    ///         these bytes, the rest of the file can be copied through unchanged.
+    qsizetype headerSize(QByteArrayView data);
+
     QDateTime readTime(const QByteArray &buf);
     bool write(QByteArray &buf, const GeoTagWorker::CameraFeedbackPacket &geotag);
+
+    /// Largest possible header: SOI marker followed by a maximum size APP1 segment
+    constexpr qsizetype kMaxHeaderSize = 2 + 2 + 0xffff;
 }
@@ -35,7 +35,8 @@ GeoTagController::~GeoTagController()
 
 void GeoTagController::cancelTagging()
 {
-    (void) QMetaObject::invokeMethod(_worker, "cancelTagging", Qt::AutoConnection);
+    // Called directly since the worker thread is busy in process() and won't see a queued call until it is done
+    _worker->cancelTagging();
     (void) QMetaObject::invokeMethod(_workerThread, "quit", Qt::AutoConnection);
 
     _workerThread->wait();
@@ -6,8 +6,11 @@
 #include "PX4LogParser.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtConcurrent/QtConcurrentMap>
 #include <QtCore/QDir>
 
+#include <numeric>
+
 QGC_LOGGING_CATEGORY(GeoTagWorkerLog, "AnalyzeView.GeoTagWorker")
 
 GeoTagWorker::GeoTagWorker(QObject *parent)
@@ -27,9 +30,46 @@ GeoTagWorker::~GeoTagWorker()
     // qCDebug(GeoTagWorkerLog) << Q_FUNC_INFO << this;
 }
 
+namespace {
+
+/// Read only view of an image file. The file is memory mapped when possible so only the pages which are actually
+/// used are read from disk.
+class ImageFile
+{
+public:
+    explicit ImageFile(const QString &fileName)
+        : _file(fileName)
+    {
+        if (!_file.open(QIODevice::ReadOnly)) {
+            return;
+        }
+
+        const qint64 size = _file.size();
+        uchar *const mapped = (size > 0) ? _file.map(0, size) : nullptr;
+        if (mapped) {
+            _data = QByteArrayView(mapped, size);
+        } else {
+            // For example files in resources
+            _buffer = _file.readAll();
+            _data = QByteArrayView(_buffer);
+        }
+    }
+
+    bool isOpen() const { return _file.isOpen(); }
+    QByteArrayView data() const { return _data; }
+
+private:
+    QFile _file;
+    QByteArray _buffer;
+    QByteArrayView _data;
+};
+
+} // namespace
+
 bool GeoTagWorker::process()
 {
     _cancel = false;
+    _lastProgress = 0;
     emit progressChanged(1);
 
     using StepFunction = bool (GeoTagWorker::*)();
@@ -81,33 +121,90 @@ bool GeoTagWorker::_loadImages()
     return true;
 }
 
-bool GeoTagWorker::_parseExif()
+bool GeoTagWorker::_forEachImage(int count, int step, const std::function<QString(int)> &imageFunction)
 {
-    _imageTimestamps.clear();
+    QList<int> indices(count);
+    std::iota(indices.begin(), indices.end(), 0);
 
-    // TODO: QtConcurrent::mapped?
-    for (const QFileInfo& fileInfo : _imageList) {
-        if (_cancel) {
-            emit error(tr("Tagging cancelled"));
-            return false;
+    QMutex errorMutex;
+    QString firstError;
+    std::atomic_bool failed = false;
+    std::atomic_int completed = 0;
+
+    QtConcurrent::blockingMap(indices, [&](int index) {
+        if (_cancel || failed) {
+            return;
         }
 
-        QFile file(fileInfo.absoluteFilePath());
-        if (!file.open(QIODevice::ReadOnly)) {
-            emit error(tr("Geotagging failed. Couldn't open image: %1").arg(fileInfo.fileName()));
-            return false;
+        const QString errorMsg = imageFunction(index);
+        if (!errorMsg.isEmpty()) {
+            QMutexLocker locker(&errorMutex);
+            if (!failed) {
+                failed = true;
+                firstError = errorMsg;
+            }
+            return;
         }
 
-        const QByteArray imageBuffer = file.readAll();
-        file.close();
+        _updateProgress(step, ++completed, count);
+    });
+
+    if (_cancel) {
+        emit error(tr("Tagging cancelled"));
+        return false;
+    }
+    if (failed) {
+        emit error(firstError);
+        return false;
+    }
+
+    return true;
+}
+
+void GeoTagWorker::_updateProgress(int step, int completed, int count)
+{
+    const double progress = (step + (static_cast<double>(completed) / count)) * (100. / kSteps);
+
+    // Called from multiple threads, only report whole percentages and never go backwards
+    QMutexLocker locker(&_progressMutex);
+    if ((progress - _lastProgress) >= 1.) {
+        _lastProgress = progress;
+        emit progressChanged(progress);
+    }
+}
+
+bool GeoTagWorker::_parseExif()
+{
+    _imageTimestamps.clear();
+    _imageTimestamps.resize(_imageList.count());
+
+    // Each thread only writes its own entries
+    double *const timestamps = _imageTimestamps.data();
+    const QFileInfoList &imageList = _imageList;
 
-        const QDateTime imageTime = ExifParser::readTime(imageBuffer);
+    const bool success = _forEachImage(_imageList.count(), 1, [timestamps, &imageList](int index) -> QString {
+        const QFileInfo &fileInfo = imageList.at(index);
+
+        const ImageFile image(fileInfo.absoluteFilePath());
+        if (!image.isOpen()) {
+            return tr("Geotagging failed. Couldn't open image: %1").arg(fileInfo.fileName());
+        }
+
+        // Only the EXIF header is needed, which keeps the rest of the mapped file from being read
+        const QByteArrayView data = image.data();
+        const qsizetype headerSize = ExifParser::headerSize(data.first(qMin(data.size(), ExifParser::kMaxHeaderSize)));
+        const QByteArrayView header = ((headerSize > 0) && (headerSize <= data.size())) ? data.first(headerSize) : data;
+        const QDateTime imageTime = ExifParser::readTime(QByteArray::fromRawData(header.constData(), header.size()));
         if (!imageTime.isValid()) {
-            emit error(tr("Geotagging failed. Couldn't extract time from image: %1").arg(fileInfo.fileName()));
-            return false;
+            return tr("Geotagging failed. Couldn't extract time from image: %1").arg(fileInfo.fileName());
         }
 
-        (void) _imageTimestamps.append(imageTime.toSecsSinceEpoch());
+        timestamps[index] = imageTime.toSecsSinceEpoch();
+        return QString();
+    });
+
+    if (!success) {
+        return false;
     }
 
     emit progressChanged(2.0 * (100.0 / kSteps));
@@ -125,16 +222,15 @@ bool GeoTagWorker::_parseLogs()
         return false;
     }
 
-    const QByteArray log = file.readAll();
-    file.close();
-
+    // Logs can be several GB, parse them from the file a block at a time
     bool parseComplete = false;
     QString errorString;
     if (_logFile.endsWith(".ulg", Qt::CaseSensitive)) {
-        parseComplete = ULogParser::getTagsFromLogStreamed(log, _triggerList, errorString);
+        parseComplete = ULogParser::getTagsFromLogStreamed(file, _triggerList, errorString);
     } else {
-        parseComplete = PX4LogParser::getTagsFromLog(log, _triggerList);
+        parseComplete = PX4LogParser::getTagsFromLog(file, _triggerList);
     }
+    file.close();
 
     if (!parseComplete) {
         emit error(errorString.isEmpty() ? tr("Log parsing failed") : errorString);
@@ -195,49 +291,61 @@ bool GeoTagWorker::_tagImages()
 {
     const qsizetype maxIndex = std::min(_imageIndices.count(), _triggerIndices.count());
     for (int i = 0; i < maxIndex; i++) {
-        if (_cancel) {
-            emit error(tr("Tagging cancelled"));
-            return false;
-        }
-
         const int imageIndex = _imageIndices[i];
-        if (imageIndex >= _imageList.count()) {
+        if ((imageIndex >= _imageList.count()) || (imageIndex >= _triggerList.count())) {
             emit error(tr("Geotagging failed. Requesting image #%1, but only %2 images present.").arg(imageIndex).arg(_imageList.count()));
             return false;
         }
+    }
 
-        const QFileInfo &imageInfo = _imageList.at(imageIndex);
-        QFile fileRead(imageInfo.absoluteFilePath());
-        if (!fileRead.open(QIODevice::ReadOnly)) {
-            emit error(tr("Geotagging failed. Couldn't open an image."));
-            return false;
-        }
+    return _forEachImage(maxIndex, 4, [this](int index) { return _tagImage(index); });
+}
 
-        QByteArray imageBuffer = fileRead.readAll();
-        fileRead.close();
+QString GeoTagWorker::_tagImage(int index) const
+{
+    const int imageIndex = _imageIndices[index];
+    const QFileInfo &imageInfo = _imageList.at(imageIndex);
 
-        if (!ExifParser::write(imageBuffer, _triggerList[imageIndex])) {
-            emit error(tr("Geotagging failed. Couldn't write to image: %1").arg(imageInfo.fileName()));
-            return false;
-        }
+    const ImageFile image(imageInfo.absoluteFilePath());
+    if (!image.isOpen()) {
+        return tr("Geotagging failed. Couldn't open an image.");
+    }
 
-        QFile fileWrite;
-        if (_saveDirectory.isEmpty()) {
-            fileWrite.setFileName(_imageDirectory + "/TAGGED/" + imageInfo.fileName());
-        } else {
-            fileWrite.setFileName(_saveDirectory + "/" + imageInfo.fileName());
+    // Only the EXIF header is changed, it is copied and updated while the image data is written straight from the mapping
+    const QByteArrayView data = image.data();
+    qsizetype headerSize = ExifParser::headerSize(data.first(qMin(data.size(), ExifParser::kMaxHeaderSize)));
+    if ((headerSize <= 0) || (headerSize > data.size())) {
+        headerSize = data.size();
+    }
+    QByteArray header = data.first(headerSize).toByteArray();
+    if (!ExifParser::write(header, _triggerList[imageIndex])) {
+        if (headerSize == data.size()) {
+            return tr("Geotagging failed. Couldn't write to image: %1").arg(imageInfo.fileName());
         }
 
-        if (!fileWrite.open(QFile::WriteOnly)) {
-            emit error(tr("Geotagging failed. Couldn't write to image: %1").arg(imageInfo.fileName()));
-            return false;
+        // Tag data which isn't in the APP1 segment, fall back to updating the whole image
+        header = data.toByteArray();
+        headerSize = data.size();
+        if (!ExifParser::write(header, _triggerList[imageIndex])) {
+            return tr("Geotagging failed. Couldn't write to image: %1").arg(imageInfo.fileName());
         }
+    }
+
+    QFile fileWrite;
+    if (_saveDirectory.isEmpty()) {
+        fileWrite.setFileName(_imageDirectory + "/TAGGED/" + imageInfo.fileName());
+    } else {
+        fileWrite.setFileName(_saveDirectory + "/" + imageInfo.fileName());
+    }
 
-        fileWrite.write(imageBuffer);
-        fileWrite.close();
+    if (!fileWrite.open(QFile::WriteOnly)) {
+        return tr("Geotagging failed. Couldn't write to image: %1").arg(imageInfo.fileName());
+    }
 
-        emit progressChanged(4. * (100. / kSteps) + ((100. / kSteps) / maxIndex) * i);
+    const QByteArrayView remainder = data.sliced(headerSize);
+    if ((fileWrite.write(header) != header.size()) || (fileWrite.write(remainder.constData(), remainder.size()) != remainder.size())) {
+        return tr("Geotagging failed. Couldn't write to image: %1").arg(imageInfo.fileName());
     }
 
-    return true;
+    return QString();
 }
@@ -2,11 +2,19 @@
 
 #include <QtCore/QFileInfoList>
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QString>
 
+#include <atomic>
+#include <functional>
+
 Q_DECLARE_LOGGING_CATEGORY(GeoTagWorkerLog)
 
+/// Matches the images in a directory to the camera trigger messages in a flight log and writes tagged copies.
+///     EXIF parsing and tagging run on the global thread pool. Images are memory mapped and only their EXIF header
+///     is read into memory, the tagged copy is written as the updated header followed by the rest of the mapped file.
+///     Signals may be emitted from thread pool threads.
 class GeoTagWorker : public QObject
 {
     Q_OBJECT
@@ -41,6 +49,8 @@ class GeoTagWorker : public QObject
 
 public slots:
     bool process();
+
+    /// Thread safe, may be called directly while process() is running
     void cancelTagging() { _cancel = true; }
 
 private:
@@ -50,7 +60,15 @@ public slots:
     bool _calibrate();
     bool _tagImages();
 
-    bool _cancel = false;
+    /// Runs imageFunction for each index on the thread pool, stopping at the first failure or cancellation
+    ///     @param imageFunction Returns an empty string on success, otherwise the error to report
+    bool _forEachImage(int count, int step, const std::function<QString(int)> &imageFunction);
+    QString _tagImage(int index) const;
+    void _updateProgress(int step, int completed, int count);
+
+    std::atomic_bool _cancel = false;
+    QMutex _progressMutex;
+    double _lastProgress = 0;
     QString _logFile;
     QString _imageDirectory;
     QString _saveDirectory;
@@ -0,0 +1,505 @@
+#include "LogBatchAnalyzer.h"
+#include "MAVLinkLib.h"
+#include "QGCLoggingCategory.h"
+#include "QGCZstdSeekable.h"
+#include "ULogParser.h"
+
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtCore/QDateTime>
+#include <QtCore/QDirIterator>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtCore/QtEndian>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <ulog_cpp/data_container.hpp>
+#include <ulog_cpp/messages.hpp>
+
+using namespace ulog_cpp;
+
+QGC_LOGGING_CATEGORY(LogBatchAnalyzerLog, "AnalyzeView.LogBatchAnalyzer")
+
+namespace {
+
+constexpr qint64 kReadBlockSize = 64 * 1024;
+constexpr int kTlogTimestampSize = sizeof(quint64);
+constexpr int kFrameLengthBytes = 3;            ///< STX, payload length and v2 incompatibility flags
+constexpr uint8_t kULogArmingStateArmed = 2;    ///< vehicle_status.arming_state
+
+/// Accumulates the parts of a summary which don't depend on the log format
+class SummaryBuilder
+{
+public:
+    explicit SummaryBuilder(LogBatchAnalyzer::Summary &summary) : _summary(summary) {}
+
+    void setTime(quint64 timeUs)
+    {
+        _firstTimeUs = std::min(_firstTimeUs, timeUs);
+        _lastTimeUs = std::max(_lastTimeUs, timeUs);
+    }
+
+    void setArmed(quint64 timeUs, bool armed)
+    {
+        if (armed && !_armed) {
+            _armedTimeUs = timeUs;
+        } else if (!armed && _armed && (timeUs > _armedTimeUs)) {
+            _flightTimeUs += timeUs - _armedTimeUs;
+        }
+        _armed = armed;
+    }
+
+    void setAltitude(double altitudeM)
+    {
+        if (std::isnan(_summary.maxAltitudeM) || (altitudeM > _summary.maxAltitudeM)) {
+            _summary.maxAltitudeM = altitudeM;
+        }
+    }
+
+    void setBatteryUsed(double usedMah)
+    {
+        if (std::isnan(_summary.batteryUsedMah) || (usedMah > _summary.batteryUsedMah)) {
+            _summary.batteryUsedMah = usedMah;
+        }
+    }
+
+    void setBatteryRemaining(double percent)
+    {
+        if (std::isnan(_summary.batteryStartPercent)) {
+            _summary.batteryStartPercent = percent;
+        }
+        _summary.batteryEndPercent = percent;
+    }
+
+    void addError(const QString &text)
+    {
+        _summary.errorCount++;
+        if (_summary.errors.count() < LogBatchAnalyzer::kMaxErrorTexts) {
+            _summary.errors.append(text.trimmed());
+        }
+    }
+
+    void finish()
+    {
+        // Log ended while still armed
+        setArmed(_lastTimeUs, false);
+
+        _summary.flightTimeSecs = _flightTimeUs / 1.0e6;
+        if (_lastTimeUs > _firstTimeUs) {
+            _summary.durationSecs = (_lastTimeUs - _firstTimeUs) / 1.0e6;
+        }
+    }
+
+private:
+    LogBatchAnalyzer::Summary &_summary;
+    quint64 _firstTimeUs = std::numeric_limits<quint64>::max();
+    quint64 _lastTimeUs = 0;
+    bool _armed = false;
+    quint64 _armedTimeUs = 0;
+    quint64 _flightTimeUs = 0;
+};
+
+/// Tlog timestamps are big endian, some tools have written them little endian
+quint64 tlogTimestamp(const uchar *bytes)
+{
+    static const quint64 now = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()) * 1000;
+
+    const quint64 timestamp = qFromBigEndian<quint64>(bytes);
+    return (timestamp > now) ? qFromLittleEndian<quint64>(bytes) : timestamp;
+}
+
+bool validTlogTimestamp(quint64 timeUs)
+{
+    static const quint64 now = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()) * 1000;
+
+    return (timeUs > 0) && (timeUs <= now);
+}
+
+/// @return Length of the MAVLink frame starting at frame, 0 if frame doesn't start with a STX
+int mavlinkFrameLength(const uchar *frame)
+{
+    switch (frame[0]) {
+    case MAVLINK_STX_MAVLINK1:
+        return MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1 + frame[1] + MAVLINK_NUM_CHECKSUM_BYTES;
+    case MAVLINK_STX:
+        return MAVLINK_NUM_HEADER_BYTES + frame[1] + MAVLINK_NUM_CHECKSUM_BYTES + ((frame[2] & MAVLINK_IFLAG_SIGNED) ? MAVLINK_SIGNATURE_BLOCK_LEN : 0);
+    default:
+        return 0;
+    }
+}
+
+/// Parser state is local rather than a MAVLink channel so any number of logs can be parsed at the same time
+/// @return false: Frame is not a complete message with a valid CRC
+bool decodeFrame(const uchar *frame, int length, mavlink_message_t &message)
+{
+    mavlink_message_t rxMessage{};
+    mavlink_status_t rxStatus{};
+    mavlink_status_t status{};
+
+    uint8_t result = MAVLINK_FRAMING_INCOMPLETE;
+    for (int i = 0; i < length; i++) {
+        result = mavlink_frame_char_buffer(&rxMessage, &rxStatus, frame[i], &message, &status);
+    }
+
+    return (result == MAVLINK_FRAMING_OK);
+}
+
+void handleTlogMessage(SummaryBuilder &builder, const mavlink_message_t &message, quint64 timeUs)
+{
+    switch (message.msgid) {
+    case MAVLINK_MSG_ID_HEARTBEAT:
+    {
+        mavlink_heartbeat_t heartbeat{};
+        mavlink_msg_heartbeat_decode(&message, &heartbeat);
+        // Only the autopilot's heartbeat has the armed state, cameras, gimbals and GCSs send heartbeats as well
+        if ((message.compid == MAV_COMP_ID_AUTOPILOT1) && (heartbeat.autopilot != MAV_AUTOPILOT_INVALID)) {
+            builder.setArmed(timeUs, (heartbeat.base_mode & MAV_MODE_FLAG_SAFETY_ARMED) != 0);
+        }
+        break;
+    }
+    case MAVLINK_MSG_ID_GLOBAL_POSITION_INT:
+        builder.setAltitude(mavlink_msg_global_position_int_get_relative_alt(&message) / 1000.0);
+        break;
+    case MAVLINK_MSG_ID_SYS_STATUS:
+    {
+        const int8_t remaining = mavlink_msg_sys_status_get_battery_remaining(&message);
+        if (remaining >= 0) {
+            builder.setBatteryRemaining(remaining);
+        }
+        break;
+    }
+    case MAVLINK_MSG_ID_BATTERY_STATUS:
+    {
+        mavlink_battery_status_t batteryStatus{};
+        mavlink_msg_battery_status_decode(&message, &batteryStatus);
+        if ((batteryStatus.id == 0) && (batteryStatus.current_consumed >= 0)) {
+            builder.setBatteryUsed(batteryStatus.current_consumed);
+        }
+        break;
+    }
+    case MAVLINK_MSG_ID_STATUSTEXT:
+    {
+        mavlink_statustext_t statusText{};
+        mavlink_msg_statustext_decode(&message, &statusText);
+        if (statusText.severity <= MAV_SEVERITY_ERROR) {
+            // Text is only null terminated when shorter than the field
+            builder.addError(QString::fromLatin1(statusText.text, qstrnlen(statusText.text, sizeof(statusText.text))));
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void handleULogSample(SummaryBuilder &builder, const std::string &topic, int multiId, const TypedDataView &sample)
+{
+    // Only the first battery, same as the tlog which only uses BATTERY_STATUS id 0. Samples of several batteries
+    // interleaved would make the start and end charge come from different batteries.
+    if ((topic == "battery_status") && (multiId != 0)) {
+        return;
+    }
+
+    try {
+        const uint64_t timeUs = sample.at("timestamp").as<uint64_t>();
+        builder.setTime(timeUs);
+
+        if (topic == "vehicle_status") {
+            builder.setArmed(timeUs, sample.at("arming_state").as<uint8_t>() == kULogArmingStateArmed);
+        } else if (topic == "vehicle_local_position") {
+            if (sample.at("z_valid").as<bool>()) {
+                // NED, up is negative
+                builder.setAltitude(-sample.at("z").as<float>());
+            }
+        } else if (topic == "battery_status") {
+            const float remaining = sample.at("remaining").as<float>();
+            if (remaining >= 0) {
+                builder.setBatteryRemaining(remaining * 100.0);
+            }
+            const float dischargedMah = sample.at("discharged_mah").as<float>();
+            if (dischargedMah >= 0) {
+                builder.setBatteryUsed(dischargedMah);
+            }
+        }
+    } catch (const AccessException &exception) {
+        qCDebug(LogBatchAnalyzerLog) << topic.c_str() << exception.what();
+    }
+}
+
+QByteArray csvNumber(double value, int precision)
+{
+    return std::isnan(value) ? QByteArray() : QByteArray::number(value, 'f', precision);
+}
+
+QByteArray csvText(const QString &text)
+{
+    QByteArray field = text.toUtf8();
+    if (field.contains(',') || field.contains('"') || field.contains('\n')) {
+        (void) field.replace("\"", "\"\"");
+        field = '"' + field + '"';
+    }
+    return field;
+}
+
+const char *formatName(LogBatchAnalyzer::LogFormat format)
+{
+    switch (format) {
+    case LogBatchAnalyzer::TlogFormat:
+        return "tlog";
+    case LogBatchAnalyzer::ULogFormat:
+        return "ulog";
+    default:
+        return "unknown";
+    }
+}
+
+} // namespace
+
+LogBatchAnalyzer::LogFormat LogBatchAnalyzer::_format(const QString &fileName)
+{
+    const QString name = QFileInfo(fileName).fileName().toLower();
+    if (name.endsWith(QStringLiteral(".tlog")) || name.endsWith(QStringLiteral(".tlog.zst"))) {
+        return TlogFormat;
+    }
+    if (name.endsWith(QStringLiteral(".ulg"))) {
+        return ULogFormat;
+    }
+
+    return UnknownFormat;
+}
+
+LogBatchAnalyzer::Summary LogBatchAnalyzer::analyzeFile(const QString &fileName)
+{
+    Summary summary;
+    summary.fileName = fileName;
+    summary.format = _format(fileName);
+
+    // Compressed telemetry logs are decompressed one frame at a time while they are parsed
+    std::unique_ptr<QIODevice> file;
+    if ((summary.format == TlogFormat) && QGCZstdSeekable::isZstdFile(fileName)) {
+        file = std::make_unique<QGCZstdSeekableDevice>(fileName);
+    } else {
+        file = std::make_unique<QFile>(fileName);
+    }
+    if (!file->open(QIODevice::ReadOnly)) {
+        summary.errorMessage = file->errorString();
+        return summary;
+    }
+
+    switch (summary.format) {
+    case TlogFormat:
+        (void) analyzeTlog(*file, summary);
+        break;
+    case ULogFormat:
+        (void) analyzeULog(*file, summary);
+        break;
+    default:
+        summary.errorMessage = QStringLiteral("Unknown log format");
+        break;
+    }
+
+    qCDebug(LogBatchAnalyzerLog) << fileName << "ok:" << summary.ok << summary.errorMessage;
+
+    return summary;
+}
+
+bool LogBatchAnalyzer::analyzeTlog(QIODevice &log, Summary &summary)
+{
+    summary.format = TlogFormat;
+    SummaryBuilder builder(summary);
+
+    // Each record is a timestamp followed by a single message. Records are taken apart using the frame length, so a
+    // record which was cut short (e.g. the logger was killed mid write) is detected by its CRC instead of swallowing
+    // the records which follow it. After a bad record the parser resyncs on the next plausible timestamp followed by
+    // a frame which passes its CRC.
+    mavlink_message_t message{};
+    quint64 messageCount = 0;
+    quint64 skippedBytes = 0;
+    int badRecordCount = 0;
+    bool resyncing = false;
+
+    QByteArray pending;
+    QByteArray block(kReadBlockSize, Qt::Uninitialized);
+    bool endOfLog = false;
+    while (!endOfLog) {
+        const qint64 bytesRead = log.read(block.data(), block.size());
+        if (bytesRead < 0) {
+            summary.errorMessage = log.errorString();
+            return false;
+        }
+        endOfLog = (bytesRead == 0);
+        pending.append(block.constData(), bytesRead);
+
+        const uchar *const bytes = reinterpret_cast<const uchar*>(pending.constData());
+        const qsizetype size = pending.size();
+        qsizetype pos = 0;
+        while ((pos + kTlogTimestampSize + kFrameLengthBytes) <= size) {
+            const uchar *const frame = bytes + pos + kTlogTimestampSize;
+            const int frameLength = mavlinkFrameLength(frame);
+            if ((frameLength > 0) && ((pos + kTlogTimestampSize + frameLength) > size) && !endOfLog) {
+                // Rest of the record is in the next block
+                break;
+            }
+
+            const quint64 timeUs = tlogTimestamp(bytes + pos);
+            const bool candidate = (frameLength > 0) && ((pos + kTlogTimestampSize + frameLength) <= size) && (!resyncing || validTlogTimestamp(timeUs));
+            if (candidate && decodeFrame(frame, frameLength, message)) {
+                resyncing = false;
+                messageCount++;
+                builder.setTime(timeUs);
+                handleTlogMessage(builder, message, timeUs);
+                pos += kTlogTimestampSize + frameLength;
+                continue;
+            }
+
+            if (!resyncing) {
+                resyncing = true;
+                badRecordCount++;
+            }
+            skippedBytes++;
+            pos++;
+        }
+
+        pending.remove(0, pos);
+    }
+
+    if (badRecordCount > 0) {
+        qCDebug(LogBatchAnalyzerLog) << "Skipped truncated or corrupt records:" << badRecordCount << "bytes:" << skippedBytes;
+    }
+
+    if (messageCount == 0) {
+        summary.errorMessage = QStringLiteral("No MAVLink messages found");
+        return false;
+    }
+
+    builder.finish();
+    summary.ok = true;
+
+    return true;
+}
+
+bool LogBatchAnalyzer::analyzeULog(QIODevice &log, Summary &summary)
+{
+    summary.format = ULogFormat;
+    SummaryBuilder builder(summary);
+
+    static const std::set<std::string> topics = { "vehicle_status", "vehicle_local_position", "battery_status" };
+
+    const ULogParser::TopicCallback callback = [&builder](const std::string &topic, int multiId, const TypedDataView &sample) {
+        handleULogSample(builder, topic, multiId, sample);
+    };
+    const ULogParser::LoggingCallback loggingCallback = [&builder](const Logging &logging) {
+        // Levels are ordered by severity, most severe first
+        if (logging.logLevel() <= Logging::Level::Error) {
+            builder.addError(QString::fromStdString(logging.message()));
+        }
+    };
+
+    if (!ULogParser::parseTopics(log, topics, callback, summary.errorMessage, loggingCallback)) {
+        return false;
+    }
+
+    // Recoverable errors are reported through the error message as well, they don't make the summary invalid
+    summary.errorMessage.clear();
+    builder.finish();
+    summary.ok = true;
+
+    return true;
+}
+
+QList<LogBatchAnalyzer::Summary> LogBatchAnalyzer::analyzeFiles(const QStringList &fileNames, int threadCount)
+{
+    QThreadPool pool;
+    if (threadCount > 0) {
+        pool.setMaxThreadCount(threadCount);
+    }
+
+    // Logs are independent, parsing state is per log so there is nothing to synchronize
+    return QtConcurrent::blockingMapped<QList<Summary>>(&pool, fileNames, &LogBatchAnalyzer::analyzeFile);
+}
+
+QStringList LogBatchAnalyzer::findLogs(const QString &directory)
+{
+    QStringList fileNames;
+
+    QDirIterator it(directory, { QStringLiteral("*.tlog"), QStringLiteral("*.tlog.zst"), QStringLiteral("*.ulg") }, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        fileNames.append(it.next());
+    }
+    fileNames.sort();
+
+    return fileNames;
+}
+
+bool LogBatchAnalyzer::writeReport(const QList<Summary> &summaries, QIODevice &output, QString &errorMessage)
+{
+    QByteArray report("file,format,status,duration_s,flight_time_s,max_altitude_m,battery_used_mah,battery_start_pct,battery_end_pct,error_count,errors\n");
+
+    for (const Summary &summary : summaries) {
+        const QList<QByteArray> fields = {
+            csvText(summary.fileName),
+            formatName(summary.format),
+            summary.ok ? QByteArray("ok") : csvText(summary.errorMessage),
+            csvNumber(summary.durationSecs, 1),
+            csvNumber(summary.flightTimeSecs, 1),
+            csvNumber(summary.maxAltitudeM, 1),
+            csvNumber(summary.batteryUsedMah, 0),
+            csvNumber(summary.batteryStartPercent, 0),
+            csvNumber(summary.batteryEndPercent, 0),
+            QByteArray::number(summary.errorCount),
+            csvText(summary.errors.join(QStringLiteral("; "))),
+        };
+        report.append(fields.join(','));
+        report.append('\n');
+    }
+
+    if (output.write(report) != report.size()) {
+        errorMessage = output.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+int LogBatchAnalyzer::runCommandLine(const QString &directory, const QString &reportFileName)
+{
+    if (!QFileInfo(directory).isDir()) {
+        qCritical() << "Log directory not found:" << directory;
+        return 1;
+    }
+
+    const QStringList fileNames = findLogs(directory);
+    qInfo() << "Analyzing" << fileNames.count() << "logs in" << directory << "using" << QThread::idealThreadCount() << "threads";
+
+    QElapsedTimer timer;
+    timer.start();
+    const QList<Summary> summaries = analyzeFiles(fileNames);
+    const qsizetype failedCount = std::count_if(summaries.cbegin(), summaries.cend(), [](const Summary &summary) { return !summary.ok; });
+    qInfo() << "Analyzed" << summaries.count() << "logs in" << timer.elapsed() << "ms," << failedCount << "could not be analyzed";
+
+    QString errorMessage;
+    if (reportFileName.isEmpty()) {
+        QFile output;
+        if (!output.open(stdout, QIODevice::WriteOnly) || !writeReport(summaries, output, errorMessage)) {
+            qCritical() << "Could not write report:" << (errorMessage.isEmpty() ? output.errorString() : errorMessage);
+            return 1;
+        }
+    } else {
+        QSaveFile output(reportFileName);
+        if (!output.open(QIODevice::WriteOnly) || !writeReport(summaries, output, errorMessage) || !output.commit()) {
+            qCritical() << "Could not write report" << reportFileName << ":" << (errorMessage.isEmpty() ? output.errorString() : errorMessage);
+            return 1;
+        }
+        qInfo() << "Report written to" << reportFileName;
+    }
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <limits>
+
+class QIODevice;
+
+Q_DECLARE_LOGGING_CATEGORY(LogBatchAnalyzerLog)
+
+/// Headless analysis of flight logs, for producing reports over a large number of logs without the user interface.
+///     Telemetry logs (.tlog, .tlog.zst) and ULogs (.ulg) are read in a single streaming pass each, only the few messages needed
+///     for the summary are decoded. A batch of logs is spread across a thread pool with one log per task, so a
+///     directory of logs is processed in parallel on all cores.
+class LogBatchAnalyzer
+{
+public:
+    enum LogFormat {
+        UnknownFormat,
+        TlogFormat,
+        ULogFormat,
+    };
+
+    static constexpr double kNoValue = std::numeric_limits<double>::quiet_NaN();
+
+    struct Summary {
+        QString fileName;
+        LogFormat format = UnknownFormat;
+        bool ok = false;
+        QString errorMessage;               ///< Reason the log could not be analyzed when !ok
+        double durationSecs = 0;            ///< Time from the first to the last timestamp in the log
+        double flightTimeSecs = 0;          ///< Total time armed
+        double maxAltitudeM = kNoValue;     ///< Highest altitude above home (tlog) or the local origin (ULog)
+        double batteryUsedMah = kNoValue;   ///< NaN if not logged
+        double batteryStartPercent = kNoValue;
+        double batteryEndPercent = kNoValue;
+        int errorCount = 0;                 ///< Messages reported by the vehicle at error severity or above
+        QStringList errors;                 ///< Text of the first kMaxErrorTexts error messages
+    };
+
+    /// Analyzes a single log, the format is determined from the file extension
+    static Summary analyzeFile(const QString &fileName);
+
+    /// @return false: Log could not be parsed, summary.errorMessage set
+    static bool analyzeTlog(QIODevice &log, Summary &summary);
+    static bool analyzeULog(QIODevice &log, Summary &summary);
+
+    /// Analyzes the logs in parallel
+    ///     @param threadCount Maximum number of logs processed at the same time, 0 for one per core
+    /// @return Summaries in the same order as fileNames
+    static QList<Summary> analyzeFiles(const QStringList &fileNames, int threadCount = 0);
+
+    /// @return Logs found in directory and its subdirectories, sorted by path
+    static QStringList findLogs(const QString &directory);
+
+    /// Writes one CSV row per summary with a header row
+    static bool writeReport(const QList<Summary> &summaries, QIODevice &output, QString &errorMessage);
+
+    /// Entry point for the --analyze-logs command line option
+    ///     @param reportFileName CSV report file, empty to write the report to stdout
+    /// @return Process exit code
+    static int runCommandLine(const QString &directory, const QString &reportFileName);
+
+    static constexpr int kMaxErrorTexts = 5;
+
+private:
+    static LogFormat _format(const QString &fileName);
+};
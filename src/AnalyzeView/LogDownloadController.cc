@@ -1,5 +1,6 @@
 #include "LogDownloadController.h"
 #include "AppSettings.h"
+#include "FTPManager.h"
 #include "LogEntry.h"
 #include "MAVLinkProtocol.h"
 #include "MultiVehicleManager.h"
@@ -11,8 +12,12 @@
 #include "Vehicle.h"
 
 #include <QtCore/QApplicationStatic>
+#include <QtCore/QFileInfo>
+#include <QtCore/QRegularExpression>
 #include <QtCore/QTimer>
 
+#include <algorithm>
+
 QGC_LOGGING_CATEGORY(LogDownloadControllerLog, "AnalyzeView.LogDownloadController")
 
 LogDownloadController::LogDownloadController(QObject *parent)
@@ -69,7 +74,7 @@ void LogDownloadController::_processDownload()
 {
     if (_requestingLogEntries) {
         _findMissingEntries();
-    } else if (_downloadingLogs) {
+    } else if (_downloadingLogs && _downloadData && (_ftpState == FtpIdle)) {
         _findMissingData();
     }
 }
@@ -134,6 +139,7 @@ void LogDownloadController::_setActiveVehicle(Vehicle *vehicle)
         _logEntriesModel->clearAndDeleteContents();
         (void) disconnect(_vehicle, &Vehicle::logEntry, this, &LogDownloadController::_logEntry);
         (void) disconnect(_vehicle, &Vehicle::logData,  this, &LogDownloadController::_logData);
+        (void) disconnect(_vehicle->ftpManager(), nullptr, this, nullptr);
     }
 
     _vehicle = vehicle;
@@ -141,6 +147,9 @@ void LogDownloadController::_setActiveVehicle(Vehicle *vehicle)
     if (_vehicle) {
         (void) connect(_vehicle, &Vehicle::logEntry, this, &LogDownloadController::_logEntry);
         (void) connect(_vehicle, &Vehicle::logData,  this, &LogDownloadController::_logData);
+        (void) connect(_vehicle->ftpManager(), &FTPManager::listDirectoryComplete, this, &LogDownloadController::_ftpListDirectoryComplete);
+        (void) connect(_vehicle->ftpManager(), &FTPManager::downloadComplete, this, &LogDownloadController::_ftpDownloadComplete);
+        (void) connect(_vehicle->ftpManager(), &FTPManager::commandProgress, this, &LogDownloadController::_ftpCommandProgress);
     }
 }
 
@@ -215,7 +224,7 @@ bool LogDownloadController::_entriesComplete() const
 
 void LogDownloadController::_logData(uint32_t ofs, uint16_t id, uint8_t count, const uint8_t *data)
 {
-    if (!_downloadingLogs || !_downloadData) {
+    if (!_downloadingLogs || !_downloadData || (_ftpState != FtpIdle)) {
         return;
     }
 
@@ -230,92 +239,101 @@ void LogDownloadController::_logData(uint32_t ofs, uint16_t id, uint8_t count, c
         return;
     }
 
-    bool result = false;
-    if (ofs <= _downloadData->entry->size()) {
-        const uint32_t chunk = ofs / LogDownloadData::kChunkSize;
-        // qCDebug(LogDownloadControllerLog) << "Received data - Offset:" << ofs << "Chunk:" << chunk;
-        if (chunk != _downloadData->current_chunk) {
-            qCWarning(LogDownloadControllerLog) << "Ignored packet for out of order chunk actual:expected" << chunk << _downloadData->current_chunk;
-            return;
-        }
+    if (ofs > _downloadData->entry->size()) {
+        qCWarning(LogDownloadControllerLog) << "Received log offset greater than expected";
+        _downloadData->entry->setStatus(tr("Error"));
+        return;
+    }
 
-        const uint16_t bin = (ofs - (chunk * LogDownloadData::kChunkSize)) / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
-        if (bin >= _downloadData->chunk_table.size()) {
-            qCWarning(LogDownloadControllerLog) << "Out of range bin received";
-        } else {
-            _downloadData->chunk_table.setBit(bin);
-        }
+    const uint32_t bin = ofs / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+    // qCDebug(LogDownloadControllerLog) << "Received data - Offset:" << ofs << "Bin:" << bin;
+    const uint written = _downloadData->written;
+    if (!_downloadData->storeBin(bin, data, count)) {
+        qCDebug(LogDownloadControllerLog) << "Ignored packet outside of the current window bin:window" << bin << _downloadData->window_start;
+        return;
+    }
 
-        if (_downloadData->file.pos() != ofs) {
-            if (!_downloadData->file.seek(ofs)) {
-                qCWarning(LogDownloadControllerLog) << "Error while seeking log file offset";
-                return;
-            }
-        }
+    _downloadData->rate_bytes += (_downloadData->written - written);
+    _updateDataRate();
+    _retries = 0;
 
-        if (_downloadData->file.write(reinterpret_cast<const char*>(data), count)) {
-            _downloadData->written += count;
-            _downloadData->rate_bytes += count;
-            _updateDataRate();
-
-            result = true;
-            _retries = 0;
-
-            _timer->start(kTimeOutMs);
-            if (_logComplete()) {
-                _downloadData->entry->setStatus(tr("Downloaded"));
-                _receivedAllData();
-            } else if (_chunkComplete()) {
-                _downloadData->advanceChunk();
-                _requestLogData(_downloadData->ID,
-                                _downloadData->current_chunk * LogDownloadData::kChunkSize,
-                                _downloadData->chunk_table.size() * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
-            } else if ((bin < (_downloadData->chunk_table.size() - 1)) && _downloadData->chunk_table.at(bin + 1)) {
-                // Likely to be grabbing fragments and got to the end of a gap
-                _findMissingData();
-            }
-        } else {
-            qCWarning(LogDownloadControllerLog) << "Error while writing log file chunk";
-        }
+    _timer->start(kTimeOutMs);
+    if (_downloadData->windowComplete()) {
+        _windowComplete();
     } else {
-        qCWarning(LogDownloadControllerLog) << "Received log offset greater than expected";
+        const uint32_t windowBin = bin - _downloadData->window_start;
+        if ((windowBin < static_cast<uint32_t>(_downloadData->window_table.size() - 1)) && _downloadData->window_table.testBit(windowBin + 1)) {
+            // Likely to be grabbing fragments and got to the end of a gap
+            _findMissingData();
+        }
     }
+}
 
-    if (!result) {
+void LogDownloadController::_windowComplete()
+{
+    if (!_downloadData->writeWindow()) {
+        qCWarning(LogDownloadControllerLog) << "Error while writing log file window" << _downloadData->file.errorString();
         _downloadData->entry->setStatus(tr("Error"));
+        _receivedAllData();
+        return;
     }
-}
 
-void LogDownloadController::_findMissingData()
-{
-    if (_logComplete()) {
+    if (_downloadData->logComplete()) {
+        _downloadData->file.close();
+        _downloadData->entry->setStatus(tr("Downloaded"));
         _receivedAllData();
         return;
     }
 
-    if (_chunkComplete()) {
-        _downloadData->advanceChunk();
+    // Grow the window while the link delivers everything, back off once it starts dropping data
+    const uint32_t windowBins = static_cast<uint32_t>(_downloadData->window_table.size());
+    uint32_t chunks = _downloadData->window_chunks;
+    if (_downloadData->window_refetched == 0) {
+        chunks *= 2;
+    } else if (_downloadData->window_refetched > (windowBins / 10)) {
+        chunks /= 2;
+    }
+    qCDebug(LogDownloadControllerLog) << "Window complete - refetched bins:" << _downloadData->window_refetched << "of" << windowBins << "next window chunks:" << chunks;
+
+    _downloadData->startWindow(chunks);
+    _requestWindow();
+}
+
+void LogDownloadController::_requestWindow()
+{
+    _requestLogData(_downloadData->ID,
+                    _downloadData->window_start * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN,
+                    _downloadData->window_table.size() * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
+}
+
+void LogDownloadController::_findMissingData()
+{
+    if (_downloadData->windowComplete()) {
+        _windowComplete();
+        return;
     }
 
     _retries++;
 
     _updateDataRate();
 
-    uint16_t start = 0, end = 0;
-    const int size = _downloadData->chunk_table.size();
+    uint32_t start = 0, end = 0;
+    const uint32_t size = static_cast<uint32_t>(_downloadData->window_table.size());
     for (; start < size; start++) {
-        if (!_downloadData->chunk_table.testBit(start)) {
+        if (!_downloadData->window_table.testBit(start)) {
             break;
         }
     }
 
     for (end = start; end < size; end++) {
-        if (_downloadData->chunk_table.testBit(end)) {
+        if (_downloadData->window_table.testBit(end)) {
             break;
         }
     }
 
-    const uint32_t pos = (_downloadData->current_chunk * LogDownloadData::kChunkSize) + (start * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
+    _downloadData->window_refetched += (end - start);
+
+    const uint32_t pos = (_downloadData->window_start + start) * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
     const uint32_t len = (end - start) * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
     _requestLogData(_downloadData->ID, pos, len, _retries);
 }
@@ -337,25 +355,190 @@ void LogDownloadController::_updateDataRate()
     _downloadData->elapsed.start();
 }
 
-bool LogDownloadController::_chunkComplete() const
+void LogDownloadController::_receivedAllData()
 {
-    return _downloadData->chunkEquals(true);
+    _timer->stop();
+    if (!_prepareLogDownload()) {
+        _resetSelection();
+        _setDownloading(false);
+    } else if (!_startFtpDownload()) {
+        _startMavlinkDownload();
+    }
 }
 
-bool LogDownloadController::_logComplete() const
+void LogDownloadController::_startMavlinkDownload()
 {
-    return (_chunkComplete() && ((_downloadData->current_chunk + 1) == _downloadData->numChunks()));
+    _ftpState = FtpIdle;
+
+    if (!_downloadData->file.isOpen()) {
+        if (!_downloadData->file.open(QIODevice::WriteOnly) || !_downloadData->file.resize(_downloadData->entry->size())) {
+            qCWarning(LogDownloadControllerLog) << "Failed to create log file:" << _downloadData->file.fileName();
+            _downloadData->entry->setStatus(tr("Error"));
+            _receivedAllData();
+            return;
+        }
+    }
+
+    _downloadData->startWindow(LogDownloadData::kInitialWindowChunks);
+    _downloadData->elapsed.start();
+    if (_downloadData->logComplete()) {
+        // Empty log
+        _windowComplete();
+        return;
+    }
+
+    _requestWindow();
+    _timer->start(kTimeOutMs);
 }
 
-void LogDownloadController::_receivedAllData()
+bool LogDownloadController::_startFtpDownload()
 {
-    _timer->stop();
-    if (_prepareLogDownload()) {
-        _requestLogData(_downloadData->ID, 0, _downloadData->chunk_table.size() * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
-        _timer->start(kTimeOutMs);
+    if (!(_vehicle->capabilityBits() & MAV_PROTOCOL_CAPABILITY_FTP)) {
+        return false;
+    }
+
+    if (_vehicle->px4Firmware()) {
+        // PX4 names each log after its start time in a directory per date, which is also the time it reports in LOG_ENTRY
+        const QDateTime time = _downloadData->entry->time().toUTC();
+        if (time.date().year() < 2010) {
+            qCDebug(LogDownloadControllerLog) << "Log" << _downloadData->ID << "has no time, using LOG_REQUEST_DATA";
+            return false;
+        }
+        _ftpDir = QString::fromLatin1(kPX4FtpLogRoot) + QLatin1Char('/') + time.toString(QStringLiteral("yyyy-MM-dd"));
+        _ftpFileName = time.toString(QStringLiteral("HH_mm_ss")) + QStringLiteral(".ulg");
+    } else if (_vehicle->apmFirmware()) {
+        // ArduPilot log ids depend on which numbered files exist, see _apmFtpLogFileName
+        _ftpDir = QString::fromLatin1(kAPMFtpLogRoot);
+        _ftpFileName.clear();
     } else {
-        _resetSelection();
-        _setDownloading(false);
+        return false;
+    }
+
+    if (!_vehicle->ftpManager()->listDirectory(_vehicle->defaultComponentId(), _ftpDir)) {
+        qCDebug(LogDownloadControllerLog) << "MAVLink FTP busy, using LOG_REQUEST_DATA";
+        return false;
+    }
+
+    qCDebug(LogDownloadControllerLog) << "Searching for log" << _downloadData->ID << "with MAVLink FTP in" << _ftpDir;
+    _ftpState = FtpListing;
+    _downloadData->entry->setStatus(tr("Searching"));
+
+    return true;
+}
+
+QString LogDownloadController::_apmFtpLogFileName(const QHash<QString, uint> &files) const
+{
+    // ArduPilot lists its logs from the oldest to the newest. Log numbers wrap around once the maximum log number is
+    // reached, the oldest log then follows the only gap in the numbering.
+    static const QRegularExpression logFileRegExp(QStringLiteral("^(\\d+)\\.BIN$"));
+
+    QList<QPair<uint, QString>> logFiles;
+    for (auto it = files.constBegin(); it != files.constEnd(); ++it) {
+        const QRegularExpressionMatch match = logFileRegExp.match(it.key());
+        if (match.hasMatch()) {
+            logFiles.append(qMakePair(match.captured(1).toUInt(), it.key()));
+        }
+    }
+    if (logFiles.isEmpty() || (logFiles.count() != _logEntriesModel->count())) {
+        qCDebug(LogDownloadControllerLog) << "MAVLink FTP found" << logFiles.count() << "log files for" << _logEntriesModel->count() << "log entries";
+        return QString();
+    }
+
+    std::sort(logFiles.begin(), logFiles.end());
+    qsizetype oldestIndex = 0;
+    int gapCount = 0;
+    for (qsizetype i = 1; i < logFiles.count(); i++) {
+        if (logFiles[i].first != (logFiles[i - 1].first + 1)) {
+            oldestIndex = i;
+            gapCount++;
+        }
+    }
+    if (gapCount > 1) {
+        qCDebug(LogDownloadControllerLog) << "MAVLink FTP log numbers have" << gapCount << "gaps, unable to map log ids";
+        return QString();
+    }
+
+    return logFiles[(oldestIndex + _downloadData->ID) % logFiles.count()].second;
+}
+
+void LogDownloadController::_ftpListDirectoryComplete(const QStringList &dirList, const QString &errorMsg)
+{
+    if ((_ftpState != FtpListing) || !_downloadData) {
+        return;
+    }
+
+    if (!errorMsg.isEmpty()) {
+        qCDebug(LogDownloadControllerLog) << "MAVLink FTP list failed, using LOG_REQUEST_DATA" << errorMsg;
+        _startMavlinkDownload();
+        return;
+    }
+
+    QHash<QString, uint> files;
+    for (const QString &entry : dirList) {
+        if (entry.startsWith(QLatin1Char('F'))) {
+            const QStringList nameAndSize = entry.mid(1).split(QLatin1Char('\t'));
+            if (nameAndSize.count() == 2) {
+                files.insert(nameAndSize[0], nameAndSize[1].toUInt());
+            }
+        }
+    }
+
+    const QString fileName = _ftpFileName.isEmpty() ? _apmFtpLogFileName(files) : _ftpFileName;
+    if (fileName.isEmpty() || !files.contains(fileName)) {
+        qCDebug(LogDownloadControllerLog) << "MAVLink FTP did not find log" << _downloadData->ID << fileName << ", using LOG_REQUEST_DATA";
+        _startMavlinkDownload();
+        return;
+    }
+    if (files.value(fileName) != _downloadData->entry->size()) {
+        qCDebug(LogDownloadControllerLog) << "MAVLink FTP file" << fileName << "size" << files.value(fileName) << "does not match log" << _downloadData->ID
+                                          << "size" << _downloadData->entry->size() << ", using LOG_REQUEST_DATA";
+        _startMavlinkDownload();
+        return;
+    }
+
+    // FTPManager creates the file itself
+    const QFileInfo fileInfo(_downloadData->file.fileName());
+    (void) _downloadData->file.remove();
+
+    const QString ftpPath = _ftpDir + QLatin1Char('/') + fileName;
+    qCDebug(LogDownloadControllerLog) << "Downloading log" << _downloadData->ID << "with MAVLink FTP from" << ftpPath;
+    _ftpState = FtpDownloading;
+    _downloadData->elapsed.start();
+    if (!_vehicle->ftpManager()->download(_vehicle->defaultComponentId(), ftpPath, fileInfo.absolutePath(), fileInfo.fileName())) {
+        _startMavlinkDownload();
+    }
+}
+
+void LogDownloadController::_ftpDownloadComplete(const QString &file, const QString &errorMsg)
+{
+    Q_UNUSED(file);
+
+    if ((_ftpState != FtpDownloading) || !_downloadData) {
+        return;
+    }
+
+    if (!errorMsg.isEmpty()) {
+        qCWarning(LogDownloadControllerLog) << "MAVLink FTP download failed, using LOG_REQUEST_DATA" << errorMsg;
+        _startMavlinkDownload();
+        return;
+    }
+
+    _ftpState = FtpIdle;
+    _downloadData->entry->setStatus(tr("Downloaded"));
+    _receivedAllData();
+}
+
+void LogDownloadController::_ftpCommandProgress(float value)
+{
+    if ((_ftpState != FtpDownloading) || !_downloadData) {
+        return;
+    }
+
+    const uint written = static_cast<uint>(value * _downloadData->entry->size());
+    if (written > _downloadData->written) {
+        _downloadData->rate_bytes += (written - _downloadData->written);
+        _downloadData->written = written;
+        _updateDataRate();
     }
 }
 
@@ -406,8 +589,6 @@ bool LogDownloadController::_prepareLogDownload()
     } else if (!_downloadData->file.resize(entry->size())) {
         qCWarning(LogDownloadControllerLog) << "Failed to allocate space for log file:" <<  _downloadData->filename;
     } else {
-        _downloadData->current_chunk = 0;
-        _downloadData->chunk_table = QBitArray(_downloadData->chunkBins(), false);
         _downloadData->elapsed.start();
         result = true;
     }
@@ -449,6 +630,14 @@ QGCLogEntry *LogDownloadController::_getNextSelected() const
 
 void LogDownloadController::cancel()
 {
+    const FtpState ftpState = _ftpState;
+    _ftpState = FtpIdle;
+    if (ftpState == FtpListing) {
+        _vehicle->ftpManager()->cancelListDirectory();
+    } else if (ftpState == FtpDownloading) {
+        _vehicle->ftpManager()->cancelDownload();
+    }
+
     _requestLogEnd();
     _receivedAllEntries();
 
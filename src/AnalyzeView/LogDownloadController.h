@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QtCore/QHash>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
 #include <QtQmlIntegration/QtQmlIntegration>
@@ -64,6 +65,9 @@ private slots:
     void _logEntry(uint32_t time_utc, uint32_t size, uint16_t id, uint16_t num_logs, uint16_t last_log_num);
     void _logData(uint32_t ofs, uint16_t id, uint8_t count, const uint8_t *data);
     void _processDownload();
+    void _ftpListDirectoryComplete(const QStringList &dirList, const QString &errorMsg);
+    void _ftpDownloadComplete(const QString &file, const QString &errorMsg);
+    void _ftpCommandProgress(float value);
     void _handleCompressionProgress(qreal progress);
     void _handleCompressionFinished(bool success);
 
@@ -72,9 +76,7 @@ private slots:
     bool _getRequestingList() const { return _requestingLogEntries; }
     bool _getDownloadingLogs() const { return _downloadingLogs; }
 
-    bool _chunkComplete() const;
     bool _entriesComplete() const;
-    bool _logComplete() const;
     bool _prepareLogDownload();
     void _downloadToDirectory(const QString &dir);
     void _findMissingData();
@@ -84,6 +86,11 @@ private slots:
     void _requestLogData(uint16_t id, uint32_t offset, uint32_t count, int retryCount = 0);
     void _requestLogList(uint32_t start, uint32_t end);
     void _requestLogEnd();
+    void _requestWindow();
+    void _startMavlinkDownload();
+    bool _startFtpDownload();
+    QString _apmFtpLogFileName(const QHash<QString, uint> &files) const;
+    void _windowComplete();
     void _resetSelection(bool canceled = false);
     void _setDownloading(bool active);
     void _setListing(bool active);
@@ -91,6 +98,15 @@ private slots:
 
     QGCLogEntry *_getNextSelected() const;
 
+    /// Logs are fetched with MAVLink FTP burst reads when the vehicle supports it. The file which belongs to a log
+    /// entry is derived from the log id (ArduPilot) or the log time (PX4) and its size is checked against the log
+    /// entry. If the file can't be identified that way the log is downloaded with LOG_REQUEST_DATA instead.
+    enum FtpState {
+        FtpIdle,
+        FtpListing,
+        FtpDownloading,
+    };
+
     QTimer *_timer = nullptr;
     QmlObjectListModel *_logEntriesModel = nullptr;
 
@@ -104,8 +120,13 @@ private slots:
     bool _compressLogs = false;
     bool _compressing = false;
     float _compressionProgress = 0.0F;
+    FtpState _ftpState = FtpIdle;
+    QString _ftpDir;                        ///< Directory which contains the log being downloaded
+    QString _ftpFileName;                   ///< Expected file name of the log, empty if it comes from the directory listing
 
     static constexpr uint32_t kTimeOutMs = 500;
     static constexpr uint32_t kGUIRateMs = 17; ///< 1000ms / 60fps
     static constexpr uint32_t kRequestLogListTimeoutMs = 5000;
+    static constexpr const char *kPX4FtpLogRoot = "/fs/microsd/log";
+    static constexpr const char *kAPMFtpLogRoot = "/APM/LOGS";
 };
@@ -4,6 +4,8 @@
 
 #include <QtCore/QtMath>
 
+#include <cstring>
+
 QGC_LOGGING_CATEGORY(LogEntryLog, "AnalyzeView.QGCLogEntry")
 
 LogDownloadData::LogDownloadData(QGCLogEntry * const entry)
@@ -18,27 +20,57 @@ LogDownloadData::~LogDownloadData()
     // qCDebug(LogEntryLog) << Q_FUNC_INFO << this;
 }
 
-void LogDownloadData::advanceChunk()
+void LogDownloadData::startWindow(uint32_t chunks)
 {
-    ++current_chunk;
-    chunk_table = QBitArray(chunkBins(), false);
+    window_start += window_table.size();
+    window_chunks = qBound(kMinWindowChunks, chunks, kMaxWindowChunks);
+
+    const uint32_t bins = qMin(window_chunks * kTableBins, numBins() - qMin(window_start, numBins()));
+    window_table = QBitArray(bins, false);
+    window_received = 0;
+    window_refetched = 0;
+
+    const qint64 offset = static_cast<qint64>(window_start) * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+    const qint64 bytes = qMin(static_cast<qint64>(bins) * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN, static_cast<qint64>(entry->size()) - offset);
+    window_buffer.resize(qMax(bytes, 0LL));
 }
 
-uint32_t LogDownloadData::chunkBins() const
+uint32_t LogDownloadData::numBins() const
 {
-    const qreal num = static_cast<qreal>((entry->size() - (current_chunk * kChunkSize))) / static_cast<qreal>(MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
-    return qMin(static_cast<uint32_t>(qCeil(num)), kTableBins);
+    const qreal num = static_cast<qreal>(entry->size()) / static_cast<qreal>(MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
+    return qCeil(num);
 }
 
-uint32_t LogDownloadData::numChunks() const
+bool LogDownloadData::storeBin(uint32_t bin, const uint8_t *data, uint8_t count)
 {
-    const qreal num = static_cast<qreal>(entry->size()) / static_cast<qreal>(kChunkSize);
-    return qCeil(num);
+    if ((bin < window_start) || ((bin - window_start) >= static_cast<uint32_t>(window_table.size()))) {
+        return false;
+    }
+
+    const uint32_t windowBin = bin - window_start;
+    const qsizetype offset = static_cast<qsizetype>(windowBin) * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+    const qsizetype bytes = qMin(static_cast<qsizetype>(count), window_buffer.size() - offset);
+    if (bytes > 0) {
+        (void) memcpy(window_buffer.data() + offset, data, bytes);
+    }
+
+    if (!window_table.testBit(windowBin)) {
+        window_table.setBit(windowBin);
+        window_received++;
+        written += bytes;
+    }
+
+    return true;
 }
 
-bool LogDownloadData::chunkEquals(const bool val) const
+bool LogDownloadData::writeWindow()
 {
-    return (chunk_table == QBitArray(chunk_table.size(), val));
+    const qint64 offset = static_cast<qint64>(window_start) * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+    if ((file.pos() != offset) && !file.seek(offset)) {
+        return false;
+    }
+
+    return (file.write(window_buffer) == window_buffer.size());
 }
 
 /*===========================================================================*/
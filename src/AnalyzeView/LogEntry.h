@@ -1,8 +1,10 @@
 #pragma once
 
 #include <QtCore/QBitArray>
+#include <QtCore/QByteArray>
 #include <QtCore/QDateTime>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
 #include <QtCore/QString>
@@ -19,22 +21,32 @@ struct LogDownloadData
     explicit LogDownloadData(QGCLogEntry * const entry);
     ~LogDownloadData();
 
-    void advanceChunk();
+    /// Starts the next window at the first bin following the current one
+    ///     @param chunks Window size in kChunkSize chunks, the last window of a log may be smaller
+    void startWindow(uint32_t chunks);
 
-    /// The number of MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN bins in the current chunk
-    uint32_t chunkBins() const;
+    /// The number of MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN bins in the file
+    uint32_t numBins() const;
 
-    /// The number of kChunkSize chunks in the file
-    uint32_t numChunks() const;
+    /// Copies the payload of a LOG_DATA message into the window buffer
+    ///     @return false: Bin is outside the current window
+    bool storeBin(uint32_t bin, const uint8_t *data, uint8_t count);
 
-    /// True if all bins in the chunk have been set to val
-    bool chunkEquals(const bool val) const;
+    /// Writes the window buffer to the file with a single write
+    bool writeWindow();
+
+    bool windowComplete() const { return window_received == static_cast<uint32_t>(window_table.size()); }
+    bool logComplete() const { return windowComplete() && ((window_start + window_table.size()) >= numBins()); }
 
     uint ID = 0;
     QGCLogEntry *const entry = nullptr;
 
-    QBitArray chunk_table;
-    uint32_t current_chunk = 0;
+    uint32_t window_start = 0;          ///< First bin of the current window
+    QBitArray window_table;             ///< Bins of the current window which have been received
+    uint32_t window_received = 0;       ///< Number of set bits in window_table
+    uint32_t window_refetched = 0;      ///< Bins of the current window which had to be requested again
+    uint32_t window_chunks = kInitialWindowChunks;
+    QByteArray window_buffer;           ///< Data of the current window, written to the file once complete
     QFile file;
     QString filename;
     uint written = 0;
@@ -44,6 +56,9 @@ struct LogDownloadData
 
     static constexpr uint32_t kTableBins = 512;
     static constexpr uint32_t kChunkSize = kTableBins * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+    static constexpr uint32_t kInitialWindowChunks = 4;
+    static constexpr uint32_t kMinWindowChunks = 1;
+    static constexpr uint32_t kMaxWindowChunks = 64;    ///< ~2.9MB window buffer
 };
 
 /*===========================================================================*/
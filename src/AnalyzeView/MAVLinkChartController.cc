@@ -73,6 +73,17 @@ void MAVLinkChartController::setRangeXIndex(quint32 index)
     updateXRange();
 }
 
+void MAVLinkChartController::setPlotWidth(int width)
+{
+    width = qMax(width, 1);
+    if (width == _plotWidth) {
+        return;
+    }
+
+    _plotWidth = width;
+    emit plotWidthChanged();
+}
+
 void MAVLinkChartController::updateXRange()
 {
     if (_rangeXIndex >= static_cast<quint32>(_inspectorController->timeScaleSt().count())) {
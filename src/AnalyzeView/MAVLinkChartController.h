@@ -30,6 +30,7 @@ class MAVLinkChartController : public QObject
     Q_PROPERTY(qreal        rangeYMax   READ rangeYMax                              NOTIFY rangeYMaxChanged)
     Q_PROPERTY(quint32      rangeYIndex READ rangeYIndex    WRITE setRangeYIndex    NOTIFY rangeYIndexChanged)
     Q_PROPERTY(quint32      rangeXIndex READ rangeXIndex    WRITE setRangeXIndex    NOTIFY rangeXIndexChanged)
+    Q_PROPERTY(int          plotWidth   READ plotWidth      WRITE setPlotWidth      NOTIFY plotWidthChanged)
 
 
 public:
@@ -49,9 +50,11 @@ class MAVLinkChartController : public QObject
     quint32 rangeXIndex() const { return _rangeXIndex; }
     quint32 rangeYIndex() const { return _rangeYIndex; }
     int chartIndex() const { return _chartIndex; }
+    int plotWidth() const { return _plotWidth; }
 
     void setRangeXIndex(quint32 index);
     void setRangeYIndex(quint32 index);
+    void setPlotWidth(int width);
     void updateXRange();
     void updateYRange();
 
@@ -63,6 +66,7 @@ class MAVLinkChartController : public QObject
     void rangeYMaxChanged();
     void rangeYIndexChanged();
     void rangeXIndexChanged();
+    void plotWidthChanged();
 
 private slots:
     void _refreshSeries();
@@ -79,6 +83,8 @@ private slots:
     quint32 _rangeXIndex = 0;   ///< 5 Seconds
     quint32 _rangeYIndex = 0;   ///< Auto Range
     QVariantList _chartFields;
+    int _plotWidth = kDefaultPlotWidth;     ///< Pixels, series are decimated to this many points
 
     static constexpr int kUpdateFrequency = 1000 / 15;  ///< 15Hz
+    static constexpr int kDefaultPlotWidth = 1000;
 };
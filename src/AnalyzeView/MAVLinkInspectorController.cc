@@ -187,10 +187,47 @@ void MAVLinkInspectorController::_vehicleRemoved(const Vehicle *vehicle)
     emit systemsChanged();
 }
 
+void MAVLinkInspectorController::setActive(bool active)
+{
+    if (active == _active) {
+        return;
+    }
+
+    _active = active;
+    qCDebug(MAVLinkInspectorControllerLog) << "active" << _active;
+
+    if (_active) {
+        // Catch up on what was counted while hidden
+        for (int i = 0; i < _systems->count(); i++) {
+            QGCMAVLinkSystem *const system = qobject_cast<QGCMAVLinkSystem*>(_systems->get(i));
+            if (!system) {
+                continue;
+            }
+
+            for (int j = 0; j < system->messages()->count(); j++) {
+                QGCMAVLinkMessage *const msg = qobject_cast<QGCMAVLinkMessage*>(system->messages()->get(j));
+                if (msg) {
+                    msg->setCount(_counters.count(msg->sysId(), msg->compId(), msg->id()));
+                }
+            }
+        }
+        _updateFrequencyTimer->start();
+    } else {
+        _updateFrequencyTimer->stop();
+    }
+
+    emit activeChanged();
+}
+
 void MAVLinkInspectorController::_receiveMessage(LinkInterface *link, const mavlink_message_t &message)
 {
     Q_UNUSED(link);
 
+    (void) _counters.increment(message.sysid, message.compid, message.msgid);
+    if (!_active) {
+        return;
+    }
+
     QGCMAVLinkMessage *msg = nullptr;
     QGCMAVLinkSystem *system = _findVehicle(message.sysid);
 
@@ -210,6 +247,7 @@ void MAVLinkInspectorController::_receiveMessage(LinkInterface *link, const mavl
 
     if (!msg) {
         msg = new QGCMAVLinkMessage(message, this);
+        msg->setCount(_counters.count(message.sysid, message.compid, message.msgid));
         system->append(msg);
     } else {
         msg->update(message);
@@ -6,6 +6,7 @@
 #include <QtQmlIntegration/QtQmlIntegration>
 
 #include "MAVLinkLib.h"
+#include "MAVLinkMessageCounters.h"
 
 Q_DECLARE_LOGGING_CATEGORY(MAVLinkInspectorControllerLog)
 
@@ -31,6 +32,7 @@ class MAVLinkInspectorController : public QObject
     Q_PROPERTY(QStringList          timeScales      READ timeScales     NOTIFY timeScalesChanged)
     Q_PROPERTY(QStringList          rangeList       READ rangeList      NOTIFY rangeListChanged)
     Q_PROPERTY(QStringList          systemNames     READ systemNames    NOTIFY systemsChanged)
+    Q_PROPERTY(bool                 active          READ active         WRITE setActive NOTIFY activeChanged)
 
     struct TimeScale_st
     {
@@ -61,10 +63,18 @@ class MAVLinkInspectorController : public QObject
     QStringList timeScales();
     QStringList rangeList();
 
+    /// While inactive received messages are only counted, the message objects and their rates are updated again
+    /// once the inspector is shown
+    bool active() const { return _active; }
+    void setActive(bool active);
+
+    const MAVLinkMessageCounters &counters() const { return _counters; }
+
     const QList<TimeScale_st*> &timeScaleSt() const { return _timeScaleSt; }
     const QList<Range_st*> &rangeSt() const { return _rangeSt; }
 
 signals:
+    void activeChanged();
     void activeSystemChanged();
     void rangeListChanged();
     void systemsChanged();
@@ -90,4 +100,6 @@ private slots:
     QGCMAVLinkSystem *_activeSystem = nullptr;
     QTimer *_updateFrequencyTimer = nullptr;
     QmlObjectListModel *_systems = nullptr;     ///< List of QGCMAVLinkSystem
+    MAVLinkMessageCounters _counters;
+    bool _active = true;
 };
@@ -20,7 +20,8 @@ AnalyzePage {
     property real   maxButtonWidth:     0
 
     MAVLinkInspectorController {
-        id: controller
+        id:     controller
+        active: root.visible
     }
 
     function updateEnabledStatus(repeater, message, chart) {
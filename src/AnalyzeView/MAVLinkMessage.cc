@@ -3,6 +3,7 @@
 #include "QGCLoggingCategory.h"
 #include "QmlObjectListModel.h"
 
+#include <QtCore/QDateTime>
 #include <QtCore/QTimeZone>
 
 QGC_LOGGING_CATEGORY(MAVLinkMessageLog, "AnalyzeView.MAVLinkMessage")
@@ -41,6 +42,9 @@ QGCMAVLinkMessage::QGCMAVLinkMessage(const mavlink_message_t &message, QObject *
         }
 
         QGCMAVLinkMessageField *const field = new QGCMAVLinkMessageField(msgInfo->fields[i].name, type, this);
+        if (msgInfo->fields[i].type == MAVLINK_TYPE_CHAR) {
+            field->setSelectable(false);
+        }
         _fields->append(field);
     }
 }
@@ -98,6 +102,15 @@ void QGCMAVLinkMessage::setTargetRateHz(int32_t rate)
     }
 }
 
+void QGCMAVLinkMessage::setCount(quint64 count)
+{
+    _lastCount = count;
+    if (count != _count) {
+        _count = count;
+        emit countChanged();
+    }
+}
+
 void QGCMAVLinkMessage::update(const mavlink_message_t &message)
 {
     _count++;
@@ -123,209 +136,78 @@ void QGCMAVLinkMessage::_updateFields()
         return;
     }
 
-    uint8_t *const msg = reinterpret_cast<uint8_t*>(&_message.payload64[0]);
+    const uint8_t *const msg = reinterpret_cast<const uint8_t*>(&_message.payload64[0]);
     for (unsigned int i = 0; i < msgInfo->num_fields; ++i) {
         QGCMAVLinkMessageField *const field = qobject_cast<QGCMAVLinkMessageField*>(_fields->get(static_cast<int>(i)));
         if (!field) {
             continue;
         }
 
-        const unsigned int offset = msgInfo->fields[i].wire_offset;
-        const unsigned int array_length = msgInfo->fields[i].array_length;
-        static const unsigned int array_buffer_length = (MAVLINK_MAX_PAYLOAD_LEN + MAVLINK_NUM_CHECKSUM_BYTES + 7);
+        const mavlink_field_info_t &fieldInfo = msgInfo->fields[i];
+        if (_selected) {
+            field->updateValue(_fieldString(fieldInfo, msg), _fieldValue(fieldInfo, msg));
+        } else if (field->selected()) {
+            // Only charted, the value text isn't shown so don't spend time formatting it
+            field->appendSample(_fieldValue(fieldInfo, msg));
+        }
+    }
+}
 
-        switch (msgInfo->fields[i].type) {
-        case MAVLINK_TYPE_CHAR:
-            field->setSelectable(false);
-            if (array_length > 0) {
-                char *const str = reinterpret_cast<char*>(msg + offset);
-                str[array_length - 1] = '\0';
-                const QString v(str);
-                field->updateValue(v, 0);
-            } else {
-                char b = *(reinterpret_cast<char*>(msg + offset));
-                const QString v(b);
-                field->updateValue(v, 0);
-            }
-            break;
-        case MAVLINK_TYPE_UINT8_T:
-            if (array_length > 0) {
-                const uint8_t *const nums = msg + offset;
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(nums[array_length - 1]);
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                const uint8_t u = *(msg + offset);
-                field->updateValue(QString::number(u), static_cast<qreal>(u));
-            }
-            break;
-        case MAVLINK_TYPE_INT8_T:
-            if (array_length > 0) {
-                const int8_t *const nums = reinterpret_cast<int8_t*>(msg + offset);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(nums[array_length - 1]);
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                const int8_t n = *(reinterpret_cast<int8_t*>(msg + offset));
-                field->updateValue(QString::number(n), static_cast<qreal>(n));
-            }
-            break;
-        case MAVLINK_TYPE_UINT16_T:
-            if (array_length > 0) {
-                uint16_t nums[array_buffer_length / sizeof(uint16_t)]{};
-                (void) memcpy(nums, msg + offset,  sizeof(uint16_t) * array_length);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(nums[array_length - 1]);
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                uint16_t n = 0;
-                (void) memcpy(&n, msg + offset, sizeof(uint16_t));
-                field->updateValue(QString::number(n), static_cast<qreal>(n));
-            }
-            break;
-        case MAVLINK_TYPE_INT16_T:
-            if (array_length > 0) {
-                int16_t nums[array_buffer_length / sizeof(int16_t)]{};
-                (void) memcpy(nums, msg + offset, sizeof(int16_t) * array_length);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(nums[array_length - 1]);
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                int16_t n;
-                memcpy(&n, msg + offset, sizeof(int16_t));
-                field->updateValue(QString::number(n), static_cast<qreal>(n));
-            }
-            break;
-        case MAVLINK_TYPE_UINT32_T:
-            if (array_length > 0) {
-                uint32_t nums[array_buffer_length / sizeof(uint32_t)]{};
-                (void) memcpy(nums, msg + offset, sizeof(uint32_t) * array_length);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(nums[array_length - 1]);
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                uint32_t n;
-                (void) memcpy(&n, msg + offset, sizeof(uint32_t));
-                if (_message.msgid == MAVLINK_MSG_ID_SYSTEM_TIME) {
-                    const QDateTime d = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(n), QTimeZone::utc());
-                    field->updateValue(d.toString("HH:mm:ss"), static_cast<qreal>(n));
-                } else {
-                    field->updateValue(QString::number(n), static_cast<qreal>(n));
-                }
-            }
-            break;
-        case MAVLINK_TYPE_INT32_T:
-            if (array_length > 0) {
-                int32_t nums[array_buffer_length / sizeof(int32_t)]{};
-                (void) memcpy(nums, msg + offset,  sizeof(int32_t) * array_length);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(nums[array_length - 1]);
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                int32_t n;
-                (void) memcpy(&n, msg + offset, sizeof(int32_t));
-                field->updateValue(QString::number(n), static_cast<qreal>(n));
-            }
-            break;
-        case MAVLINK_TYPE_FLOAT:
-            if (array_length > 0) {
-                float nums[array_buffer_length / sizeof(float)]{};
-                (void) memcpy(nums, msg + offset,  sizeof(float) * array_length);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                   string += tmp.arg(static_cast<double>(nums[j]));
-                }
-                string += QString::number(static_cast<double>(nums[array_length - 1]));
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                float fv;
-                (void) memcpy(&fv, msg + offset, sizeof(float));
-                field->updateValue(QString::number(static_cast<double>(fv)), static_cast<qreal>(fv));
-            }
-            break;
-        case MAVLINK_TYPE_DOUBLE:
-            if (array_length > 0) {
-                double nums[array_buffer_length / sizeof(double)]{};
-                (void) memcpy(nums, msg + offset, sizeof(double) * array_length);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(static_cast<double>(nums[array_length - 1]));
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                double d;
-                (void) memcpy(&d, msg + offset, sizeof(double));
-                field->updateValue(QString::number(d), static_cast<qreal>(d));
-            }
-            break;
-        case MAVLINK_TYPE_UINT64_T:
-            if (array_length > 0) {
-                uint64_t nums[array_buffer_length / sizeof(uint64_t)]{};
-                (void) memcpy(nums, msg + offset, sizeof(uint64_t) * array_length);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(nums[array_length - 1]);
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                uint64_t n;
-                (void) memcpy(&n, msg + offset, sizeof(uint64_t));
-                if(_message.msgid == MAVLINK_MSG_ID_SYSTEM_TIME) {
-                    const QDateTime d = QDateTime::fromMSecsSinceEpoch(n / 1000, QTimeZone::utc());
-                    field->updateValue(d.toString("yyyy MM dd HH:mm:ss"), static_cast<qreal>(n));
-                } else {
-                    field->updateValue(QString::number(n), static_cast<qreal>(n));
-                }
-            }
-            break;
-        case MAVLINK_TYPE_INT64_T:
-            if (array_length > 0) {
-                int64_t nums[array_buffer_length / sizeof(int64_t)]{};
-                (void) memcpy(nums, msg + offset,  sizeof(int64_t) * array_length);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(nums[array_length - 1]);
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                int64_t n;
-                (void) memcpy(&n, msg + offset, sizeof(int64_t));
-                field->updateValue(QString::number(n), static_cast<qreal>(n));
-            }
-            break;
-        default:
-            break;
+qreal QGCMAVLinkMessage::_fieldValue(const mavlink_field_info_t &fieldInfo, const uint8_t *payload)
+{
+    // Arrays are charted by their first element
+    const uint8_t *const data = payload + fieldInfo.wire_offset;
+    switch (fieldInfo.type) {
+    case MAVLINK_TYPE_UINT8_T:  return _read<uint8_t>(data);
+    case MAVLINK_TYPE_INT8_T:   return _read<int8_t>(data);
+    case MAVLINK_TYPE_UINT16_T: return _read<uint16_t>(data);
+    case MAVLINK_TYPE_INT16_T:  return _read<int16_t>(data);
+    case MAVLINK_TYPE_UINT32_T: return _read<uint32_t>(data);
+    case MAVLINK_TYPE_INT32_T:  return _read<int32_t>(data);
+    case MAVLINK_TYPE_FLOAT:    return _read<float>(data);
+    case MAVLINK_TYPE_DOUBLE:   return _read<double>(data);
+    case MAVLINK_TYPE_UINT64_T: return static_cast<qreal>(_read<uint64_t>(data));
+    case MAVLINK_TYPE_INT64_T:  return static_cast<qreal>(_read<int64_t>(data));
+    case MAVLINK_TYPE_CHAR:
+    default:
+        return 0;
+    }
+}
+
+QString QGCMAVLinkMessage::_fieldString(const mavlink_field_info_t &fieldInfo, const uint8_t *payload) const
+{
+    const uint8_t *const data = payload + fieldInfo.wire_offset;
+    const unsigned int arrayLength = fieldInfo.array_length;
+
+    switch (fieldInfo.type) {
+    case MAVLINK_TYPE_CHAR:
+        if (arrayLength > 0) {
+            // Strings which fill the array have no terminator
+            const char *const str = reinterpret_cast<const char*>(data);
+            return QString::fromUtf8(str, static_cast<qsizetype>(qstrnlen(str, arrayLength)));
+        }
+        return QString(QChar::fromLatin1(_read<char>(data)));
+    case MAVLINK_TYPE_UINT8_T:  return _numberString<uint8_t>(data, arrayLength);
+    case MAVLINK_TYPE_INT8_T:   return _numberString<int8_t>(data, arrayLength);
+    case MAVLINK_TYPE_UINT16_T: return _numberString<uint16_t>(data, arrayLength);
+    case MAVLINK_TYPE_INT16_T:  return _numberString<int16_t>(data, arrayLength);
+    case MAVLINK_TYPE_UINT32_T:
+        if ((arrayLength == 0) && (_message.msgid == MAVLINK_MSG_ID_SYSTEM_TIME)) {
+            const QDateTime d = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(_read<uint32_t>(data)), QTimeZone::utc());
+            return d.toString("HH:mm:ss");
+        }
+        return _numberString<uint32_t>(data, arrayLength);
+    case MAVLINK_TYPE_INT32_T:  return _numberString<int32_t>(data, arrayLength);
+    case MAVLINK_TYPE_FLOAT:    return _numberString<float>(data, arrayLength);
+    case MAVLINK_TYPE_DOUBLE:   return _numberString<double>(data, arrayLength);
+    case MAVLINK_TYPE_UINT64_T:
+        if ((arrayLength == 0) && (_message.msgid == MAVLINK_MSG_ID_SYSTEM_TIME)) {
+            const QDateTime d = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(_read<uint64_t>(data) / 1000), QTimeZone::utc());
+            return d.toString("yyyy MM dd HH:mm:ss");
         }
+        return _numberString<uint64_t>(data, arrayLength);
+    case MAVLINK_TYPE_INT64_T:  return _numberString<int64_t>(data, arrayLength);
+    default:
+        return QString();
     }
 }
@@ -5,6 +5,8 @@
 #include <QtCore/QLoggingCategory>
 #include <QtQmlIntegration/QtQmlIntegration>
 
+#include <cstring>
+
 #include "MAVLinkLib.h"
 
 class QmlObjectListModel;
@@ -49,6 +51,9 @@ class QGCMAVLinkMessage : public QObject
     void setSelected(bool sel);
     void setTargetRateHz(int32_t rate);
 
+    /// Sets the total number of messages received, rates are measured from this point on
+    void setCount(quint64 count);
+
 signals:
     void countChanged();
     void actualRateHzChanged();
@@ -58,6 +63,34 @@ class QGCMAVLinkMessage : public QObject
 
 private:
     void _updateFields();
+    QString _fieldString(const mavlink_field_info_t &fieldInfo, const uint8_t *payload) const;
+    static qreal _fieldValue(const mavlink_field_info_t &fieldInfo, const uint8_t *payload);
+
+    /// Fields aren't necessarily aligned in the payload
+    template<typename T>
+    static T _read(const uint8_t *data, unsigned int index = 0)
+    {
+        T value;
+        (void) memcpy(&value, data + (index * sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    static QString _numberString(const uint8_t *data, unsigned int arrayLength)
+    {
+        if (arrayLength == 0) {
+            return QString::number(_read<T>(data));
+        }
+
+        QString string;
+        for (unsigned int i = 0; i < arrayLength; ++i) {
+            if (i > 0) {
+                string += QStringLiteral(", ");
+            }
+            string += QString::number(_read<T>(data, i));
+        }
+        return string;
+    }
 
     mavlink_message_t _message{};
     QmlObjectListModel *_fields = nullptr;
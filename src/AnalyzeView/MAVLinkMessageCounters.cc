@@ -0,0 +1,79 @@
+#include "MAVLinkMessageCounters.h"
+
+quint64 MAVLinkMessageCounters::_key(quint8 sysId, quint8 compId, quint32 msgId)
+{
+    // Message ids are 24 bits. The top bit keeps a valid key from ever being 0, which marks an unused slot.
+    return (Q_UINT64_C(1) << 48) | (static_cast<quint64>(sysId) << 40) | (static_cast<quint64>(compId) << 32) | (msgId & 0xffffff);
+}
+
+quint32 MAVLinkMessageCounters::_hash(quint64 key)
+{
+    // Fibonacci hashing spreads the mostly sequential message ids across the table
+    return static_cast<quint32>((key * Q_UINT64_C(0x9E3779B97F4A7C15)) >> (64 - kCapacityBits));
+}
+
+bool MAVLinkMessageCounters::increment(quint8 sysId, quint8 compId, quint32 msgId)
+{
+    const quint64 key = _key(sysId, compId, msgId);
+    quint32 index = _hash(key);
+
+    for (int probe = 0; probe < kCapacity; probe++, index = (index + 1) & (kCapacity - 1)) {
+        Slot &slot = _slots[index];
+        quint64 slotKey = slot.key.load(std::memory_order_acquire);
+        if (slotKey == 0) {
+            if (slot.key.compare_exchange_strong(slotKey, key, std::memory_order_acq_rel)) {
+                (void) _size.fetch_add(1, std::memory_order_relaxed);
+                slotKey = key;
+            }
+            // else another thread claimed the slot, slotKey now holds its key
+        }
+
+        if (slotKey == key) {
+            (void) slot.count.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+quint64 MAVLinkMessageCounters::count(quint8 sysId, quint8 compId, quint32 msgId) const
+{
+    const quint64 key = _key(sysId, compId, msgId);
+    quint32 index = _hash(key);
+
+    for (int probe = 0; probe < kCapacity; probe++, index = (index + 1) & (kCapacity - 1)) {
+        const Slot &slot = _slots[index];
+        const quint64 slotKey = slot.key.load(std::memory_order_acquire);
+        if (slotKey == key) {
+            return slot.count.load(std::memory_order_relaxed);
+        }
+        if (slotKey == 0) {
+            break;
+        }
+    }
+
+    return 0;
+}
+
+QList<MAVLinkMessageCounters::Entry> MAVLinkMessageCounters::entries() const
+{
+    QList<Entry> result;
+    result.reserve(size());
+
+    for (const Slot &slot : _slots) {
+        const quint64 key = slot.key.load(std::memory_order_acquire);
+        if (key == 0) {
+            continue;
+        }
+
+        Entry entry;
+        entry.sysId = static_cast<quint8>(key >> 40);
+        entry.compId = static_cast<quint8>(key >> 32);
+        entry.msgId = static_cast<quint32>(key & 0xffffff);
+        entry.count = slot.count.load(std::memory_order_relaxed);
+        result.append(entry);
+    }
+
+    return result;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QtCore/QList>
+
+#include <array>
+#include <atomic>
+
+/// Lock-free receive counters per (system id, component id, message id).
+///     A fixed size open addressing table: counting a message is a hash, usually a single probe and an atomic
+///     increment, with no allocation and no locking, so it can be called for every received message from any thread.
+///     Entries are never removed. Once the table is full new keys are no longer counted.
+class MAVLinkMessageCounters
+{
+public:
+    struct Entry {
+        quint8 sysId = 0;
+        quint8 compId = 0;
+        quint32 msgId = 0;
+        quint64 count = 0;
+    };
+
+    /// @return false: Table full, message not counted
+    bool increment(quint8 sysId, quint8 compId, quint32 msgId);
+
+    /// @return Number of messages counted for the key, 0 if none
+    quint64 count(quint8 sysId, quint8 compId, quint32 msgId) const;
+
+    /// @return Snapshot of all keys which have been counted
+    QList<Entry> entries() const;
+
+    /// Number of distinct keys
+    int size() const { return _size.load(std::memory_order_relaxed); }
+
+    static constexpr int kCapacityBits = 12;
+    static constexpr int kCapacity = 1 << kCapacityBits;
+
+private:
+    struct Slot {
+        std::atomic<quint64> key{0};    ///< 0 for an unused slot
+        std::atomic<quint64> count{0};
+    };
+
+    static quint64 _key(quint8 sysId, quint8 compId, quint32 msgId);
+    static quint32 _hash(quint64 key);
+
+    std::array<Slot, kCapacity> _slots;
+    std::atomic<int> _size{0};
+};
@@ -35,7 +35,7 @@ void QGCMAVLinkMessageField::addSeries(MAVLinkChartController *chartController,
     _pSeries = series;
     emit seriesChanged();
 
-    _dataIndex = 0;
+    _samples.clear();
     _msg->updateFieldSelection();
 }
 
@@ -45,9 +45,10 @@ void QGCMAVLinkMessageField::delSeries()
         return;
     }
 
-    _values.clear();
+    _samples.clear();
+    _points.clear();
     QLineSeries *const lineSeries = static_cast<QLineSeries*>(_pSeries);
-    lineSeries->replace(_values);
+    lineSeries->clear();
     _pSeries = nullptr;
     _chartController = nullptr;
     emit seriesChanged();
@@ -83,37 +84,36 @@ void QGCMAVLinkMessageField::updateValue(const QString &newValue, qreal v)
         emit valueChanged();
     }
 
+    appendSample(v);
+}
+
+void QGCMAVLinkMessageField::appendSample(qreal v)
+{
     if (!_pSeries || !_chartController) {
         return;
     }
 
-    const int count = _values.count();
-    if (count < (50 * 60)) { ///< Arbitrary limit of 1 minute of data at 50Hz for now
-        const QPointF p(qgcApp()->msecsSinceBoot(), v);
-        _values.append(p);
-    } else {
-        if (_dataIndex >= count) {
-            _dataIndex = 0;
-        }
-        _values[_dataIndex].setX(qgcApp()->msecsSinceBoot());
-        _values[_dataIndex].setY(v);
-        _dataIndex++;
-    }
+    _samples.append(static_cast<qint64>(qgcApp()->msecsSinceBoot()), v);
+}
 
-    if (_chartController->rangeYIndex() != 0) {
+void QGCMAVLinkMessageField::updateSeries()
+{
+    if (!_pSeries || !_chartController || (_samples.count() <= 1)) {
         return;
     }
 
-    qreal vmin = std::numeric_limits<qreal>::max();
-    qreal vmax = std::numeric_limits<qreal>::min();
-    for (const QPointF &point : _values) {
-        const qreal v = point.y();
-        if (vmax < v) {
-            vmax = v;
-        }
-        if (vmin > v) {
-            vmin = v;
-        }
+    // Only what fits on the chart is handed to the series: the visible time range, reduced to min/max per pixel
+    const qint64 startTime = _chartController->rangeXMin().toMSecsSinceEpoch();
+    const qint64 endTime = _chartController->rangeXMax().toMSecsSinceEpoch();
+    qreal vmin = _rangeMin;
+    qreal vmax = _rangeMax;
+    (void) _samples.decimate(startTime, endTime, _chartController->plotWidth(), _points, vmin, vmax);
+
+    QLineSeries *const lineSeries = static_cast<QLineSeries*>(_pSeries);
+    lineSeries->replace(_points);
+
+    if (_chartController->rangeYIndex() != 0) {
+        return;
     }
 
     bool changed = false;
@@ -131,26 +131,3 @@ void QGCMAVLinkMessageField::updateValue(const QString &newValue, qreal v)
         _chartController->updateYRange();
     }
 }
-
-void QGCMAVLinkMessageField::updateSeries()
-{
-    const int count = _values.count();
-    if (count <= 1) {
-        return;
-    }
-
-    QList<QPointF> s;
-    s.reserve(count);
-    int idx = _dataIndex;
-    for (int i = 0; i < count; i++, idx++) {
-        if (idx >= count) {
-            idx = 0;
-        }
-
-        const QPointF p(_values[idx]);
-        s.append(p);
-    }
-
-    QLineSeries *const lineSeries = static_cast<QLineSeries*>(_pSeries);
-    lineSeries->replace(s);
-}
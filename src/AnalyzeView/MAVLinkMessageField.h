@@ -6,6 +6,8 @@
 #include <QtCore/QString>
 #include <QtQmlIntegration/QtQmlIntegration>
 
+#include "TimeSeriesBuffer.h"
+
 Q_DECLARE_LOGGING_CATEGORY(MAVLinkMessageFieldLog)
 
 class QGCMAVLinkMessage;
@@ -36,7 +38,7 @@ class QGCMAVLinkMessageField : public QObject
     bool selectable() const { return _selectable; }
     bool selected() const { return !!_pSeries; }
     const QAbstractSeries *series() const { return _pSeries; }
-    const QList<QPointF> *values() const { return &_values; }
+    const TimeSeriesBuffer &samples() const { return _samples; }
     qreal rangeMin() const { return _rangeMin; }
     qreal rangeMax() const { return _rangeMax; }
     int chartIndex() const;
@@ -44,6 +46,9 @@ class QGCMAVLinkMessageField : public QObject
     void setSelectable(bool sel);
     void updateValue(const QString &newValue, qreal v);
 
+    /// Adds a chart sample without updating the displayed value
+    void appendSample(qreal v);
+
     void addSeries(MAVLinkChartController *chartController, QAbstractSeries *series);
     void delSeries();
     void updateSeries();
@@ -60,11 +65,13 @@ class QGCMAVLinkMessageField : public QObject
 
     QString _value;
     bool _selectable = true;
-    int _dataIndex = 0;
     qreal _rangeMin = 0;
     qreal _rangeMax = 0;
-    QList<QPointF> _values;
+    TimeSeriesBuffer _samples{kMaxSamples};
+    QList<QPointF> _points;     ///< Decimated samples handed to the series, kept to reuse the allocation
 
     QAbstractSeries *_pSeries = nullptr;
     MAVLinkChartController *_chartController = nullptr;
+
+    static constexpr qsizetype kMaxSamples = 200 * 60;     ///< 60 seconds, the longest time scale, at 200Hz
 };
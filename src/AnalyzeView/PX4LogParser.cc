@@ -1,8 +1,11 @@
 #include "PX4LogParser.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtCore/QBuffer>
 #include <QtCore/QtEndian>
 
+#include <cmath>
+
 QGC_LOGGING_CATEGORY(PX4LogParserLog, "AnalyzeView.PX4LogParser")
 
 // general message header
@@ -24,76 +27,156 @@ static constexpr const char triggerHeader[4] = {static_cast<char>(0xA3), static_
 static constexpr const int triggerOffsets[2] = {3, 11};
 static constexpr const int triggerLengths[2] = {8, 4};
 
+namespace {
+
+// Messages are at most this long since the format stores the length in a single byte
+constexpr qsizetype kMaxMessageLength = 0xff;
+
+/// Finds the message length in the format definition which starts with pattern
+///     @return -1: Format not found
+int findFormatLength(QIODevice &log, QByteArrayView pattern)
+{
+    // Formats are defined at the start of the log, keep a few bytes between blocks for a match which spans two blocks
+    QByteArray window;
+    while (true) {
+        const QByteArray block = log.read(PX4LogParser::kReadBlockSize);
+        if (block.isEmpty()) {
+            return -1;
+        }
+        window.append(block);
+
+        const qsizetype index = window.indexOf(pattern);
+        if (index < 0) {
+            window = window.right(pattern.size());
+        } else if ((index + pattern.size()) < window.size()) {
+            return static_cast<uchar>(window[index + pattern.size()]);
+        }
+    }
+}
+
+/// @return true: The next message header follows immediately after the message at index. Expects at least
+///               length + 2 bytes of data after index unless the end of the log has been reached.
+bool isCompleteMessage(const QByteArray &window, qsizetype index, int length)
+{
+    return window.indexOf(QByteArrayView(header, 2), index + 1) == (index + length);
+}
+
+} // namespace
+
 namespace PX4LogParser {
 
-bool getTagsFromLog(const QByteArray& log, QList<GeoTagWorker::CameraFeedbackPacket>& cameraFeedback)
+bool getTagsFromLog(const QByteArray &log, QList<GeoTagWorker::CameraFeedbackPacket> &cameraFeedback)
 {
-    // extract header information: message lengths
-    const uint8_t* iptr = reinterpret_cast<const uint8_t*>(log.mid(log.indexOf(gposHeaderHeader) + 4, 1).constData());
-    const int gposHeaderOffset = static_cast<int>(qFromLittleEndian(*iptr));
+    QBuffer buffer;
+    buffer.setData(log);
+    (void) buffer.open(QIODevice::ReadOnly);
 
-    iptr = reinterpret_cast<const uint8_t*>(log.mid(log.indexOf(triggerHeaderHeader) + 4, 1).constData());
-    const int triggerHeaderOffset = static_cast<int>(qFromLittleEndian(*iptr));
+    return getTagsFromLog(buffer, cameraFeedback);
+}
 
-    // extract trigger data
-    int index = 1;
+bool getTagsFromLog(QIODevice &log, QList<GeoTagWorker::CameraFeedbackPacket> &cameraFeedback)
+{
+    // extract header information: message lengths
+    const qint64 startPos = log.pos();
+    const int gposHeaderOffset = findFormatLength(log, QByteArrayView(gposHeaderHeader, 4));
+    (void) log.seek(startPos);
+    const int triggerHeaderOffset = findFormatLength(log, QByteArrayView(triggerHeaderHeader, 4));
+    (void) log.seek(startPos);
+
+    if ((gposHeaderOffset < 0) || (triggerHeaderOffset < 0)) {
+        qCWarning(PX4LogParserLog) << "Trigger or position message format not found";
+        return false;
+    }
+
+    // Scan the messages in order. Each trigger is followed by the first valid position after it, triggers which
+    // occur before that position is found are skipped.
+    const QByteArrayView messageStart(header, 2);
+    QByteArray window;
+    qsizetype pos = 0;
+    bool atEnd = false;
     int sequence = -1;
-    while(index < log.length() - 1) {
-        // first extract trigger
-        index = log.indexOf(triggerHeader, index + 1);
+    bool havePendingTrigger = false;
+    GeoTagWorker::CameraFeedbackPacket feedback{};
+
+    while (true) {
+        if (!atEnd && ((window.size() - pos) < (kMaxMessageLength + 2))) {
+            // Keep only what hasn't been scanned yet
+            (void) window.remove(0, pos);
+            pos = 0;
+
+            const QByteArray block = log.read(kReadBlockSize);
+            if (block.isEmpty()) {
+                atEnd = true;
+            } else {
+                window.append(block);
+            }
+            continue;
+        }
 
-        // check for whether last entry has been passed
+        const qsizetype index = window.indexOf(messageStart, pos);
         if (index < 0) {
-            break;
+            if (atEnd) {
+                break;
+            }
+            // The last byte may be the start of a header
+            pos = qMax(pos, window.size() - 1);
+            continue;
         }
-
-        if (log.indexOf(header, index + 1) != (index + triggerHeaderOffset)) {
+        if (!atEnd && ((window.size() - index) < (kMaxMessageLength + 2))) {
+            pos = index;
             continue;
         }
+        pos = index + 1;
 
-        GeoTagWorker::CameraFeedbackPacket feedback;
-        (void) memset(&feedback, 0, sizeof(feedback));
-
-        const uint64_t* const time = reinterpret_cast<const uint64_t*>(log.mid(index + triggerOffsets[0], triggerLengths[0]).data());
-        const double timeDouble = static_cast<double>(qFromLittleEndian(*time)) / 1.0e6;
-        const uint32_t* const seq = reinterpret_cast<const uint32_t*>(log.mid(index + triggerOffsets[1], triggerLengths[1]).data());
-        const int seqInt = static_cast<int>(qFromLittleEndian(*seq));
-        // Assume that logging has not skipped more than 20 triggers. This prevents wrong header detection.
-        if ((sequence >= seqInt) || ((sequence + 20) < seqInt)) {
+        if ((index + 3) > window.size()) {
             continue;
         }
+        const char type = window[index + 2];
 
-        feedback.timestamp = timeDouble;
-        feedback.imageSequence = seqInt;
-        sequence = seqInt;
+        if (!havePendingTrigger) {
+            if ((type != triggerHeader[2]) || !isCompleteMessage(window, index, triggerHeaderOffset)) {
+                continue;
+            }
+            if ((index + triggerOffsets[1] + triggerLengths[1]) > window.size()) {
+                continue;
+            }
 
-        // second extract position
-        while (true) {
-            const int gposIndex = log.indexOf(gposHeader, index + 1);
-            if (gposIndex < 0) {
-                (void) cameraFeedback.append(feedback);
-                break;
+            const quint64 time = qFromLittleEndian<quint64>(window.constData() + index + triggerOffsets[0]);
+            const int seqInt = static_cast<int>(qFromLittleEndian<quint32>(window.constData() + index + triggerOffsets[1]));
+            // Assume that logging has not skipped more than 20 triggers. This prevents wrong header detection.
+            if ((sequence >= seqInt) || ((sequence + 20) < seqInt)) {
+                continue;
             }
-            index = gposIndex;
 
+            feedback = GeoTagWorker::CameraFeedbackPacket{};
+            feedback.timestamp = static_cast<double>(time) / 1.0e6;
+            feedback.imageSequence = seqInt;
+            sequence = seqInt;
+            havePendingTrigger = true;
+        } else {
             // verify that at an offset of gposHeaderOffset the next log message starts
-            if ((gposIndex + gposHeaderOffset) == log.indexOf(header, gposIndex + 1)) {
-                const int32_t* const lat = reinterpret_cast<const int32_t*>(log.mid(gposIndex + gposOffsets[0], gposLengths[0]).constData());
-                feedback.latitude = static_cast<double>(qFromLittleEndian(*lat)) / 1.0e7;
-
-                const int32_t* const lon = reinterpret_cast<const int32_t*>(log.mid(gposIndex + gposOffsets[1], gposLengths[1]).constData());
-                feedback.longitude = static_cast<double>(qFromLittleEndian(*lon)) / 1.0e7;
-                feedback.longitude = fmod(180.0 + feedback.longitude, 360.0) - 180.0;
+            if ((type != gposHeader[2]) || !isCompleteMessage(window, index, gposHeaderOffset)) {
+                continue;
+            }
+            if ((index + gposOffsets[2] + gposLengths[2]) > window.size()) {
+                continue;
+            }
 
-                const float* const alt = reinterpret_cast<const float*>(log.mid(gposIndex + gposOffsets[2], gposLengths[2]).constData());
-                feedback.altitude = qFromLittleEndian(*alt);
+            feedback.latitude = static_cast<double>(qFromLittleEndian<qint32>(window.constData() + index + gposOffsets[0])) / 1.0e7;
+            feedback.longitude = static_cast<double>(qFromLittleEndian<qint32>(window.constData() + index + gposOffsets[1])) / 1.0e7;
+            feedback.longitude = fmod(180.0 + feedback.longitude, 360.0) - 180.0;
+            feedback.altitude = qFromLittleEndian<float>(window.constData() + index + gposOffsets[2]);
 
-                (void) cameraFeedback.append(feedback);
-                break;
-            }
+            (void) cameraFeedback.append(feedback);
+            havePendingTrigger = false;
         }
     }
 
+    if (havePendingTrigger) {
+        // No position after the last trigger
+        (void) cameraFeedback.append(feedback);
+    }
+
     return true;
 }
 
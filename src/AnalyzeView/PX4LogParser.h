@@ -6,8 +6,16 @@
 
 #include "GeoTagWorker.h"
 
+class QIODevice;
+
 Q_DECLARE_LOGGING_CATEGORY(PX4LogParserLog)
 
 namespace PX4LogParser {
     bool getTagsFromLog(const QByteArray &log, QList<GeoTagWorker::CameraFeedbackPacket> &cameraFeedback);
+
+    /// Get GeoTags from a log, reading it in fixed size blocks. Memory use doesn't depend on the size of the log.
+    ///     @return false: The log doesn't contain the trigger and position message formats
+    bool getTagsFromLog(QIODevice &log, QList<GeoTagWorker::CameraFeedbackPacket> &cameraFeedback);
+
+    constexpr qint64 kReadBlockSize = 64 * 1024;
 }
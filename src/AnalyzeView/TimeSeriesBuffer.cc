@@ -0,0 +1,104 @@
+#include "TimeSeriesBuffer.h"
+
+#include <algorithm>
+
+TimeSeriesBuffer::TimeSeriesBuffer(qsizetype capacity)
+    : _times(static_cast<size_t>(qMax(capacity, qsizetype(1))))
+    , _values(_times.size())
+{
+}
+
+void TimeSeriesBuffer::append(qint64 time, double value)
+{
+    _times[_head] = time;
+    _values[_head] = value;
+
+    _head = (_head + 1) % capacity();
+    if (_count < capacity()) {
+        _count++;
+    }
+}
+
+void TimeSeriesBuffer::clear()
+{
+    _head = 0;
+    _count = 0;
+}
+
+qsizetype TimeSeriesBuffer::_physicalIndex(qsizetype index) const
+{
+    const qsizetype oldest = (_count < capacity()) ? 0 : _head;
+    return (oldest + index) % capacity();
+}
+
+qsizetype TimeSeriesBuffer::decimate(qint64 startTime, qint64 endTime, int buckets, QList<QPointF> &points, double &min, double &max) const
+{
+    points.clear();
+    if ((_count == 0) || (buckets <= 0) || (endTime < startTime)) {
+        return 0;
+    }
+
+    // Samples are in time order, binary search for the first one in the window
+    qsizetype first = 0;
+    qsizetype last = _count;
+    while (first < last) {
+        const qsizetype mid = first + ((last - first) / 2);
+        if (timeAt(mid) < startTime) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+
+    const double bucketWidth = static_cast<double>(qMax(endTime - startTime, qint64(1))) / buckets;
+    points.reserve(qMin<qsizetype>(_count - first, static_cast<qsizetype>(buckets) * 2));
+
+    qsizetype samples = 0;
+    qsizetype bucket = -1;
+    qsizetype minIndex = 0;
+    qsizetype maxIndex = 0;
+    const auto flushBucket = [this, &points, &minIndex, &maxIndex]() {
+        const qsizetype firstIndex = qMin(minIndex, maxIndex);
+        const qsizetype secondIndex = qMax(minIndex, maxIndex);
+        points.append(QPointF(timeAt(firstIndex), valueAt(firstIndex)));
+        if (secondIndex != firstIndex) {
+            points.append(QPointF(timeAt(secondIndex), valueAt(secondIndex)));
+        }
+    };
+
+    for (qsizetype i = first; i < _count; i++) {
+        const qint64 time = timeAt(i);
+        if (time > endTime) {
+            break;
+        }
+
+        const double value = valueAt(i);
+        if (samples++ == 0) {
+            min = value;
+            max = value;
+        } else {
+            min = std::min(min, value);
+            max = std::max(max, value);
+        }
+
+        const qsizetype sampleBucket = std::min(static_cast<qsizetype>((time - startTime) / bucketWidth), static_cast<qsizetype>(buckets - 1));
+        if (sampleBucket != bucket) {
+            if (bucket >= 0) {
+                flushBucket();
+            }
+            bucket = sampleBucket;
+            minIndex = i;
+            maxIndex = i;
+        } else if (value < valueAt(minIndex)) {
+            minIndex = i;
+        } else if (value > valueAt(maxIndex)) {
+            maxIndex = i;
+        }
+    }
+
+    if (bucket >= 0) {
+        flushBucket();
+    }
+
+    return samples;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QPointF>
+
+#include <vector>
+
+/// Fixed capacity ring buffer of (time, value) samples for charting.
+///     Times and values are kept in separate arrays so appending a sample is two stores and scanning the values for a
+///     range touches only the values. Once full the oldest sample is overwritten. Samples must be appended in time
+///     order.
+class TimeSeriesBuffer
+{
+public:
+    explicit TimeSeriesBuffer(qsizetype capacity);
+
+    void append(qint64 time, double value);
+    void clear();
+
+    qsizetype count() const { return _count; }
+    qsizetype capacity() const { return static_cast<qsizetype>(_times.size()); }
+
+    /// @param index 0 is the oldest sample
+    qint64 timeAt(qsizetype index) const { return _times[_physicalIndex(index)]; }
+    double valueAt(qsizetype index) const { return _values[_physicalIndex(index)]; }
+
+    /// Reduces the samples within [startTime, endTime] to at most two points per bucket, the minimum and maximum of
+    /// the samples which fall into the bucket in the order they occurred. With one bucket per horizontal pixel of
+    /// the chart the plot looks the same as plotting every sample.
+    ///     @param points Output, cleared first
+    ///     @param min/max Range of the values within the time window, unchanged if there are none
+    /// @return Number of samples within the time window
+    qsizetype decimate(qint64 startTime, qint64 endTime, int buckets, QList<QPointF> &points, double &min, double &max) const;
+
+private:
+    qsizetype _physicalIndex(qsizetype index) const;
+
+    std::vector<qint64> _times;
+    std::vector<double> _values;
+    qsizetype _head = 0;        ///< Next write position
+    qsizetype _count = 0;
+};
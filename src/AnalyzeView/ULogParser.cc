@@ -1,10 +1,13 @@
 #include "ULogParser.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtCore/QBuffer>
 #include <QtCore/QByteArray>
+#include <QtCore/QIODevice>
 #include <QtCore/QString>
 
 #include <cmath>
+#include <map>
 #include <unordered_map>
 
 #include <ulog_cpp/data_container.hpp>
@@ -76,35 +79,69 @@ bool getTagsFromLog(const QByteArray &log, QList<GeoTagWorker::CameraFeedbackPac
     return true;
 }
 
-class CameraCaptureHandler : public DataHandlerInterface {
+namespace {
+
+bool cameraFeedbackFromSample(const TypedDataView &sample, GeoTagWorker::CameraFeedbackPacket &feedback)
+{
+    try {
+        feedback.timestamp = sample.at("timestamp").as<uint64_t>() / 1.0e6;
+        feedback.timestampUTC = sample.at("timestamp_utc").as<uint64_t>() / 1.0e6;
+        feedback.imageSequence = sample.at("seq").as<uint32_t>();
+        feedback.latitude = sample.at("lat").as<double>();
+        feedback.longitude = sample.at("lon").as<double>();
+        feedback.longitude = fmod(180.0 + feedback.longitude, 360.0) - 180.0;
+        feedback.altitude = sample.at("alt").as<float>();
+        feedback.groundDistance = sample.at("ground_distance").as<float>();
+        feedback.captureResult = sample.at("result").as<uint8_t>();
+    } catch (const AccessException &exception) {
+        qCDebug(ULogParserLog) << Q_FUNC_INFO << exception.what();
+        return false;
+    }
+
+    return true;
+}
+
+/// Decodes only the data messages of the subscribed topics, everything else is dropped as soon as it is parsed
+class TopicHandler : public DataHandlerInterface {
 public:
-    explicit CameraCaptureHandler(QList<GeoTagWorker::CameraFeedbackPacket> &packets, QString &errorMsg);
+    TopicHandler(const std::set<std::string> &topics, const TopicCallback &callback, QString &errorMsg,
+                 const LoggingCallback &loggingCallback = LoggingCallback());
 
     void error(const std::string &msg, bool is_recoverable) override;
     void messageFormat(const MessageFormat &message_format) override;
     void addLoggedMessage(const AddLoggedMessage &add_logged_message) override;
     void headerComplete() override;
     void data(const Data &data) override;
+    void logging(const Logging &logging) override;
 
     bool hadFatalError() const { return _hadFatalError; }
     bool isHeaderComplete() const { return _headerComplete; }
 
 private:
-    QList<GeoTagWorker::CameraFeedbackPacket> &_cameraFeedback;
+    const std::set<std::string> &_topics;
+    const TopicCallback &_callback;
     QString &_errorMessage;
-    std::shared_ptr<MessageFormat> _cameraCaptureFormat;
-    std::unordered_map<uint16_t, uint8_t> _cameraCaptureIds;
+    const LoggingCallback _loggingCallback;
+    std::map<std::string, std::shared_ptr<MessageFormat>> _formats;     ///< All formats, needed to resolve nested types
+    struct Subscription {
+        std::shared_ptr<MessageFormat> format;
+        int multiId = 0;
+    };
+    std::unordered_map<uint16_t, Subscription> _subscribedIds;
     bool _hadFatalError = false;
     bool _headerComplete = false;
 };
 
-CameraCaptureHandler::CameraCaptureHandler(QList<GeoTagWorker::CameraFeedbackPacket> &packets, QString &errorMsg)
-    : _cameraFeedback(packets)
+TopicHandler::TopicHandler(const std::set<std::string> &topics, const TopicCallback &callback, QString &errorMsg,
+                           const LoggingCallback &loggingCallback)
+    : _topics(topics)
+    , _callback(callback)
     , _errorMessage(errorMsg)
+    , _loggingCallback(loggingCallback)
 {
 }
 
-void CameraCaptureHandler::error(const std::string &msg, bool is_recoverable)
+void TopicHandler::error(const std::string &msg, bool is_recoverable)
 {
     if (!is_recoverable) {
         _hadFatalError = true;
@@ -113,66 +150,81 @@ void CameraCaptureHandler::error(const std::string &msg, bool is_recoverable)
     (void) _errorMessage.append(QStringLiteral(", "));
 }
 
-void CameraCaptureHandler::messageFormat(const MessageFormat &message_format)
+void TopicHandler::messageFormat(const MessageFormat &message_format)
 {
-    if (message_format.name() == "camera_capture") {
-        _cameraCaptureFormat = std::make_shared<MessageFormat>(message_format);
-    }
+    _formats[message_format.name()] = std::make_shared<MessageFormat>(message_format);
 }
 
-void CameraCaptureHandler::addLoggedMessage(const AddLoggedMessage &add_logged_message)
+void TopicHandler::addLoggedMessage(const AddLoggedMessage &add_logged_message)
 {
-    if (add_logged_message.messageName() == "camera_capture" && _cameraCaptureFormat) {
-        _cameraCaptureIds[add_logged_message.msgId()] = add_logged_message.multiId();
+    if (_topics.find(add_logged_message.messageName()) == _topics.end()) {
+        return;
+    }
+
+    const auto it = _formats.find(add_logged_message.messageName());
+    if (it != _formats.end()) {
+        _subscribedIds[add_logged_message.msgId()] = { it->second, add_logged_message.multiId() };
     }
 }
 
-void CameraCaptureHandler::headerComplete()
+void TopicHandler::headerComplete()
 {
     _headerComplete = true;
-    if (_cameraCaptureFormat) {
-        _cameraCaptureFormat->resolveDefinition({{"camera_capture", _cameraCaptureFormat}});
+    for (const std::string &topic : _topics) {
+        const auto it = _formats.find(topic);
+        if (it != _formats.end()) {
+            it->second->resolveDefinition(_formats);
+        }
     }
 }
 
-void CameraCaptureHandler::data(const Data &data)
+void TopicHandler::data(const Data &data)
 {
-    if (!_headerComplete || !_cameraCaptureFormat) {
+    if (!_headerComplete) {
         return;
     }
 
-    auto it = _cameraCaptureIds.find(data.msgId());
-    if (it == _cameraCaptureIds.end()) {
+    const auto it = _subscribedIds.find(data.msgId());
+    if (it == _subscribedIds.end()) {
         return;
     }
 
-    TypedDataView sample(data, *_cameraCaptureFormat);
-    GeoTagWorker::CameraFeedbackPacket feedback = {0};
-
-    try {
-        feedback.timestamp = sample.at("timestamp").as<uint64_t>() / 1.0e6;
-        feedback.timestampUTC = sample.at("timestamp_utc").as<uint64_t>() / 1.0e6;
-        feedback.imageSequence = sample.at("seq").as<uint32_t>();
-        feedback.latitude = sample.at("lat").as<double>();
-        feedback.longitude = sample.at("lon").as<double>();
-        feedback.longitude = fmod(180.0 + feedback.longitude, 360.0) - 180.0;
-        feedback.altitude = sample.at("alt").as<float>();
-        feedback.groundDistance = sample.at("ground_distance").as<float>();
-        feedback.captureResult = sample.at("result").as<uint8_t>();
+    const TypedDataView sample(data, *it->second.format);
+    _callback(it->second.format->name(), it->second.multiId, sample);
+}
 
-        (void) _cameraFeedback.append(feedback);
-    } catch (const AccessException &exception) {
-        qCDebug(ULogParserLog) << Q_FUNC_INFO << exception.what();
+void TopicHandler::logging(const Logging &logging)
+{
+    if (_loggingCallback) {
+        _loggingCallback(logging);
     }
 }
 
-bool getTagsFromLogStreamed(const QByteArray &log, QList<GeoTagWorker::CameraFeedbackPacket> &cameraFeedback, QString &errorMessage)
+const std::set<std::string> kCameraCaptureTopics = { "camera_capture" };
+
+} // namespace
+
+bool parseTopics(QIODevice &log, const std::set<std::string> &topics, const TopicCallback &callback, QString &errorMessage,
+                 const LoggingCallback &loggingCallback)
 {
     errorMessage.clear();
 
-    auto handler = std::make_shared<CameraCaptureHandler>(cameraFeedback, errorMessage);
+    auto handler = std::make_shared<TopicHandler>(topics, callback, errorMessage, loggingCallback);
     Reader parser(handler);
-    parser.readChunk(reinterpret_cast<const uint8_t*>(log.constData()), log.size());
+
+    // The reader keeps partial messages between chunks, so a single block sized buffer is all that is needed
+    QByteArray block(kReadBlockSize, Qt::Uninitialized);
+    while (!handler->hadFatalError()) {
+        const qint64 bytesRead = log.read(block.data(), block.size());
+        if (bytesRead < 0) {
+            errorMessage = log.errorString();
+            return false;
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+        parser.readChunk(reinterpret_cast<const uint8_t*>(block.constData()), static_cast<int>(bytesRead));
+    }
 
     if (handler->hadFatalError()) {
         errorMessage = QStringLiteral("Could not parse ULog");
@@ -184,6 +236,32 @@ bool getTagsFromLogStreamed(const QByteArray &log, QList<GeoTagWorker::CameraFee
         return false;
     }
 
+    return true;
+}
+
+bool getTagsFromLogStreamed(const QByteArray &log, QList<GeoTagWorker::CameraFeedbackPacket> &cameraFeedback, QString &errorMessage)
+{
+    // Shares the data, the buffer is read in the same blocks as a file
+    QBuffer buffer;
+    buffer.setData(log);
+    (void) buffer.open(QIODevice::ReadOnly);
+
+    return getTagsFromLogStreamed(buffer, cameraFeedback, errorMessage);
+}
+
+bool getTagsFromLogStreamed(QIODevice &log, QList<GeoTagWorker::CameraFeedbackPacket> &cameraFeedback, QString &errorMessage)
+{
+    const TopicCallback callback = [&cameraFeedback](const std::string &, int, const TypedDataView &sample) {
+        GeoTagWorker::CameraFeedbackPacket feedback = {0};
+        if (cameraFeedbackFromSample(sample, feedback)) {
+            (void) cameraFeedback.append(feedback);
+        }
+    };
+
+    if (!parseTopics(log, kCameraCaptureTopics, callback, errorMessage)) {
+        return false;
+    }
+
     if (cameraFeedback.isEmpty()) {
         errorMessage = QStringLiteral("Could not detect camera_capture packets in ULog");
         return false;
@@ -3,19 +3,50 @@
 #include <QtCore/QList>
 #include <QtCore/QLoggingCategory>
 
+#include <functional>
+#include <set>
+#include <string>
+
 #include "GeoTagWorker.h"
 
 class QByteArray;
+class QIODevice;
 class QString;
 
+namespace ulog_cpp {
+    class Logging;
+    class TypedDataView;
+}
+
 Q_DECLARE_LOGGING_CATEGORY(ULogParserLog)
 
 namespace ULogParser {
+    /// Called for each sample of a subscribed topic. The sample is only valid for the duration of the call.
+    /// Topics published by several instances (e.g. one per sensor) are told apart by multiId, the first instance is 0.
+    using TopicCallback = std::function<void(const std::string &topic, int multiId, const ulog_cpp::TypedDataView &sample)>;
+
+    /// Called for each logged text message
+    using LoggingCallback = std::function<void(const ulog_cpp::Logging &logging)>;
+
+    /// Parses a ULog from a device in fixed size blocks, only the samples of the requested topics are decoded.
+    /// Memory use doesn't depend on the size of the log.
+    ///     @param topics Topic (message format) names to decode
+    ///     @param loggingCallback Optional, receives the logged text messages
+    ///     @return false if failed, errorMessage set
+    bool parseTopics(QIODevice &log, const std::set<std::string> &topics, const TopicCallback &callback, QString &errorMessage,
+                     const LoggingCallback &loggingCallback = LoggingCallback());
+
     /// Get GeoTags from a ULog (stores full log in memory)
     ///     @return true if failed, errorMessage set
     bool getTagsFromLog(const QByteArray &log, QList<GeoTagWorker::CameraFeedbackPacket> &cameraFeedback, QString &errorMessage);
 
-    /// Get GeoTags from a ULog using streamed parsing (lower memory usage)
-    ///     @return true if failed, errorMessage set
+    /// Get GeoTags from a ULog held in memory, parsed in blocks through the QIODevice overload
+    ///     @return false if failed, errorMessage set
     bool getTagsFromLogStreamed(const QByteArray &log, QList<GeoTagWorker::CameraFeedbackPacket> &cameraFeedback, QString &errorMessage);
+
+    /// Get GeoTags from a ULog file, reading it in fixed size blocks
+    ///     @return false if failed, errorMessage set
+    bool getTagsFromLogStreamed(QIODevice &log, QList<GeoTagWorker::CameraFeedbackPacket> &cameraFeedback, QString &errorMessage);
+
+    constexpr qint64 kReadBlockSize = 64 * 1024;
 } // namespace ULogParser
@@ -0,0 +1,319 @@
+#include "ULogTopicExtractor.h"
+#include "QGCLoggingCategory.h"
+#include "ULogParser.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QIODevice>
+#include <QtCore/QSaveFile>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ulog_cpp/data_container.hpp>
+
+using namespace ulog_cpp;
+
+QGC_LOGGING_CATEGORY(ULogTopicExtractorLog, "AnalyzeView.ULogTopicExtractor")
+
+namespace {
+
+/// Maps the columns of a table to the fields of its topic, set up from the format of the first sample
+struct TopicState {
+    qsizetype tableIndex = 0;
+    bool bound = false;
+    std::vector<std::string> fieldNames;    ///< Parallel to the columns of the table
+};
+
+/// @return false: Field can't be stored in a column (array, string or nested type)
+bool columnType(const Field &field, ULogTopicExtractor::ColumnType &type)
+{
+    if (field.arrayLength() >= 0) {
+        return false;
+    }
+
+    switch (field.type().type) {
+    case Field::BasicType::FLOAT:
+    case Field::BasicType::DOUBLE:
+        type = ULogTopicExtractor::RealColumn;
+        return true;
+    case Field::BasicType::UINT64:
+        // Doesn't fit a qint64 column
+        type = ULogTopicExtractor::UnsignedColumn;
+        return true;
+    case Field::BasicType::CHAR:
+    case Field::BasicType::NESTED:
+        return false;
+    default:
+        type = ULogTopicExtractor::IntegerColumn;
+        return true;
+    }
+}
+
+void bindColumns(ULogTopicExtractor::Table &table, TopicState &state, const MessageFormat &format, const QStringList &requestedFields)
+{
+    QStringList fields = requestedFields;
+    if (fields.isEmpty()) {
+        for (const std::string &name : format.fieldNames()) {
+            // Timestamp is the row key, padding only exists for alignment
+            if ((name != "timestamp") && !QString::fromStdString(name).startsWith(QStringLiteral("_padding"))) {
+                fields.append(QString::fromStdString(name));
+            }
+        }
+    }
+
+    for (const QString &fieldName : std::as_const(fields)) {
+        const std::string name = fieldName.toStdString();
+        const std::shared_ptr<Field> field = format.field(name);
+
+        ULogTopicExtractor::ColumnType type;
+        if (!field || !columnType(*field, type)) {
+            if (!requestedFields.isEmpty()) {
+                qCWarning(ULogTopicExtractorLog) << "Field not extracted, unknown or not a scalar:" << table.topic << fieldName;
+            }
+            continue;
+        }
+
+        ULogTopicExtractor::Column column;
+        column.name = fieldName;
+        column.type = type;
+        column.singlePrecision = (field->type().type == Field::BasicType::FLOAT);
+        table.columns.append(column);
+        state.fieldNames.push_back(name);
+    }
+
+    state.bound = true;
+}
+
+/// Shortest representation which reads back to the same value
+void appendReal(QByteArray &buffer, const ULogTopicExtractor::Column &column, qsizetype row)
+{
+    char text[32];
+    const double value = column.reals[row];
+    const std::to_chars_result result = column.singlePrecision ? std::to_chars(text, text + sizeof(text), static_cast<float>(value))
+                                                               : std::to_chars(text, text + sizeof(text), value);
+    buffer.append(text, result.ptr - text);
+}
+
+bool writeAll(QIODevice &output, const QByteArray &data, QString &errorMessage)
+{
+    if (output.write(data) != data.size()) {
+        errorMessage = output.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+double ULogTopicExtractor::Column::value(qsizetype row) const
+{
+    switch (type) {
+    case IntegerColumn:
+        return static_cast<double>(integers[row]);
+    case UnsignedColumn:
+        return static_cast<double>(unsignedIntegers[row]);
+    default:
+        return reals[row];
+    }
+}
+
+const ULogTopicExtractor::Column *ULogTopicExtractor::Table::column(const QString &name) const
+{
+    for (const Column &column : columns) {
+        if (column.name == name) {
+            return &column;
+        }
+    }
+
+    return nullptr;
+}
+
+void ULogTopicExtractor::addTopic(const QString &topic, const QStringList &fields)
+{
+    if (!_topics.contains(topic)) {
+        _topics.append(topic);
+    }
+    _fields[topic] = fields;
+}
+
+void ULogTopicExtractor::setTimeRange(quint64 startUs, quint64 endUs)
+{
+    _startUs = startUs;
+    _endUs = endUs;
+}
+
+const ULogTopicExtractor::Table *ULogTopicExtractor::table(const QString &topic, int multiId) const
+{
+    for (const Table &table : _tables) {
+        if ((table.topic == topic) && (table.multiId == multiId)) {
+            return &table;
+        }
+    }
+
+    return nullptr;
+}
+
+bool ULogTopicExtractor::extract(QIODevice &log, QString &errorMessage)
+{
+    _tables.clear();
+
+    // Instance 0 of every topic always has a table, further instances get one when their first sample shows up
+    std::set<std::string> topics;
+    std::map<std::pair<std::string, int>, TopicState> states;
+    for (const QString &topic : std::as_const(_topics)) {
+        Table table;
+        table.topic = topic;
+        _tables.append(table);
+
+        const std::string name = topic.toStdString();
+        (void) topics.insert(name);
+        states[{ name, 0 }].tableIndex = _tables.count() - 1;
+    }
+
+    const ULogParser::TopicCallback callback = [this, &states](const std::string &topic, int multiId, const TypedDataView &sample) {
+        auto it = states.find({ topic, multiId });
+        if (it == states.end()) {
+            Table table;
+            table.topic = QString::fromStdString(topic);
+            table.multiId = multiId;
+            _tables.append(table);
+
+            it = states.emplace(std::make_pair(topic, multiId), TopicState()).first;
+            it->second.tableIndex = _tables.count() - 1;
+        }
+
+        TopicState &state = it->second;
+        Table &table = _tables[state.tableIndex];
+        if (!state.bound) {
+            bindColumns(table, state, sample.format(), _fields.value(table.topic));
+        }
+
+        uint64_t timestamp = 0;
+        try {
+            timestamp = sample.at("timestamp").as<uint64_t>();
+        } catch (const AccessException &exception) {
+            qCDebug(ULogTopicExtractorLog) << "Sample without timestamp" << table.topic << exception.what();
+            return;
+        }
+        if ((timestamp < _startUs) || (timestamp > _endUs)) {
+            return;
+        }
+
+        table.timestamps.append(timestamp);
+        for (size_t i = 0; i < state.fieldNames.size(); i++) {
+            Column &column = table.columns[static_cast<qsizetype>(i)];
+            // A field which fails to decode still gets a value so all columns keep the same row count
+            try {
+                const Value value = sample.at(state.fieldNames[i]);
+                if (column.type == IntegerColumn) {
+                    column.integers.append(value.as<int64_t>());
+                } else if (column.type == UnsignedColumn) {
+                    column.unsignedIntegers.append(value.as<uint64_t>());
+                } else if (column.singlePrecision) {
+                    column.reals.append(value.as<float>());
+                } else {
+                    column.reals.append(value.as<double>());
+                }
+            } catch (const AccessException &exception) {
+                qCDebug(ULogTopicExtractorLog) << table.topic << column.name << exception.what();
+                if (column.type == IntegerColumn) {
+                    column.integers.append(0);
+                } else if (column.type == UnsignedColumn) {
+                    column.unsignedIntegers.append(0);
+                } else {
+                    column.reals.append(std::nan(""));
+                }
+            }
+        }
+    };
+
+    if (!ULogParser::parseTopics(log, topics, callback, errorMessage)) {
+        return false;
+    }
+
+    // Instances were appended as they were found, group them with their topic
+    std::stable_sort(_tables.begin(), _tables.end(), [this](const Table &a, const Table &b) {
+        const qsizetype aIndex = _topics.indexOf(a.topic);
+        const qsizetype bIndex = _topics.indexOf(b.topic);
+        return (aIndex != bIndex) ? (aIndex < bIndex) : (a.multiId < b.multiId);
+    });
+
+    for (const Table &table : std::as_const(_tables)) {
+        qCDebug(ULogTopicExtractorLog) << "Extracted" << table.name() << "rows:" << table.rowCount() << "columns:" << table.columns.count();
+    }
+
+    return true;
+}
+
+bool ULogTopicExtractor::exportCsv(const Table &table, QIODevice &output, QString &errorMessage)
+{
+    QByteArray buffer;
+    buffer.reserve(_csvFlushSize + 1024);
+
+    buffer.append("timestamp");
+    for (const Column &column : table.columns) {
+        buffer.append(',');
+        buffer.append(column.name.toUtf8());
+    }
+    buffer.append('\n');
+
+    for (qsizetype row = 0; row < table.rowCount(); row++) {
+        buffer.append(QByteArray::number(table.timestamps[row]));
+        for (const Column &column : table.columns) {
+            buffer.append(',');
+            if (column.type == IntegerColumn) {
+                buffer.append(QByteArray::number(column.integers[row]));
+            } else if (column.type == UnsignedColumn) {
+                buffer.append(QByteArray::number(column.unsignedIntegers[row]));
+            } else {
+                appendReal(buffer, column, row);
+            }
+        }
+        buffer.append('\n');
+
+        if (buffer.size() >= _csvFlushSize) {
+            if (!writeAll(output, buffer, errorMessage)) {
+                return false;
+            }
+            buffer.resize(0); // Keeps the reserved capacity, clear() would release it
+        }
+    }
+
+    return writeAll(output, buffer, errorMessage);
+}
+
+bool ULogTopicExtractor::exportCsv(const QString &directory, QString &errorMessage) const
+{
+    const QDir dir(directory);
+    if (!dir.exists() && !dir.mkpath(QStringLiteral("."))) {
+        errorMessage = QStringLiteral("Could not create directory %1").arg(directory);
+        return false;
+    }
+
+    for (const Table &table : _tables) {
+        QSaveFile file(dir.filePath(table.name() + QStringLiteral(".csv")));
+        if (!file.open(QIODevice::WriteOnly)) {
+            errorMessage = file.errorString();
+            return false;
+        }
+
+        if (!exportCsv(table, file, errorMessage)) {
+            file.cancelWriting();
+            return false;
+        }
+
+        if (!file.commit()) {
+            errorMessage = file.errorString();
+            return false;
+        }
+    }
+
+    return true;
+}
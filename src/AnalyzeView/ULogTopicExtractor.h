@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <limits>
+
+class QIODevice;
+
+Q_DECLARE_LOGGING_CATEGORY(ULogTopicExtractorLog)
+
+/// Extracts the fields of selected ULog topics into typed columns in a single streaming pass over the log.
+///     Only the samples of the requested topics are decoded, so pulling a few topics out of a multi GB log needs
+///     memory for the extracted values only. Each instance of a topic becomes a table with one row per sample, keyed
+///     by the sample timestamp. Tables can be exported as CSV.
+class ULogTopicExtractor
+{
+public:
+    enum ColumnType {
+        IntegerColumn,      ///< Signed integer, unsigned integer up to 32 bit and bool fields, stored as qint64
+        UnsignedColumn,     ///< uint64 fields, stored as quint64
+        RealColumn,         ///< float and double fields, stored as double
+    };
+
+    struct Column {
+        QString name;
+        ColumnType type = RealColumn;
+        QList<qint64> integers;     ///< Values when type is IntegerColumn
+        QList<quint64> unsignedIntegers;    ///< Values when type is UnsignedColumn
+        QList<double> reals;        ///< Values when type is RealColumn
+        bool singlePrecision = false;   ///< Values of a float field, exported with float precision
+
+        double value(qsizetype row) const;
+    };
+
+    struct Table {
+        QString topic;
+        int multiId = 0;                ///< Instance of the topic, 0 for the first one
+        QList<quint64> timestamps;      ///< Microseconds since boot
+        QList<Column> columns;
+
+        qsizetype rowCount() const { return timestamps.count(); }
+        const Column *column(const QString &name) const;
+
+        /// Topic and instance, e.g. sensor_accel_1
+        QString name() const { return QStringLiteral("%1_%2").arg(topic).arg(multiId); }
+    };
+
+    /// Adds a topic to extract
+    ///     @param fields Fields to extract, empty for all scalar fields of the topic
+    void addTopic(const QString &topic, const QStringList &fields = QStringList());
+
+    /// Only samples with timestamp within [startUs, endUs] are extracted
+    void setTimeRange(quint64 startUs, quint64 endUs);
+
+    /// Parses the log and fills the tables of the requested topics. Previously extracted data is discarded.
+    ///     @return false: Log could not be parsed, errorMessage set
+    bool extract(QIODevice &log, QString &errorMessage);
+
+    /// Tables in the order topics were added, the instances of a topic ordered by multiId.
+    /// Topics which are not in the log have an empty table for instance 0.
+    const QList<Table> &tables() const { return _tables; }
+    const Table *table(const QString &topic, int multiId = 0) const;
+
+    /// Writes a table as CSV with a header row, the first column is the timestamp
+    static bool exportCsv(const Table &table, QIODevice &output, QString &errorMessage);
+
+    /// Writes each table to <directory>/<topic>_<multiId>.csv
+    bool exportCsv(const QString &directory, QString &errorMessage) const;
+
+private:
+    QStringList _topics;
+    QHash<QString, QStringList> _fields;
+    quint64 _startUs = 0;
+    quint64 _endUs = std::numeric_limits<quint64>::max();
+    QList<Table> _tables;
+
+    static constexpr qsizetype _csvFlushSize = 64 * 1024;
+};
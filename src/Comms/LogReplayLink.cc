@@ -3,7 +3,9 @@
 #include "MAVLinkProtocol.h"
 #include "MultiVehicleManager.h"
 #include "QGCLoggingCategory.h"
+#include "QGCZstdSeekable.h"
 
+#include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QtEndian>
 #include <QtCore/QThread>
@@ -132,8 +134,10 @@ void LogReplayWorker::disconnectFromLog()
         _readTickTimer->stop();
     }
 
-    if (_logFile.isOpen()) {
-        _logFile.close();
+    if (_logFile) {
+        _logFile->close();
+        delete _logFile;
+        _logFile = nullptr;
     }
 
     _isConnected = false;
@@ -150,7 +154,7 @@ void LogReplayWorker::play()
     LinkManager::instance()->setConnectionsSuspended(tr("Connect not allowed during Flight Data replay."));
     MAVLinkProtocol::instance()->suspendLogForReplay(true);
 
-    if (_logFile.atEnd()) {
+    if (_logFile && _logFile->atEnd()) {
         _resetPlaybackToBeginning();
     }
 
@@ -181,6 +185,10 @@ void LogReplayWorker::setPlaybackSpeed(qreal playbackSpeed)
 
 void LogReplayWorker::movePlayhead(qreal percentComplete)
 {
+    if (!_logFile) {
+        return;
+    }
+
     if (isPlaying()) {
         pause();
         if (_readTickTimer->isActive()) {
@@ -190,8 +198,8 @@ void LogReplayWorker::movePlayhead(qreal percentComplete)
 
     percentComplete = qBound(0., percentComplete, 100.);
     const qreal percentCompleteMult = percentComplete / 100.0;
-    const qint64 newFilePos = static_cast<qint64>(percentCompleteMult * static_cast<qreal>(_logFile.size()));
-    if (!_logFile.seek(newFilePos)) {
+    const qint64 newFilePos = static_cast<qint64>(percentCompleteMult * static_cast<qreal>(_logFile->size()));
+    if (!_logFile->seek(newFilePos)) {
         emit errorOccurred(tr("Unable to seek to new position"));
         return;
     }
@@ -200,10 +208,10 @@ void LogReplayWorker::movePlayhead(qreal percentComplete)
     _logCurrentTimeUSecs = _seekToNextMavlinkMessage(dummy);
 
     qreal newRelativeTimeUSecs = static_cast<qreal>(_logCurrentTimeUSecs - _logStartTimeUSecs);
-    const qreal baudRate = _logFile.size() / static_cast<qreal>(_logDurationUSecs) / 1e6;
+    const qreal baudRate = _logFile->size() / static_cast<qreal>(_logDurationUSecs) / 1e6;
     const qreal desiredTimeUSecs = percentCompleteMult * _logDurationUSecs;
     const qint64 offset = (newRelativeTimeUSecs - desiredTimeUSecs) * baudRate;
-    if (!_logFile.seek(_logFile.pos() + offset)) {
+    if (!_logFile->seek(_logFile->pos() + offset)) {
         emit errorOccurred(tr("Unable to seek to new position"));
         return;
     }
@@ -218,9 +226,9 @@ void LogReplayWorker::movePlayhead(qreal percentComplete)
 
 void LogReplayWorker::_resetPlaybackToBeginning()
 {
-    if (_logFile.isOpen()) {
-        if (!_logFile.reset()) {
-            qCWarning(LogReplayLinkLog) << "failed to reset log file:" << _logFile.error() << _logFile.errorString();
+    if (_logFile && _logFile->isOpen()) {
+        if (!_logFile->reset()) {
+            qCWarning(LogReplayLinkLog) << "failed to reset log file:" << _logFile->errorString();
         }
     }
 
@@ -234,12 +242,12 @@ void LogReplayWorker::_readNextLogEntry()
     int timeToNextExecutionMSecs = 0;
     while (timeToNextExecutionMSecs < 3) {
         QByteArray bytes;
-        bytes.reserve(_logFile.bytesAvailable());
+        bytes.reserve(_logFile->bytesAvailable());
         const qint64 nextTimeUSecs = _readNextMavlinkMessage(bytes);
         emit dataReceived(bytes);
         emit playbackPercentCompleteChanged((static_cast<float>(_logCurrentTimeUSecs - _logStartTimeUSecs) / static_cast<float>(_logDurationUSecs)) * 100);
 
-        if (_logFile.atEnd()) {
+        if (_logFile->atEnd()) {
             pause();
             emit playbackAtEnd();
             return;
@@ -265,27 +273,36 @@ void LogReplayWorker::_signalCurrentLogTimeSecs()
 
 bool LogReplayWorker::_loadLogFile()
 {
-    if (_logFile.isOpen()) {
-        _logFile.close();
+    if (_logFile) {
+        _logFile->close();
+        delete _logFile;
+        _logFile = nullptr;
         emit errorOccurred(tr("Attempt to load new log while log being played"));
         return false;
     }
 
+    // Compressed logs are replayed in place, only the frame being read is decompressed
     const QString logFilename = _logReplayConfig->logFilename();
-    _logFile.setFileName(logFilename);
-    if (!_logFile.open(QFile::ReadOnly)) {
-        emit errorOccurred(tr("Unable to open log file: '%1', error: %2").arg(logFilename, _logFile.errorString()));
+    if (QGCZstdSeekable::isZstdFile(logFilename)) {
+        _logFile = new QGCZstdSeekableDevice(logFilename, this);
+    } else {
+        _logFile = new QFile(logFilename, this);
+    }
+    if (!_logFile->open(QIODevice::ReadOnly)) {
+        emit errorOccurred(tr("Unable to open log file: '%1', error: %2").arg(logFilename, _logFile->errorString()));
+        delete _logFile;
+        _logFile = nullptr;
         return false;
     }
 
-    QFileInfo logFileInfo;
-    logFileInfo.setFile(logFilename);
-    _logFileSize = logFileInfo.size();
+    _logFileSize = _logFile->size();
 
-    const quint64 startTimeUSecs = _parseTimestamp(_logFile.read(kTimestamp));
+    const quint64 startTimeUSecs = _parseTimestamp(_logFile->read(kTimestamp));
     const quint64 endTimeUSecs = _findLastTimestamp();
     if (endTimeUSecs <= startTimeUSecs) {
-        _logFile.close();
+        _logFile->close();
+        delete _logFile;
+        _logFile = nullptr;
         emit errorOccurred(tr("The log file '%1' is corrupt or empty.").arg(logFilename));
         return false;
     }
@@ -295,8 +312,8 @@ bool LogReplayWorker::_loadLogFile()
     _logDurationUSecs = endTimeUSecs - startTimeUSecs;
     _logCurrentTimeUSecs = startTimeUSecs;
 
-    if (!_logFile.reset()) {
-        qCWarning(LogReplayLinkLog) << "failed to reset log file:" << _logFile.error() << _logFile.errorString();
+    if (!_logFile->reset()) {
+        qCWarning(LogReplayLinkLog) << "failed to reset log file:" << _logFile->errorString();
     }
 
     const quint64 logDurationSecondsTotal = _logDurationUSecs / 1000000;
@@ -321,7 +338,7 @@ quint64 LogReplayWorker::_readNextMavlinkMessage(QByteArray &bytes)
     bytes.clear();
 
     char nextByte;
-    while (_logFile.getChar(&nextByte)) {
+    while (_logFile->getChar(&nextByte)) {
         mavlink_message_t message{};
         mavlink_status_t status{};
         const bool messageFound = mavlink_parse_char(_mavlinkChannel, nextByte, &message, &status);
@@ -332,7 +349,7 @@ quint64 LogReplayWorker::_readNextMavlinkMessage(QByteArray &bytes)
         (void) bytes.append(nextByte);
 
         if (messageFound) {
-            const QByteArray rawTime = _logFile.read(kTimestamp);
+            const QByteArray rawTime = _logFile->read(kTimestamp);
             return _parseTimestamp(rawTime);
         }
     }
@@ -346,21 +363,21 @@ quint64 LogReplayWorker::_seekToNextMavlinkMessage(mavlink_message_t &nextMsg)
 
     qint64 messageStartPos = -1;
     char nextByte;
-    while (_logFile.getChar(&nextByte)) {
+    while (_logFile->getChar(&nextByte)) {
         mavlink_status_t status{};
         const bool messageFound = mavlink_parse_char(_mavlinkChannel, nextByte, &nextMsg, &status);
 
         if (status.parse_state == MAVLINK_PARSE_STATE_GOT_STX) {
-            messageStartPos = _logFile.pos() - 1;
+            messageStartPos = _logFile->pos() - 1;
         }
 
         if (messageFound && (messageStartPos != -1)) {
-            if (!_logFile.seek(messageStartPos - kTimestamp)) {
-                qCWarning(LogReplayLinkLog) << "Failed to seek next message:" << _logFile.error() << _logFile.errorString();
+            if (!_logFile->seek(messageStartPos - kTimestamp)) {
+                qCWarning(LogReplayLinkLog) << "Failed to seek next message:" << _logFile->errorString();
                 break;
             }
 
-            const QByteArray rawTime = _logFile.read(kTimestamp);
+            const QByteArray rawTime = _logFile->read(kTimestamp);
             return _parseTimestamp(rawTime);
         }
     }
@@ -370,20 +387,20 @@ quint64 LogReplayWorker::_seekToNextMavlinkMessage(mavlink_message_t &nextMsg)
 
 quint64 LogReplayWorker::_findLastTimestamp()
 {
-    if (!_logFile.reset()) {
-        qCWarning(LogReplayLinkLog) << "failed to reset log file:" << _logFile.error() << _logFile.errorString();
+    if (!_logFile->reset()) {
+        qCWarning(LogReplayLinkLog) << "failed to reset log file:" << _logFile->errorString();
     }
 
     mavlink_reset_channel_status(_mavlinkChannel);
 
     quint64 lastTimestamp = 0;
 
-    while (_logFile.bytesAvailable() > kTimestamp) {
-        lastTimestamp = _parseTimestamp(_logFile.read(kTimestamp));
+    while (_logFile->bytesAvailable() > kTimestamp) {
+        lastTimestamp = _parseTimestamp(_logFile->read(kTimestamp));
 
         bool endOfMessage = false;
         char nextByte;
-        while (!endOfMessage && _logFile.getChar(&nextByte)) {
+        while (!endOfMessage && _logFile->getChar(&nextByte)) {
             mavlink_message_t msg{};
             mavlink_status_t status{};
             endOfMessage = mavlink_parse_char(_mavlinkChannel, nextByte, &msg, &status);
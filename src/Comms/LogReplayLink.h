@@ -3,7 +3,7 @@
 #include "LinkConfiguration.h"
 #include "LinkInterface.h"
 
-#include <QtCore/QFile>
+#include <QtCore/QIODevice>
 #include <QtCore/QLoggingCategory>
 #include <QtQmlIntegration/QtQmlIntegration>
 
@@ -108,7 +108,7 @@ private slots:
     quint64 _playbackStartTimeMSecs = 0;
     quint64 _playbackStartLogTimeUSecs = 0;
 
-    QFile _logFile;
+    QIODevice *_logFile = nullptr;      ///< QFile, or QGCZstdSeekableDevice for compressed logs
     quint64 _logFileSize = 0;
 
     static constexpr size_t kTimestamp = sizeof(quint64);
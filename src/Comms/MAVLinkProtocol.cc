@@ -6,6 +6,7 @@
 #include "QGCApplication.h"
 #include "QGCFileHelper.h"
 #include "QGCLoggingCategory.h"
+#include "QGCZstdSeekable.h"
 #include "QmlObjectListModel.h"
 #include "SettingsManager.h"
 
@@ -18,6 +19,8 @@
 #include <QtCore/QStandardPaths>
 #include <QtCore/QTimer>
 
+#include <memory>
+
 QGC_LOGGING_CATEGORY(MAVLinkProtocolLog, "Comms.MAVLinkProtocol")
 
 Q_APPLICATION_STATIC(MAVLinkProtocol, _mavlinkProtocolInstance);
@@ -383,13 +386,17 @@ void MAVLinkProtocol::_saveTelemetryLog(const QString &tempLogfile)
         const QString saveDirPath = SettingsManager::instance()->appSettings()->telemetrySavePath();
         const QDir saveDir(saveDirPath);
 
+        // The temp log stays uncompressed so a crash never leaves a half written frame behind
+        const bool compress = SettingsManager::instance()->mavlinkSettings()->telemetryCompress()->rawValue().toBool();
+        const QString extension = compress ? QStringLiteral("%1.zst").arg(AppSettings::telemetryFileExtension) : QString(AppSettings::telemetryFileExtension);
+
         const QString nameFormat("%1%2.%3");
         const QString dtFormat("yyyy-MM-dd hh-mm-ss");
 
         int tryIndex = 1;
-        QString saveFileName = nameFormat.arg(QDateTime::currentDateTime().toString(dtFormat), QString(), AppSettings::telemetryFileExtension);
+        QString saveFileName = nameFormat.arg(QDateTime::currentDateTime().toString(dtFormat), QString(), extension);
         while (saveDir.exists(saveFileName)) {
-            saveFileName = nameFormat.arg(QDateTime::currentDateTime().toString(dtFormat), QStringLiteral(".%1").arg(tryIndex++), AppSettings::telemetryFileExtension);
+            saveFileName = nameFormat.arg(QDateTime::currentDateTime().toString(dtFormat), QStringLiteral(".%1").arg(tryIndex++), extension);
         }
 
         const QString saveFilePath = saveDir.absoluteFilePath(saveFileName);
@@ -412,6 +419,26 @@ void MAVLinkProtocol::_saveTelemetryLog(const QString &tempLogfile)
             return;
         }
 
+        // The compressor writes its last frame and seek table when it is destroyed, so it has to be gone before
+        // the save is canceled. Otherwise it would still write into the canceled file.
+        std::unique_ptr<QGCZstdSeekableWriter> compressor;
+        const auto cancelSave = [&compressor, &out]() {
+            compressor.reset();
+            out.cancelWriting();
+        };
+
+        if (compress) {
+            compressor = std::make_unique<QGCZstdSeekableWriter>(&out);
+            if (!compressor->open(QIODevice::WriteOnly)) {
+                const QString error = tr("Unable to save telemetry log. Error opening destination '%1': '%2'.").arg(saveFilePath, compressor->errorString());
+                qgcApp()->showAppMessage(error);
+                cancelSave();
+                (void) QFile::remove(tempLogfile);
+                return;
+            }
+        }
+        QIODevice *const sink = compressor ? static_cast<QIODevice*>(compressor.get()) : static_cast<QIODevice*>(&out);
+
         // Stream copy to avoid large allocations.
         QByteArray buffer;
         constexpr int bufferSize = 256 * 1024; // 256 KiB
@@ -424,19 +451,27 @@ void MAVLinkProtocol::_saveTelemetryLog(const QString &tempLogfile)
             if (n < 0) {
                 const QString error = tr("Unable to save telemetry log. Error reading source '%1': '%2'.").arg(tempLogfile, in.errorString());
                 qgcApp()->showAppMessage(error);
-                out.cancelWriting();
+                cancelSave();
                 (void) QFile::remove(tempLogfile);
                 return;
             }
-            if (out.write(buffer.constData(), n) != n) {
-                const QString error = tr("Unable to save telemetry log. Error writing destination '%1': '%2'.").arg(saveFilePath, out.errorString());
+            if (sink->write(buffer.constData(), n) != n) {
+                const QString error = tr("Unable to save telemetry log. Error writing destination '%1': '%2'.").arg(saveFilePath, sink->errorString());
                 qgcApp()->showAppMessage(error);
-                out.cancelWriting();
+                cancelSave();
                 (void) QFile::remove(tempLogfile);
                 return;
             }
         }
 
+        if (compressor && !compressor->finish()) {
+            const QString error = tr("Unable to save telemetry log. Error writing destination '%1': '%2'.").arg(saveFilePath, compressor->errorString());
+            qgcApp()->showAppMessage(error);
+            cancelSave();
+            (void) QFile::remove(tempLogfile);
+            return;
+        }
+
         if (!out.commit()) {
             const QString error = tr("Unable to finalize telemetry log '%1': '%2'.").arg(saveFilePath, out.errorString());
             qgcApp()->showAppMessage(error);
@@ -771,6 +771,28 @@ void MockLink::_setParamFloatUnionIntoMap(int componentId, const QString &paramN
     _mapParamName2Value[componentId][paramName] = paramVariant;
 }
 
+QVariant MockLink::paramValue(int componentId, const QString &paramName) const
+{
+    return _mapParamName2Value.value(componentId).value(paramName);
+}
+
+void MockLink::setParamValue(int componentId, const QString &paramName, const QVariant &value)
+{
+    if (!_mapParamName2Value.contains(componentId) || !_mapParamName2Value[componentId].contains(paramName)) {
+        qCWarning(MockLinkLog) << "setParamValue: Unknown parameter" << componentId << paramName;
+        return;
+    }
+
+    QVariant paramVariant = value;
+    if (!paramVariant.convert(_mapParamName2Value[componentId][paramName].metaType())) {
+        qCWarning(MockLinkLog) << "setParamValue: Unable to convert value" << paramName << value;
+        return;
+    }
+
+    qCDebug(MockLinkLog) << "setParamValue" << paramName << paramVariant;
+    _mapParamName2Value[componentId][paramName] = paramVariant;
+}
+
 float MockLink::_floatUnionForParam(int componentId, const QString &paramName)
 {
     Q_ASSERT(_mapParamName2Value.contains(componentId));
@@ -69,6 +69,12 @@ class MockLink : public LinkInterface
     /// Reset the state of the MissionItemHandler to no items, no transactions in progress.
     void resetMissionItemHandler() const { _missionItemHandler->reset(); }
 
+    /// @return Number of MISSION_WRITE_PARTIAL_LIST sequences the mission item handler has started
+    int missionItemPartialWriteCount() const { return _missionItemHandler->partialWriteCount(); }
+
+    /// Changes the mission on the vehicle as if it was uploaded by another GCS
+    void changeMissionExternally() const { _missionItemHandler->changeMissionExternally(); }
+
     /// Returns the filename for the simulated log file. Only available after a download is requested.
     QString logDownloadFile() const { return _logDownloadFilename; }
 
@@ -83,6 +89,13 @@ class MockLink : public LinkInterface
     };
     void setRequestMessageFailureMode(RequestMessageFailureMode_t failureMode) { _requestMessageFailureMode = failureMode; }
 
+    /// @return Current value of the parameter, invalid if the parameter does not exist
+    QVariant paramValue(int componentId, const QString &paramName) const;
+
+    /// Changes a parameter as if it was changed on the vehicle itself, no PARAM_VALUE is sent
+    ///     @param value Converted to the type of the existing parameter
+    void setParamValue(int componentId, const QString &paramName, const QVariant &value);
+
     enum ParamSetFailureMode_t {
         FailParamSetNone,               ///< Normal behavior
         FailParamSetNoAck,              ///< Do not send PARAM_VALUE ack
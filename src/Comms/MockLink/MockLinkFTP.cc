@@ -2,6 +2,7 @@
 #include "MockLink.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtCore/QDataStream>
 #include <QtCore/QDir>
 #include <QtCore/QTemporaryFile>
 
@@ -378,11 +379,95 @@ void MockLinkFTP::_finalizeActiveUpload()
 
     if (!_uploadSession.remotePath.isEmpty()) {
         _uploadedFiles.insert(_uploadSession.remotePath, _uploadSession.buffer);
+        if (_paramFileApplyEnabled && (_uploadSession.remotePath == QStringLiteral("@PARAM/param.pck"))) {
+            _applyParamFile(_uploadSession.buffer);
+        }
     }
 
     _uploadSession.reset();
 }
 
+/// Applies an ArduPilot packed parameter file
+void MockLinkFTP::_applyParamFile(const QByteArray &data)
+{
+    constexpr quint16 magic_standard = 0x671B;
+
+    QDataStream in(data);
+    in.setByteOrder(QDataStream::LittleEndian);
+    in.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint16 magic = 0;
+    quint16 numParams = 0;
+    quint16 totalParams = 0;
+    in >> magic >> numParams >> totalParams;
+    if ((in.status() != QDataStream::Ok) || (magic != magic_standard)) {
+        qCWarning(MockLinkFTPLog) << "_applyParamFile: Invalid header" << magic;
+        return;
+    }
+
+    QByteArray previousName;
+    int paramCount = 0;
+    while ((paramCount < numParams) && !in.atEnd()) {
+        quint8 ptype = 0;
+        in >> ptype;
+        if (ptype == 0) {
+            // Padding
+            continue;
+        }
+
+        quint8 lengths = 0;
+        in >> lengths;
+        const int commonLength = lengths & 0x0F;
+        const int suffixLength = (lengths >> 4) + 1;
+        QByteArray name = previousName.left(commonLength);
+        QByteArray suffix(suffixLength, '\0');
+        if (in.readRawData(suffix.data(), suffixLength) != suffixLength) {
+            qCWarning(MockLinkFTPLog) << "_applyParamFile: Truncated name";
+            return;
+        }
+        name.append(suffix);
+
+        QVariant value;
+        switch (ptype) {
+        case 1: {
+            qint8 int8 = 0;
+            in >> int8;
+            value = QVariant::fromValue(int8);
+            break;
+        }
+        case 2: {
+            qint16 int16 = 0;
+            in >> int16;
+            value = QVariant::fromValue(int16);
+            break;
+        }
+        case 3: {
+            qint32 int32 = 0;
+            in >> int32;
+            value = QVariant::fromValue(int32);
+            break;
+        }
+        case 4: {
+            float floatValue = 0;
+            in >> floatValue;
+            value = QVariant::fromValue(floatValue);
+            break;
+        }
+        default:
+            qCWarning(MockLinkFTPLog) << "_applyParamFile: Unknown type" << ptype;
+            return;
+        }
+        if (in.status() != QDataStream::Ok) {
+            qCWarning(MockLinkFTPLog) << "_applyParamFile: Truncated value" << name;
+            return;
+        }
+
+        _mockLink->setParamValue(_componentIdServer, QString::fromLatin1(name), value);
+        previousName = name;
+        paramCount++;
+    }
+}
+
 void MockLinkFTP::mavlinkMessageReceived(const mavlink_message_t &message)
 {
     if (message.msgid != MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL) {
@@ -41,6 +41,10 @@ class MockLinkFTP : public QObject
     /// Clears the stored uploaded file contents.
     void clearUploadedFiles() { _uploadedFiles.clear(); }
 
+    /// Uploaded @PARAM/param.pck files are applied to the MockLink parameters by default. Disable to simulate
+    /// a vehicle which accepts the file but does not change its parameters.
+    void enableParamFileApply(bool enable) { _paramFileApplyEnabled = enable; }
+
     /// By calling setErrorMode with one of these modes you can cause the server to simulate an error.
     enum ErrorMode_t {
         errModeNone,                        ///< No error, respond correctly
@@ -97,6 +101,7 @@ class MockLinkFTP : public QObject
     void _resetCommand(uint8_t senderSystemId, uint8_t senderComponentId, uint16_t seqNumber);
     void _writeCommand(uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request *request, uint16_t seqNumber);
     void _finalizeActiveUpload();
+    void _applyParamFile(const QByteArray &data);
     /// Generates the next sequence number given an incoming sequence number. Handles generating
     /// bad sequence numbers when errModeBadSequence is set.
     uint16_t _nextSeqNumber(uint16_t seqNumber) const;
@@ -110,6 +115,7 @@ class MockLinkFTP : public QObject
     MockLink *_mockLink;                        ///< MockLink to communicate through
 
     bool _BinParamFileEnabled = false;
+    bool _paramFileApplyEnabled = true;
     bool _lastReplyValid = false;
     bool _randomDropsEnabled = false;
     ErrorMode_t _errMode = errModeNone;         ///< Currently set error mode, as specified by setErrorMode
@@ -42,6 +42,9 @@ bool MockLinkMissionItemHandler::handleMessage(const mavlink_message_t &msg)
     case MAVLINK_MSG_ID_MISSION_COUNT:
         _handleMissionCount(msg);
         break;
+    case MAVLINK_MSG_ID_MISSION_WRITE_PARTIAL_LIST:
+        _handleMissionWritePartialList(msg);
+        break;
     case MAVLINK_MSG_ID_MISSION_ACK:
         // Acks are received back for each MISSION_ITEM message
         break;
@@ -87,6 +90,9 @@ void MockLinkMissionItemHandler::_handleMissionClearAll(const mavlink_message_t
         Q_ASSERT(false);
     }
 
+    if ((_requestType == MAV_MISSION_TYPE_MISSION) || (_requestType == MAV_MISSION_TYPE_ALL)) {
+        _missionChanged(MAV_MISSION_TYPE_MISSION);
+    }
     _sendAck(MAV_MISSION_ACCEPTED);
 }
 
@@ -144,7 +150,7 @@ void MockLinkMissionItemHandler::_handleMissionRequestList(const mavlink_message
         msg.compid,                 // Target is original sender
         itemCount,                  // Number of mission items
         _requestType,
-        0
+        (_requestType == MAV_MISSION_TYPE_MISSION) ? _missionOpaqueId : 0
     );
 
     _mockLink->respondWithMavlinkMessage(responseMsg);
@@ -259,6 +265,7 @@ void MockLinkMissionItemHandler::_handleMissionCount(const mavlink_message_t &ms
     }
 
     if (_writeSequenceCount == 0) {
+        _missionChanged(_requestType);
         _sendAck(MAV_MISSION_ACCEPTED);
         return;
     }
@@ -279,6 +286,43 @@ void MockLinkMissionItemHandler::_handleMissionCount(const mavlink_message_t &ms
     _requestNextMissionItem(_writeSequenceIndex);
 }
 
+void MockLinkMissionItemHandler::_handleMissionWritePartialList(const mavlink_message_t &msg)
+{
+    mavlink_mission_write_partial_list_t partialList{};
+    mavlink_msg_mission_write_partial_list_decode(&msg, &partialList);
+    Q_ASSERT(partialList.target_system == _mockLink->vehicleId());
+
+    _requestType = static_cast<MAV_MISSION_TYPE>(partialList.mission_type);
+
+    qCDebug(MockLinkMissionItemHandlerLog) << "_handleMissionWritePartialList write sequence start_index:end_index" << partialList.start_index << partialList.end_index;
+
+    int itemCount = 0;
+    switch (_requestType) {
+    case MAV_MISSION_TYPE_MISSION:
+        itemCount = _missionItems.count();
+        break;
+    case MAV_MISSION_TYPE_FENCE:
+        itemCount = _fenceItems.count();
+        break;
+    case MAV_MISSION_TYPE_RALLY:
+        itemCount = _rallyItems.count();
+        break;
+    default:
+        break;
+    }
+
+    // Partial writes can only replace existing items
+    if ((partialList.start_index < 0) || (partialList.end_index < partialList.start_index) || (partialList.end_index >= itemCount)) {
+        _sendAck(MAV_MISSION_ERROR);
+        return;
+    }
+
+    _partialWriteCount++;
+    _writeSequenceIndex = partialList.start_index;
+    _writeSequenceCount = partialList.end_index + 1;
+    _requestNextMissionItem(_writeSequenceIndex);
+}
+
 void MockLinkMissionItemHandler::_requestNextMissionItem(int sequenceNumber)
 {
     qCDebug(MockLinkMissionItemHandlerLog) << "write sequence sequenceNumber:" << sequenceNumber << "_failureMode:" << _failureMode;
@@ -336,7 +380,7 @@ void MockLinkMissionItemHandler::_sendAck(MAV_MISSION_RESULT ackType) const
         MAVLinkProtocol::getComponentId(),
         ackType,
         _requestType,
-        0
+        (_requestType == MAV_MISSION_TYPE_MISSION) ? _missionOpaqueId : 0
     );
 
     _mockLink->respondWithMavlinkMessage(message);
@@ -387,6 +431,8 @@ void MockLinkMissionItemHandler::_handleMissionItem(const mavlink_message_t &msg
 
         if (_failureMode == FailWriteFinalAckErrorAck) {
             ack = MAV_MISSION_ERROR;
+        } else {
+            _missionChanged(missionType);
         }
 
         _sendAck(ack);
@@ -416,6 +462,42 @@ void MockLinkMissionItemHandler::sendUnexpectedMissionRequest()
     Q_ASSERT(false);
 }
 
+void MockLinkMissionItemHandler::_missionChanged(MAV_MISSION_TYPE missionType)
+{
+    if (missionType == MAV_MISSION_TYPE_MISSION) {
+        _missionOpaqueId++;
+    }
+}
+
+void MockLinkMissionItemHandler::_sendMissionCurrent() const
+{
+    mavlink_mission_current_t missionCurrent{};
+    missionCurrent.seq = 0;
+    missionCurrent.total = static_cast<uint16_t>(_missionItems.count());
+    missionCurrent.mission_id = _missionOpaqueId;
+
+    mavlink_message_t message{};
+    (void) mavlink_msg_mission_current_encode_chan(
+        _mockLink->vehicleId(),
+        MAV_COMP_ID_AUTOPILOT1,
+        _mockLink->mavlinkChannel(),
+        &message,
+        &missionCurrent
+    );
+
+    _mockLink->respondWithMavlinkMessage(message);
+}
+
+void MockLinkMissionItemHandler::changeMissionExternally()
+{
+    if (!_missionItems.isEmpty()) {
+        mavlink_mission_item_int_t &missionItem = _missionItems.last();
+        missionItem.z += 25;
+    }
+    _missionChanged(MAV_MISSION_TYPE_MISSION);
+    _sendMissionCurrent();
+}
+
 void MockLinkMissionItemHandler::setFailureMode(FailureMode_t failureMode, MAV_MISSION_RESULT failureAckResult)
 {
     _failureMode = failureMode;
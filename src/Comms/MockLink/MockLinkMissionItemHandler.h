@@ -69,6 +69,12 @@ class MockLinkMissionItemHandler : public QObject
 
     void setSendHomePositionOnEmptyList(bool sendHomePositionOnEmptyList) { _sendHomePositionOnEmptyList = sendHomePositionOnEmptyList; }
 
+    /// @return Number of MISSION_WRITE_PARTIAL_LIST sequences started
+    int partialWriteCount() const { return _partialWriteCount; }
+
+    /// Simulates another GCS changing the mission: alters an item, updates the opaque_id and announces it in MISSION_CURRENT
+    void changeMissionExternally();
+
 private slots:
     void _missionItemResponseTimeout();
 
@@ -77,15 +83,20 @@ private slots:
     void _handleMissionRequest(const mavlink_message_t &msg);
     void _handleMissionItem(const mavlink_message_t &msg);
     void _handleMissionCount(const mavlink_message_t &msg);
+    void _handleMissionWritePartialList(const mavlink_message_t &msg);
     void _handleMissionClearAll(const mavlink_message_t &msg);
     void _requestNextMissionItem(int sequenceNumber);
     void _sendAck(MAV_MISSION_RESULT ackType) const;
+    void _sendMissionCurrent() const;
+    void _missionChanged(MAV_MISSION_TYPE missionType);
     void _startMissionItemResponseTimer();
 
     MockLink *_mockLink = nullptr;
 
     int _writeSequenceCount = 0;    ///< Numbers of items about to be written
     int _writeSequenceIndex = 0;    ///< Current index being reqested
+    int _partialWriteCount = 0;     ///< Number of partial write sequences started
+    uint32_t _missionOpaqueId = 1;  ///< opaque_id of the current mission, changes whenever the mission does
 
     typedef QMap<uint16_t, mavlink_mission_item_int_t> MissionItemList_t;
 
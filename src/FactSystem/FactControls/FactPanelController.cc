@@ -56,10 +56,14 @@ bool FactPanelController::_allParametersExists(int componentId, const QStringLis
 
 Fact *FactPanelController::getParameterFact(int componentId, const QString &name, bool reportMissing) const
 {
-    if (_vehicle && _vehicle->parameterManager()->parameterExists(componentId, name)) {
-        Fact *const fact = _vehicle->parameterManager()->getParameter(componentId, name);
-        QQmlEngine::setObjectOwnership(fact, QQmlEngine::CppOwnership);
-        return fact;
+    if (_vehicle) {
+        // Single lookup instead of an exists check followed by a get
+        ParameterManager *const parameterManager = _vehicle->parameterManager();
+        Fact *const fact = parameterManager->parameter(parameterManager->parameterHandle(componentId, name));
+        if (fact) {
+            QQmlEngine::setObjectOwnership(fact, QQmlEngine::CppOwnership);
+            return fact;
+        }
     }
 
     if (reportMissing) {
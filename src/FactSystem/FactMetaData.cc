@@ -5,6 +5,8 @@
 #include "SettingsManager.h"
 #include "UnitsSettings.h"
 
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
 #include <QtCore/QtMath>
 
 QGC_LOGGING_CATEGORY(FactMetaDataLog, "FactSystem.FactMetaData")
@@ -1457,6 +1459,92 @@ QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonArray(const QJsonArr
     return metaDataMap;
 }
 
+namespace {
+    struct SharedMetaDataMap_t {
+        QMap<QString, FactMetaData*> metaDataMap;
+        int useCount = 0;
+    };
+
+    QMutex s_sharedMapsMutex;
+    QHash<QString /* jsonFilename + settingsGroup */, SharedMetaDataMap_t*> s_sharedMaps;
+
+    qsizetype _stringFootprint(const QString &string)
+    {
+        return string.capacity() * static_cast<qsizetype>(sizeof(QChar));
+    }
+
+    qsizetype _stringListFootprint(const QStringList &list)
+    {
+        qsizetype bytes = list.capacity() * static_cast<qsizetype>(sizeof(QString));
+        for (const QString &string : list) {
+            bytes += _stringFootprint(string);
+        }
+        return bytes;
+    }
+}
+
+const QMap<QString, FactMetaData*> &FactMetaData::sharedMapFromJsonFile(const QString &jsonFilename, const QString &settingsGroup)
+{
+    const QString key = jsonFilename + QLatin1Char('|') + settingsGroup;
+
+    QMutexLocker locker(&s_sharedMapsMutex);
+
+    SharedMetaDataMap_t *sharedMap = s_sharedMaps.value(key, nullptr);
+    if (!sharedMap) {
+        sharedMap = new SharedMetaDataMap_t;
+        sharedMap->metaDataMap = createMapFromJsonFile(jsonFilename, nullptr /* metaDataParent */);
+        s_sharedMaps[key] = sharedMap;
+        qCDebug(FactMetaDataLog) << "Created shared meta data map" << key << "count:" << sharedMap->metaDataMap.count();
+    }
+    sharedMap->useCount++;
+
+    return sharedMap->metaDataMap;
+}
+
+QStringList FactMetaData::sharedMapMemoryReport()
+{
+    QStringList report;
+
+    QMutexLocker locker(&s_sharedMapsMutex);
+
+    for (auto it = s_sharedMaps.constBegin(); it != s_sharedMaps.constEnd(); ++it) {
+        const SharedMetaDataMap_t *const sharedMap = it.value();
+
+        qsizetype perUserBytes = 0;
+        for (const FactMetaData *const metaData : sharedMap->metaDataMap) {
+            perUserBytes += metaData->approximateFootprint();
+        }
+
+        report.append(QStringLiteral("%1: %2 facts, %3 bytes per copy, %4 users, %5 bytes unshared vs %3 bytes shared")
+            .arg(it.key())
+            .arg(sharedMap->metaDataMap.count())
+            .arg(perUserBytes)
+            .arg(sharedMap->useCount)
+            .arg(perUserBytes * sharedMap->useCount));
+    }
+
+    return report;
+}
+
+qsizetype FactMetaData::approximateFootprint() const
+{
+    qsizetype bytes = sizeof(FactMetaData);
+
+    bytes += _stringListFootprint(_bitmaskStrings);
+    bytes += _bitmaskValues.capacity() * static_cast<qsizetype>(sizeof(QVariant));
+    bytes += _stringListFootprint(_enumStrings);
+    bytes += _enumValues.capacity() * static_cast<qsizetype>(sizeof(QVariant));
+    bytes += _stringFootprint(_category);
+    bytes += _stringFootprint(_group);
+    bytes += _stringFootprint(_longDescription);
+    bytes += _stringFootprint(_name);
+    bytes += _stringFootprint(_shortDescription);
+    bytes += _stringFootprint(_rawUnits);
+    bytes += _stringFootprint(_cookedUnits);
+
+    return bytes;
+}
+
 QVariant FactMetaData::cookedMax() const
 {
     // We have to be careful with cooked min/max. Running the raw values through the translator could flip min and max.
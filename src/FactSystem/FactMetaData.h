@@ -62,6 +62,19 @@ class FactMetaData : public QObject
 
     static FactMetaData *createFromJsonObject(const QJsonObject &json, const QMap<QString, QString> &defineMap, QObject *metaDataParent);
 
+    /// Returns a meta data map which is shared by every caller using the same json file and settings group. The map is
+    /// created on first use and lives for the lifetime of the application. Use this instead of createMapFromJsonFile for
+    /// objects which are instantiated many times (such as mission items) and never modify their meta data.
+    ///     @param settingsGroup: SettingsFact applies per-group overrides to meta data so it is part of the sharing key
+    static const QMap<QString, FactMetaData*> &sharedMapFromJsonFile(const QString &jsonFilename, const QString &settingsGroup = QString());
+
+    /// @return One line per shared meta data map showing the memory used by the shared map and the memory which
+    ///         would have been used if each user had created its own copy.
+    static QStringList sharedMapMemoryReport();
+
+    /// @return Approximate memory footprint of this object in bytes, including string and enum storage
+    qsizetype approximateFootprint() const;
+
     const FactMetaData &operator=(const FactMetaData &other);
 
     /// Converts from meters to the user specified horizontal distance unit
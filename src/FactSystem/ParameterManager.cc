@@ -15,9 +15,13 @@
 
 #include <QtCore/QEasingCurve>
 #include <QtCore/QFile>
+#include <QtCore/QRegularExpression>
 #include <QtCore/QStandardPaths>
+#include <QtCore/QTemporaryFile>
 #include <QtCore/QVariantAnimation>
 
+#include <algorithm>
+
 QGC_LOGGING_CATEGORY(ParameterManagerLog, "FactSystem.ParameterManager")
 QGC_LOGGING_CATEGORY(ParameterManagerVerbose1Log, "FactSystem.ParameterManager:verbose1")
 QGC_LOGGING_CATEGORY(ParameterManagerVerbose2Log, "FactSystem.ParameterManager:verbose2")
@@ -29,6 +33,7 @@ ParameterManager::ParameterManager(Vehicle *vehicle)
     , _logReplay(!vehicle->vehicleLinkManager()->primaryLink().expired() && vehicle->vehicleLinkManager()->primaryLink().lock()->isLogReplay())
     , _tryftp(vehicle->apmFirmware())
     , _disableAllRetries(_logReplay)
+    , _vehicleId(vehicle->id())
 {
     qCDebug(ParameterManagerLog) << this;
 
@@ -51,6 +56,23 @@ ParameterManager::ParameterManager(Vehicle *vehicle)
         (void) connect(&_waitingParamTimeoutTimer, &QTimer::timeout, this, &ParameterManager::_waitingParamTimeout);
     }
 
+    _cacheWriteTimer.setSingleShot(true);
+    _cacheWriteTimer.setInterval(kCacheWriteDelayMs);
+    (void) connect(&_cacheWriteTimer, &QTimer::timeout, this, &ParameterManager::_writePendingLocalParamCaches);
+
+    (void) connect(this, &ParameterManager::_paramSetSuccess, this, [this](int componentId, const QString &paramName, const QVariant &rawValue) {
+        _bulkWriteParamComplete(componentId, paramName, rawValue, true /* success */);
+    });
+    (void) connect(this, &ParameterManager::_paramSetFailure, this, [this](int componentId, const QString &paramName, const QVariant &rawValue) {
+        _bulkWriteParamComplete(componentId, paramName, rawValue, false /* success */);
+    });
+    (void) connect(this, &ParameterManager::_paramRequestReadFailure, this, [this](int componentId, const QString &paramName, int /* paramIndex */) {
+        const ParameterKey key(componentId, paramName);
+        if (_bulkWriteReadBackValues.contains(key)) {
+            _bulkWriteParamComplete(componentId, paramName, _bulkWriteReadBackValues.take(key), false /* success */);
+        }
+    });
+
     // Ensure the cache directory exists
     (void) QFileInfo(QSettings().fileName()).dir().mkdir("ParamCache");
 }
@@ -58,6 +80,9 @@ ParameterManager::ParameterManager(Vehicle *vehicle)
 ParameterManager::~ParameterManager()
 {
     qCDebug(ParameterManagerLog) << this;
+
+    // Don't lose changes made just before the vehicle went away, they are what make the next connect load from cache
+    _writePendingLocalParamCaches();
 }
 
 void ParameterManager::_updateProgressBar()
@@ -155,6 +180,13 @@ void ParameterManager::_handleParamValue(int componentId, const QString &paramet
         }
     }
 
+    if (!_initialLoadComplete && _staleCacheMap.contains(componentId)) {
+        const CacheMapName2ParamTypeVal &staleCache = _staleCacheMap[componentId];
+        if (!staleCache.contains(parameterName) || (staleCache[parameterName].second != parameterValue)) {
+            _staleCacheChangedCount++;
+        }
+    }
+
     _initialRequestTimeoutTimer.stop();
     _waitingParamTimeoutTimer.stop();
 
@@ -182,7 +214,10 @@ void ParameterManager::_handleParamValue(int componentId, const QString &paramet
     // Remove this parameter from the waiting lists
     if (_waitingReadParamIndexMap[componentId].contains(parameterIndex)) {
         _waitingReadParamIndexMap[componentId].remove(parameterIndex);
-        (void) _indexBatchQueue.removeOne(parameterIndex);
+        if (_indexBatchQueue.removeOne(parameterIndex)) {
+            // Link is keeping up with the re-requests, allow more of them in flight
+            _indexBatchWindow = qMin(_indexBatchWindow + 1, kIndexBatchWindowMax);
+        }
         _fillIndexBatchQueue(false /* waitingParamTimeout */);
     }
 
@@ -202,7 +237,7 @@ void ParameterManager::_handleParamValue(int componentId, const QString &paramet
         // More params to wait for, restart timer
         _waitingParamTimeoutTimer.start();
         qCDebug(ParameterManagerVerbose1Log) << _logVehiclePrefix(-1) << "Restarting _waitingParamTimeoutTimer: totalWaitingParamCount:" << totalWaitingParamCount;
-    } else if (!_mapCompId2FactMap.contains(_vehicle->defaultComponentId())) {
+    } else if (!_mapCompId2ParamHandleMap.contains(_vehicle->defaultComponentId())) {
         // Still waiting for parameters from default component
         qCDebug(ParameterManagerLog) << _logVehiclePrefix(-1) << "Restarting _waitingParamTimeoutTimer (still waiting for default component params)";
         _waitingParamTimeoutTimer.start();
@@ -212,25 +247,15 @@ void ParameterManager::_handleParamValue(int componentId, const QString &paramet
 
     _updateProgressBar();
 
-    Fact *fact = nullptr;
-    if (_mapCompId2FactMap.contains(componentId) && _mapCompId2FactMap[componentId].contains(parameterName)) {
-        fact = _mapCompId2FactMap[componentId][parameterName];
-    } else {
-        qCDebug(ParameterManagerVerbose1Log) << _logVehiclePrefix(componentId) << "Adding new fact" << parameterName;
-
-        fact = new Fact(componentId, parameterName, mavTypeToFactType(mavParamType), this);
-        FactMetaData *const factMetaData = _vehicle->compInfoManager()->compInfoParam(componentId)->factMetaDataForName(parameterName, fact->type());
-        fact->setMetaData(factMetaData);
-
-        _mapCompId2FactMap[componentId][parameterName] = fact;
-
-        // We need to know when the fact value changes so we can update the vehicle
-        (void) connect(fact, &Fact::containerRawValueChanged, this, &ParameterManager::_factRawValueUpdated);
-
-        emit factAdded(componentId, fact);
+    ParameterHandle handle = _findParam(componentId, parameterName);
+    if (handle == invalidParameterHandle) {
+        qCDebug(ParameterManagerVerbose1Log) << _logVehiclePrefix(componentId) << "Adding new parameter" << parameterName;
+        handle = _addParam(componentId, parameterName, mavTypeToFactType(mavParamType), parameterValue);
     }
 
-    fact->containerSetRawValue(parameterValue);
+    const bool valueChanged = _setParamRawValue(handle, parameterValue);
+
+    _bulkWriteReadBack(componentId, parameterName, parameterValue);
 
     // Update param cache. The param cache is only used on PX4 Firmware since ArduPilot and Solo have volatile params
     // which invalidate the cache. The Solo also streams param updates in flight for things like gimbal values
@@ -239,6 +264,9 @@ void ParameterManager::_handleParamValue(int componentId, const QString &paramet
         if (_prevWaitingReadParamIndexCount != 0 && readWaitingParamCount == 0) {
             // All reads just finished, update the cache
             _writeLocalParamCache(_vehicle->id(), componentId);
+        } else if (_initialLoadComplete && valueChanged && !_paramMetaData(handle)->volatileValue()) {
+            // Keep the cache in sync with the vehicle so the hash check still matches on the next connect
+            _scheduleLocalParamCacheWrite(componentId);
         }
     }
 
@@ -259,7 +287,7 @@ QString ParameterManager::_vehicleAndComponentString(int componentId) const
 
     // IF we have parameters for multiple components include the component id for disambiguation
     QString componentIdStr;
-    if (_mapCompId2FactMap.keys().count() > 1) {
+    if (_mapCompId2ParamHandleMap.count() > 1) {
         componentIdStr = QStringLiteral("comp: %1").arg(componentId);
     }
 
@@ -274,7 +302,7 @@ QString ParameterManager::_vehicleAndComponentString(int componentId) const
     }
 }
 
-void ParameterManager::_mavlinkParamSet(int componentId, const QString &paramName, FactMetaData::ValueType_t valueType, const QVariant &rawValue)
+void ParameterManager::_mavlinkParamSet(int componentId, const QString &paramName, FactMetaData::ValueType_t valueType, const QVariant &rawValue, bool notifyFailure)
 {
     auto paramSetEncoder = [this, componentId, paramName, valueType, rawValue](uint8_t systemId, uint8_t channel, mavlink_message_t *message) -> void {
         const MAV_PARAM_TYPE paramType = factTypeToMavType(valueType);
@@ -367,13 +395,13 @@ void ParameterManager::_mavlinkParamSet(int componentId, const QString &paramNam
         refreshParameter(componentId, paramName);
     });
     auto userNotifyState = new ShowAppMessageState(stateMachine, QStringLiteral("Parameter write failed: param: %1 %2").arg(paramName).arg(_vehicleAndComponentString(componentId)));
-    auto logSuccessState = new FunctionState(QStringLiteral("ParameterManager log success"), stateMachine, [this, componentId, paramName]() {
+    auto logSuccessState = new FunctionState(QStringLiteral("ParameterManager log success"), stateMachine, [this, componentId, paramName, rawValue]() {
         qCDebug(ParameterManagerLog) << "Parameter write succeeded: param:" << paramName << _vehicleAndComponentString(componentId);
-        emit _paramSetSuccess(componentId, paramName);
+        emit _paramSetSuccess(componentId, paramName, rawValue);
     });
-    auto logFailureState = new FunctionState(QStringLiteral("ParameterManager log failure"), stateMachine, [this, componentId, paramName]() {
+    auto logFailureState = new FunctionState(QStringLiteral("ParameterManager log failure"), stateMachine, [this, componentId, paramName, rawValue]() {
         qCDebug(ParameterManagerLog) << "Parameter write failed: param:" << paramName << _vehicleAndComponentString(componentId);
-        emit _paramSetFailure(componentId, paramName);
+        emit _paramSetFailure(componentId, paramName, rawValue);
     });
     auto finalState = new QGCFinalState(stateMachine);
 
@@ -393,7 +421,11 @@ void ParameterManager::_mavlinkParamSet(int componentId, const QString &paramNam
     sendParamSetState->addThisTransition(&QGCState::error, logFailureState); // Error is signaled after retries exhausted or internal error
 
     // Error state branching transitions
-    logFailureState->addThisTransition  (&QGCState::advance, userNotifyState);
+    if (notifyFailure) {
+        logFailureState->addThisTransition  (&QGCState::advance, userNotifyState);
+    } else {
+        logFailureState->addThisTransition  (&QGCState::advance, paramRefreshState);
+    }
     userNotifyState->addThisTransition  (&QGCState::advance, paramRefreshState);
     paramRefreshState->addThisTransition(&QGCState::advance, finalState);
 
@@ -494,6 +526,7 @@ void ParameterManager::_ftpDownloadComplete(const QString &fileName, const QStri
         qCDebug(ParameterManagerLog) << "ParameterManager::_ftpDownloadComplete : Parameter file received:" << fileName;
         if (_parseParamFile(fileName)) {
             qCDebug(ParameterManagerLog) << "ParameterManager::_ftpDownloadComplete : Parsed!";
+            _ftpParamLoadSucceeded = true;
             return;
         } else {
             qCDebug(ParameterManagerLog) << "ParameterManager::_ftpDownloadComplete : Error in parameter file";
@@ -558,6 +591,9 @@ void ParameterManager::refreshAllParameters(uint8_t componentId)
 
     if (!_initialLoadComplete) {
         _initialRequestTimeoutTimer.start();
+        if (!_loadTimer.isValid()) {
+            _loadTimer.start();
+        }
     }
 
     if (_tryftp && ((componentId == MAV_COMP_ID_ALL) || (componentId == MAV_COMP_ID_AUTOPILOT1))) {
@@ -627,7 +663,7 @@ void ParameterManager::refreshParametersPrefix(int componentId, const QString &n
     componentId = _actualComponentId(componentId);
     qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "refreshParametersPrefix - name:" << namePrefix << ")";
 
-    for (const QString &paramName: _mapCompId2FactMap[componentId].keys()) {
+    for (const QString &paramName: _mapCompId2ParamHandleMap[componentId].keys()) {
         if (paramName.startsWith(namePrefix)) {
             refreshParameter(componentId, paramName);
         }
@@ -636,14 +672,7 @@ void ParameterManager::refreshParametersPrefix(int componentId, const QString &n
 
 bool ParameterManager::parameterExists(int componentId, const QString &paramName) const
 {
-    bool ret = false;
-
-    componentId = _actualComponentId(componentId);
-    if (_mapCompId2FactMap.contains(componentId)) {
-        ret = _mapCompId2FactMap[componentId].contains(_remapParamNameToVersion(paramName));
-    }
-
-    return ret;
+    return _factHandleHash.contains(ParameterKey(_actualComponentId(componentId), _remapParamNameToVersion(paramName)));
 }
 
 Fact *ParameterManager::getParameter(int componentId, const QString &paramName)
@@ -651,25 +680,103 @@ Fact *ParameterManager::getParameter(int componentId, const QString &paramName)
     componentId = _actualComponentId(componentId);
 
     const QString mappedParamName = _remapParamNameToVersion(paramName);
-    if (!_mapCompId2FactMap.contains(componentId) || !_mapCompId2FactMap[componentId].contains(mappedParamName)) {
+    Fact *const fact = parameter(_findParam(componentId, mappedParamName));
+    if (!fact) {
         qgcApp()->reportMissingParameter(componentId, mappedParamName);
         return &_defaultFact;
     }
 
-    return _mapCompId2FactMap[componentId][mappedParamName];
+    return fact;
 }
 
-QStringList ParameterManager::parameterNames(int componentId) const
+ParameterManager::ParameterHandle ParameterManager::parameterHandle(int componentId, const QString &paramName) const
+{
+    return _factHandleHash.value(ParameterKey(_actualComponentId(componentId), _remapParamNameToVersion(paramName)), invalidParameterHandle);
+}
+
+Fact *ParameterManager::parameter(ParameterHandle handle)
 {
-    QStringList names;
+    if ((handle < 0) || (handle >= _params.count())) {
+        return nullptr;
+    }
+
+    ParamEntry &entry = _params[handle];
+    if (!entry.fact) {
+        // First access, create the Fact from the compact storage
+        qCDebug(ParameterManagerVerbose1Log) << _logVehiclePrefix(entry.componentId) << "Creating fact" << entry.name;
 
-    const int compId = _actualComponentId(componentId);
-    const QMap<QString, Fact*> &factMap = _mapCompId2FactMap[compId];
-    for (const QString &paramName: factMap.keys()) {
-        names << paramName;
+        Fact *const fact = new Fact(entry.componentId, entry.name, entry.type, this);
+        fact->setMetaData(_paramMetaData(handle));
+        fact->containerSetRawValue(entry.rawValue);
+        entry.rawValue.clear();
+        entry.fact = fact;
+
+        // We need to know when the fact value changes so we can update the vehicle
+        (void) connect(fact, &Fact::containerRawValueChanged, this, &ParameterManager::_factRawValueUpdated);
+    }
+
+    return entry.fact;
+}
+
+int ParameterManager::factCount() const
+{
+    int count = 0;
+    for (const ParamEntry &entry: _params) {
+        if (entry.fact) {
+            count++;
+        }
     }
 
-    return names;
+    return count;
+}
+
+ParameterManager::ParameterHandle ParameterManager::_findParam(int componentId, const QString &paramName) const
+{
+    return _factHandleHash.value(ParameterKey(componentId, paramName), invalidParameterHandle);
+}
+
+ParameterManager::ParameterHandle ParameterManager::_addParam(int componentId, const QString &paramName, FactMetaData::ValueType_t type, const QVariant &rawValue)
+{
+    // Handles are never reused so callers can hold on to them for the lifetime of the manager
+    const ParameterHandle handle = static_cast<ParameterHandle>(_params.count());
+    _params.append({ componentId, paramName, type, rawValue, nullptr });
+    _mapCompId2ParamHandleMap[componentId][paramName] = handle;
+    _factHandleHash[ParameterKey(componentId, paramName)] = handle;
+
+    emit parameterAdded(componentId, handle);
+
+    return handle;
+}
+
+bool ParameterManager::_setParamRawValue(ParameterHandle handle, const QVariant &rawValue)
+{
+    ParamEntry &entry = _params[handle];
+    if (entry.fact) {
+        const bool changed = (entry.fact->rawValue() != rawValue);
+        entry.fact->containerSetRawValue(rawValue);
+        return changed;
+    }
+
+    const bool changed = (entry.rawValue != rawValue);
+    entry.rawValue = rawValue;
+    return changed;
+}
+
+QVariant ParameterManager::_paramRawValue(ParameterHandle handle) const
+{
+    const ParamEntry &entry = _params[handle];
+    return (entry.fact ? entry.fact->rawValue() : entry.rawValue);
+}
+
+FactMetaData *ParameterManager::_paramMetaData(ParameterHandle handle) const
+{
+    const ParamEntry &entry = _params[handle];
+    return _vehicle->compInfoManager()->compInfoParam(entry.componentId)->factMetaDataForName(entry.name, entry.type);
+}
+
+QStringList ParameterManager::parameterNames(int componentId) const
+{
+    return _mapCompId2ParamHandleMap.value(_actualComponentId(componentId)).keys();
 }
 
 bool ParameterManager::_fillIndexBatchQueue(bool waitingParamTimeout)
@@ -678,8 +785,6 @@ bool ParameterManager::_fillIndexBatchQueue(bool waitingParamTimeout)
         return false;
     }
 
-    constexpr int maxBatchSize = 10;
-
     if (waitingParamTimeout) {
         // We timed out, clear the queue and try again
         qCDebug(ParameterManagerLog) << "Refilling index based batch queue due to timeout";
@@ -700,7 +805,7 @@ bool ParameterManager::_fillIndexBatchQueue(bool waitingParamTimeout)
                 continue;
             }
 
-            if (_indexBatchQueue.count() > maxBatchSize) {
+            if (_indexBatchQueue.count() >= _indexBatchWindow) {
                 break;
             }
 
@@ -713,6 +818,7 @@ bool ParameterManager::_fillIndexBatchQueue(bool waitingParamTimeout)
             } else {
                 // Retry again
                 _indexBatchQueue.append(paramIndex);
+                _indexReRequestCount++;
                 _mavlinkParamRequestRead(componentId, QString(), paramIndex, false /* notifyFailure */);
                 qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Read re-request for (paramIndex:" << paramIndex << "retryCount:" << _waitingReadParamIndexMap[componentId][paramIndex] << ")";
             }
@@ -731,11 +837,15 @@ void ParameterManager::_waitingParamTimeout()
     qCDebug(ParameterManagerLog) << _logVehiclePrefix(-1) << "_waitingParamTimeout";
 
     // Now that we have timed out for possibly the first time we can activate the index batch queue
+    if (_indexBatchQueueActive) {
+        // The link could not keep up with the re-requests in flight, back off
+        _indexBatchWindow = qMax(_indexBatchWindow / 2, kIndexBatchWindowMin);
+    }
     _indexBatchQueueActive = true;
 
     // First check for any missing parameters from the initial index based load
     bool paramsRequested = _fillIndexBatchQueue(true /* waitingParamTimeout */);
-    if (!paramsRequested && !_waitingForDefaultComponent && !_mapCompId2FactMap.contains(_vehicle->defaultComponentId())) {
+    if (!paramsRequested && !_waitingForDefaultComponent && !_mapCompId2ParamHandleMap.contains(_vehicle->defaultComponentId())) {
         // Initial load is complete but we still don't have any default component params. Wait one more cycle to see if the
         // any show up.
         qCDebug(ParameterManagerLog) << _logVehiclePrefix(-1) << "Restarting _waitingParamTimeoutTimer - still don't have default component params" << _vehicle->defaultComponentId();
@@ -852,9 +962,9 @@ void ParameterManager::_writeLocalParamCache(int vehicleId, int componentId)
 {
     CacheMapName2ParamTypeVal cacheMap;
 
-    for (const QString &paramName: _mapCompId2FactMap[componentId].keys()) {
-        const Fact *const fact = _mapCompId2FactMap[componentId][paramName];
-        cacheMap[paramName] = ParamTypeVal(fact->type(), fact->rawValue());
+    const QMap<QString, ParameterHandle> &handleMap = _mapCompId2ParamHandleMap[componentId];
+    for (auto it = handleMap.constBegin(); it != handleMap.constEnd(); it++) {
+        cacheMap[it.key()] = ParamTypeVal(_params[it.value()].type, _paramRawValue(it.value()));
     }
 
     QFile cacheFile(parameterCacheFile(vehicleId, componentId));
@@ -864,6 +974,29 @@ void ParameterManager::_writeLocalParamCache(int vehicleId, int componentId)
     } else {
         qCWarning(ParameterManagerLog) << "Failed to open cache file for writing" << cacheFile.fileName();
     }
+
+    (void) _pendingCacheWriteComponentIds.removeOne(componentId);
+}
+
+void ParameterManager::_scheduleLocalParamCacheWrite(int componentId)
+{
+    if (!_pendingCacheWriteComponentIds.contains(componentId)) {
+        _pendingCacheWriteComponentIds.append(componentId);
+    }
+
+    // Restart so a burst of changes results in a single write
+    _cacheWriteTimer.start();
+}
+
+void ParameterManager::_writePendingLocalParamCaches()
+{
+    _cacheWriteTimer.stop();
+
+    const QList<int> componentIds = _pendingCacheWriteComponentIds;
+    for (const int componentId: componentIds) {
+        qCDebug(ParameterManagerLog) << "Updating parameter cache after parameter change - componentId:" << componentId;
+        _writeLocalParamCache(_vehicleId, componentId);
+    }
 }
 
 QDir ParameterManager::parameterCacheDir()
@@ -915,6 +1048,9 @@ void ParameterManager::_tryCacheHashLoad(int vehicleId, int componentId, const Q
     if (crc32_value == hashValue.toUInt()) {
         qCInfo(ParameterManagerLog) << "Parameters loaded from cache" << qPrintable(QFileInfo(cacheFile).absoluteFilePath());
 
+        _loadedFromCache = true;
+        (void) _staleCacheMap.remove(componentId);
+
         const int count = cacheMap.count();
         int index = 0;
         for (const QString &name: cacheMap.keys()) {
@@ -967,6 +1103,7 @@ void ParameterManager::_tryCacheHashLoad(int vehicleId, int componentId, const Q
         ani->start(QAbstractAnimation::DeleteWhenStopped);
     } else {
         qCInfo(ParameterManagerLog) << "Parameters cache match failed" << qPrintable(QFileInfo(cacheFile).absoluteFilePath());
+        _staleCacheMap[componentId] = cacheMap;
         if (ParameterManagerDebugCacheFailureLog().isDebugEnabled()) {
             _debugCacheCRC[componentId] = true;
             _debugCacheMap[componentId] = cacheMap;
@@ -982,6 +1119,7 @@ QString ParameterManager::readParametersFromStream(QTextStream &stream)
 {
     QString missingErrors;
     QString typeErrors;
+    QList<ParamSetRequest> requests;
 
     while (!stream.atEnd()) {
         const QString line = stream.readLine();
@@ -1015,12 +1153,26 @@ QString ParameterManager::readParametersFromStream(QTextStream &stream)
                     continue;
                 }
 
+                QVariant typedValue = valStr;
+                QString convertError;
+                if (fact->metaData() && !fact->metaData()->convertAndValidateRaw(valStr, true /* convertOnly */, typedValue, convertError)) {
+                    const QString error = QStringLiteral("%1:%2 ").arg(componentId).arg(paramName);
+                    typeErrors += error;
+                    qCDebug(ParameterManagerLog) << "Skipped due to conversion failure:" << error << convertError;
+                    continue;
+                }
+                if (typedValue == fact->rawValue()) {
+                    continue;
+                }
+
                 qCDebug(ParameterManagerLog) << "Updating parameter" << componentId << paramName << valStr;
-                fact->setRawValue(valStr);
+                requests.append({ fact->componentId(), fact->name(), fact->type(), typedValue });
             }
         }
     }
 
+    writeParameters(requests);
+
     QString errors;
 
     if (!missingErrors.isEmpty()) {
@@ -1051,20 +1203,48 @@ void ParameterManager::writeParametersToStream(QTextStream &stream) const
     stream << "#\n";
     stream << "# Vehicle-Id Component-Id Name Value Type\n";
 
-    for (const int componentId: _mapCompId2FactMap.keys()) {
-        for (const QString &paramName: _mapCompId2FactMap[componentId].keys()) {
-            const Fact *const fact = _mapCompId2FactMap[componentId][paramName];
-            if (fact) {
-                stream << _vehicle->id() << "\t" << componentId << "\t" << paramName << "\t" << fact->rawValueStringFullPrecision() << "\t" << QStringLiteral("%1").arg(factTypeToMavType(fact->type())) << "\n";
-            } else {
-                qCWarning(ParameterManagerLog) << "Internal error: missing fact";
-            }
+    for (const int componentId: _mapCompId2ParamHandleMap.keys()) {
+        const QMap<QString, ParameterHandle> &handleMap = _mapCompId2ParamHandleMap[componentId];
+        for (auto it = handleMap.constBegin(); it != handleMap.constEnd(); it++) {
+            // Written from the raw entries so saving does not create Facts for parameters nobody looked at
+            const ParamEntry &entry = _params[it.value()];
+            stream << _vehicle->id() << "\t" << componentId << "\t" << it.key() << "\t" << _rawValueStringFullPrecision(entry.type, _paramRawValue(it.value())) << "\t" << QStringLiteral("%1").arg(factTypeToMavType(entry.type)) << "\n";
         }
     }
 
     stream.flush();
 }
 
+/// Same formatting as Fact::rawValueStringFullPrecision, without needing a Fact
+QString ParameterManager::_rawValueStringFullPrecision(FactMetaData::ValueType_t type, const QVariant &rawValue)
+{
+    constexpr int decimalPlaces = 18;
+
+    QString valueString;
+    switch (type) {
+    case FactMetaData::valueTypeFloat:
+    case FactMetaData::valueTypeDouble:
+    {
+        const double dValue = (type == FactMetaData::valueTypeFloat) ? static_cast<double>(rawValue.toFloat()) : rawValue.toDouble();
+        if (qIsNaN(dValue)) {
+            valueString = QStringLiteral("–.") + QString(decimalPlaces, QChar(u'–'));
+        } else {
+            valueString = QStringLiteral("%1").arg(dValue, 0, 'f', decimalPlaces);
+            static const QRegularExpression reNegativeZero(QStringLiteral("^-0\\.0+$"));
+            if (reNegativeZero.match(valueString).hasMatch()) {
+                valueString = valueString.mid(1);
+            }
+        }
+        break;
+    }
+    default:
+        valueString = rawValue.toString();
+        break;
+    }
+
+    return valueString;
+}
+
 MAV_PARAM_TYPE ParameterManager::factTypeToMavType(FactMetaData::ValueType_t factType)
 {
     switch (factType) {
@@ -1134,7 +1314,7 @@ void ParameterManager::_checkInitialLoadComplete()
         }
     }
 
-    if (!_mapCompId2FactMap.contains(_vehicle->defaultComponentId())) {
+    if (!_mapCompId2ParamHandleMap.contains(_vehicle->defaultComponentId())) {
         // No default component params yet, not done yet
         return;
     }
@@ -1156,6 +1336,15 @@ void ParameterManager::_checkInitialLoadComplete()
 
     qCDebug(ParameterManagerLog) << _logVehiclePrefix(-1) << "Initial load complete";
 
+    _timeToReadyMs = _loadTimer.isValid() ? _loadTimer.elapsed() : 0;
+    qCInfo(ParameterManagerLog) << _logVehiclePrefix(-1) << "Parameters ready -"
+                                << "timeToReadyMs:" << _timeToReadyMs
+                                << "count:" << _totalParamCount
+                                << "fromCache:" << _loadedFromCache
+                                << "indexReRequests:" << _indexReRequestCount
+                                << "changedSinceStaleCache:" << (_staleCacheMap.isEmpty() ? -1 : _staleCacheChangedCount);
+    _staleCacheMap.clear();
+
     // Check for index based load failures
     QString indexList;
     bool initialLoadFailures = false;
@@ -1313,12 +1502,7 @@ void ParameterManager::_loadOfflineEditingParams()
             break;
         }
 
-        Fact *const fact = new Fact(defaultComponentId, paramName, mavTypeToFactType(paramType), this);
-
-        FactMetaData *const factMetaData = _vehicle->compInfoManager()->compInfoParam(defaultComponentId)->factMetaDataForName(paramName, fact->type());
-        fact->setMetaData(factMetaData);
-
-        _mapCompId2FactMap[defaultComponentId][paramName] = fact;
+        (void) _addParam(defaultComponentId, paramName, mavTypeToFactType(paramType), paramValue);
     }
 
     _parametersReady = true;
@@ -1539,24 +1723,13 @@ bool ParameterManager::_parseParamFile(const QString& filename)
                                                     (ptype == AP_PARAM_INT32) ? FactMetaData::valueTypeInt32 :
                                                     FactMetaData::valueTypeFloat);
 
-        Fact *fact = nullptr;
-        if (_mapCompId2FactMap.contains(componentId) && _mapCompId2FactMap[componentId].contains(parameterName)) {
-            fact = _mapCompId2FactMap[componentId][parameterName];
+        const ParameterHandle handle = _findParam(componentId, parameterName);
+        if (handle == invalidParameterHandle) {
+            qCDebug(ParameterManagerVerbose1Log) << _logVehiclePrefix(componentId) << "Adding new parameter" << parameterName;
+            (void) _addParam(componentId, parameterName, factType, parameterValue);
         } else {
-            qCDebug(ParameterManagerVerbose1Log) << _logVehiclePrefix(componentId) << "Adding new fact" << parameterName;
-
-            fact = new Fact(componentId, parameterName, factType, this);
-            FactMetaData *const factMetaData = _vehicle->compInfoManager()->compInfoParam(componentId)->factMetaDataForName(parameterName, fact->type());
-            fact->setMetaData(factMetaData);
-
-            _mapCompId2FactMap[componentId][parameterName] = fact;
-
-            // We need to know when the fact value changes so we can update the vehicle
-            (void) connect(fact, &Fact::containerRawValueChanged, this, &ParameterManager::_factRawValueUpdated);
-
-            emit factAdded(componentId, fact);
+            (void) _setParamRawValue(handle, parameterValue);
         }
-        fact->containerSetRawValue(parameterValue);
     }
 
 Success:
@@ -1574,6 +1747,274 @@ bool ParameterManager::_parseParamFile(const QString& filename)
     return false;
 }
 
+void ParameterManager::writeParameters(const QList<ParamSetRequest> &requests)
+{
+    if (requests.isEmpty()) {
+        return;
+    }
+
+    qCDebug(ParameterManagerLog) << _logVehiclePrefix(-1) << "writeParameters count:" << requests.count();
+
+    if (_bulkWriteTotal == 0) {
+        // Bulk write counts as a single pending write until it is complete
+        _incrementPendingWriteCount();
+        _bulkWriteFailures.clear();
+        _bulkWriteCompleted = 0;
+    }
+    _bulkWriteTotal += requests.count();
+
+    QList<ParamSetRequest> ftpRequests;
+    for (const ParamSetRequest &request: requests) {
+        // Show the new values right away, the same as a single Fact edit does. Failed writes are refreshed from the vehicle.
+        const ParameterHandle handle = _findParam(request.componentId, request.name);
+        if (handle != invalidParameterHandle) {
+            (void) _setParamRawValue(handle, request.rawValue);
+        }
+
+        if (_ftpParamLoadSucceeded && _bulkWriteFtpRequests.isEmpty() && (request.componentId == MAV_COMP_ID_AUTOPILOT1)) {
+            ftpRequests.append(request);
+        } else {
+            _bulkWriteQueue.append(request);
+        }
+    }
+
+    if (!ftpRequests.isEmpty() && !_bulkWriteFtpUpload(ftpRequests)) {
+        _bulkWriteQueue.append(ftpRequests);
+    }
+
+    emit bulkWriteProgressChanged(_bulkWriteCompleted, _bulkWriteTotal);
+    _bulkWriteSendNext();
+}
+
+void ParameterManager::_bulkWriteSendNext()
+{
+    while (_bulkWriteOutstanding.count() < kParamSetWindowSize) {
+        if (!_bulkWriteQueue.isEmpty()) {
+            const ParamSetRequest request = _bulkWriteQueue.takeFirst();
+            _bulkWriteOutstanding.append(request);
+            _mavlinkParamSet(request.componentId, request.name, request.valueType, request.rawValue, false /* notifyFailure */);
+        } else if (!_bulkWriteReadBackQueue.isEmpty()) {
+            const ParamSetRequest request = _bulkWriteReadBackQueue.takeFirst();
+            _bulkWriteOutstanding.append(request);
+            _bulkWriteReadBackValues[ParameterKey(request.componentId, request.name)] = request.rawValue;
+            _mavlinkParamRequestRead(request.componentId, request.name, -1, false /* notifyFailure */);
+        } else {
+            break;
+        }
+    }
+}
+
+void ParameterManager::_bulkWriteParamComplete(int componentId, const QString &paramName, const QVariant &rawValue, bool success)
+{
+    // A write for the same parameter outside of the bulk write, with a different value, must not complete the bulk write
+    const auto outstanding = std::find_if(_bulkWriteOutstanding.cbegin(), _bulkWriteOutstanding.cend(), [&](const ParamSetRequest &request) {
+        if ((request.componentId != componentId) || (request.name != paramName) || (request.rawValue.typeId() != rawValue.typeId())) {
+            return false;
+        }
+        if (rawValue.typeId() == QMetaType::Float) {
+            // Float comparison must be fuzzy
+            return QGC::fuzzyCompare(request.rawValue.toFloat(), rawValue.toFloat());
+        }
+        return request.rawValue == rawValue;
+    });
+    if (outstanding == _bulkWriteOutstanding.cend()) {
+        // Not part of a bulk write
+        return;
+    }
+    (void) _bulkWriteOutstanding.erase(outstanding);
+
+    _bulkWriteCompleted++;
+    if (!success) {
+        _bulkWriteFailures.append(paramName);
+    }
+
+    _setLoadProgress(static_cast<double>(_bulkWriteCompleted) / static_cast<double>(_bulkWriteTotal));
+    emit bulkWriteProgressChanged(_bulkWriteCompleted, _bulkWriteTotal);
+
+    _bulkWriteSendNext();
+
+    if (_bulkWriteOutstanding.isEmpty() && _bulkWriteQueue.isEmpty() && _bulkWriteReadBackQueue.isEmpty() && _bulkWriteFtpRequests.isEmpty()) {
+        qCDebug(ParameterManagerLog) << _logVehiclePrefix(-1) << "Bulk write complete - count:" << _bulkWriteTotal << "failures:" << _bulkWriteFailures.count();
+
+        if (!_bulkWriteFailures.isEmpty()) {
+            qgcApp()->showAppMessage(tr("%1 of %2 parameter writes failed: %3").arg(_bulkWriteFailures.count()).arg(_bulkWriteTotal).arg(_bulkWriteFailures.join(QStringLiteral(", "))));
+        }
+
+        const QStringList failures = _bulkWriteFailures;
+        _bulkWriteTotal = 0;
+        _bulkWriteCompleted = 0;
+        _bulkWriteFailures.clear();
+        _setLoadProgress(0);
+        _decrementPendingWriteCount();
+
+        emit bulkWriteComplete(failures);
+    }
+}
+
+bool ParameterManager::_bulkWriteFtpUpload(const QList<ParamSetRequest> &requests)
+{
+    // Unique name since several vehicles, or several instances of QGC, can be uploading at the same time
+    QTemporaryFile *const uploadFile = new QTemporaryFile(QDir(QStandardPaths::writableLocation(QStandardPaths::TempLocation)).filePath(QStringLiteral("QGCParamUpload-XXXXXX.pck")), this);
+    if (!uploadFile->open()) {
+        qCWarning(ParameterManagerLog) << "Unable to create parameter upload file:" << uploadFile->errorString();
+        delete uploadFile;
+        return false;
+    }
+    const QString fileName = uploadFile->fileName();
+    uploadFile->close();
+
+    if (!_writeParamFile(fileName, requests)) {
+        delete uploadFile;
+        return false;
+    }
+
+    FTPManager *const ftpManager = _vehicle->ftpManager();
+    (void) connect(ftpManager, &FTPManager::uploadComplete, this, &ParameterManager::_bulkWriteFtpUploadComplete);
+    if (!ftpManager->upload(MAV_COMP_ID_AUTOPILOT1, QStringLiteral("@PARAM/param.pck"), fileName)) {
+        qCDebug(ParameterManagerLog) << "FTPManager::upload returned failure, falling back to PARAM_SET";
+        (void) disconnect(ftpManager, &FTPManager::uploadComplete, this, &ParameterManager::_bulkWriteFtpUploadComplete);
+        delete uploadFile;
+        return false;
+    }
+
+    qCDebug(ParameterManagerLog) << _logVehiclePrefix(MAV_COMP_ID_AUTOPILOT1) << "Uploading parameter file - count:" << requests.count();
+    _bulkWriteFtpRequests = requests;
+    _bulkWriteFtpFile = uploadFile;
+    return true;
+}
+
+void ParameterManager::_bulkWriteFtpUploadComplete(const QString &fileName, const QString &errorMsg)
+{
+    Q_UNUSED(fileName);
+
+    (void) disconnect(_vehicle->ftpManager(), &FTPManager::uploadComplete, this, &ParameterManager::_bulkWriteFtpUploadComplete);
+    delete _bulkWriteFtpFile;
+    _bulkWriteFtpFile = nullptr;
+
+    const QList<ParamSetRequest> requests = _bulkWriteFtpRequests;
+    _bulkWriteFtpRequests.clear();
+
+    if (errorMsg.isEmpty()) {
+        // A completed upload only means the file arrived, the vehicle may still have rejected or clamped values.
+        // Each write is completed from the value read back from the vehicle, using the same window as PARAM_SET.
+        qCDebug(ParameterManagerLog) << _logVehiclePrefix(MAV_COMP_ID_AUTOPILOT1) << "Parameter file uploaded, reading back values - count:" << requests.count();
+        _bulkWriteReadBackQueue.append(requests);
+        _bulkWriteSendNext();
+    } else {
+        qCWarning(ParameterManagerLog) << "Parameter file upload failed, falling back to PARAM_SET:" << errorMsg;
+        _bulkWriteQueue.append(requests);
+        _bulkWriteSendNext();
+    }
+}
+
+void ParameterManager::_bulkWriteReadBack(int componentId, const QString &paramName, const QVariant &rawValue)
+{
+    const ParameterKey key(componentId, paramName);
+    if (!_bulkWriteReadBackValues.contains(key)) {
+        return;
+    }
+
+    const QVariant expectedValue = _bulkWriteReadBackValues.take(key);
+    bool success;
+    if (rawValue.typeId() == QMetaType::Float) {
+        // Float comparison must be fuzzy
+        success = QGC::fuzzyCompare(expectedValue.toFloat(), rawValue.toFloat());
+    } else {
+        success = (rawValue == expectedValue);
+    }
+    if (!success) {
+        qCWarning(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Uploaded parameter not applied - name:" << paramName << "expected:" << expectedValue << "vehicle:" << rawValue;
+    }
+
+    _bulkWriteParamComplete(componentId, paramName, expectedValue, success);
+}
+
+bool ParameterManager::_writeParamFile(const QString &filename, const QList<ParamSetRequest> &requests)
+{
+    constexpr quint16 magic_standard = 0x671B;
+    constexpr int maxNameLength = 16;
+    enum ap_var_type {
+        AP_PARAM_NONE = 0,
+        AP_PARAM_INT8,
+        AP_PARAM_INT16,
+        AP_PARAM_INT32,
+        AP_PARAM_FLOAT,
+    };
+
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(ParameterManagerLog) << "_writeParamFile: Could not open" << filename;
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    out << magic_standard << static_cast<quint16>(requests.count()) << static_cast<quint16>(requests.count());
+
+    QByteArray previousName;
+    for (const ParamSetRequest &request: requests) {
+        const QByteArray name = request.name.toLatin1();
+        if (name.isEmpty() || (name.length() > maxNameLength)) {
+            qCWarning(ParameterManagerLog) << "_writeParamFile: Invalid parameter name" << request.name;
+            return false;
+        }
+
+        // Names are stored as the suffix which differs from the previous name
+        int commonLength = 0;
+        while ((commonLength < 15) && (commonLength < (name.length() - 1)) && (commonLength < previousName.length()) && (name[commonLength] == previousName[commonLength])) {
+            commonLength++;
+        }
+        const int suffixLength = name.length() - commonLength;
+
+        ap_var_type ptype = AP_PARAM_NONE;
+        switch (request.valueType) {
+        case FactMetaData::valueTypeInt8:
+        case FactMetaData::valueTypeUint8:
+            ptype = AP_PARAM_INT8;
+            break;
+        case FactMetaData::valueTypeInt16:
+        case FactMetaData::valueTypeUint16:
+            ptype = AP_PARAM_INT16;
+            break;
+        case FactMetaData::valueTypeInt32:
+        case FactMetaData::valueTypeUint32:
+            ptype = AP_PARAM_INT32;
+            break;
+        case FactMetaData::valueTypeFloat:
+            ptype = AP_PARAM_FLOAT;
+            break;
+        default:
+            qCWarning(ParameterManagerLog) << "_writeParamFile: Unsupported type" << request.valueType << request.name;
+            return false;
+        }
+
+        out << static_cast<quint8>(ptype);
+        out << static_cast<quint8>(((suffixLength - 1) << 4) | commonLength);
+        (void) out.writeRawData(name.constData() + commonLength, suffixLength);
+
+        switch (ptype) {
+        case AP_PARAM_INT8:
+            out << static_cast<qint8>(request.rawValue.toInt());
+            break;
+        case AP_PARAM_INT16:
+            out << static_cast<qint16>(request.rawValue.toInt());
+            break;
+        case AP_PARAM_INT32:
+            out << static_cast<qint32>(request.rawValue.toLongLong());
+            break;
+        default:
+            out << request.rawValue.toFloat();
+            break;
+        }
+
+        previousName = name;
+    }
+
+    return (out.status() == QDataStream::Ok);
+}
+
 void ParameterManager::_incrementPendingWriteCount()
 {
     _pendingWritesCount++;
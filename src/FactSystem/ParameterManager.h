@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QMap>
 #include <QtCore/QObject>
@@ -18,6 +20,7 @@ Q_DECLARE_LOGGING_CATEGORY(ParameterManagerVerbose2Log)
 Q_DECLARE_LOGGING_CATEGORY(ParameterManagerDebugCacheFailureLog)
 
 class ParameterEditorController;
+class QTemporaryFile;
 class Vehicle;
 
 class ParameterManager : public QObject
@@ -39,6 +42,12 @@ class ParameterManager : public QObject
     bool missingParameters() const { return _missingParameters; }
     double loadProgress() const { return _loadProgress; }
 
+    /// @return Time in msecs from the initial parameter request until parameters were ready, -1 if not yet ready
+    qint64 timeToReadyMs() const { return _timeToReadyMs; }
+
+    /// @return true: Initial parameter load was satisfied from the local parameter cache
+    bool loadedFromCache() const { return _loadedFromCache; }
+
     /// @return Directory of parameter caches
     static QDir parameterCacheDir();
 
@@ -75,6 +84,29 @@ class ParameterManager : public QObject
     ///     @param name: Parameter name
     Fact *getParameter(int componentId, const QString &paramName);
 
+    /// Stable handle to a parameter. Callers which look up the same parameter repeatedly can resolve the handle once
+    /// and skip the name lookup afterwards. Handles remain valid for the lifetime of the ParameterManager.
+    typedef int ParameterHandle;
+    static constexpr ParameterHandle invalidParameterHandle = -1;
+
+    /// Returns the handle for the specified parameter, invalidParameterHandle if the parameter does not exist
+    ///     @param componentId: Component id or ParameterManager::defaultComponentId
+    ///     @param name: Parameter name
+    ParameterHandle parameterHandle(int componentId, const QString &paramName) const;
+
+    /// Returns the parameter for the handle, nullptr for an invalid handle. Parameters are stored compactly until
+    /// their Fact is first requested, the Fact is created on demand.
+    Fact *parameter(ParameterHandle handle);
+
+    /// Return the name, raw value and meta data of the parameter for the handle without creating its Fact. The handle
+    /// must be valid.
+    QString parameterName(ParameterHandle handle) const { return _params[handle].name; }
+    QVariant parameterRawValue(ParameterHandle handle) const { return _paramRawValue(handle); }
+    FactMetaData *parameterMetaData(ParameterHandle handle) const { return _paramMetaData(handle); }
+
+    /// @return Number of parameters which have had their Fact created
+    int factCount() const;
+
     /// Returns error messages from loading
     QString readParametersFromStream(QTextStream &stream);
 
@@ -82,6 +114,23 @@ class ParameterManager : public QObject
 
     bool pendingWrites() const;
 
+    /// A single parameter value to write to the vehicle
+    struct ParamSetRequest {
+        int                         componentId;
+        QString                     name;
+        FactMetaData::ValueType_t   valueType;
+        QVariant                    rawValue;
+    };
+
+    /// Writes a set of parameter values to the vehicle. At most kParamSetWindowSize PARAM_SETs are outstanding at any
+    /// time, progress is reported through loadProgress and failures are reported to the user once for the whole set.
+    /// If the vehicle supports parameter upload through FTP the autopilot parameters are written as a single file,
+    /// each of them is then read back and the write only succeeds if the vehicle reports the written value.
+    void writeParameters(const QList<ParamSetRequest> &requests);
+
+    /// @return true: A bulk parameter write is in progress
+    bool bulkWriteActive() const { return _bulkWriteTotal > 0; }
+
     Vehicle *vehicle();
 
     static MAV_PARAM_TYPE factTypeToMavType(FactMetaData::ValueType_t factType);
@@ -93,17 +142,26 @@ class ParameterManager : public QObject
     static constexpr int kParamSetRetryCount = 2;                   ///< Number of retries for PARAM_SET
     static constexpr int kParamRequestReadRetryCount = 2;           ///< Number of retries for PARAM_REQUEST_READ
     static constexpr int kWaitForParamValueAckMs = 1000;    ///< Time to wait for param value ack after set param
+    static constexpr int kParamSetWindowSize = 10;          ///< Maximum number of outstanding PARAM_SETs for a bulk write
+    static constexpr int kCacheWriteDelayMs = 1000;         ///< Parameter changes after the initial load are written to the cache after this delay
+    static constexpr int kIndexBatchWindowMin = 4;          ///< Minimum number of index based re-requests in flight
+    static constexpr int kIndexBatchWindowInitial = 10;     ///< Number of index based re-requests in flight when re-requesting starts
+    static constexpr int kIndexBatchWindowMax = 64;         ///< Maximum number of index based re-requests in flight
 
 signals:
     void parametersReadyChanged(bool parametersReady);
     void missingParametersChanged(bool missingParameters);
     void loadProgressChanged(float value);
     void pendingWritesChanged(bool pendingWrites);
-    void factAdded(int componentId, Fact *fact);
+    /// Emitted for every parameter added after construction, including the initial load. No Fact is created for
+    /// it, listeners which need one call parameter(handle).
+    void parameterAdded(int componentId, ParameterManager::ParameterHandle handle);
+    void bulkWriteProgressChanged(int completedCount, int totalCount);
+    void bulkWriteComplete(const QStringList &failedParams);
 
     // These signals are used to verify unit tests
-    void _paramSetSuccess(int componentId, const QString &paramName);
-    void _paramSetFailure(int componentId, const QString &paramName);
+    void _paramSetSuccess(int componentId, const QString &paramName, const QVariant &rawValue);
+    void _paramSetFailure(int componentId, const QString &paramName, const QVariant &rawValue);
     void _paramRequestReadSuccess(int componentId, const QString &paramName, int paramIndex);
     void _paramRequestReadFailure(int componentId, const QString &paramName, int paramIndex);
 
@@ -114,7 +172,8 @@ private slots:
     /// Called whenever a parameter is updated or first seen.
     void _handleParamValue(int componentId, const QString &parameterName, int parameterCount, int parameterIndex, MAV_PARAM_TYPE mavParamType, const QVariant &parameterValue);
      /// Writes the parameter update to mavlink, sets up for write wait
-    void _mavlinkParamSet(int componentId, const QString &name, FactMetaData::ValueType_t valueType, const QVariant &rawValue);
+    ///     @param notifyFailure: true: Show a message to the user if the write fails
+    void _mavlinkParamSet(int componentId, const QString &name, FactMetaData::ValueType_t valueType, const QVariant &rawValue, bool notifyFailure = true);
     void _waitingParamTimeout();
     void _tryCacheLookup();
     void _initialRequestTimeout();
@@ -122,6 +181,9 @@ private slots:
     int _actualComponentId(int componentId) const;
     void _mavlinkParamRequestRead(int componentId, const QString &paramName, int paramIndex, bool notifyFailure);
     void _writeLocalParamCache(int vehicleId, int componentId);
+    /// Queues a write of the local cache for the component so reconnects after a parameter change can still load from cache
+    void _scheduleLocalParamCacheWrite(int componentId);
+    void _writePendingLocalParamCaches();
     void _tryCacheHashLoad(int vehicleId, int componentId, const QVariant &hashValue);
     void _loadMetaData();
     void _clearMetaData();
@@ -144,15 +206,56 @@ private slots:
     /// Parse the binary parameter file and inject the parameters in the qgc fact system.
     /// See: https://github.com/ArduPilot/ardupilot/tree/master/libraries/AP_Filesystem
     bool _parseParamFile(const QString &filename);
+    /// Write parameter values in the binary parameter file format used by _parseParamFile
+    static bool _writeParamFile(const QString &filename, const QList<ParamSetRequest> &requests);
+    void _bulkWriteSendNext();
+    void _bulkWriteParamComplete(int componentId, const QString &paramName, const QVariant &rawValue, bool success);
+    bool _bulkWriteFtpUpload(const QList<ParamSetRequest> &requests);
+    void _bulkWriteFtpUploadComplete(const QString &fileName, const QString &errorMsg);
+    /// Completes an uploaded write from the value the vehicle reported for it
+    void _bulkWriteReadBack(int componentId, const QString &paramName, const QVariant &rawValue);
     void _incrementPendingWriteCount();
     void _decrementPendingWriteCount();
     QString _vehicleAndComponentString(int componentId) const;
-
+    ParameterHandle _findParam(int componentId, const QString &paramName) const;
+    ParameterHandle _addParam(int componentId, const QString &paramName, FactMetaData::ValueType_t type, const QVariant &rawValue);
+    /// @return true: Value changed
+    bool _setParamRawValue(ParameterHandle handle, const QVariant &rawValue);
+    QVariant _paramRawValue(ParameterHandle handle) const;
+    FactMetaData *_paramMetaData(ParameterHandle handle) const;
+
+    static QString _rawValueStringFullPrecision(FactMetaData::ValueType_t type, const QVariant &rawValue);
     static QVariant _stringToTypedVariant(const QString &string, FactMetaData::ValueType_t type, bool failOk = false);
 
     Vehicle *_vehicle = nullptr;
 
-    QMap<int /* comp id */, QMap<QString /* parameter name */, Fact*>> _mapCompId2FactMap;
+    /// Compact storage for a parameter. The Fact is only created when the parameter is first accessed, until then the
+    /// value lives here.
+    struct ParamEntry {
+        int                         componentId;
+        QString                     name;
+        FactMetaData::ValueType_t   type;
+        QVariant                    rawValue;       ///< Only used while fact is nullptr
+        Fact                        *fact;
+    };
+
+    QList<ParamEntry> _params;                                                                          ///< Index is the ParameterHandle
+    QMap<int /* comp id */, QMap<QString /* parameter name */, ParameterHandle>> _mapCompId2ParamHandleMap;    ///< Ordered view used for iteration
+
+    typedef QPair<int /* comp id */, QString /* parameter name */> ParameterKey;
+    QHash<ParameterKey, ParameterHandle> _factHandleHash;   ///< Used for name lookups
+
+    // Bulk write support
+    QList<ParamSetRequest> _bulkWriteQueue;                 ///< Writes which have not been sent yet
+    QList<ParamSetRequest> _bulkWriteOutstanding;           ///< Writes waiting for a PARAM_VALUE ack with the value written
+    QList<ParamSetRequest> _bulkWriteFtpRequests;           ///< Writes included in the FTP upload in progress
+    QTemporaryFile *_bulkWriteFtpFile = nullptr;            ///< Parameter file of the FTP upload in progress
+    QList<ParamSetRequest> _bulkWriteReadBackQueue;         ///< Uploaded writes which have not been read back yet
+    QHash<ParameterKey, QVariant> _bulkWriteReadBackValues; ///< Uploaded writes waiting for their read back, with the value written
+    QStringList _bulkWriteFailures;
+    int _bulkWriteTotal = 0;
+    int _bulkWriteCompleted = 0;
+    bool _ftpParamLoadSucceeded = false;                    ///< true: Vehicle provided its parameters through FTP, so it also accepts parameter uploads
 
     double _loadProgress = 0;                   ///< Parameter load progess, [0.0,1.0]
     bool _parametersReady = false;              ///< true: parameter load complete
@@ -168,6 +271,10 @@ private slots:
     QMap<int /* component id */, bool> _debugCacheCRC; ///< true: debug cache crc failure
     QMap<int /* component id */, CacheMapName2ParamTypeVal> _debugCacheMap;
     QMap<int /* component id */, QMap<QString /* param name */, bool /* seen */>> _debugCacheParamSeen;
+    QMap<int /* component id */, CacheMapName2ParamTypeVal> _staleCacheMap;    ///< Cache contents which failed the hash check, used to report the changed parameters
+
+    QList<int> _pendingCacheWriteComponentIds;  ///< Components with parameter changes not yet written to the cache
+    QTimer _cacheWriteTimer;
 
     // Wait counts from previous parameter update cycle
     int _prevWaitingReadParamIndexCount = 0;
@@ -181,6 +288,7 @@ private slots:
 
     bool _indexBatchQueueActive = false;    ///< true: we are actively batching re-requests for missing index base params, false: index based re-request has not yet started
     QList<int> _indexBatchQueue;            ///< The current queue of index re-requests
+    int _indexBatchWindow = kIndexBatchWindowInitial;   ///< Number of re-requests allowed in flight, grows on responses and shrinks on timeouts
 
     QMap<int, int> _paramCountMap;                              ///< Key: Component id, Value: count of parameters in this component
     QMap<int, QMap<int, int>> _waitingReadParamIndexMap;        ///< Key: Component id, Value: Map { Key: parameter index still waiting for, Value: retry count }
@@ -194,5 +302,13 @@ private slots:
 
     Fact _defaultFact;   ///< Used to return default fact, when parameter not found
 
+    // Load statistics
+    QElapsedTimer _loadTimer;               ///< Started with the initial parameter request
+    qint64 _timeToReadyMs = -1;
+    bool _loadedFromCache = false;
+    int _indexReRequestCount = 0;           ///< Number of index based re-requests sent during the initial load
+    int _staleCacheChangedCount = 0;        ///< Number of parameters which differed from a stale cache
+    const int _vehicleId = 0;               ///< Saved so pending cache writes can be flushed on destruction
+
     bool _tryftp = false;
 };
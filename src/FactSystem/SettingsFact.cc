@@ -3,8 +3,7 @@
 #include "QGCCorePlugin.h"
 #include "QGCLoggingCategory.h"
 #include "SettingsManager.h"
-
-#include <QtCore/QSettings>
+#include "SettingsStore.h"
 
 QGC_LOGGING_CATEGORY(SettingsFactLog, "FactSystem.SettingsFact")
 
@@ -19,11 +18,6 @@ SettingsFact::SettingsFact(const QString &settingsGroup, FactMetaData *metaData,
     , _settingsGroup(settingsGroup)
 {
     // qCDebug(SettingsFactLog) << Q_FUNC_INFO << this;
-    QSettings settings;
-
-    if (!_settingsGroup.isEmpty()) {
-        settings.beginGroup(_settingsGroup);
-    }
 
     // Allow core plugin a chance to override the default value
     SettingsManager::adjustSettingMetaData(settingsGroup, *metaData, _visible);
@@ -39,7 +33,7 @@ SettingsFact::SettingsFact(const QString &settingsGroup, FactMetaData *metaData,
         } else if (_visible) {
             QVariant typedValue;
             QString errorString;
-            (void) metaData->convertAndValidateRaw(settings.value(_name, rawDefaultValue), true /* conertOnly */, typedValue, errorString);
+            (void) metaData->convertAndValidateRaw(SettingsStore::instance()->value(_settingsGroup, _name, rawDefaultValue), true /* conertOnly */, typedValue, errorString);
             resolvedValue = typedValue;
         } else {
             // Setting is not visible, force to default value always
@@ -78,11 +72,6 @@ const SettingsFact &SettingsFact::operator=(const SettingsFact &other)
 
 void SettingsFact::_rawValueChanged(const QVariant &value)
 {
-    QSettings settings;
-
-    if (!_settingsGroup.isEmpty()) {
-        settings.beginGroup(_settingsGroup);
-    }
-
-    settings.setValue(_name, value);
+    // Written behind, repeated changes (for example from a slider) are coalesced into a single write
+    SettingsStore::instance()->setValue(_settingsGroup, _name, value);
 }
@@ -84,8 +84,23 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString &metaData
     }
     _parameterMetaDataLoaded = true;
 
+    const QByteArray sourceHash = ParameterMetaDataCache::hashFile(metaDataFile);
+    if (_metaDataCache.open(sourceHash)) {
+        qCDebug(APMParameterMetaDataLog) << "Loaded parameter meta data from cache:" << metaDataFile;
+        _loadedFromCache = true;
+        return;
+    }
+
     qCDebug(APMParameterMetaDataLog) << "Loading parameter meta data:" << metaDataFile;
 
+    if (_parseParameterFactMetaDataFile(metaDataFile) && !sourceHash.isEmpty()) {
+        (void) ParameterMetaDataCache::save(ParameterMetaDataCache::build(_cacheRecords(), sourceHash), sourceHash);
+    }
+}
+
+/// @return false: badly formed xml, parameters found before the error are still available
+bool APMParameterMetaData::_parseParameterFactMetaDataFile(const QString &metaDataFile)
+{
     QFile xmlFile(metaDataFile);
     Q_ASSERT(xmlFile.exists());
 
@@ -93,12 +108,7 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString &metaData
     Q_UNUSED(success);
     Q_ASSERT(success);
 
-    QXmlStreamReader xml(xmlFile.readAll());
-    xmlFile.close();
-    if (xml.hasError()) {
-        qCWarning(APMParameterMetaDataLog) << "Badly formed XML, reading failed:" << xml.errorString();
-        return;
-    }
+    QXmlStreamReader xml(&xmlFile);
 
     bool badMetaData = true;
     APMFactMetaDataRaw *rawMetaData = nullptr;
@@ -124,13 +134,13 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString &metaData
             } else if (elementName == "vehicles") {
                 if (xmlState.top() != XmlState::ParamFileFound) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, vehicles matched";
-                    return;
+                    return false;
                 }
                 xmlState.push(XmlState::FoundVehicles);
             } else if (elementName == "libraries") {
                 if (xmlState.top() != XmlState::ParamFileFound) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, libraries matched";
-                    return;
+                    return false;
                 }
                 currentCategory = "libraries";
                 xmlState.push(XmlState::FoundLibraries);
@@ -138,7 +148,7 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString &metaData
                 if (xmlState.top() != XmlState::FoundVehicles && xmlState.top() != XmlState::FoundLibraries) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, parameters matched"
                                                        << "but we don't have proper vehicle or libraries yet";
-                    return;
+                    return false;
                 }
 
                 if (xml.attributes().hasAttribute("name")) {
@@ -156,7 +166,7 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString &metaData
                         qCDebug(APMParameterMetaDataVerboseLog) << "not interested in this block of parameters, skipping:" << nameValue;
                         if (_skipXMLBlock(xml, "parameters")) {
                             qCWarning(APMParameterMetaDataLog) << "something wrong with the xml, skip of the xml failed";
-                            return;
+                            return false;
                         }
                         (void) xml.readNext();
                         continue;
@@ -166,13 +176,13 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString &metaData
                 if (xmlState.top() != XmlState::FoundParameters) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, element param matched"
                                                        << "while we are not yet in parameters";
-                    return;
+                    return false;
                 }
                 xmlState.push(XmlState::FoundParameter);
 
                 if (!xml.attributes().hasAttribute("name")) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, parameter attribute name missing";
-                    return;
+                    return false;
                 }
 
                 QString name = xml.attributes().value("name").toString();
@@ -213,12 +223,12 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString &metaData
                 // We should be getting meta data now
                 if (xmlState.top() != XmlState::FoundParameter) {
                     qCWarning(APMParameterMetaDataLog) << "Badly formed XML, while reading parameter fields wrong state";
-                    return;
+                    return false;
                 }
                 if (!badMetaData) {
                     if (!_parseParameterAttributes(xml, rawMetaData)) {
                         qCDebug(APMParameterMetaDataLog) << "Badly formed XML, failed to read parameter attributes";
-                        return;
+                        return false;
                     }
                     continue;
                 }
@@ -245,6 +255,77 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString &metaData
         }
         (void) xml.readNext();
     }
+
+    if (xml.hasError()) {
+        qCWarning(APMParameterMetaDataLog) << "Badly formed XML, reading failed:" << xml.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+QList<ParameterMetaDataCache::Record> APMParameterMetaData::_cacheRecords() const
+{
+    QList<ParameterMetaDataCache::Record> records;
+
+    for (auto sectionIt = _vehicleTypeToParametersMap.constBegin(); sectionIt != _vehicleTypeToParametersMap.constEnd(); sectionIt++) {
+        for (const APMFactMetaDataRaw *const rawMetaData : sectionIt.value()) {
+            ParameterMetaDataCache::Record record;
+            record.section = sectionIt.key();
+            record.name = rawMetaData->name;
+            record.category = rawMetaData->category;
+            record.group = rawMetaData->group;
+            record.shortDescription = rawMetaData->shortDescription;
+            record.longDescription = rawMetaData->longDescription;
+            record.units = rawMetaData->units;
+            record.min = rawMetaData->min;
+            record.max = rawMetaData->max;
+            record.increment = rawMetaData->incrementSize;
+            if (rawMetaData->rebootRequired) {
+                record.flags |= ParameterMetaDataCache::RebootRequired;
+            }
+            if (rawMetaData->readOnly) {
+                record.flags |= ParameterMetaDataCache::ReadOnly;
+            }
+            record.values = rawMetaData->values;
+            record.bitmask = rawMetaData->bitmask;
+            records.append(record);
+        }
+    }
+
+    return records;
+}
+
+APMFactMetaDataRaw *APMParameterMetaData::_findRawMetaData(const QString &section, const QString &name)
+{
+    ParameterNametoFactMetaDataMap &parameterMap = _vehicleTypeToParametersMap[section];
+    APMFactMetaDataRaw *rawMetaData = parameterMap.value(name, nullptr);
+    if (rawMetaData) {
+        return rawMetaData;
+    }
+
+    ParameterMetaDataCache::Record record;
+    if (!_metaDataCache.find(section, name, record)) {
+        return nullptr;
+    }
+
+    rawMetaData = new APMFactMetaDataRaw(this);
+    rawMetaData->name = record.name;
+    rawMetaData->category = record.category;
+    rawMetaData->group = record.group;
+    rawMetaData->shortDescription = record.shortDescription;
+    rawMetaData->longDescription = record.longDescription;
+    rawMetaData->units = record.units;
+    rawMetaData->min = record.min;
+    rawMetaData->max = record.max;
+    rawMetaData->incrementSize = record.increment;
+    rawMetaData->rebootRequired = (record.flags & ParameterMetaDataCache::RebootRequired);
+    rawMetaData->readOnly = (record.flags & ParameterMetaDataCache::ReadOnly);
+    rawMetaData->values = record.values;
+    rawMetaData->bitmask = record.bitmask;
+    parameterMap[name] = rawMetaData;
+
+    return rawMetaData;
 }
 
 void APMParameterMetaData::_correctGroupMemberships(ParameterNametoFactMetaDataMap &parameterToFactMetaDataMap, QMap<QString,QStringList> &groupMembers)
@@ -418,10 +499,9 @@ FactMetaData *APMParameterMetaData::getMetaDataForFact(const QString &name, MAV_
 
     // check if we have metadata for fact, use generic otherwise
     while (keepTrying) {
-        if (_vehicleTypeToParametersMap[mavTypeString].contains(name)) {
-            rawMetaData = _vehicleTypeToParametersMap[mavTypeString][name];
-        } else if (_vehicleTypeToParametersMap["libraries"].contains(name)) {
-            rawMetaData = _vehicleTypeToParametersMap["libraries"][name];
+        rawMetaData = _findRawMetaData(mavTypeString, name);
+        if (!rawMetaData) {
+            rawMetaData = _findRawMetaData(QStringLiteral("libraries"), name);
         }
         if (!rawMetaData && (mavTypeString == "Rover")) {
             // Hack city: Older versions of Rover have different name
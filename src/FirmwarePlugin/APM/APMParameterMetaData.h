@@ -7,6 +7,7 @@
 
 #include "MAVLinkLib.h"
 #include "FactMetaData.h"
+#include "ParameterMetaDataCache.h"
 
 Q_DECLARE_LOGGING_CATEGORY(APMParameterMetaDataLog)
 Q_DECLARE_LOGGING_CATEGORY(APMParameterMetaDataVerboseLog)
@@ -30,7 +31,7 @@ class APMFactMetaDataRaw : public QObject
     QString incrementSize;
     QString units;
     bool rebootRequired = false;
-    bool readOnly;
+    bool readOnly = false;
     QList<QPair<QString, QString>> values;
     QList<QPair<QString, QString>> bitmask;
 };
@@ -40,6 +41,8 @@ class APMFactMetaDataRaw : public QObject
 typedef QMap<QString, APMFactMetaDataRaw*> ParameterNametoFactMetaDataMap;
 
 /// Collection of Parameter Facts for ArduPilot
+///     The xml is only parsed the first time a specific meta data file is seen. After that raw meta data is read
+///     from the binary ParameterMetaDataCache as each parameter is requested.
 class APMParameterMetaData : public QObject
 {
     Q_OBJECT
@@ -53,6 +56,9 @@ class APMParameterMetaData : public QObject
 
     static void getParameterMetaDataVersionInfo(const QString &metaDataFile, int &majorVersion, int &minorVersion);
 
+    /// @return true: meta data was loaded from the binary cache instead of parsing the xml
+    bool loadedFromCache() const { return _loadedFromCache; }
+
 private:
     enum XmlState {
         None,
@@ -66,6 +72,9 @@ class APMParameterMetaData : public QObject
         Done
     };
 
+    bool _parseParameterFactMetaDataFile(const QString &metaDataFile);
+    QList<ParameterMetaDataCache::Record> _cacheRecords() const;
+    APMFactMetaDataRaw *_findRawMetaData(const QString &section, const QString &name);
     static bool _skipXMLBlock(QXmlStreamReader &xml, const QString &blockName);
     bool _parseParameterAttributes(QXmlStreamReader &xml, APMFactMetaDataRaw *rawMetaData);
     static void _correctGroupMemberships(ParameterNametoFactMetaDataMap &parameterToFactMetaDataMap, QMap<QString,QStringList> &groupMembers);
@@ -73,6 +82,8 @@ class APMParameterMetaData : public QObject
     static QString _groupFromParameterName(const QString &name);
 
     bool _parameterMetaDataLoaded = false; ///< true: parameter meta data already loaded
+    bool _loadedFromCache = false;
+    ParameterMetaDataCache _metaDataCache;
     // FIXME: metadata is vehicle type specific now
     QMap<QString, ParameterNametoFactMetaDataMap> _vehicleTypeToParametersMap; ///< Maps from a vehicle type to paramametertoFactMeta map>
 };
@@ -277,6 +277,10 @@ class FirmwarePlugin : public QObject
     ///     false: Do not send first item to vehicle, sequence numbers must be adjusted
     virtual bool sendHomePositionToVehicle() const { return false; }
 
+    /// @return true: Vehicle supports MISSION_WRITE_PARTIAL_LIST for replacing a range of its existing mission items.
+    ///     Only the changed items of an edited mission are then sent, instead of the full mission.
+    virtual bool supportsMissionPartialWrite() const { return false; }
+
     /// Returns the parameter set version info pulled from inside the meta data file. -1 if not found.
     /// Note: The implementation for this must not vary by vehicle type.
     /// Important: Only CompInfoParam code should use this method
@@ -4,6 +4,7 @@
 #include <QtCore/QFile>
 #include <QtCore/QDir>
 #include <QtCore/QDebug>
+#include <QtCore/QHash>
 #include <QtCore/QXmlStreamReader>
 
 QGC_LOGGING_CATEGORY(PX4ParameterMetaDataLog, "FirmwarePlugin.PX4ParameterMetaData")
@@ -73,32 +74,59 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
     }
     _parameterMetaDataLoaded = true;
 
+    const QByteArray sourceHash = ParameterMetaDataCache::hashFile(metaDataFile);
+
+#ifndef GENERATE_PARAMETER_JSON
+    if (_metaDataCache.open(sourceHash)) {
+        qCDebug(PX4ParameterMetaDataLog) << "Loaded parameter meta data from cache:" << metaDataFile;
+        _loadedFromCache = true;
+        return;
+    }
+#endif
+
     qCDebug(PX4ParameterMetaDataLog) << "Loading parameter meta data:" << metaDataFile;
 
+    // A badly formed file still provides the meta data found up to the error, it just isn't cached
+    QList<ParameterMetaDataCache::Record> records;
+    const bool parseComplete = _parseParameterFactMetaDataFile(metaDataFile, records);
+
+    const QByteArray blob = ParameterMetaDataCache::build(records, sourceHash);
+    if (parseComplete && !sourceHash.isEmpty()) {
+        (void) ParameterMetaDataCache::save(blob, sourceHash);
+    }
+    (void) _metaDataCache.openData(blob, sourceHash);
+
+#ifdef GENERATE_PARAMETER_JSON
+    for (const ParameterMetaDataCache::Record& record: records) {
+        (void) getMetaDataForFact(record.name, MAV_TYPE_GENERIC, FactMetaData::valueTypeInt32);
+    }
+    _generateParameterJson();
+#endif
+}
+
+/// Parses the raw meta data for each parameter from the xml file
+/// @return false: file is missing, badly formed or too old, records only holds the parameters found before the error
+bool PX4ParameterMetaData::_parseParameterFactMetaDataFile(const QString& metaDataFile, QList<ParameterMetaDataCache::Record>& records)
+{
     QFile xmlFile(metaDataFile);
 
     if (!xmlFile.exists()) {
         qWarning() << "Internal error: metaDataFile mission" << metaDataFile;
-        return;
+        return false;
     }
 
     if (!xmlFile.open(QIODevice::ReadOnly)) {
         qWarning() << "Internal error: Unable to open parameter file:" << metaDataFile << xmlFile.errorString();
-        return;
+        return false;
     }
 
-    QXmlStreamReader xml(xmlFile.readAll());
-    xmlFile.close();
-    if (xml.hasError()) {
-        qWarning() << "Badly formed XML" << xml.errorString();
-        return;
-    }
+    QXmlStreamReader xml(&xmlFile);
 
-    QString         factGroup;
-    QString         errorString;
-    FactMetaData*   metaData = nullptr;
-    int             xmlState = XmlStateNone;
-    bool            badMetaData = true;
+    QString                         factGroup;
+    ParameterMetaDataCache::Record* record = nullptr;
+    QHash<QString, qsizetype>       nameToRecordIndex;
+    int                             xmlState = XmlStateNone;
+    bool                            badMetaData = true;
 
     while (!xml.atEnd()) {
         if (xml.isStartElement()) {
@@ -107,14 +135,14 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
             if (elementName == "parameters") {
                 if (xmlState != XmlStateNone) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 xmlState = XmlStateFoundParameters;
 
             } else if (elementName == "version") {
                 if (xmlState != XmlStateFoundParameters) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 xmlState = XmlStateFoundVersion;
 
@@ -123,12 +151,12 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 int intVersion = strVersion.toInt(&convertOk);
                 if (!convertOk) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 if (intVersion <= 2) {
                     // We can't read these old files
                     qDebug() << "Parameter version stamp too old, skipping load. Found:" << intVersion << "Want: 3 File:" << metaDataFile;
-                    return;
+                    return false;
                 }
 
             } else if (elementName == "parameter_version_major") {
@@ -140,13 +168,13 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                 if (xmlState != XmlStateFoundVersion) {
                     // We didn't get a version stamp, assume older version we can't read
                     qDebug() << "Parameter version stamp not found, skipping load" << metaDataFile;
-                    return;
+                    return false;
                 }
                 xmlState = XmlStateFoundGroup;
 
                 if (!xml.attributes().hasAttribute("name")) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 factGroup = xml.attributes().value("name").toString();
                 qCDebug(PX4ParameterMetaDataLog) << "Found group: " << factGroup;
@@ -154,13 +182,13 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
             } else if (elementName == "parameter") {
                 if (xmlState != XmlStateFoundGroup) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
                 xmlState = XmlStateFoundParameter;
 
                 if (!xml.attributes().hasAttribute("name") || !xml.attributes().hasAttribute("type")) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
 
                 QString name = xml.attributes().value("name").toString();
@@ -188,109 +216,84 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
 
                 qCDebug(PX4ParameterMetaDataLog) << "Found parameter name:" << name << " type:" << type << " default:" << strDefault;
 
-                // Convert type from string to FactMetaData::ValueType_t
+                // Validate the type now, conversion to FactMetaData::ValueType_t happens again when the Fact is created
                 bool unknownType;
-                FactMetaData::ValueType_t foundType = FactMetaData::stringToType(type, unknownType);
+                (void) FactMetaData::stringToType(type, unknownType);
                 if (unknownType) {
                     qWarning() << "Parameter meta data with bad type:" << type << " name:" << name;
-                    return;
+                    return false;
                 }
 
-                // Now that we know type we can create meta data object and add it to the system
-                metaData = new FactMetaData(foundType, this);
-                if (_mapParameterName2FactMetaData.contains(name)) {
+                ParameterMetaDataCache::Record newRecord;
+                newRecord.name = name;
+                newRecord.type = type;
+                if (nameToRecordIndex.contains(name)) {
                     // We can't trust the meta data since we have dups
                     qCWarning(PX4ParameterMetaDataLog) << "Duplicate parameter found:" << name;
                     badMetaData = true;
                     // Reset to default meta data
-                    _mapParameterName2FactMetaData[name] = metaData;
+                    newRecord.flags = ParameterMetaDataCache::Duplicate;
+                    records[nameToRecordIndex[name]] = newRecord;
+                    record = &records[nameToRecordIndex[name]];
                 } else {
-                    _mapParameterName2FactMetaData[name] = metaData;
-                    metaData->setName(name);
-                    metaData->setCategory(category);
-                    metaData->setGroup(factGroup);
-                    metaData->setReadOnly(readOnly);
-                    metaData->setVolatileValue(volatileValue);
-
-                    if (xml.attributes().hasAttribute("default") && !strDefault.isEmpty()) {
-                        QVariant varDefault;
-
-                        if (metaData->convertAndValidateRaw(strDefault, false, varDefault, errorString)) {
-                            metaData->setRawDefaultValue(varDefault);
-                        } else {
-                            qCWarning(PX4ParameterMetaDataLog) << "Invalid default value, name:" << name << " type:" << type << " default:" << strDefault << " error:" << errorString;
-                        }
+                    newRecord.category = category;
+                    newRecord.group = factGroup;
+                    if (readOnly) {
+                        newRecord.flags |= ParameterMetaDataCache::ReadOnly;
                     }
+                    if (volatileValue) {
+                        newRecord.flags |= ParameterMetaDataCache::Volatile;
+                    }
+                    if (xml.attributes().hasAttribute("default")) {
+                        newRecord.defaultValue = strDefault;
+                    }
+                    nameToRecordIndex[name] = records.count();
+                    records.append(newRecord);
+                    record = &records.last();
                 }
 
             } else {
                 // We should be getting meta data now
                 if (xmlState != XmlStateFoundParameter) {
                     qWarning() << "Badly formed XML";
-                    return;
+                    return false;
                 }
 
                 if (!badMetaData) {
-                    if (metaData) {
+                    if (record) {
                         if (elementName == "short_desc") {
                             QString text = xml.readElementText();
                             text = text.replace("\n", " ");
                             qCDebug(PX4ParameterMetaDataLog) << "Short description:" << text;
-                            metaData->setShortDescription(text);
+                            record->shortDescription = text;
 
                         } else if (elementName == "long_desc") {
                             QString text = xml.readElementText();
                             text = text.replace("\n", " ");
                             qCDebug(PX4ParameterMetaDataLog) << "Long description:" << text;
-                            metaData->setLongDescription(text);
+                            record->longDescription = text;
 
                         } else if (elementName == "min") {
-                            QString text = xml.readElementText();
-                            qCDebug(PX4ParameterMetaDataLog) << "Min:" << text;
-
-                            QVariant varMin;
-                            if (metaData->convertAndValidateRaw(text, false /* convertOnly */, varMin, errorString)) {
-                                metaData->setRawMin(varMin);
-                            } else {
-                                qCWarning(PX4ParameterMetaDataLog) << "Invalid min value, name:" << metaData->name() << " type:" << metaData->type() << " min:" << text << " error:" << errorString;
-                            }
+                            record->min = xml.readElementText();
+                            qCDebug(PX4ParameterMetaDataLog) << "Min:" << record->min;
 
                         } else if (elementName == "max") {
-                            QString text = xml.readElementText();
-                            qCDebug(PX4ParameterMetaDataLog) << "Max:" << text;
-
-                            QVariant varMax;
-                            if (metaData->convertAndValidateRaw(text, false /* convertOnly */, varMax, errorString)) {
-                                metaData->setRawMax(varMax);
-                            } else {
-                                // PX4 firmware has a metadata generation bug for VTQ_TELEM_IDS_* parameters
-                                if (!metaData->name().startsWith("VTQ_TELEM_IDS_")) {
-                                    qCWarning(PX4ParameterMetaDataLog) << "Invalid max value, name:" << metaData->name() << " type:" << metaData->type() << " max:" << text << " error:" << errorString;
-                                }
-                            }
+                            record->max = xml.readElementText();
+                            qCDebug(PX4ParameterMetaDataLog) << "Max:" << record->max;
 
                         } else if (elementName == "unit") {
-                            QString text = xml.readElementText();
-                            qCDebug(PX4ParameterMetaDataLog) << "Unit:" << text;
-                            metaData->setRawUnits(text);
+                            record->units = xml.readElementText();
+                            qCDebug(PX4ParameterMetaDataLog) << "Unit:" << record->units;
 
                         } else if (elementName == "decimal") {
-                            QString text = xml.readElementText();
-                            qCDebug(PX4ParameterMetaDataLog) << "Decimal:" << text;
-
-                            bool convertOk;
-                            QVariant varDecimals = QVariant(text).toUInt(&convertOk);
-                            if (convertOk) {
-                                metaData->setDecimalPlaces(varDecimals.toInt());
-                            } else {
-                                qCWarning(PX4ParameterMetaDataLog) << "Invalid decimals value, name:" << metaData->name() << " type:" << metaData->type() << " decimals:" << text << " error: invalid number";
-                            }
+                            record->decimalPlaces = xml.readElementText();
+                            qCDebug(PX4ParameterMetaDataLog) << "Decimal:" << record->decimalPlaces;
 
                         } else if (elementName == "reboot_required") {
                             QString text = xml.readElementText();
                             qCDebug(PX4ParameterMetaDataLog) << "RebootRequired:" << text;
                             if (text.compare("true", Qt::CaseInsensitive) == 0) {
-                                metaData->setVehicleRebootRequired(true);
+                                record->flags |= ParameterMetaDataCache::RebootRequired;
                             }
 
                         } else if (elementName == "values") {
@@ -301,59 +304,26 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
                             QString enumString = xml.readElementText();
                             qCDebug(PX4ParameterMetaDataLog) << "parameter value:"
                                                              << "value desc:" << enumString << "code:" << enumValueStr;
+                            record->values.append(qMakePair(enumValueStr, enumString));
 
-                            QVariant    enumValue;
-                            QString     errorString;
-                            if (metaData->convertAndValidateRaw(enumValueStr, false /* validate */, enumValue, errorString)) {
-                                metaData->addEnumInfo(enumString, enumValue);
-                            } else {
-                                qCDebug(PX4ParameterMetaDataLog) << "Invalid enum value, name:" << metaData->name()
-                                                                 << " type:" << metaData->type() << " value:" << enumValueStr
-                                                                 << " error:" << errorString;
-                            }
                         } else if (elementName == "increment") {
-                            double  increment;
-                            bool    ok;
-                            QString text = xml.readElementText();
-                            increment = text.toDouble(&ok);
-                            if (ok) {
-                                metaData->setRawIncrement(increment);
-                            } else {
-                                qCWarning(PX4ParameterMetaDataLog) << "Invalid value for increment, name:" << metaData->name() << " increment:" << text;
-                            }
+                            record->increment = xml.readElementText();
 
                         } else if (elementName == "boolean") {
-                            QVariant    enumValue;
-                            metaData->convertAndValidateRaw(1, false /* validate */, enumValue, errorString);
-                            metaData->addEnumInfo(tr("Enabled"), enumValue);
-                            metaData->convertAndValidateRaw(0, false /* validate */, enumValue, errorString);
-                            metaData->addEnumInfo(tr("Disabled"), enumValue);
+                            record->flags |= ParameterMetaDataCache::Boolean;
 
                         } else if (elementName == "bitmask") {
                             // doing nothing individual bits will follow anyway. May be used for sanity checking.
 
                         } else if (elementName == "bit") {
+                            QString bitIndex = xml.attributes().value("index").toString();
                             bool ok = false;
-                            unsigned char bit = xml.attributes().value("index").toString().toUInt(&ok);
+                            (void) bitIndex.toUInt(&ok);
                             if (ok) {
                                 QString bitDescription = xml.readElementText();
                                 qCDebug(PX4ParameterMetaDataLog) << "parameter value:"
-                                                                 << "index:" << bit << "description:" << bitDescription;
-
-                                if (bit < 32) {
-                                    QVariant bitmaskRawValue = 1 << bit;
-                                    QVariant bitmaskValue;
-                                    QString errorString;
-                                    if (metaData->convertAndValidateRaw(bitmaskRawValue, true, bitmaskValue, errorString)) {
-                                        metaData->addBitmaskInfo(bitDescription, bitmaskValue);
-                                    } else {
-                                        qCDebug(PX4ParameterMetaDataLog) << "Invalid bitmask value, name:" << metaData->name()
-                                                                         << " type:" << metaData->type() << " value:" << bitmaskValue
-                                                                         << " error:" << errorString;
-                                    }
-                                } else {
-                                    qCWarning(PX4ParameterMetaDataLog) << "Invalid value for bitmask bit, name:" << metaData->name() << " bit:" << bit;
-                                }
+                                                                 << "index:" << bitIndex << "description:" << bitDescription;
+                                record->bitmask.append(qMakePair(bitIndex, bitDescription));
                             }
                         } else {
                             qCDebug(PX4ParameterMetaDataLog) << "Unknown element in XML: " << elementName;
@@ -367,17 +337,8 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
             QString elementName = xml.name().toString();
 
             if (elementName == "parameter") {
-                // Done loading this parameter, validate default value
-                if (metaData->defaultValueAvailable()) {
-                    QVariant var;
-
-                    if (!metaData->convertAndValidateRaw(metaData->rawDefaultValue(), false /* convertOnly */, var, errorString)) {
-                        qCWarning(PX4ParameterMetaDataLog) << "Invalid default value, name:" << metaData->name() << " type:" << metaData->type() << " default:" << metaData->rawDefaultValue() << " error:" << errorString;
-                    }
-                }
-
                 // Reset for next parameter
-                metaData = nullptr;
+                record = nullptr;
                 badMetaData = false;
                 xmlState = XmlStateFoundGroup;
             } else if (elementName == "group") {
@@ -389,9 +350,144 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
         xml.readNext();
     }
 
-#ifdef GENERATE_PARAMETER_JSON
-    _generateParameterJson();
-#endif
+    if (xml.hasError()) {
+        qWarning() << "Badly formed XML" << xml.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+/// Creates the FactMetaData for a parameter from its raw meta data
+FactMetaData* PX4ParameterMetaData::_createMetaData(const ParameterMetaDataCache::Record& record)
+{
+    QString errorString;
+
+    bool unknownType;
+    FactMetaData::ValueType_t type = FactMetaData::stringToType(record.type, unknownType);
+    FactMetaData* metaData = new FactMetaData(type, this);
+    if (record.flags & ParameterMetaDataCache::Duplicate) {
+        return metaData;
+    }
+
+    metaData->setName(record.name);
+    metaData->setCategory(record.category);
+    metaData->setGroup(record.group);
+    metaData->setReadOnly(record.flags & ParameterMetaDataCache::ReadOnly);
+    metaData->setVolatileValue(record.flags & ParameterMetaDataCache::Volatile);
+
+    if (!record.defaultValue.isEmpty()) {
+        QVariant varDefault;
+
+        if (metaData->convertAndValidateRaw(record.defaultValue, false, varDefault, errorString)) {
+            metaData->setRawDefaultValue(varDefault);
+        } else {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid default value, name:" << record.name << " type:" << record.type << " default:" << record.defaultValue << " error:" << errorString;
+        }
+    }
+
+    if (!record.shortDescription.isEmpty()) {
+        metaData->setShortDescription(record.shortDescription);
+    }
+    if (!record.longDescription.isEmpty()) {
+        metaData->setLongDescription(record.longDescription);
+    }
+
+    if (!record.min.isEmpty()) {
+        QVariant varMin;
+        if (metaData->convertAndValidateRaw(record.min, false /* convertOnly */, varMin, errorString)) {
+            metaData->setRawMin(varMin);
+        } else {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid min value, name:" << metaData->name() << " type:" << metaData->type() << " min:" << record.min << " error:" << errorString;
+        }
+    }
+
+    if (!record.max.isEmpty()) {
+        QVariant varMax;
+        if (metaData->convertAndValidateRaw(record.max, false /* convertOnly */, varMax, errorString)) {
+            metaData->setRawMax(varMax);
+        } else {
+            // PX4 firmware has a metadata generation bug for VTQ_TELEM_IDS_* parameters
+            if (!metaData->name().startsWith("VTQ_TELEM_IDS_")) {
+                qCWarning(PX4ParameterMetaDataLog) << "Invalid max value, name:" << metaData->name() << " type:" << metaData->type() << " max:" << record.max << " error:" << errorString;
+            }
+        }
+    }
+
+    if (!record.units.isEmpty()) {
+        metaData->setRawUnits(record.units);
+    }
+
+    if (!record.decimalPlaces.isEmpty()) {
+        bool convertOk;
+        QVariant varDecimals = QVariant(record.decimalPlaces).toUInt(&convertOk);
+        if (convertOk) {
+            metaData->setDecimalPlaces(varDecimals.toInt());
+        } else {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid decimals value, name:" << metaData->name() << " type:" << metaData->type() << " decimals:" << record.decimalPlaces << " error: invalid number";
+        }
+    }
+
+    if (record.flags & ParameterMetaDataCache::RebootRequired) {
+        metaData->setVehicleRebootRequired(true);
+    }
+
+    for (const QPair<QString, QString>& value: record.values) {
+        QVariant enumValue;
+        if (metaData->convertAndValidateRaw(value.first, false /* validate */, enumValue, errorString)) {
+            metaData->addEnumInfo(value.second, enumValue);
+        } else {
+            qCDebug(PX4ParameterMetaDataLog) << "Invalid enum value, name:" << metaData->name()
+                                             << " type:" << metaData->type() << " value:" << value.first
+                                             << " error:" << errorString;
+        }
+    }
+
+    if (!record.increment.isEmpty()) {
+        bool ok;
+        double increment = record.increment.toDouble(&ok);
+        if (ok) {
+            metaData->setRawIncrement(increment);
+        } else {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid value for increment, name:" << metaData->name() << " increment:" << record.increment;
+        }
+    }
+
+    if (record.flags & ParameterMetaDataCache::Boolean) {
+        QVariant enumValue;
+        metaData->convertAndValidateRaw(1, false /* validate */, enumValue, errorString);
+        metaData->addEnumInfo(tr("Enabled"), enumValue);
+        metaData->convertAndValidateRaw(0, false /* validate */, enumValue, errorString);
+        metaData->addEnumInfo(tr("Disabled"), enumValue);
+    }
+
+    for (const QPair<QString, QString>& bitmask: record.bitmask) {
+        unsigned char bit = bitmask.first.toUInt();
+        if (bit < 32) {
+            QVariant bitmaskRawValue = 1 << bit;
+            QVariant bitmaskValue;
+            if (metaData->convertAndValidateRaw(bitmaskRawValue, true, bitmaskValue, errorString)) {
+                metaData->addBitmaskInfo(bitmask.second, bitmaskValue);
+            } else {
+                qCDebug(PX4ParameterMetaDataLog) << "Invalid bitmask value, name:" << metaData->name()
+                                                 << " type:" << metaData->type() << " value:" << bitmaskValue
+                                                 << " error:" << errorString;
+            }
+        } else {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid value for bitmask bit, name:" << metaData->name() << " bit:" << bit;
+        }
+    }
+
+    // Validate default value against the final min/max
+    if (metaData->defaultValueAvailable()) {
+        QVariant var;
+
+        if (!metaData->convertAndValidateRaw(metaData->rawDefaultValue(), false /* convertOnly */, var, errorString)) {
+            qCWarning(PX4ParameterMetaDataLog) << "Invalid default value, name:" << metaData->name() << " type:" << metaData->type() << " default:" << metaData->rawDefaultValue() << " error:" << errorString;
+        }
+    }
+
+    return metaData;
 }
 
 #ifdef GENERATE_PARAMETER_JSON
@@ -483,9 +579,14 @@ FactMetaData* PX4ParameterMetaData::getMetaDataForFact(const QString& name, MAV_
     Q_UNUSED(vehicleType)
 
     if (!_mapParameterName2FactMetaData.contains(name)) {
-        qCDebug(PX4ParameterMetaDataLog) << "No metaData for " << name << "using generic metadata";
-        FactMetaData* metaData = new FactMetaData(type, this);
-        _mapParameterName2FactMetaData[name] = metaData;
+        ParameterMetaDataCache::Record record;
+        if (_metaDataCache.find(QString(), name, record)) {
+            _mapParameterName2FactMetaData[name] = _createMetaData(record);
+        } else {
+            qCDebug(PX4ParameterMetaDataLog) << "No metaData for " << name << "using generic metadata";
+            FactMetaData* metaData = new FactMetaData(type, this);
+            _mapParameterName2FactMetaData[name] = metaData;
+        }
     }
 
     return _mapParameterName2FactMetaData[name];
@@ -3,6 +3,7 @@
 
 #include "MAVLinkLib.h"
 #include "FactMetaData.h"
+#include "ParameterMetaDataCache.h"
 
 #include <QtCore/QObject>
 #include <QtCore/QLoggingCategory>
@@ -12,6 +13,8 @@ Q_DECLARE_LOGGING_CATEGORY(PX4ParameterMetaDataLog)
 //#define GENERATE_PARAMETER_JSON
 
 /// Loads and holds parameter fact meta data for PX4 stack
+///     The xml is only parsed the first time a specific meta data file is seen, after that the binary
+///     ParameterMetaDataCache is used. FactMetaData objects are created as each parameter is requested.
 class PX4ParameterMetaData : public QObject
 {
     Q_OBJECT
@@ -24,6 +27,9 @@ class PX4ParameterMetaData : public QObject
 
     static void getParameterMetaDataVersionInfo(const QString& metaDataFile, int& majorVersion, int& minorVersion);
 
+    /// @return true: meta data was loaded from the binary cache instead of parsing the xml
+    bool loadedFromCache(void) const { return _loadedFromCache; }
+
 private:
     enum {
         XmlStateNone,
@@ -35,6 +41,8 @@ class PX4ParameterMetaData : public QObject
     };
 
     QVariant _stringToTypedVariant(const QString& string, FactMetaData::ValueType_t type, bool* convertOk);
+    bool _parseParameterFactMetaDataFile(const QString& metaDataFile, QList<ParameterMetaDataCache::Record>& records);
+    FactMetaData* _createMetaData(const ParameterMetaDataCache::Record& record);
     static void _outputFileWarning(const QString& metaDataFile, const QString& error1, const QString& error2);
 
 #ifdef GENERATE_PARAMETER_JSON
@@ -42,7 +50,9 @@ class PX4ParameterMetaData : public QObject
 #endif
 
     bool                                _parameterMetaDataLoaded        = false;    ///< true: parameter meta data already loaded
-    FactMetaData::NameToMetaDataMap_t   _mapParameterName2FactMetaData;             ///< Maps from a parameter name to FactMetaData
+    bool                                _loadedFromCache                = false;
+    ParameterMetaDataCache              _metaDataCache;                             ///< Raw meta data for all parameters in the file
+    FactMetaData::NameToMetaDataMap_t   _mapParameterName2FactMetaData;             ///< Maps from a parameter name to FactMetaData, filled as parameters are requested
 
     static constexpr const char* kInvalidConverstion = "Internal Error: No support for string parameters";
 
@@ -0,0 +1,322 @@
+#include "ParameterMetaDataCache.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QHash>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+
+#include <algorithm>
+#include <cstring>
+
+QGC_LOGGING_CATEGORY(ParameterMetaDataCacheLog, "FirmwarePlugin.ParameterMetaDataCache")
+
+QString ParameterMetaDataCache::Record::*const ParameterMetaDataCache::_stringFields[StringFieldCount] = {
+    &Record::section,
+    &Record::name,
+    &Record::type,
+    &Record::category,
+    &Record::group,
+    &Record::shortDescription,
+    &Record::longDescription,
+    &Record::units,
+    &Record::min,
+    &Record::max,
+    &Record::defaultValue,
+    &Record::increment,
+    &Record::decimalPlaces,
+};
+
+QByteArray ParameterMetaDataCache::hashFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(ParameterMetaDataCacheLog) << "Unable to open file for hashing" << fileName << file.errorString();
+        return QByteArray();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (!hash.addData(&file)) {
+        return QByteArray();
+    }
+
+    return hash.result();
+}
+
+QString ParameterMetaDataCache::cacheFileName(const QByteArray &sourceHash)
+{
+    const QString cacheDir = !_cacheDirectory.isEmpty() ? _cacheDirectory
+                                                        : QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/QGCParamMetaDataCache");
+    return QDir(cacheDir).filePath(QString::fromLatin1(sourceHash.toHex()) + QLatin1String(".pmd"));
+}
+
+QByteArray ParameterMetaDataCache::build(const QList<Record> &records, const QByteArray &sourceHash)
+{
+    // Intern all strings, index 0 is always the empty string
+    QList<QByteArray> strings = { QByteArray() };
+    QHash<QString, quint32> stringIndices = { { QString(), 0 } };
+    const auto intern = [&strings, &stringIndices](const QString &string) -> quint32 {
+        const auto it = stringIndices.constFind(string);
+        if (it != stringIndices.constEnd()) {
+            return it.value();
+        }
+        const quint32 index = static_cast<quint32>(strings.count());
+        strings.append(string.toUtf8());
+        stringIndices.insert(string, index);
+        return index;
+    };
+
+    QList<RecordData> recordData;
+    QList<PairData> pairData;
+    recordData.reserve(records.count());
+    for (const Record &record : records) {
+        RecordData data{};
+        for (int field = 0; field < StringFieldCount; field++) {
+            data.strings[field] = intern(record.*_stringFields[field]);
+        }
+        data.flags = record.flags;
+        data.valuesStart = static_cast<quint32>(pairData.count());
+        data.valuesCount = static_cast<quint32>(record.values.count());
+        for (const QPair<QString, QString> &value : record.values) {
+            pairData.append({ intern(value.first), intern(value.second) });
+        }
+        data.bitmaskStart = static_cast<quint32>(pairData.count());
+        data.bitmaskCount = static_cast<quint32>(record.bitmask.count());
+        for (const QPair<QString, QString> &bit : record.bitmask) {
+            pairData.append({ intern(bit.first), intern(bit.second) });
+        }
+        recordData.append(data);
+    }
+
+    // Sort by section then name using the same utf8 byte ordering as the lookup
+    std::stable_sort(recordData.begin(), recordData.end(), [&strings](const RecordData &a, const RecordData &b) {
+        const int sectionCompare = QByteArrayView(strings[a.strings[SectionField]]).compare(strings[b.strings[SectionField]]);
+        if (sectionCompare != 0) {
+            return sectionCompare < 0;
+        }
+        return QByteArrayView(strings[a.strings[NameField]]).compare(strings[b.strings[NameField]]) < 0;
+    });
+
+    QList<StringRef> stringRefs;
+    stringRefs.reserve(strings.count());
+    quint32 stringDataSize = 0;
+    for (const QByteArray &string : strings) {
+        stringRefs.append({ stringDataSize, static_cast<quint32>(string.size()) });
+        stringDataSize += static_cast<quint32>(string.size());
+    }
+
+    // Fixed size arrays first so every table is 4 byte aligned, string data last
+    Header header{};
+    header.magic = _magic;
+    header.version = kFormatVersion;
+    (void) std::memcpy(header.sourceHash, sourceHash.constData(), std::min(sizeof(header.sourceHash), static_cast<size_t>(sourceHash.size())));
+    header.stringCount = static_cast<quint32>(stringRefs.count());
+    header.stringRefOffset = sizeof(Header);
+    header.recordCount = static_cast<quint32>(recordData.count());
+    header.recordOffset = header.stringRefOffset + (header.stringCount * sizeof(StringRef));
+    header.pairCount = static_cast<quint32>(pairData.count());
+    header.pairOffset = header.recordOffset + (header.recordCount * sizeof(RecordData));
+    header.stringDataOffset = header.pairOffset + (header.pairCount * sizeof(PairData));
+    header.totalSize = header.stringDataOffset + stringDataSize;
+
+    QByteArray blob;
+    blob.reserve(header.totalSize);
+    (void) blob.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    (void) blob.append(reinterpret_cast<const char *>(stringRefs.constData()), stringRefs.count() * sizeof(StringRef));
+    (void) blob.append(reinterpret_cast<const char *>(recordData.constData()), recordData.count() * sizeof(RecordData));
+    (void) blob.append(reinterpret_cast<const char *>(pairData.constData()), pairData.count() * sizeof(PairData));
+    for (const QByteArray &string : strings) {
+        (void) blob.append(string);
+    }
+
+    qCDebug(ParameterMetaDataCacheLog) << "Built cache records:strings:bytes" << header.recordCount << header.stringCount << blob.size();
+
+    return blob;
+}
+
+bool ParameterMetaDataCache::save(const QByteArray &blob, const QByteArray &sourceHash)
+{
+    const QString fileName = cacheFileName(sourceHash);
+    const QFileInfo fileInfo(fileName);
+    QDir cacheDir = fileInfo.absoluteDir();
+    if (!cacheDir.mkpath(QStringLiteral("."))) {
+        qCWarning(ParameterMetaDataCacheLog) << "Unable to create cache directory" << cacheDir.absolutePath();
+        return false;
+    }
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly) || (file.write(blob) != blob.size()) || !file.commit()) {
+        qCWarning(ParameterMetaDataCacheLog) << "Unable to write cache file" << fileName << file.errorString();
+        return false;
+    }
+
+    // Each firmware version has its own meta data, keep only the most recently written ones
+    const QFileInfoList cacheFiles = cacheDir.entryInfoList({ QStringLiteral("*.pmd") }, QDir::Files, QDir::Time);
+    for (qsizetype i = _maxCacheFiles; i < cacheFiles.count(); i++) {
+        (void) QFile::remove(cacheFiles[i].absoluteFilePath());
+    }
+
+    qCDebug(ParameterMetaDataCacheLog) << "Saved" << fileName;
+
+    return true;
+}
+
+bool ParameterMetaDataCache::open(const QByteArray &sourceHash)
+{
+    close();
+
+    if (sourceHash.isEmpty()) {
+        return false;
+    }
+
+    _file.setFileName(cacheFileName(sourceHash));
+    if (!_file.exists()) {
+        qCDebug(ParameterMetaDataCacheLog) << "Cache miss" << _file.fileName();
+        return false;
+    }
+    if (!_file.open(QIODevice::ReadOnly)) {
+        qCWarning(ParameterMetaDataCacheLog) << "Unable to open cache file" << _file.fileName() << _file.errorString();
+        return false;
+    }
+
+    _size = _file.size();
+    _data = (_size > 0) ? _file.map(0, _size) : nullptr;
+    if (!_data) {
+        qCWarning(ParameterMetaDataCacheLog) << "Unable to map cache file" << _file.fileName() << _file.errorString();
+        close();
+        return false;
+    }
+
+    if (!_validate(sourceHash)) {
+        qCDebug(ParameterMetaDataCacheLog) << "Discarding invalid cache file" << _file.fileName();
+        const QString fileName = _file.fileName();
+        close();
+        (void) QFile::remove(fileName);
+        return false;
+    }
+
+    qCDebug(ParameterMetaDataCacheLog) << "Cache hit" << _file.fileName() << "records" << count();
+
+    return true;
+}
+
+bool ParameterMetaDataCache::openData(const QByteArray &blob, const QByteArray &sourceHash)
+{
+    close();
+
+    _blob = blob;
+    _data = reinterpret_cast<const uchar *>(_blob.constData());
+    _size = _blob.size();
+    if (!_validate(sourceHash)) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void ParameterMetaDataCache::close()
+{
+    if (_file.isOpen()) {
+        if (_data) {
+            (void) _file.unmap(const_cast<uchar *>(_data));
+        }
+        _file.close();
+    }
+    _blob.clear();
+    _data = nullptr;
+    _size = 0;
+}
+
+bool ParameterMetaDataCache::_validate(const QByteArray &sourceHash)
+{
+    if (_size < static_cast<qint64>(sizeof(Header))) {
+        return false;
+    }
+
+    const Header &header = _header();
+    if ((header.magic != _magic) || (header.version != kFormatVersion) || (header.totalSize != _size)) {
+        return false;
+    }
+    if ((sourceHash.size() != static_cast<qsizetype>(sizeof(header.sourceHash))) ||
+            (std::memcmp(header.sourceHash, sourceHash.constData(), sizeof(header.sourceHash)) != 0)) {
+        return false;
+    }
+
+    // Tables must be in order and within the blob
+    const quint64 stringRefEnd = static_cast<quint64>(header.stringRefOffset) + (static_cast<quint64>(header.stringCount) * sizeof(StringRef));
+    const quint64 recordEnd = static_cast<quint64>(header.recordOffset) + (static_cast<quint64>(header.recordCount) * sizeof(RecordData));
+    const quint64 pairEnd = static_cast<quint64>(header.pairOffset) + (static_cast<quint64>(header.pairCount) * sizeof(PairData));
+    if ((header.stringRefOffset < sizeof(Header)) || (stringRefEnd > header.recordOffset) || (recordEnd > header.pairOffset) ||
+            (pairEnd > header.stringDataOffset) || (header.stringDataOffset > header.totalSize) || (header.stringCount == 0)) {
+        return false;
+    }
+
+    return true;
+}
+
+QByteArrayView ParameterMetaDataCache::_stringView(quint32 index) const
+{
+    const Header &header = _header();
+    if (index >= header.stringCount) {
+        return QByteArrayView();
+    }
+
+    const StringRef &ref = _stringRefs()[index];
+    if ((static_cast<quint64>(header.stringDataOffset) + ref.offset + ref.size) > header.totalSize) {
+        return QByteArrayView();
+    }
+
+    return QByteArrayView(reinterpret_cast<const char *>(_data + header.stringDataOffset + ref.offset), ref.size);
+}
+
+int ParameterMetaDataCache::count() const
+{
+    return isOpen() ? static_cast<int>(_header().recordCount) : 0;
+}
+
+bool ParameterMetaDataCache::find(const QString &section, const QString &name, Record &record) const
+{
+    if (!isOpen()) {
+        return false;
+    }
+
+    const QByteArray sectionUtf8 = section.toUtf8();
+    const QByteArray nameUtf8 = name.toUtf8();
+    const RecordData *const begin = _records();
+    const RecordData *const end = begin + _header().recordCount;
+    const RecordData *const found = std::lower_bound(begin, end, 0, [this, &sectionUtf8, &nameUtf8](const RecordData &data, int) {
+        const int sectionCompare = _stringView(data.strings[SectionField]).compare(sectionUtf8);
+        if (sectionCompare != 0) {
+            return sectionCompare < 0;
+        }
+        return _stringView(data.strings[NameField]).compare(nameUtf8) < 0;
+    });
+    if ((found == end) || (_stringView(found->strings[SectionField]) != sectionUtf8) || (_stringView(found->strings[NameField]) != nameUtf8)) {
+        return false;
+    }
+
+    record = Record();
+    for (int field = 0; field < StringFieldCount; field++) {
+        record.*_stringFields[field] = _string(found->strings[field]);
+    }
+    record.flags = found->flags;
+
+    const quint32 pairCount = _header().pairCount;
+    if ((static_cast<quint64>(found->valuesStart) + found->valuesCount <= pairCount) &&
+            (static_cast<quint64>(found->bitmaskStart) + found->bitmaskCount <= pairCount)) {
+        const PairData *const pairs = _pairs();
+        record.values.reserve(found->valuesCount);
+        for (quint32 i = found->valuesStart; i < found->valuesStart + found->valuesCount; i++) {
+            record.values.append({ _string(pairs[i].first), _string(pairs[i].second) });
+        }
+        record.bitmask.reserve(found->bitmaskCount);
+        for (quint32 i = found->bitmaskStart; i < found->bitmaskStart + found->bitmaskCount; i++) {
+            record.bitmask.append({ _string(pairs[i].first), _string(pairs[i].second) });
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QFile>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+
+Q_DECLARE_LOGGING_CATEGORY(ParameterMetaDataCacheLog)
+
+/// Versioned binary cache for the parameter meta data parsed from a firmware parameter meta data xml file.
+///     A cache file holds a deduplicated string table, the parameter records and their enum/bitmask pairs in a
+///     single blob which is memory mapped when opened. Records are sorted by section and name, so lookups binary
+///     search the mapping directly and only the parameters which are actually used are converted back to QStrings.
+///     Cache files are keyed by a hash of the xml contents, an updated meta data file is reparsed automatically.
+///     The blob is stored in native byte order since it never leaves the machine which created it.
+class ParameterMetaDataCache
+{
+public:
+    /// Raw meta data for a single parameter. Values are kept as the strings from the xml since they can only be
+    /// converted once the type of the Fact is known.
+    struct Record {
+        QString section;            ///< Firmware specific grouping, for example the ArduPilot vehicle type
+        QString name;
+        QString type;
+        QString category;
+        QString group;
+        QString shortDescription;
+        QString longDescription;
+        QString units;
+        QString min;
+        QString max;
+        QString defaultValue;
+        QString increment;
+        QString decimalPlaces;
+        quint32 flags = 0;
+        QList<QPair<QString, QString>> values;     ///< value, description
+        QList<QPair<QString, QString>> bitmask;    ///< bit, description
+    };
+
+    enum RecordFlag : quint32 {
+        RebootRequired  = 1 << 0,
+        ReadOnly        = 1 << 1,
+        Volatile        = 1 << 2,
+        Boolean         = 1 << 3,   ///< Enabled/Disabled enum values should be added
+        Duplicate       = 1 << 4,   ///< Parameter was found more than once in the source, meta data is not trustworthy
+    };
+
+    ParameterMetaDataCache() = default;
+    ~ParameterMetaDataCache() { close(); }
+
+    /// @return Hash which identifies the contents of the meta data source file, empty if the file can't be read
+    static QByteArray hashFile(const QString &fileName);
+
+    /// @return Path of the cache file for the specified source hash
+    static QString cacheFileName(const QByteArray &sourceHash);
+
+    /// Overrides the directory cache files are stored in, an empty directory restores the default. Used by unit tests.
+    static void setCacheDirectory(const QString &directory) { _cacheDirectory = directory; }
+
+    /// Serializes the records into the binary cache format
+    static QByteArray build(const QList<Record> &records, const QByteArray &sourceHash);
+
+    /// Writes the blob to the cache file for the source hash, pruning the oldest cache files if there are too many
+    static bool save(const QByteArray &blob, const QByteArray &sourceHash);
+
+    /// Maps the cache file for the source hash
+    /// @return false: No cache file, or the file was written by a different format version
+    bool open(const QByteArray &sourceHash);
+
+    /// Uses a blob held in memory, for example one which was just built, instead of a cache file
+    bool openData(const QByteArray &blob, const QByteArray &sourceHash);
+
+    void close();
+    bool isOpen() const { return _data != nullptr; }
+
+    /// @return Number of records
+    int count() const;
+
+    /// @return true: Record found and returned in record
+    bool find(const QString &section, const QString &name, Record &record) const;
+
+    static constexpr quint32 kFormatVersion = 1;
+
+private:
+    enum StringField {
+        SectionField,
+        NameField,
+        TypeField,
+        CategoryField,
+        GroupField,
+        ShortDescriptionField,
+        LongDescriptionField,
+        UnitsField,
+        MinField,
+        MaxField,
+        DefaultValueField,
+        IncrementField,
+        DecimalPlacesField,
+        StringFieldCount
+    };
+
+    struct Header {
+        quint32 magic;
+        quint32 version;
+        quint8  sourceHash[32];
+        quint32 totalSize;
+        quint32 stringCount;
+        quint32 stringRefOffset;
+        quint32 stringDataOffset;
+        quint32 recordCount;
+        quint32 recordOffset;
+        quint32 pairCount;
+        quint32 pairOffset;
+    };
+
+    struct StringRef {
+        quint32 offset;     ///< Relative to stringDataOffset
+        quint32 size;       ///< Utf8 bytes
+    };
+
+    struct RecordData {
+        quint32 strings[StringFieldCount];
+        quint32 flags;
+        quint32 valuesStart;
+        quint32 valuesCount;
+        quint32 bitmaskStart;
+        quint32 bitmaskCount;
+    };
+
+    struct PairData {
+        quint32 first;
+        quint32 second;
+    };
+
+    static QString Record::*const _stringFields[StringFieldCount];
+
+    bool _validate(const QByteArray &sourceHash);
+    QByteArrayView _stringView(quint32 index) const;
+    QString _string(quint32 index) const { return QString::fromUtf8(_stringView(index)); }
+    const Header &_header() const { return *reinterpret_cast<const Header *>(_data); }
+    const RecordData *_records() const { return reinterpret_cast<const RecordData *>(_data + _header().recordOffset); }
+    const PairData *_pairs() const { return reinterpret_cast<const PairData *>(_data + _header().pairOffset); }
+    const StringRef *_stringRefs() const { return reinterpret_cast<const StringRef *>(_data + _header().stringRefOffset); }
+
+    QFile _file;
+    QByteArray _blob;               ///< Backing store when not using a mapped file
+    const uchar *_data = nullptr;
+    qint64 _size = 0;
+
+    static inline QString _cacheDirectory;          ///< Empty: QGCParamMetaDataCache in the standard cache location
+    static constexpr quint32 _magic = 0x444d5051;   ///< "QPMD"
+    static constexpr int _maxCacheFiles = 10;
+
+    Q_DISABLE_COPY(ParameterMetaDataCache)
+};
@@ -121,7 +121,7 @@ private slots:
     double                              _imageFootprintFrontal      = 0;
     QVariantList                        _knownCameraList;
 
-    QMap<QString, FactMetaData*> _metaDataMap;
+    const QMap<QString, FactMetaData*>& _metaDataMap;
 
     SettingsFact _cameraNameFact;
     SettingsFact _valueSetIsDistanceFact;
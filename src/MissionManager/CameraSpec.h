@@ -42,7 +42,7 @@ class CameraSpec : public QObject
 private:
     bool _dirty;
 
-    QMap<QString, FactMetaData*> _metaDataMap;
+    const QMap<QString, FactMetaData*>& _metaDataMap;
 
     SettingsFact _sensorWidthFact;
     SettingsFact _sensorHeightFact;
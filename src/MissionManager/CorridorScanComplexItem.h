@@ -82,7 +82,7 @@ private slots:
 
     EntryPointLocation              _entryPointLocation;
 
-    QMap<QString, FactMetaData*>    _metaDataMap;
+    const QMap<QString, FactMetaData*>&   _metaDataMap;
     SettingsFact                    _corridorWidthFact;
 
     static constexpr const char* _jsonEntryPointKey =       "EntryPoint";
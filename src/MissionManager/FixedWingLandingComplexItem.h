@@ -67,7 +67,7 @@ private slots:
     void            _calcGlideSlope         (void) final;
     MissionItem*    _createLandItem         (int seqNum, bool altRel, double lat, double lon, double alt, QObject* parent) final;
 
-    QMap<QString, FactMetaData*> _metaDataMap;
+    const QMap<QString, FactMetaData*>& _metaDataMap;
 
     Fact            _landingDistanceFact;
     Fact            _finalApproachAltitudeFact;
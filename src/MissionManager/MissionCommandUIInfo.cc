@@ -40,9 +40,38 @@ const MissionCmdParamInfo& MissionCmdParamInfo::operator=(const MissionCmdParamI
     _userMin =          other._userMin;
     _userMax =          other._userMax;
 
+    // Shared meta data reflects the previous values, rebuild on next use. The previous object stays alive as a child of
+    // this object since Facts created before the assignment may still reference it.
+    _factMetaData = nullptr;
+
     return *this;
 }
 
+FactMetaData* MissionCmdParamInfo::factMetaData(void) const
+{
+    if (!_factMetaData) {
+        _factMetaData = new FactMetaData(FactMetaData::valueTypeDouble, const_cast<MissionCmdParamInfo*>(this));
+        _factMetaData->setName(_label);
+        _factMetaData->setDecimalPlaces(_decimalPlaces);
+        if (!_enumStrings.isEmpty()) {
+            _factMetaData->setEnumInfo(_enumStrings, _enumValues);
+        }
+        _factMetaData->setRawUnits(_units);
+        _factMetaData->setRawDefaultValue(_defaultValue);
+        _factMetaData->setRawMin(_min);
+        _factMetaData->setRawMax(_max);
+        // if user min/max are NaN, we leave them unset (invalid)
+        if (!qIsNaN(_userMin)) {
+            _factMetaData->setRawUserMin(_userMin);
+        }
+        if (!qIsNaN(_userMax)) {
+            _factMetaData->setRawUserMax(_userMax);
+        }
+    }
+
+    return _factMetaData;
+}
+
 MissionCommandUIInfo::MissionCommandUIInfo(QObject* parent)
     : QObject(parent)
 {
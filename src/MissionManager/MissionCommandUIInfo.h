@@ -8,6 +8,7 @@
 
 Q_DECLARE_LOGGING_CATEGORY(MissionCommandsLog)
 
+class FactMetaData;
 class MissionCommandTree;
 class MissionCommandUIInfo;
 #ifdef QGC_UNITTEST_BUILD
@@ -76,6 +77,11 @@ class MissionCmdParamInfo : public QObject {
     double          userMax         (void) const { return _userMax; }
     bool            advanced        (void) const { return _advanced; }
 
+    /// Returns the FactMetaData for editing this parameter. It is created on first use and shared by all mission items which
+    /// reference this parameter, so callers must not modify it. Assignment creates a new object on next use, the previous one
+    /// remains valid for the lifetime of this object.
+    FactMetaData*   factMetaData    (void) const;
+
 private:
     int             _decimalPlaces;
     double          _defaultValue;
@@ -91,6 +97,8 @@ class MissionCmdParamInfo : public QObject {
     double          _userMin;
     double          _userMax;
 
+    mutable FactMetaData* _factMetaData = nullptr;
+
     friend class MissionCommandTree;
     friend class MissionCommandUIInfo;
 };
@@ -2,6 +2,7 @@
 #include "Vehicle.h"
 #include "MissionManager.h"
 #include "FlightPathSegment.h"
+#include "FactMetaData.h"
 #include "FirmwarePlugin.h"
 #include "QGCApplication.h"
 #include "SimpleMissionItem.h"
@@ -24,6 +25,7 @@
 #include "QGC.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtCore/QHash>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 
@@ -799,15 +801,15 @@ bool MissionController::_loadJsonMissionFileV2(const QJsonObject& json, QmlObjec
         QString itemType = itemObject[VisualMissionItem::jsonTypeKey].toString();
 
         if (itemType == VisualMissionItem::jsonTypeSimpleItemValue) {
-            SimpleMissionItem* simpleItem = new SimpleMissionItem(_masterController, _flyView, true /* forLoad */);
+            // Peek at the command so takeoff items are created as a TakeoffMissionItem up front instead of
+            // being loaded twice. This matters for large plans where item construction dominates load time.
+            SimpleMissionItem* simpleItem = nullptr;
+            if (TakeoffMissionItem::isTakeoffCommand(static_cast<MAV_CMD>(itemObject[MissionItem::_jsonCommandKey].toInt()))) {
+                simpleItem = new TakeoffMissionItem(_masterController, _flyView, settingsItem, true /* forLoad */);
+            } else {
+                simpleItem = new SimpleMissionItem(_masterController, _flyView, true /* forLoad */);
+            }
             if (simpleItem->load(itemObject, nextSequenceNumber, errorString)) {
-                if (TakeoffMissionItem::isTakeoffCommand(static_cast<MAV_CMD>(simpleItem->command()))) {
-                    // This needs to be a TakeoffMissionItem
-                    TakeoffMissionItem* takeoffItem = new TakeoffMissionItem(_masterController, _flyView, settingsItem, true /* forLoad */);
-                    takeoffItem->load(itemObject, nextSequenceNumber, errorString);
-                    simpleItem->deleteLater();
-                    simpleItem = takeoffItem;
-                }
                 qCDebug(MissionControllerLog) << "Loading simple item: nextSequenceNumber:command" << nextSequenceNumber << simpleItem->command();
                 nextSequenceNumber = simpleItem->lastSequenceNumber() + 1;
                 visualItems->append(simpleItem);
@@ -877,30 +879,32 @@ bool MissionController::_loadJsonMissionFileV2(const QJsonObject& json, QmlObjec
         }
     }
 
-    // Fix up the DO_JUMP commands jump sequence number by finding the item with the matching doJumpId
+    // Fix up the DO_JUMP commands jump sequence number by finding the item with the matching doJumpId.
+    // Build a doJumpId -> sequence number index first so this stays linear for large plans.
+    QHash<int, int> doJumpIdToSequence;
+    QList<SimpleMissionItem*> doJumpItems;
+    doJumpIdToSequence.reserve(visualItems->count());
     for (int i=0; i<visualItems->count(); i++) {
         if (visualItems->value<VisualMissionItem*>(i)->isSimpleItem()) {
-            SimpleMissionItem* doJumpItem = visualItems->value<SimpleMissionItem*>(i);
-            if (doJumpItem->command() == MAV_CMD_DO_JUMP) {
-                bool found = false;
-                int findDoJumpId = static_cast<int>(doJumpItem->missionItem().param1());
-                for (int j=0; j<visualItems->count(); j++) {
-                    if (visualItems->value<VisualMissionItem*>(j)->isSimpleItem()) {
-                        SimpleMissionItem* targetItem = visualItems->value<SimpleMissionItem*>(j);
-                        if (targetItem->missionItem().doJumpId() == findDoJumpId) {
-                            doJumpItem->missionItem().setParam1(targetItem->sequenceNumber());
-                            found = true;
-                            break;
-                        }
-                    }
-                }
-                if (!found) {
-                    errorString = tr("Could not find doJumpId: %1").arg(findDoJumpId);
-                    return false;
-                }
+            SimpleMissionItem* simpleItem = visualItems->value<SimpleMissionItem*>(i);
+            // First item wins to match the previous linear search behavior
+            if (!doJumpIdToSequence.contains(simpleItem->missionItem().doJumpId())) {
+                doJumpIdToSequence.insert(simpleItem->missionItem().doJumpId(), simpleItem->sequenceNumber());
+            }
+            if (simpleItem->command() == MAV_CMD_DO_JUMP) {
+                doJumpItems.append(simpleItem);
             }
         }
     }
+    for (SimpleMissionItem* doJumpItem: doJumpItems) {
+        const int findDoJumpId = static_cast<int>(doJumpItem->missionItem().param1());
+        const auto it = doJumpIdToSequence.constFind(findDoJumpId);
+        if (it == doJumpIdToSequence.constEnd()) {
+            errorString = tr("Could not find doJumpId: %1").arg(findDoJumpId);
+            return false;
+        }
+        doJumpItem->missionItem().setParam1(it.value());
+    }
 
     return true;
 }
@@ -1019,10 +1023,34 @@ bool MissionController::load(const QJsonObject& json, QString& errorString)
         return false;
     }
     _initLoadedVisualItems(loadedVisualItems);
+    _logMetaDataMemoryReport();
 
     return true;
 }
 
+void MissionController::_logMetaDataMemoryReport(void) const
+{
+    if (!MissionControllerLog().isDebugEnabled()) {
+        return;
+    }
+
+    int simpleItemCount = 0;
+    for (int i=0; i<_visualItems->count(); i++) {
+        if (_visualItems->value<VisualMissionItem*>(i)->isSimpleItem()) {
+            simpleItemCount++;
+        }
+    }
+
+    // Simple items used to carry seven private param FactMetaData objects each, they now share the ones owned by MissionCmdParamInfo
+    const qsizetype paramMetaDataBytes = 7 * FactMetaData(FactMetaData::valueTypeDouble).approximateFootprint();
+    qCDebug(MissionControllerLog) << "Meta data memory report - simple items:" << simpleItemCount
+                                  << "param meta data per item unshared:" << paramMetaDataBytes << "bytes, shared: 0 bytes"
+                                  << "total saved:" << paramMetaDataBytes * simpleItemCount << "bytes";
+    for (const QString& line: FactMetaData::sharedMapMemoryReport()) {
+        qCDebug(MissionControllerLog) << "Meta data memory report -" << line;
+    }
+}
+
 bool MissionController::loadTextFile(QFile& file, QString& errorString)
 {
     QString     errorStr;
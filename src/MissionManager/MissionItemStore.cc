@@ -0,0 +1,107 @@
+#include "MissionItemStore.h"
+#include "MissionItem.h"
+
+#include <bit>
+
+MissionItemStore::MissionItemStore(const QList<MissionItem*>& missionItems)
+{
+    reserve(static_cast<int>(missionItems.count()));
+    for (const MissionItem* missionItem: missionItems) {
+        append(*missionItem);
+    }
+}
+
+void MissionItemStore::clear(void)
+{
+    _command.clear();
+    _frame.clear();
+    _autoContinue.clear();
+    _params.clear();
+    _x.clear();
+    _y.clear();
+}
+
+void MissionItemStore::reserve(int count)
+{
+    _command.reserve(count);
+    _frame.reserve(count);
+    _autoContinue.reserve(count);
+    _params.reserve(count * _cFloatParams);
+    _x.reserve(count);
+    _y.reserve(count);
+}
+
+void MissionItemStore::append(const MissionItem& missionItem)
+{
+    const uint8_t frame = static_cast<uint8_t>(missionItem.frame());
+
+    _command.append(static_cast<uint16_t>(missionItem.command()));
+    _frame.append(frame);
+    _autoContinue.append(missionItem.autoContinue() ? 1 : 0);
+    _params.append(static_cast<float>(missionItem.param1()));
+    _params.append(static_cast<float>(missionItem.param2()));
+    _params.append(static_cast<float>(missionItem.param3()));
+    _params.append(static_cast<float>(missionItem.param4()));
+    _params.append(static_cast<float>(missionItem.param7()));
+    if (_isIntegerScaledFrame(frame)) {
+        _x.append(static_cast<int32_t>(missionItem.param5() * 1e7));
+        _y.append(static_cast<int32_t>(missionItem.param6() * 1e7));
+    } else {
+        _x.append(static_cast<int32_t>(missionItem.param5()));
+        _y.append(static_cast<int32_t>(missionItem.param6()));
+    }
+}
+
+void MissionItemStore::append(const mavlink_mission_item_int_t& missionItem)
+{
+    _command.append(missionItem.command);
+    _frame.append(missionItem.frame);
+    _autoContinue.append(missionItem.autocontinue);
+    _params.append(missionItem.param1);
+    _params.append(missionItem.param2);
+    _params.append(missionItem.param3);
+    _params.append(missionItem.param4);
+    _params.append(missionItem.z);
+    _x.append(missionItem.x);
+    _y.append(missionItem.y);
+}
+
+void MissionItemStore::encode(int index, uint16_t seq, bool current, mavlink_mission_item_int_t& missionItem) const
+{
+    const float* params = &_params[index * _cFloatParams];
+
+    missionItem.param1          = params[0];
+    missionItem.param2          = params[1];
+    missionItem.param3          = params[2];
+    missionItem.param4          = params[3];
+    missionItem.x               = _x[index];
+    missionItem.y               = _y[index];
+    missionItem.z               = params[4];
+    missionItem.seq             = seq;
+    missionItem.command         = _command[index];
+    missionItem.frame           = _frame[index];
+    missionItem.current         = current ? 1 : 0;
+    missionItem.autocontinue    = _autoContinue[index];
+}
+
+bool MissionItemStore::isEqual(int index, const MissionItemStore& other, int otherIndex) const
+{
+    if (_command[index] != other._command[otherIndex] ||
+            _frame[index] != other._frame[otherIndex] ||
+            _autoContinue[index] != other._autoContinue[otherIndex] ||
+            _x[index] != other._x[otherIndex] ||
+            _y[index] != other._y[otherIndex]) {
+        return false;
+    }
+
+    // Compare bit patterns so unset (NaN) params compare equal to each other
+    const float* params = &_params[index * _cFloatParams];
+    const float* otherParams = &other._params[otherIndex * _cFloatParams];
+    for (int i=0; i<_cFloatParams; i++) {
+        if (std::bit_cast<uint32_t>(params[i]) != std::bit_cast<uint32_t>(otherParams[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QtCore/QList>
+
+#include "QGCMAVLink.h"
+
+class MissionItem;
+
+/// Compact, struct-of-arrays storage for a list of mission items in their MISSION_ITEM_INT wire representation.
+///     Values are converted from the MissionItem Facts once when the store is built. From then on items can be
+///     encoded into mavlink_mission_item_int_t and compared against each other without going through QVariant.
+///     The sequence number of an item is its index in the store.
+class MissionItemStore
+{
+public:
+    MissionItemStore() = default;
+
+    /// Builds the store from the specified mission items. Items are stored in list order.
+    explicit MissionItemStore(const QList<MissionItem*>& missionItems);
+
+    int  count  (void) const { return static_cast<int>(_command.count()); }
+    bool isEmpty(void) const { return _command.isEmpty(); }
+    void clear  (void);
+    void reserve(int count);
+
+    /// Appends the item converting from double params to the wire representation
+    void append(const MissionItem& missionItem);
+
+    /// Appends an item which is already in its wire representation
+    void append(const mavlink_mission_item_int_t& missionItem);
+
+    MAV_CMD   command       (int index) const { return static_cast<MAV_CMD>(_command[index]); }
+    MAV_FRAME frame         (int index) const { return static_cast<MAV_FRAME>(_frame[index]); }
+    bool      autoContinue  (int index) const { return _autoContinue[index] != 0; }
+
+    /// @return param1-param4 as sent to the vehicle
+    float param(int index, int paramIndex) const { return _params[(index * _cFloatParams) + paramIndex]; }
+
+    /// Encodes the item into the mavlink structure. Only the target and mission type fields are left for the caller
+    /// to fill in.
+    ///     @param seq Sequence number to send the item with
+    ///     @param current true: item is the current mission item
+    void encode(int index, uint16_t seq, bool current, mavlink_mission_item_int_t& missionItem) const;
+
+    /// @return true: the two items will result in identical MISSION_ITEM_INT messages (sequence number excluded)
+    bool isEqual(int index, const MissionItemStore& other, int otherIndex) const;
+
+    /// @return Approximate number of bytes used by the store per item
+    static constexpr int bytesPerItem(void) { return sizeof(uint16_t) + (2 * sizeof(uint8_t)) + (_cFloatParams * sizeof(float)) + (2 * sizeof(int32_t)); }
+
+private:
+    static constexpr int _cFloatParams = 5; ///< param1-param4 and z
+
+    static bool _isIntegerScaledFrame(uint8_t frame) { return frame != MAV_FRAME_MISSION; }
+
+    QList<uint16_t> _command;
+    QList<uint8_t>  _frame;
+    QList<uint8_t>  _autoContinue;
+    QList<float>    _params;    ///< param1, param2, param3, param4, z interleaved per item
+    QList<int32_t>  _x;
+    QList<int32_t>  _y;
+};
@@ -223,6 +223,10 @@ void MissionManager::_mavlinkMessageReceived(const mavlink_message_t& message)
         _handleMissionCurrent(message);
         break;
 
+    case MAVLINK_MSG_ID_MISSION_ACK:
+        _handleMissionAck(message);
+        break;
+
     case MAVLINK_MSG_ID_HEARTBEAT:
         _handleHeartbeat(message);
         break;
@@ -268,6 +272,29 @@ void MissionManager::_handleMissionCurrent(const mavlink_message_t& message)
     mavlink_mission_current_t missionCurrent;
     mavlink_msg_mission_current_decode(&message, &missionCurrent);
     _updateMissionIndex(missionCurrent.seq);
+
+    // mission_id is the opaque_id of the mission currently on the vehicle. A different value means the mission was
+    // changed by someone else. While a transaction is running the id legitimately changes, the transaction tracks it.
+    if (!inProgress() && _vehicleItemStoreValid && missionCurrent.mission_id != 0 && missionCurrent.mission_id != _vehicleOpaqueId) {
+        invalidateVehicleItemStore(QStringLiteral("MISSION_CURRENT mission_id changed %1 -> %2").arg(_vehicleOpaqueId).arg(missionCurrent.mission_id));
+    }
+}
+
+void MissionManager::_handleMissionAck(const mavlink_message_t& message)
+{
+    // Acks for our own transactions are handled by PlanManager
+    if (inProgress()) {
+        return;
+    }
+
+    mavlink_mission_ack_t missionAck;
+    mavlink_msg_mission_ack_decode(&message, &missionAck);
+
+    // An ack outside of one of our transactions means the vehicle finished a mission upload from another source
+    if (missionAck.mission_type == MAV_MISSION_TYPE_MISSION && _vehicleItemStoreValid &&
+            (missionAck.opaque_id == 0 || missionAck.opaque_id != _vehicleOpaqueId)) {
+        invalidateVehicleItemStore(QStringLiteral("MISSION_ACK outside of transaction opaque_id:%1").arg(missionAck.opaque_id));
+    }
 }
 
 void MissionManager::_handleHeartbeat(const mavlink_message_t& message)
@@ -39,6 +39,7 @@ private slots:
     void _handleHighLatency(const mavlink_message_t& message);
     void _handleHighLatency2(const mavlink_message_t& message);
     void _handleMissionCurrent(const mavlink_message_t& message);
+    void _handleMissionAck(const mavlink_message_t& message);
     void _updateMissionIndex(int index);
     void _handleHeartbeat(const mavlink_message_t& message);
 
@@ -0,0 +1,250 @@
+#include "PlanFileStream.h"
+#include "JsonHelper.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QIODevice>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+
+#include <cmath>
+#include <iterator>
+
+QGC_LOGGING_CATEGORY(PlanFileStreamLog, "PlanManager.PlanFileStream")
+
+namespace PlanFileStream
+{
+    /// Buffered json serializer which flushes to the device each time kWriteChunkSize is reached
+    class _JsonWriter
+    {
+    public:
+        explicit _JsonWriter(QIODevice &device)
+            : _device(device)
+        {
+            _buffer.reserve(kWriteChunkSize + 1024);
+        }
+
+        bool writeObject(const QJsonObject &object, int indent);
+        bool writeArray(const QJsonArray &array, int indent);
+        bool writeValue(const QJsonValue &value, int indent);
+        bool flush();
+        void newline() { _buffer.append('\n'); }
+
+    private:
+        void _writeIndent(int indent) { _buffer.append(indent * 4, ' '); }
+        void _writeString(const QString &string);
+        void _writeDouble(double value);
+        bool _flushIfFull() { return (_buffer.size() >= kWriteChunkSize) ? flush() : true; }
+
+        QIODevice &_device;
+        QByteArray _buffer;
+    };
+}
+
+bool PlanFileStream::_JsonWriter::flush()
+{
+    if (_buffer.isEmpty()) {
+        return true;
+    }
+
+    const qint64 written = _device.write(_buffer);
+    const bool success = (written == _buffer.size());
+    _buffer.clear();
+
+    return success;
+}
+
+void PlanFileStream::_JsonWriter::_writeString(const QString &string)
+{
+    const QByteArray utf8 = string.toUtf8();
+
+    _buffer.append('"');
+    for (const char c : utf8) {
+        switch (c) {
+        case '"':
+            _buffer.append("\\\"");
+            break;
+        case '\\':
+            _buffer.append("\\\\");
+            break;
+        case '\b':
+            _buffer.append("\\b");
+            break;
+        case '\f':
+            _buffer.append("\\f");
+            break;
+        case '\n':
+            _buffer.append("\\n");
+            break;
+        case '\r':
+            _buffer.append("\\r");
+            break;
+        case '\t':
+            _buffer.append("\\t");
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                _buffer.append(QStringLiteral("\\u%1").arg(static_cast<int>(c), 4, 16, QLatin1Char('0')).toLatin1());
+            } else {
+                _buffer.append(c);
+            }
+            break;
+        }
+    }
+    _buffer.append('"');
+}
+
+void PlanFileStream::_JsonWriter::_writeDouble(double value)
+{
+    // Match QJsonDocument: non-finite values are not representable in json
+    if (!std::isfinite(value)) {
+        _buffer.append("null");
+    } else if ((value == std::trunc(value)) && (std::abs(value) < 1e15)) {
+        _buffer.append(QByteArray::number(static_cast<qint64>(value)));
+    } else {
+        _buffer.append(QByteArray::number(value, 'g', QLocale::FloatingPointShortest));
+    }
+}
+
+bool PlanFileStream::_JsonWriter::writeValue(const QJsonValue &value, int indent)
+{
+    switch (value.type()) {
+    case QJsonValue::Object:
+        return writeObject(value.toObject(), indent);
+    case QJsonValue::Array:
+        return writeArray(value.toArray(), indent);
+    case QJsonValue::String:
+        _writeString(value.toString());
+        break;
+    case QJsonValue::Double:
+        _writeDouble(value.toDouble());
+        break;
+    case QJsonValue::Bool:
+        _buffer.append(value.toBool() ? "true" : "false");
+        break;
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        _buffer.append("null");
+        break;
+    }
+
+    return true;
+}
+
+bool PlanFileStream::_JsonWriter::writeObject(const QJsonObject &object, int indent)
+{
+    if (object.isEmpty()) {
+        _buffer.append("{\n");
+        _writeIndent(indent);
+        _buffer.append('}');
+        return true;
+    }
+
+    _buffer.append("{\n");
+    for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+        _writeIndent(indent + 1);
+        _writeString(it.key());
+        _buffer.append(": ");
+        if (!writeValue(it.value(), indent + 1)) {
+            return false;
+        }
+        if (std::next(it) != object.constEnd()) {
+            _buffer.append(',');
+        }
+        _buffer.append('\n');
+        if (!_flushIfFull()) {
+            return false;
+        }
+    }
+    _writeIndent(indent);
+    _buffer.append('}');
+
+    return true;
+}
+
+bool PlanFileStream::_JsonWriter::writeArray(const QJsonArray &array, int indent)
+{
+    if (array.isEmpty()) {
+        _buffer.append("[\n");
+        _writeIndent(indent);
+        _buffer.append(']');
+        return true;
+    }
+
+    _buffer.append("[\n");
+    const qsizetype count = array.count();
+    for (qsizetype i = 0; i < count; i++) {
+        _writeIndent(indent + 1);
+        if (!writeValue(array.at(i), indent + 1)) {
+            return false;
+        }
+        if (i != count - 1) {
+            _buffer.append(',');
+        }
+        _buffer.append('\n');
+        if (!_flushIfFull()) {
+            return false;
+        }
+    }
+    _writeIndent(indent);
+    _buffer.append(']');
+
+    return true;
+}
+
+bool PlanFileStream::readJsonObject(const QString &filename, QJsonObject &jsonObject, QString &errorString)
+{
+    errorString.clear();
+    jsonObject = QJsonObject();
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorString = file.errorString() + QStringLiteral(" ") + filename;
+        return false;
+    }
+
+    // Map the file instead of copying it into the heap. Fall back to a normal read for devices
+    // which can't be mapped (Qt resources with compression, empty files, some Android content uris).
+    QJsonDocument jsonDoc;
+    const qint64 fileSize = file.size();
+    uchar *mapped = (fileSize > 0) ? file.map(0, fileSize) : nullptr;
+    if (mapped) {
+        const QByteArray bytes = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), fileSize);
+        const bool isJson = JsonHelper::isJsonFile(bytes, jsonDoc, errorString);
+        (void) file.unmap(mapped);
+        if (!isJson) {
+            return false;
+        }
+    } else {
+        qCDebug(PlanFileStreamLog) << "Unable to map file, reading instead" << filename;
+        if (!JsonHelper::isJsonFile(file.readAll(), jsonDoc, errorString)) {
+            return false;
+        }
+    }
+
+    if (!jsonDoc.isObject()) {
+        errorString = QObject::tr("Root of json file is not an object: %1").arg(filename);
+        return false;
+    }
+
+    jsonObject = jsonDoc.object();
+
+    return true;
+}
+
+bool PlanFileStream::writeJsonObject(QIODevice &device, const QJsonObject &jsonObject, QString &errorString)
+{
+    errorString.clear();
+
+    _JsonWriter writer(device);
+    bool success = writer.writeObject(jsonObject, 0);
+    if (success) {
+        writer.newline();
+        success = writer.flush();
+    }
+    if (!success) {
+        errorString = device.errorString();
+    }
+
+    return success;
+}
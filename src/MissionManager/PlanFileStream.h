@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
+
+class QIODevice;
+
+Q_DECLARE_LOGGING_CATEGORY(PlanFileStreamLog)
+
+/// Low overhead reading and writing of .plan files.
+///     Reading maps the file into memory instead of copying it into a QByteArray before parsing.
+///     Writing serializes the plan directly to the output device in small chunks instead of first
+///     building the full QJsonDocument::toJson byte array, which for plans with tens of thousands of
+///     items can be larger than the json object itself.
+namespace PlanFileStream
+{
+    /// Reads and parses a plan (or any json) file
+    /// @return false: file could not be read or is not valid json
+    bool readJsonObject(const QString &filename,   ///< file to read
+                        QJsonObject &jsonObject,   ///< returned root json object
+                        QString &errorString);     ///< returned error string if read failure
+
+    /// Writes the json object to the device using the same indented format as QJsonDocument::Indented
+    /// @return false: write to device failed
+    bool writeJsonObject(QIODevice &device,                ///< device to write to, must be open for writing
+                         const QJsonObject &jsonObject,    ///< root json object to write
+                         QString &errorString);            ///< returned error string if write failure
+
+    /// Size of the write buffer used by writeJsonObject before flushing to the device
+    constexpr qsizetype kWriteChunkSize = 64 * 1024;
+};
@@ -40,18 +40,72 @@ void PlanManager::_writeMissionItemsWorker(void)
 
     qCDebug(PlanManagerLog) << QStringLiteral("writeMissionItems %1 count:").arg(_planTypeString()) << _writeMissionItems.count();
 
+    // Convert to wire format once up front, requests from the vehicle are then answered straight from the store
+    _writeItemStore = MissionItemStore(_writeMissionItems);
+
+    // Only send the changed items if the vehicle can update them in place
+    _partialWrite = _findChangedItemRange(_writeStartIndex, _writeEndIndex);
+    if (!_partialWrite) {
+        _writeStartIndex = 0;
+        _writeEndIndex = _writeItemStore.count() - 1;
+    }
+
     // Prime write list
-    _itemIndicesToWrite.clear();
-    for (int i=0; i<_writeMissionItems.count(); i++) {
-        _itemIndicesToWrite << i;
+    _itemsToWrite.fill(false, _writeItemStore.count());
+    if (_writeEndIndex >= _writeStartIndex) {
+        _itemsToWrite.fill(true, _writeStartIndex, _writeEndIndex + 1);
     }
+    _itemsToWriteCount = _writeEndIndex - _writeStartIndex + 1;
 
     _retryCount = 0;
     _setTransactionInProgress(TransactionWrite);
     _connectToMavlink();
-    _writeMissionCount();
+    if (_partialWrite) {
+        _writePartialList();
+    } else {
+        _writeMissionCount();
+    }
 }
 
+/// Compares the items to write against the items known to be on the vehicle.
+///     @param[out] startIndex First item which differs
+///     @param[out] endIndex Last item which differs
+///     @return true: Write can be done with MISSION_WRITE_PARTIAL_LIST, false: full write is required
+bool PlanManager::_findChangedItemRange(int& startIndex, int& endIndex) const
+{
+    const int count = _writeItemStore.count();
+
+    if (_planType != MAV_MISSION_TYPE_MISSION || !_vehicleItemStoreValid || count == 0 || count != _vehicleItemStore.count() ||
+            !_vehicle->firmwarePlugin()->supportsMissionPartialWrite()) {
+        return false;
+    }
+
+    // Without an opaque_id there is no way to tell whether the mission was changed behind our back (another GCS,
+    // a companion computer, a reboot). Only patch a mission the vehicle identified as the one we have.
+    if (_vehicleOpaqueId == 0) {
+        qCDebug(PlanManagerLog) << QStringLiteral("_findChangedItemRange %1 vehicle did not report a mission opaque_id, using full write").arg(_planTypeString());
+        return false;
+    }
+
+    startIndex = 0;
+    while (startIndex < count && _writeItemStore.isEqual(startIndex, _vehicleItemStore, startIndex)) {
+        startIndex++;
+    }
+
+    if (startIndex == count) {
+        // Nothing changed. Resend the last item anyway so the caller still gets a vehicle confirmed write.
+        startIndex = endIndex = count - 1;
+    } else {
+        endIndex = count - 1;
+        while (endIndex > startIndex && _writeItemStore.isEqual(endIndex, _vehicleItemStore, endIndex)) {
+            endIndex--;
+        }
+    }
+
+    qCDebug(PlanManagerLog) << QStringLiteral("_findChangedItemRange %1 count:startIndex:endIndex").arg(_planTypeString()) << count << startIndex << endIndex;
+
+    return true;
+}
 
 void PlanManager::writeMissionItems(const QList<MissionItem*>& missionItems)
 {
@@ -109,7 +163,7 @@ void PlanManager::_writeMissionCount(void)
             &message,
             _vehicle->id(),
             MAV_COMP_ID_AUTOPILOT1,
-            _writeMissionItems.count(),
+            _writeItemStore.count(),
             _planType,
             0
         );
@@ -119,6 +173,32 @@ void PlanManager::_writeMissionCount(void)
     _startAckTimeout(AckMissionRequest);
 }
 
+/// This begins a partial write sequence with the vehicle. This may be called during a retry.
+void PlanManager::_writePartialList(void)
+{
+    qCDebug(PlanManagerLog) << QStringLiteral("_writePartialList %1 startIndex:endIndex:_retryCount").arg(_planTypeString()) << _writeStartIndex << _writeEndIndex << _retryCount;
+
+    SharedLinkInterfacePtr sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
+    if (sharedLink) {
+        mavlink_message_t       message;
+
+        mavlink_msg_mission_write_partial_list_pack_chan(
+            MAVLinkProtocol::instance()->getSystemId(),
+            MAVLinkProtocol::getComponentId(),
+            sharedLink->mavlinkChannel(),
+            &message,
+            _vehicle->id(),
+            MAV_COMP_ID_AUTOPILOT1,
+            _writeStartIndex,
+            _writeEndIndex,
+            _planType
+        );
+
+        _vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), message);
+    }
+    _startAckTimeout(AckMissionRequest);
+}
+
 void PlanManager::loadFromVehicle(void)
 {
     if (_vehicle->isOfflineEditingVehicle()) {
@@ -145,6 +225,10 @@ void PlanManager::_requestList(void)
 
     _itemIndicesToRead.clear();
     _clearMissionItems();
+    _vehicleItemStore.clear();
+    _vehicleItemStoreValid = false;
+    _vehicleOpaqueId = 0;
+    _readOpaqueId = 0;
 
     SharedLinkInterfacePtr  sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
     if (sharedLink){
@@ -197,19 +281,24 @@ void PlanManager::_ackTimeout(void)
         break;
     case AckMissionRequest:
         // MISSION_REQUEST is expected, or MISSION_ACK to end sequence
-        if (_itemIndicesToWrite.count() == 0) {
+        if (_itemsToWriteCount == 0) {
             // Vehicle did not send final MISSION_ACK at end of sequence
             _sendError(ProtocolError, tr("Mission write failed, vehicle failed to send final ack."));
             _finishTransaction(false);
-        } else if (_itemIndicesToWrite[0] == 0) {
-            // Vehicle did not respond to MISSION_COUNT, try again
+        } else if (_itemsToWrite.testBit(_writeStartIndex)) {
+            // Vehicle did not respond to MISSION_COUNT/MISSION_WRITE_PARTIAL_LIST, try again
             if (_retryCount > _maxRetryCount) {
                 _sendError(MaxRetryExceeded, tr("Mission write mission count failed, maximum retries exceeded."));
                 _finishTransaction(false);
             } else {
                 _retryCount++;
-                qCDebug(PlanManagerLog) << QStringLiteral("Retrying %1 MISSION_COUNT retry Count").arg(_planTypeString()) << _retryCount;
-                _writeMissionCount();
+                if (_partialWrite) {
+                    qCDebug(PlanManagerLog) << QStringLiteral("Retrying %1 MISSION_WRITE_PARTIAL_LIST retry Count").arg(_planTypeString()) << _retryCount;
+                    _writePartialList();
+                } else {
+                    qCDebug(PlanManagerLog) << QStringLiteral("Retrying %1 MISSION_COUNT retry Count").arg(_planTypeString()) << _retryCount;
+                    _writeMissionCount();
+                }
             }
         } else {
             // Vehicle did not request all items from ground station
@@ -326,9 +415,10 @@ void PlanManager::_handleMissionCount(const mavlink_message_t& message)
         return;
     }
 
-    qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionCount %1 count:").arg(_planTypeString()) << missionCount.count;
+    qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionCount %1 count:opaque_id").arg(_planTypeString()) << missionCount.count << missionCount.opaque_id;
 
     _retryCount = 0;
+    _readOpaqueId = missionCount.opaque_id;
 
     if (missionCount.count == 0) {
         _readTransactionComplete();
@@ -456,6 +546,7 @@ void PlanManager::_handleMissionItem(const mavlink_message_t& message)
         }
 
         _missionItems.append(item);
+        _vehicleItemStore.append(missionItem);
     } else {
         qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionItem %1 mission item received item index which was not requested, disregrarding:").arg(_planTypeString()) << seq;
         // We have to put the ack timeout back since it was removed above
@@ -502,47 +593,41 @@ void PlanManager::_handleMissionRequest(const mavlink_message_t& message)
 
     qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionRequest %1 sequenceNumber").arg(_planTypeString()) << missionRequestSeq;
 
-    if (missionRequestSeq > _writeMissionItems.count() - 1) {
-        _sendError(RequestRangeError, tr("Vehicle requested item outside range, count:request %1:%2. Send to Vehicle failed.").arg(_writeMissionItems.count()).arg(missionRequestSeq));
+    if (missionRequestSeq > _writeItemStore.count() - 1) {
+        _sendError(RequestRangeError, tr("Vehicle requested item outside range, count:request %1:%2. Send to Vehicle failed.").arg(_writeItemStore.count()).arg(missionRequestSeq));
         _finishTransaction(false);
         return;
     }
 
-    emit progressPctChanged((double)missionRequestSeq / (double)_writeMissionItems.count());
+    if (missionRequestSeq >= _writeStartIndex) {
+        emit progressPctChanged((double)(missionRequestSeq - _writeStartIndex) / (double)(_writeEndIndex - _writeStartIndex + 1));
+    }
 
     _lastMissionRequest = missionRequestSeq;
-    if (!_itemIndicesToWrite.contains(missionRequestSeq)) {
+    if (!_itemsToWrite.testBit(missionRequestSeq)) {
         qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionRequest %1 sequence number requested which has already been sent, sending again:").arg(_planTypeString()) << missionRequestSeq;
     } else {
-        _itemIndicesToWrite.removeOne(missionRequestSeq);
+        _itemsToWrite.clearBit(missionRequestSeq);
+        _itemsToWriteCount--;
     }
 
-    MissionItem* item = _writeMissionItems[missionRequestSeq];
-    qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionRequest %1 sequenceNumber:command").arg(_planTypeString()) << missionRequestSeq << item->command();
+    qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionRequest %1 sequenceNumber:command").arg(_planTypeString()) << missionRequestSeq << _writeItemStore.command(missionRequestSeq);
 
     SharedLinkInterfacePtr sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
     if (sharedLink) {
-        mavlink_message_t       messageOut;
-
-        mavlink_msg_mission_item_int_pack_chan(MAVLinkProtocol::instance()->getSystemId(),
-                                               MAVLinkProtocol::getComponentId(),
-                                               sharedLink->mavlinkChannel(),
-                                               &messageOut,
-                                               _vehicle->id(),
-                                               MAV_COMP_ID_AUTOPILOT1,
-                                               missionRequestSeq,
-                                               item->frame(),
-                                               item->command(),
-                                               missionRequestSeq == 0,
-                                               item->autoContinue(),
-                                               item->param1(),
-                                               item->param2(),
-                                               item->param3(),
-                                               item->param4(),
-                                               item->frame() == MAV_FRAME_MISSION ? item->param5() : item->param5() * 1e7,
-                                               item->frame() == MAV_FRAME_MISSION ? item->param6() : item->param6() * 1e7,
-                                               item->param7(),
-                                               _planType);
+        mavlink_message_t           messageOut;
+        mavlink_mission_item_int_t  missionItem;
+
+        _writeItemStore.encode(missionRequestSeq, missionRequestSeq, missionRequestSeq == 0, missionItem);
+        missionItem.target_system       = _vehicle->id();
+        missionItem.target_component    = MAV_COMP_ID_AUTOPILOT1;
+        missionItem.mission_type        = _planType;
+
+        mavlink_msg_mission_item_int_encode_chan(MAVLinkProtocol::instance()->getSystemId(),
+                                                 MAVLinkProtocol::getComponentId(),
+                                                 sharedLink->mavlinkChannel(),
+                                                 &messageOut,
+                                                 &missionItem);
         _vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), messageOut);
     }
     _startAckTimeout(AckMissionRequest);
@@ -601,8 +686,9 @@ void PlanManager::_handleMissionAck(const mavlink_message_t& message)
     case AckMissionRequest:
         // MISSION_REQUEST is expected, or MAV_MISSION_ACCEPTED to end sequence
         if (missionAck.type == MAV_MISSION_ACCEPTED) {
-            if (_itemIndicesToWrite.count() == 0) {
-                qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionAck write sequence complete %1").arg(_planTypeString());
+            if (_itemsToWriteCount == 0) {
+                qCDebug(PlanManagerLog) << QStringLiteral("_handleMissionAck write sequence complete %1 opaque_id:").arg(_planTypeString()) << missionAck.opaque_id;
+                _vehicleOpaqueId = missionAck.opaque_id;
                 _finishTransaction(true);
             } else {
                 // FIXME: Protocol error
@@ -803,7 +889,8 @@ void PlanManager::_finishTransaction(bool success, bool apmGuidedItemWrite)
     _disconnectFromMavlink();
 
     _itemIndicesToRead.clear();
-    _itemIndicesToWrite.clear();
+    _itemsToWrite.clear();
+    _itemsToWriteCount = 0;
 
     // First thing we do is clear the transaction. This way inProgesss is off when we signal transaction complete.
     TransactionType_t currentTransactionType = _transactionInProgress;
@@ -814,7 +901,10 @@ void PlanManager::_finishTransaction(bool success, bool apmGuidedItemWrite)
         if (!success) {
             // Read from vehicle failed, clear partial list
             _clearAndDeleteMissionItems();
+            _vehicleItemStore.clear();
         }
+        _vehicleItemStoreValid = success && _vehicleItemStore.count() == _missionItems.count();
+        _vehicleOpaqueId = _vehicleItemStoreValid ? _readOpaqueId : 0;
         emit newMissionItemsAvailable(false);
         break;
     case TransactionWrite:
@@ -833,14 +923,23 @@ void PlanManager::_finishTransaction(bool success, bool apmGuidedItemWrite)
                     _missionItems.append(_writeMissionItems[i]);
                 }
                 _writeMissionItems.clear();
+                _vehicleItemStore = _writeItemStore;
+                _vehicleItemStoreValid = true;
             } else {
-                // Write failed, throw out the write list
+                // Write failed, throw out the write list. A partially completed write leaves the vehicle in an unknown state.
                 _clearAndDeleteWriteMissionItems();
+                _vehicleItemStore.clear();
+                _vehicleItemStoreValid = false;
+                _vehicleOpaqueId = 0;
             }
             emit sendComplete(!success /* error */);
         }
+        _writeItemStore.clear();
         break;
     case TransactionRemoveAll:
+        _vehicleItemStore.clear();
+        _vehicleItemStoreValid = success;
+        _vehicleOpaqueId = 0;
         emit removeAllComplete(!success /* error */);
         break;
     default:
@@ -857,6 +956,16 @@ void PlanManager::_finishTransaction(bool success, bool apmGuidedItemWrite)
     }
 }
 
+void PlanManager::invalidateVehicleItemStore(const QString& reason)
+{
+    if (_vehicleItemStoreValid) {
+        qCDebug(PlanManagerLog) << QStringLiteral("invalidateVehicleItemStore %1").arg(_planTypeString()) << reason;
+    }
+    _vehicleItemStore.clear();
+    _vehicleItemStoreValid = false;
+    _vehicleOpaqueId = 0;
+}
+
 bool PlanManager::inProgress(void) const
 {
     return _transactionInProgress != TransactionNone;
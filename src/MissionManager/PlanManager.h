@@ -1,10 +1,12 @@
 #pragma once
 
+#include <QtCore/QBitArray>
 #include <QtCore/QObject>
 #include <QtCore/QTimer>
 #include <QtCore/QLoggingCategory>
 
 #include "MissionItem.h"
+#include "MissionItemStore.h"
 #include "QGCMAVLink.h"
 
 class Vehicle;
@@ -44,6 +46,10 @@ class PlanManager : public QObject
     ///     Signals removeAllComplete when done
     void removeAll(void);
 
+    /// Forgets what is known to be on the vehicle, the next write is a full upload
+    ///     @param reason Why the vehicle mission may have changed, for logging only
+    void invalidateVehicleItemStore(const QString& reason);
+
     /// Error codes returned in error signal
     typedef enum {
         InternalError,
@@ -112,6 +118,8 @@ private slots:
     void _finishTransaction(bool success, bool apmGuidedItemWrite = false);
     void _requestList(void);
     void _writeMissionCount(void);
+    void _writePartialList(void);
+    bool _findChangedItemRange(int& startIndex, int& endIndex) const;
     void _writeMissionItemsWorker(void);
     void _clearAndDeleteMissionItems(void);
     void _clearAndDeleteWriteMissionItems(void);
@@ -131,13 +139,22 @@ private slots:
 
     TransactionType_t   _transactionInProgress;
     bool                _resumeMission;
-    QList<int>          _itemIndicesToWrite;    ///< List of mission items which still need to be written to vehicle
+    QBitArray           _itemsToWrite;          ///< Bit set for each mission item which still needs to be written to vehicle
+    int                 _itemsToWriteCount = 0; ///< Number of bits set in _itemsToWrite
     QList<int>          _itemIndicesToRead;     ///< List of mission items which still need to be requested from vehicle
     int                 _lastMissionRequest;    ///< Index of item last requested by MISSION_REQUEST
     int                 _missionItemCountToRead;///< Count of all mission items to read
 
     QList<MissionItem*> _missionItems;          ///< Set of mission items on vehicle
     QList<MissionItem*> _writeMissionItems;     ///< Set of mission items currently being written to vehicle
+    MissionItemStore    _writeItemStore;        ///< Wire representation of _writeMissionItems used to answer MISSION_REQUEST
+    MissionItemStore    _vehicleItemStore;      ///< Wire representation of the items last read from or written to the vehicle
+    bool                _vehicleItemStoreValid = false; ///< true: _vehicleItemStore matches what is on the vehicle
+    uint32_t            _vehicleOpaqueId = 0;   ///< Vehicle opaque_id of the mission in _vehicleItemStore, 0 if not known
+    uint32_t            _readOpaqueId = 0;      ///< opaque_id from the MISSION_COUNT of the read in progress
+    bool                _partialWrite = false;  ///< true: Current write sequence uses MISSION_WRITE_PARTIAL_LIST
+    int                 _writeStartIndex = 0;   ///< First item index sent by the current write sequence
+    int                 _writeEndIndex = -1;    ///< Last item index sent by the current write sequence
     int                 _currentMissionIndex;
     int                 _lastCurrentIndex;
 
@@ -8,6 +8,7 @@
 #include "JsonHelper.h"
 #include "MissionManager.h"
 #include "KMLPlanDomDocument.h"
+#include "PlanFileStream.h"
 #include "SurveyPlanCreator.h"
 #include "StructureScanPlanCreator.h"
 #include "CorridorScanPlanCreator.h"
@@ -349,15 +350,14 @@ void PlanMasterController::loadFromFile(const QString& filename)
             success = true;
         }
     } else {
-        QJsonDocument   jsonDoc;
-        QByteArray      bytes = file.readAll();
+        file.close();
 
-        if (!JsonHelper::isJsonFile(bytes, jsonDoc, errorString)) {
+        QJsonObject json;
+        if (!PlanFileStream::readJsonObject(filename, json, errorString)) {
             qgcApp()->showAppMessage(errorMessage.arg(errorString));
             return;
         }
 
-        QJsonObject json = jsonDoc.object();
         //-- Allow plugins to pre process the load
         QGCCorePlugin::instance()->preLoadFromJson(this, json);
 
@@ -448,8 +448,10 @@ void PlanMasterController::saveToFile(const QString& filename)
         _currentPlanFile.clear();
         emit currentPlanFileChanged();
     } else {
-        QJsonDocument saveDoc = saveToJson();
-        file.write(saveDoc.toJson());
+        QString errorString;
+        if (!PlanFileStream::writeJsonObject(file, saveToJson().object(), errorString)) {
+            qgcApp()->showAppMessage(tr("Plan save error %1 : %2").arg(filename).arg(errorString));
+        }
         if(_currentPlanFile != planFilename) {
             _currentPlanFile = planFilename;
             emit currentPlanFileChanged();
@@ -27,13 +27,6 @@ SimpleMissionItem::SimpleMissionItem(PlanMasterController* masterController, boo
     , _supportedCommandFact             (0, "Command:",             FactMetaData::valueTypeUint32)
     , _altitudeFact                     (0, "Altitude",             FactMetaData::valueTypeDouble)
     , _amslAltAboveTerrainFact          (0, "Alt above terrain",    FactMetaData::valueTypeDouble)
-    , _param1MetaData                   (FactMetaData::valueTypeDouble)
-    , _param2MetaData                   (FactMetaData::valueTypeDouble)
-    , _param3MetaData                   (FactMetaData::valueTypeDouble)
-    , _param4MetaData                   (FactMetaData::valueTypeDouble)
-    , _param5MetaData                   (FactMetaData::valueTypeDouble)
-    , _param6MetaData                   (FactMetaData::valueTypeDouble)
-    , _param7MetaData                   (FactMetaData::valueTypeDouble)
 {
     _editorQml = QStringLiteral("qrc:/qml/QGroundControl/Controls/SimpleItemEditor.qml");
 
@@ -55,13 +48,6 @@ SimpleMissionItem::SimpleMissionItem(PlanMasterController* masterController, boo
     , _supportedCommandFact     (0,         "Command:",             FactMetaData::valueTypeUint32)
     , _altitudeFact             (0,         "Altitude",             FactMetaData::valueTypeDouble)
     , _amslAltAboveTerrainFact  (0,         "Alt above terrain",    FactMetaData::valueTypeDouble)
-    , _param1MetaData           (FactMetaData::valueTypeDouble)
-    , _param2MetaData           (FactMetaData::valueTypeDouble)
-    , _param3MetaData           (FactMetaData::valueTypeDouble)
-    , _param4MetaData           (FactMetaData::valueTypeDouble)
-    , _param5MetaData           (FactMetaData::valueTypeDouble)
-    , _param6MetaData           (FactMetaData::valueTypeDouble)
-    , _param7MetaData           (FactMetaData::valueTypeDouble)
 {
     _editorQml = QStringLiteral("qrc:/qml/QGroundControl/Controls/SimpleItemEditor.qml");
 
@@ -434,7 +420,6 @@ void SimpleMissionItem::_rebuildTextFieldFacts(void)
         }
 
         Fact*           rgParamFacts[7] =       { &_missionItem._param1Fact, &_missionItem._param2Fact, &_missionItem._param3Fact, &_missionItem._param4Fact, &_missionItem._param5Fact, &_missionItem._param6Fact, &_missionItem._param7Fact };
-        FactMetaData*   rgParamMetaData[7] =    { &_param1MetaData, &_param2MetaData, &_param3MetaData, &_param4MetaData, &_param5MetaData, &_param6MetaData, &_param7MetaData };
 
         const MissionCommandUIInfo* uiInfo = MissionCommandTree::instance()->getUIInfo(_controllerVehicle, _previousVTOLMode, command);
 
@@ -444,25 +429,10 @@ void SimpleMissionItem::_rebuildTextFieldFacts(void)
                 const MissionCmdParamInfo* paramInfo = uiInfo->getParamInfo(i, showUI);
 
                 if (showUI && paramInfo && paramInfo->enumStrings().count() == 0 && !paramInfo->nanUnchanged()) {
-                    Fact*               paramFact =     rgParamFacts[i-1];
-                    FactMetaData*       paramMetaData = rgParamMetaData[i-1];
+                    Fact* paramFact = rgParamFacts[i-1];
 
                     paramFact->setName(paramInfo->label());
-                    paramMetaData->setDecimalPlaces(paramInfo->decimalPlaces());
-                    paramMetaData->setRawUnits(paramInfo->units());
-                    paramMetaData->setRawDefaultValue(paramInfo->defaultValue());
-                    paramMetaData->setRawMin(paramInfo->min());
-                    paramMetaData->setRawMax(paramInfo->max());
-                    const double userMin = paramInfo->userMin();
-                    const double userMax = paramInfo->userMax();
-                    // if user min/max are NaN, we leave them unchanged (invalid)
-                    if (!qIsNaN(userMin)) {
-                        paramMetaData->setRawUserMin(userMin);
-                    }
-                    if (!qIsNaN(userMax)) {
-                        paramMetaData->setRawUserMax(userMax);
-                    }
-                    paramFact->setMetaData(paramMetaData);
+                    paramFact->setMetaData(paramInfo->factMetaData());
                     if (paramInfo->advanced()) {
                         _textFieldFactsAdvanced.append(paramFact);
                     } else {
@@ -492,7 +462,6 @@ void SimpleMissionItem::_rebuildNaNFacts(void)
         }
 
         Fact*           rgParamFacts[7] =       { &_missionItem._param1Fact, &_missionItem._param2Fact, &_missionItem._param3Fact, &_missionItem._param4Fact, &_missionItem._param5Fact, &_missionItem._param6Fact, &_missionItem._param7Fact };
-        FactMetaData*   rgParamMetaData[7] =    { &_param1MetaData, &_param2MetaData, &_param3MetaData, &_param4MetaData, &_param5MetaData, &_param6MetaData, &_param7MetaData };
 
         const MissionCommandUIInfo* uiInfo = MissionCommandTree::instance()->getUIInfo(_controllerVehicle, _previousVTOLMode, command);
 
@@ -509,25 +478,10 @@ void SimpleMissionItem::_rebuildNaNFacts(void)
                         firmwareVehicle = _controllerVehicle;
                     }
 
-                    Fact*               paramFact =     rgParamFacts[i-1];
-                    FactMetaData*       paramMetaData = rgParamMetaData[i-1];
+                    Fact* paramFact = rgParamFacts[i-1];
 
                     paramFact->setName(paramInfo->label());
-                    paramMetaData->setDecimalPlaces(paramInfo->decimalPlaces());
-                    paramMetaData->setRawUnits(paramInfo->units());
-                    paramMetaData->setRawDefaultValue(paramInfo->defaultValue());
-                    paramMetaData->setRawMin(paramInfo->min());
-                    paramMetaData->setRawMax(paramInfo->max());
-                    const double userMin = paramInfo->userMin();
-                    const double userMax = paramInfo->userMax();
-                    // if user min/max are NaN, we leave them unchanged (invalid)
-                    if (!qIsNaN(userMin)) {
-                        paramMetaData->setRawUserMin(userMin);
-                    }
-                    if (!qIsNaN(userMax)) {
-                        paramMetaData->setRawUserMax(userMax);
-                    }
-                    paramFact->setMetaData(paramMetaData);
+                    paramFact->setMetaData(paramInfo->factMetaData());
                     if (paramInfo->advanced()) {
                         _nanFactsAdvanced.append(paramFact);
                     } else {
@@ -594,7 +548,6 @@ void SimpleMissionItem::_rebuildComboBoxFacts(void)
         _ignoreDirtyChangeSignals = true;
 
         Fact*           rgParamFacts[7] =       { &_missionItem._param1Fact, &_missionItem._param2Fact, &_missionItem._param3Fact, &_missionItem._param4Fact, &_missionItem._param5Fact, &_missionItem._param6Fact, &_missionItem._param7Fact };
-        FactMetaData*   rgParamMetaData[7] =    { &_param1MetaData, &_param2MetaData, &_param3MetaData, &_param4MetaData, &_param5MetaData, &_param6MetaData, &_param7MetaData };
 
         MAV_CMD command;
         if (_homePositionSpecialCase) {
@@ -608,26 +561,10 @@ void SimpleMissionItem::_rebuildComboBoxFacts(void)
             const MissionCmdParamInfo* paramInfo = MissionCommandTree::instance()->getUIInfo(_controllerVehicle, _previousVTOLMode, command)->getParamInfo(i, showUI);
 
             if (showUI && paramInfo && paramInfo->enumStrings().count() != 0) {
-                Fact*               paramFact =     rgParamFacts[i-1];
-                FactMetaData*       paramMetaData = rgParamMetaData[i-1];
+                Fact* paramFact = rgParamFacts[i-1];
 
                 paramFact->setName(paramInfo->label());
-                paramMetaData->setDecimalPlaces(paramInfo->decimalPlaces());
-                paramMetaData->setEnumInfo(paramInfo->enumStrings(), paramInfo->enumValues());
-                paramMetaData->setRawUnits(paramInfo->units());
-                paramMetaData->setRawDefaultValue(paramInfo->defaultValue());
-                paramMetaData->setRawMin(paramInfo->min());
-                paramMetaData->setRawMax(paramInfo->max());
-                const double userMin = paramInfo->userMin();
-                const double userMax = paramInfo->userMax();
-                // if user min/max are NaN, we leave them unchanged (invalid)
-                if (!qIsNaN(userMin)) {
-                    paramMetaData->setRawUserMin(userMin);
-                }
-                if (!qIsNaN(userMax)) {
-                    paramMetaData->setRawUserMax(userMax);
-                }
-                paramFact->setMetaData(paramMetaData);
+                paramFact->setMetaData(paramInfo->factMetaData());
                 if (paramInfo->advanced()) {
                     _comboboxFactsAdvanced.append(paramFact);
                 } else {
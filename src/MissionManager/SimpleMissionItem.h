@@ -200,13 +200,6 @@ private slots:
     static FactMetaData*    _latitudeMetaData;
     static FactMetaData*    _longitudeMetaData;
 
-    FactMetaData    _param1MetaData;
-    FactMetaData    _param2MetaData;
-    FactMetaData    _param3MetaData;
-    FactMetaData    _param4MetaData;
-    FactMetaData    _param5MetaData;
-    FactMetaData    _param6MetaData;
-    FactMetaData    _param7MetaData;
 
     static constexpr const char* _jsonAltitudeModeKey =           "AltitudeMode";
     static constexpr const char* _jsonAltitudeKey =               "Altitude";
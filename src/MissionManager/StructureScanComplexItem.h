@@ -129,7 +129,7 @@ private slots:
     void    _setCameraShots                 (int cameraShots);
     double  _triggerDistance                (void) const;
 
-    QMap<QString, FactMetaData*> _metaDataMap;
+    const QMap<QString, FactMetaData*>& _metaDataMap;
 
     int             _sequenceNumber;
     QGCMapPolygon   _structurePolygon;
@@ -133,7 +133,7 @@ private slots:
     bool _VertexIsReflex(const QPolygonF& polygon, QList<QPointF>::const_iterator& vertexIter);
 #endif
 
-    QMap<QString, FactMetaData*> _metaDataMap;
+    const QMap<QString, FactMetaData*>& _metaDataMap;
 
     SettingsFact    _gridAngleFact;
     SettingsFact    _flyAlternateTransectsFact;
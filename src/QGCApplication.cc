@@ -33,6 +33,8 @@
 #include "QGCImageProvider.h"
 #include "QGCLoggingCategory.h"
 #include "SettingsManager.h"
+#include "SettingsStore.h"
+#include "StartupProfiler.h"
 #include "MavlinkSettings.h"
 #include "AppSettings.h"
 #include "UDPLink.h"
@@ -56,6 +58,8 @@ QGCApplication::QGCApplication(int &argc, char *argv[], const QGCCommandLinePars
 {
     _msecsElapsedTime.start();
 
+    StartupProfiler::Span span(QStringLiteral("Network proxy"));
+
     // Setup for network proxy support
     QGCNetworkHelper::initializeProxySupport();
 
@@ -89,6 +93,7 @@ QGCApplication::QGCApplication(int &argc, char *argv[], const QGCCommandLinePars
     setApplicationVersion(QString(QGC_APP_VERSION_STR));
 
     // Set settings format
+    span.next(QStringLiteral("Settings"));
     QSettings::setDefaultFormat(QSettings::IniFormat);
     QSettings settings;
     qCDebug(QGCApplicationLog) << "Settings location" << settings.fileName() << "Is writable?:" << settings.isWritable();
@@ -135,16 +140,19 @@ QGCApplication::QGCApplication(int &argc, char *argv[], const QGCCommandLinePars
     }
 
     // Set up our logging filters
+    span.next(QStringLiteral("Logging filters"));
     QGCLoggingCategoryManager::instance()->setFilterRulesFromSettings(loggingOptions);
 
     // We need to set language as early as possible prior to loading on JSON files.
+    span.next(QStringLiteral("Language"));
     setLanguage();
 
     // Force old SVG Tiny 1.2 behavior for compatibility
     QSvgRenderer::setDefaultOptions(QtSvg::Tiny12FeaturesOnly);
 
 #ifndef QGC_DAILY_BUILD
-    _checkForNewVersion();
+    // Nothing to show until the main window is up, so don't hold up startup with the network request
+    runAfterFirstFrame(QStringLiteral("New version check"), [this]() { _checkForNewVersion(); });
 #endif
 }
 
@@ -204,6 +212,7 @@ QGCApplication::~QGCApplication()
 
 void QGCApplication::init()
 {
+    StartupProfiler::Span span(QStringLiteral("SettingsManager"));
     SettingsManager::instance()->init();
     if (_systemId > 0) {
         qCDebug(QGCApplicationLog) << "Setting MAVLink System ID to:" << _systemId;
@@ -211,6 +220,7 @@ void QGCApplication::init()
     }
 
     // Although this should really be in _initForNormalAppBoot putting it here allowws us to create unit tests which pop up more easily
+    span.next(QStringLiteral("Fonts"));
     if (QFontDatabase::addApplicationFont(":/fonts/opensans") < 0) {
         qCWarning(QGCApplicationLog) << "Could not load /fonts/opensans font";
     }
@@ -235,7 +245,9 @@ void QGCApplication::_initVideo()
     QQuickWindow::setGraphicsApi(QSGRendererInterface::OpenGL);
 #endif
 
+    StartupProfiler::Span span(QStringLiteral("QGCCorePlugin"));
     QGCCorePlugin::instance();  // CorePlugin must be initialized before VideoManager for Video Cleanup
+    span.next(QStringLiteral("VideoManager"));
     VideoManager::instance();
     _videoManagerInitialized = true;
 }
@@ -245,18 +257,45 @@ void QGCApplication::_initForNormalAppBoot()
     _initVideo(); // GStreamer must be initialized before QmlEngine
 
     QQuickStyle::setStyle("Basic");
+    StartupProfiler::Span span(QStringLiteral("QGCCorePlugin init"));
     QGCCorePlugin::instance()->init();
+    span.next(QStringLiteral("MAVLinkProtocol init"));
     MAVLinkProtocol::instance()->init();
+    span.next(QStringLiteral("MultiVehicleManager init"));
     MultiVehicleManager::instance()->init();
+    span.next(QStringLiteral("QML engine"));
     _qmlAppEngine = QGCCorePlugin::instance()->createQmlApplicationEngine(this);
     QObject::connect(_qmlAppEngine, &QQmlApplicationEngine::objectCreationFailed, this, QCoreApplication::quit, Qt::QueuedConnection);
+    span.next(QStringLiteral("QML root window"));
     QGCCorePlugin::instance()->createRootWindow(_qmlAppEngine);
 
+    QQuickWindow *const rootWindow = mainRootWindow();
+    if (rootWindow) {
+        // frameSwapped comes from the render thread, the single shot connection is queued to us
+        (void) connect(rootWindow, &QQuickWindow::frameSwapped, this, &QGCApplication::_firstFrameSwapped, Qt::SingleShotConnection);
+    } else {
+        QTimer::singleShot(0, this, &QGCApplication::_firstFrameSwapped);
+    }
+
+    // A minimized or hidden window may never render, deferred initialization must still run
+    QTimer::singleShot(_firstFrameTimeoutMsecs, this, [this]() {
+        if (!_firstFrameShown) {
+            qCWarning(QGCApplicationLog) << "No frame rendered after" << _firstFrameTimeoutMsecs << "ms, running deferred initialization";
+            _firstFrameSwapped();
+        }
+    });
+
+    span.next(QStringLiteral("AudioOutput init"));
     AudioOutput::instance()->init(SettingsManager::instance()->appSettings()->audioMuted());
+    span.next(QStringLiteral("FollowMe init"));
     FollowMe::instance()->init();
+    span.next(QStringLiteral("QGCPositionManager init"));
     QGCPositionManager::instance()->init();
+    span.next(QStringLiteral("LinkManager init"));
     LinkManager::instance()->init();
+    span.next(QStringLiteral("VideoManager init"));
     VideoManager::instance()->init(mainRootWindow());
+    span.next(QStringLiteral("Remaining app boot"));
 
     // Image provider for Optical Flow
     _qmlAppEngine->addImageProvider(_qgcImageProviderId, new QGCImageProvider());
@@ -299,24 +338,70 @@ void QGCApplication::_initForNormalAppBoot()
     #endif
     #endif
 
-    // Now that main window is up check for lost log files
-    MAVLinkProtocol::instance()->checkForLostLogFiles();
+    // Nothing in the Fly view depends on these, so they wait until it has been shown
+    runAfterFirstFrame(QStringLiteral("Lost log file check"), []() { MAVLinkProtocol::instance()->checkForLostLogFiles(); });
+    runAfterFirstFrame(QStringLiteral("JoystickManager init"), []() { JoystickManager::instance()->init(); });
 
     // Load known link configurations
+    span.next(QStringLiteral("Link configurations"));
     LinkManager::instance()->loadLinkConfigurationList();
 
-    // Probe for joysticks
-    JoystickManager::instance()->init();
-
     if (_settingsUpgraded) {
         showAppMessage(tr("The format for %1 saved settings has been modified. "
                     "Your saved settings have been reset to defaults.").arg(applicationName()));
     }
 
     // Connect links with flag AutoconnectLink
+    span.next(QStringLiteral("Auto connected links"));
     LinkManager::instance()->startAutoConnectedLinks();
 }
 
+void QGCApplication::runAfterFirstFrame(const QString &name, const std::function<void()> &function)
+{
+    _deferredInits.append(qMakePair(name, function));
+    if (_firstFrameShown && (_deferredInits.count() == 1)) {
+        QTimer::singleShot(0, this, &QGCApplication::_runNextDeferredInit);
+    }
+}
+
+void QGCApplication::_firstFrameSwapped()
+{
+    if (_firstFrameShown) {
+        return;
+    }
+
+    StartupProfiler *const profiler = StartupProfiler::instance();
+    profiler->addInstant(QStringLiteral("First frame"));
+    qCDebug(QGCApplicationLog) << "First frame shown after" << _msecsElapsedTime.elapsed() << "ms";
+
+    _firstFrameShown = true;
+    if (!_deferredInits.isEmpty()) {
+        QTimer::singleShot(0, this, &QGCApplication::_runNextDeferredInit);
+    } else {
+        (void) profiler->finish();
+    }
+}
+
+void QGCApplication::_runNextDeferredInit()
+{
+    if (_deferredInits.isEmpty()) {
+        return;
+    }
+
+    // One per event loop pass so the ui stays responsive while they run
+    const QPair<QString, std::function<void()>> deferredInit = _deferredInits.takeFirst();
+    {
+        StartupProfiler::Span span(deferredInit.first, QStringLiteral("deferred"));
+        deferredInit.second();
+    }
+
+    if (!_deferredInits.isEmpty()) {
+        QTimer::singleShot(0, this, &QGCApplication::_runNextDeferredInit);
+    } else {
+        (void) StartupProfiler::instance()->finish();
+    }
+}
+
 void QGCApplication::deleteAllSettingsNextBoot()
 {
     QSettings settings;
@@ -667,6 +752,12 @@ void QGCApplication::shutdown()
 
     QGCCorePlugin::instance()->cleanup();
 
+    // Only does something if we exit before the first frame, for example from a simple boot test
+    (void) StartupProfiler::instance()->finish();
+
+    // Make sure setting changes still waiting to be written make it to disk
+    SettingsStore::instance()->flush();
+
     // This is bad, but currently qobject inheritances are incorrect and cause crashes on exit without
     delete _qmlAppEngine;
 }
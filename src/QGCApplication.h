@@ -8,6 +8,8 @@
 #include <QtCore/QTranslator>
 #include <QtWidgets/QApplication>
 
+#include <functional>
+
 namespace QGCCommandLineParser {
     struct CommandLineParseResult;
 }
@@ -92,6 +94,12 @@ class QGCApplication : public QApplication
     /// Although public, these methods are internal and should only be called by UnitTest code
     QQmlApplicationEngine *qmlAppEngine() const { return _qmlAppEngine; }
 
+    /// Queues initialization which isn't needed to show the Fly view. Queued functions are run one per event loop pass
+    /// once the main window has rendered its first frame, or on the next pass if that has already happened.
+    /// If no frame has been rendered after a few seconds (hidden window, offscreen platform) they run anyway.
+    ///     @param name Name used for the span in the startup trace
+    void runAfterFirstFrame(const QString &name, const std::function<void()> &function);
+
 signals:
     void languageChanged(const QLocale &locale);
 
@@ -121,6 +129,8 @@ private slots:
     void _qgcCurrentStableVersionDownloadComplete(const QString &remoteFile, const QString &localFile, const QString &errorMsg);
     static bool _parseVersionText(const QString &versionString, int &majorVersion, int &minorVersion, int &buildVersion);
     void _showDelayedAppMessages();
+    void _firstFrameSwapped();
+    void _runNextDeferredInit();
 
 private:
     bool compressEvent(QEvent *event, QObject *receiver, QPostEventList *postedEvents) final;
@@ -156,6 +166,9 @@ private slots:
     bool _showErrorsInToolbar = false;
     QElapsedTimer _msecsElapsedTime;
     bool _videoManagerInitialized = false;
+    bool _firstFrameShown = false;
+    static constexpr int _firstFrameTimeoutMsecs = 5000;            ///< Deferred initialization runs after this even if no frame has been rendered
+    QList<QPair<QString, std::function<void()>>> _deferredInits;   ///< Name, function, run after the first frame
 
     QList<QPair<QString /* title */, QString /* message */>> _delayedAppMessages;
 
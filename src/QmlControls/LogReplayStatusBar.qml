@@ -27,7 +27,7 @@ Rectangle {
     QGCFileDialog {
         id: filePicker
         title: qsTr("Select Telemetery Log")
-        nameFilters: [ qsTr("Telemetry Logs (*.%1)").arg(_logFileExtension), qsTr("All Files (*)") ]
+        nameFilters: [ qsTr("Telemetry Logs (*.%1 *.%1.zst)").arg(_logFileExtension), qsTr("All Files (*)") ]
         folder: QGroundControl.settingsManager.appSettings.telemetrySavePath
         onAcceptedForLoad: (file) => {
             controller.link = QGroundControl.linkManager.startLogReplay(file)
@@ -49,6 +49,7 @@ ChartView {
         id:                     chartController
         inspectorController:    chartView.inspectorController
         chartIndex:             chartView.chartIndex
+        plotWidth:              Math.round(chartView.plotArea.width)
     }
 
     DateTimeAxis {
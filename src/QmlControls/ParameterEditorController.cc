@@ -5,10 +5,13 @@
 #include "Vehicle.h"
 #include "QGCLoggingCategory.h"
 
+#include <algorithm>
+
 QGC_LOGGING_CATEGORY(ParameterEditorControllerLog, "QMLControls.ParameterEditorController")
 
-ParameterTableModel::ParameterTableModel(QObject* parent)
+ParameterTableModel::ParameterTableModel(ParameterManager* parameterMgr, QObject* parent)
     : QAbstractTableModel(parent)
+    , _parameterMgr(parameterMgr)
 {
 
 }
@@ -41,11 +44,19 @@ QVariant ParameterTableModel::data(const QModelIndex &index, int role) const
         return QVariant();
     }
 
+    const RowData& rowData = _tableData[index.row()];
     switch (role) {
         case Qt::DisplayRole:
-            return QVariant::fromValue(_tableData[index.row()][index.column()]);
+            switch (index.column()) {
+                case NameColumn:
+                    return rowData.name;
+                case DescriptionColumn:
+                    return rowData.description;
+                default:
+                    return QVariant::fromValue(_parameterMgr->parameter(rowData.paramHandle));
+            }
         case FactRole:
-            return QVariant::fromValue(_tableData[index.row()][ValueColumn]);
+            return QVariant::fromValue(_parameterMgr->parameter(rowData.paramHandle));
         default:
             return QVariant();
     }
@@ -71,25 +82,22 @@ void ParameterTableModel::clear()
     }
 }
 
-void ParameterTableModel::append(Fact* fact)
+void ParameterTableModel::append(int paramHandle)
 {
-    insert(rowCount(), fact);
+    insert(rowCount(), paramHandle);
 }
 
-void ParameterTableModel::insert(int row, Fact* fact)
+void ParameterTableModel::insert(int row, int paramHandle)
 {
     if (row < 0 || row > rowCount()) {
         qWarning() << "Invalid row row:rowCount" << row << rowCount() << Q_FUNC_INFO;
         row = qMax(qMin(row, rowCount()), 0);
     }
 
-    ColumnData colData(_tableViewColCount, QString());
-    colData[NameColumn] = fact->name();
-    colData[ValueColumn] = QVariant::fromValue(fact);
-    colData[DescriptionColumn] = fact->shortDescription();
+    const RowData rowData = { _parameterMgr->parameterName(paramHandle), _parameterMgr->parameterMetaData(paramHandle)->shortDescription(), paramHandle };
 
     beginInsertRows(QModelIndex(), row, row);
-    _tableData.insert(row, colData);
+    _tableData.insert(row, rowData);
     endInsertRows();
 
     emit rowCountChanged(rowCount());
@@ -113,19 +121,20 @@ void ParameterTableModel::endReset()
     endResetModel();
 }
 
-Fact* ParameterTableModel::factAt(int row) const
+QString ParameterTableModel::nameAt(int row) const
 {
     if (row < 0 || row >= _tableData.count()) {
         qWarning() << "Invalid row row:rowCount" << row << _tableData.count() << Q_FUNC_INFO;
-        return nullptr;
+        return QString();
     }
 
-    return _tableData[row][ValueColumn].value<Fact*>();
+    return _tableData[row].name;
 }
 
 
-ParameterEditorGroup::ParameterEditorGroup(QObject* parent)
+ParameterEditorGroup::ParameterEditorGroup(ParameterManager* parameterMgr, QObject* parent)
     : QObject(parent)
+    , facts(parameterMgr)
 {
 
 }
@@ -133,20 +142,24 @@ ParameterEditorGroup::ParameterEditorGroup(QObject* parent)
 ParameterEditorController::ParameterEditorController(QObject *parent)
     : FactPanelController(parent)
     , _parameterMgr(_vehicle->parameterManager())
+    , _searchParameters(_parameterMgr)
 {
     // qCDebug(ParameterEditorControllerLog) << Q_FUNC_INFO << this;
 
     _buildLists();
 
-    _searchTimer.setSingleShot(true);
-    _searchTimer.setInterval(300);
+    // The search index makes each search cheap enough to run on every keystroke. It is built from the parameter
+    // meta data so no Facts are created until a row is shown.
+    const int defaultComponentId = _vehicle->defaultComponentId();
+    for (const QString &paramName: _parameterMgr->parameterNames(defaultComponentId)) {
+        _addToSearchIndex(_parameterMgr->parameterHandle(defaultComponentId, paramName));
+    }
 
     connect(this, &ParameterEditorController::currentCategoryChanged,   this, &ParameterEditorController::_currentCategoryChanged);
     connect(this, &ParameterEditorController::currentGroupChanged,      this, &ParameterEditorController::_currentGroupChanged);
-    connect(this, &ParameterEditorController::searchTextChanged,        this, &ParameterEditorController::_searchTextChanged);
-    connect(this, &ParameterEditorController::showModifiedOnlyChanged,  this, &ParameterEditorController::_searchTextChanged);
-    connect(&_searchTimer, &QTimer::timeout,                            this, &ParameterEditorController::_performSearch);
-    connect(_parameterMgr, &ParameterManager::factAdded,                this, &ParameterEditorController::_factAdded);
+    connect(this, &ParameterEditorController::searchTextChanged,        this, &ParameterEditorController::_performSearch);
+    connect(this, &ParameterEditorController::showModifiedOnlyChanged,  this, &ParameterEditorController::_performSearch);
+    connect(_parameterMgr, &ParameterManager::parameterAdded,           this, &ParameterEditorController::_parameterAdded);
 
     ParameterEditorCategory* category = _categories.count() ? _categories.value<ParameterEditorCategory*>(0) : nullptr;
     setCurrentCategory(category);
@@ -159,31 +172,32 @@ ParameterEditorController::~ParameterEditorController()
 
 void ParameterEditorController::_buildListsForComponent(int compId)
 {
-    for (const QString& factName: _parameterMgr->parameterNames(compId)) {
-        Fact* fact = _parameterMgr->getParameter(compId, factName);
+    for (const QString& paramName: _parameterMgr->parameterNames(compId)) {
+        const int paramHandle = _parameterMgr->parameterHandle(compId, paramName);
+        const FactMetaData* metaData = _parameterMgr->parameterMetaData(paramHandle);
 
         ParameterEditorCategory* category = nullptr;
-        if (_mapCategoryName2Category.contains(fact->category())) {
-            category = _mapCategoryName2Category[fact->category()];
+        if (_mapCategoryName2Category.contains(metaData->category())) {
+            category = _mapCategoryName2Category[metaData->category()];
         } else {
             category        = new ParameterEditorCategory(this);
-            category->name  = fact->category();
-            _mapCategoryName2Category[fact->category()] = category;
+            category->name  = metaData->category();
+            _mapCategoryName2Category[metaData->category()] = category;
             _categories.append(category);
         }
 
         ParameterEditorGroup* group = nullptr;
-        if (category->mapGroupName2Group.contains(fact->group())) {
-            group = category->mapGroupName2Group[fact->group()];
+        if (category->mapGroupName2Group.contains(metaData->group())) {
+            group = category->mapGroupName2Group[metaData->group()];
         } else {
-            group               = new ParameterEditorGroup(this);
+            group               = new ParameterEditorGroup(_parameterMgr, this);
             group->componentId  = compId;
-            group->name         = fact->group();
-            category->mapGroupName2Group[fact->group()] = group;
+            group->name         = metaData->group();
+            category->mapGroupName2Group[metaData->group()] = group;
             category->groups.append(group);
         }
 
-        group->facts.append(fact);
+        group->facts.append(paramHandle);
     }
 }
 
@@ -237,17 +251,23 @@ void ParameterEditorController::_buildLists(void)
     }
 }
 
-void ParameterEditorController::_factAdded(int compId, Fact* fact)
+void ParameterEditorController::_parameterAdded(int compId, int paramHandle)
 {
+    const FactMetaData* metaData = _parameterMgr->parameterMetaData(paramHandle);
+
+    if (compId == _vehicle->defaultComponentId()) {
+        _addToSearchIndex(paramHandle);
+    }
+
     bool                        inserted = false;
     ParameterEditorCategory*    category = nullptr;
 
-    if (_mapCategoryName2Category.contains(fact->category())) {
-        category = _mapCategoryName2Category[fact->category()];
+    if (_mapCategoryName2Category.contains(metaData->category())) {
+        category = _mapCategoryName2Category[metaData->category()];
     } else {
         category        = new ParameterEditorCategory(this);
-        category->name  = fact->category();
-        _mapCategoryName2Category[fact->category()] = category;
+        category->name  = metaData->category();
+        _mapCategoryName2Category[metaData->category()] = category;
 
         // Insert in sorted order
         inserted = false;
@@ -264,13 +284,13 @@ void ParameterEditorController::_factAdded(int compId, Fact* fact)
     }
 
     ParameterEditorGroup* group = nullptr;
-    if (category->mapGroupName2Group.contains(fact->group())) {
-        group = category->mapGroupName2Group[fact->group()];
+    if (category->mapGroupName2Group.contains(metaData->group())) {
+        group = category->mapGroupName2Group[metaData->group()];
     } else {
-        group               = new ParameterEditorGroup(this);
+        group               = new ParameterEditorGroup(_parameterMgr, this);
         group->componentId  = compId;
-        group->name         = fact->group();
-        category->mapGroupName2Group[fact->group()] = group;
+        group->name         = metaData->group();
+        category->mapGroupName2Group[metaData->group()] = group;
 
         // Insert in sorted order
         QmlObjectListModel& groups = category->groups;
@@ -289,13 +309,14 @@ void ParameterEditorController::_factAdded(int compId, Fact* fact)
 
     // Insert in sorted order
     auto& facts = group->facts;
+    const QString paramName = _parameterMgr->parameterName(paramHandle);
     for (int i=0; i<facts.rowCount(); i++) {
-        if (facts.factAt(i)->name() > fact->name()) {
-            facts.insert(i, fact);
+        if (facts.nameAt(i) > paramName) {
+            facts.insert(i, paramHandle);
             return;
         }
     }
-    facts.append(fact);
+    facts.append(paramHandle);
 }
 
 void ParameterEditorController::saveToFile(const QString& filename)
@@ -331,18 +352,17 @@ void ParameterEditorController::clearDiff(void)
 
 void ParameterEditorController::sendDiff(void)
 {
+    QList<ParameterManager::ParamSetRequest> requests;
+
     for (int i=0; i<_diffList.count(); i++) {
         ParameterEditorDiff* paramDiff = _diffList.value<ParameterEditorDiff*>(i);
 
         if (paramDiff->load) {
-            if (paramDiff->noVehicleValue) {
-                _parameterMgr->_mavlinkParamSet(paramDiff->componentId, paramDiff->name, paramDiff->valueType, paramDiff->fileValueVar);
-            } else {
-                Fact* fact = _parameterMgr->getParameter(paramDiff->componentId, paramDiff->name);
-                fact->setRawValue(paramDiff->fileValueVar);
-            }
+            requests.append({ paramDiff->componentId, paramDiff->name, paramDiff->valueType, paramDiff->fileValueVar });
         }
     }
+
+    _parameterMgr->writeParameters(requests);
 }
 
 bool ParameterEditorController::buildDiffFromFile(const QString& filename)
@@ -451,69 +471,66 @@ void ParameterEditorController::resetAllToVehicleConfiguration(void)
     refresh();
 }
 
-bool ParameterEditorController::_shouldShow(Fact* fact) const
+bool ParameterEditorController::_shouldShow(int paramHandle) const
 {
     if (!_showModifiedOnly) {
         return true;
     }
 
-    return fact->defaultValueAvailable() && !fact->valueEqualsDefault();
+    const FactMetaData* metaData = _parameterMgr->parameterMetaData(paramHandle);
+    return metaData->defaultValueAvailable() && (metaData->rawDefaultValue() != _parameterMgr->parameterRawValue(paramHandle));
 }
 
-void ParameterEditorController::_searchTextChanged(void)
+void ParameterEditorController::_addToSearchIndex(int paramHandle)
 {
-    _searchTimer.start();
+    const FactMetaData* metaData = _parameterMgr->parameterMetaData(paramHandle);
+    (void) _searchIndex.add({ _parameterMgr->parameterName(paramHandle), metaData->shortDescription(), metaData->longDescription() });
+    _searchIndexHandles.append(paramHandle);
+
+    // Previous results don't know about the new entry
+    _lastSearchTerms.clear();
 }
 
 void ParameterEditorController::_performSearch(void)
 {
-    QObjectList newParameterList;
-
     QStringList rgSearchStrings = _searchText.split(' ', Qt::SkipEmptyParts);
 
     if (rgSearchStrings.isEmpty() && !_showModifiedOnly) {
         ParameterEditorCategory* category = _categories.count() ? _categories.value<ParameterEditorCategory*>(0) : nullptr;
         setCurrentCategory(category);
         _searchParameters.clear();
+        _lastSearchTerms.clear();
     } else {
-        QVector<QRegularExpression> regexList;
-        regexList.reserve(rgSearchStrings.size());
-        for (const QString &searchItem : rgSearchStrings) {
-            QRegularExpression re(searchItem, QRegularExpression::CaseInsensitiveOption);
-            regexList.append(re.isValid() ? re : QRegularExpression());
+        // While typing the new search text usually extends the previous one. In that case all matches must come from the
+        // previous matches, since a string containing the longer term also contains its prefix.
+        bool refinesLastSearch = !_lastSearchTerms.isEmpty() && (rgSearchStrings.count() >= _lastSearchTerms.count());
+        for (int i = 0; refinesLastSearch && (i < _lastSearchTerms.count()); i++) {
+            const QString &lastTerm = _lastSearchTerms[i];
+            const bool lastTermIsLast = (i == _lastSearchTerms.count() - 1);
+            refinesLastSearch = ParameterSearchIndex::isLiteral(lastTerm) && ParameterSearchIndex::isLiteral(rgSearchStrings[i]) &&
+                                (lastTermIsLast ? rgSearchStrings[i].startsWith(lastTerm, Qt::CaseInsensitive) : (rgSearchStrings[i].compare(lastTerm, Qt::CaseInsensitive) == 0));
         }
 
-        _searchParameters.beginReset();
-        _searchParameters.clear();
+        _lastSearchMatches = _searchIndex.search(rgSearchStrings, refinesLastSearch ? &_lastSearchMatches : nullptr);
+        _lastSearchTerms = rgSearchStrings;
 
-        for (const QString &paraName: _parameterMgr->parameterNames(_vehicle->defaultComponentId())) {
-            Fact* fact = _parameterMgr->getParameter(_vehicle->defaultComponentId(), paraName);
-            bool matched = _shouldShow(fact);
-            // All of the search items must match in order for the parameter to be added to the list
-            if (matched) {
-                for (int i = 0; i < rgSearchStrings.size(); ++i) {
-                    const QRegularExpression &re = regexList.at(i);
-                    if (re.isValid()) {
-                        if (!fact->name().contains(re) &&
-                                !fact->shortDescription().contains(re) &&
-                                !fact->longDescription().contains(re)) {
-                            matched = false;
-                        }
-                    } else {
-                        const QString &searchItem = rgSearchStrings.at(i);
-                        if (!fact->name().contains(searchItem, Qt::CaseInsensitive) &&
-                                !fact->shortDescription().contains(searchItem, Qt::CaseInsensitive) &&
-                                !fact->longDescription().contains(searchItem, Qt::CaseInsensitive)) {
-                            matched = false;
-                        }
-                    }
-                }
-            }
-            if (matched) {
-                _searchParameters.append(fact);
+        QList<QPair<QString, int>> matchedParams;
+        matchedParams.reserve(_lastSearchMatches.count());
+        for (const int id: std::as_const(_lastSearchMatches)) {
+            const int paramHandle = _searchIndexHandles[id];
+            if (_shouldShow(paramHandle)) {
+                matchedParams.append({ _parameterMgr->parameterName(paramHandle), paramHandle });
             }
         }
 
+        // Parameters added after the initial index build are out of order
+        std::sort(matchedParams.begin(), matchedParams.end());
+
+        _searchParameters.beginReset();
+        _searchParameters.clear();
+        for (const auto& matchedParam: std::as_const(matchedParams)) {
+            _searchParameters.append(matchedParam.second);
+        }
         _searchParameters.endReset();
 
         if (_parameters != &_searchParameters) {
@@ -7,21 +7,21 @@
 #include "FactPanelController.h"
 #include "QmlObjectListModel.h"
 #include "FactMetaData.h"
+#include "ParameterSearchIndex.h"
 
 Q_DECLARE_LOGGING_CATEGORY(ParameterEditorControllerLog)
 
 class ParameterManager;
 
+/// Rows hold the parameter handle, the Fact of a row is only created once the view asks for it
 class ParameterTableModel : public QAbstractTableModel
 {
     Q_OBJECT
 
 public:
-    explicit ParameterTableModel(QObject* parent = nullptr);
+    explicit ParameterTableModel(ParameterManager* parameterMgr, QObject* parent = nullptr);
     ~ParameterTableModel() override;
 
-    typedef QVector<QVariant> ColumnData;
-
     enum {
         FactRole = Qt::UserRole + 1
     };
@@ -34,12 +34,12 @@ class ParameterTableModel : public QAbstractTableModel
 
     Q_PROPERTY(int rowCount READ rowCount NOTIFY rowCountChanged)
 
-    void append      (Fact* fact);
-    void insert      (int row, Fact* fact);
+    void append      (int paramHandle);
+    void insert      (int row, int paramHandle);
     void clear       ();
     void beginReset  ();
     void endReset    ();
-    Fact*            factAt(int row) const;
+    QString          nameAt(int row) const;
 
     // Overrides from QAbstractTableModel
     int         rowCount    (const QModelIndex & parent = QModelIndex()) const override;
@@ -51,8 +51,15 @@ class ParameterTableModel : public QAbstractTableModel
     void rowCountChanged(int count);
 
 private:
+    struct RowData {
+        QString name;
+        QString description;
+        int     paramHandle;
+    };
+
+    ParameterManager*   _parameterMgr = nullptr;
     int                 _tableViewColCount = 3;
-    QList<ColumnData>   _tableData;
+    QList<RowData>      _tableData;
     bool                _externalBeginResetModel = false;
 };
 
@@ -61,7 +68,7 @@ class ParameterEditorGroup : public QObject
     Q_OBJECT
 
 public:
-    ParameterEditorGroup(QObject* parent);
+    ParameterEditorGroup(ParameterManager* parameterMgr, QObject* parent);
 
     Q_PROPERTY(QString              name    MEMBER name     CONSTANT)
     Q_PROPERTY(QAbstractTableModel* facts   READ getFacts   CONSTANT)
@@ -166,19 +173,18 @@ class ParameterEditorController : public FactPanelController
 private slots:
     void _currentCategoryChanged(void);
     void _currentGroupChanged   (void);
-    void _searchTextChanged     (void);
     void _buildLists            (void);
     void _buildListsForComponent(int compId);
-    void _factAdded             (int compId, Fact* fact);
+    void _parameterAdded        (int compId, int paramHandle);
 
 private:
-    bool _shouldShow(Fact *fact) const;
+    bool _shouldShow(int paramHandle) const;
     void _performSearch();
+    void _addToSearchIndex(int paramHandle);
 
 private:
     ParameterManager*           _parameterMgr           = nullptr;
     QString                     _searchText;
-    QTimer                      _searchTimer;
     ParameterEditorCategory*    _currentCategory        = nullptr;
     ParameterEditorGroup*       _currentGroup           = nullptr;
     bool                        _showModifiedOnly       = false;
@@ -190,4 +196,10 @@ private slots:
     ParameterTableModel         _searchParameters;
     QAbstractTableModel*        _parameters             = nullptr;
     QMap<QString, ParameterEditorCategory*> _mapCategoryName2Category;
+
+    // Search support
+    ParameterSearchIndex        _searchIndex;
+    QList<int>                  _searchIndexHandles;                ///< Parameter handle, index is the search index entry id
+    QStringList                 _lastSearchTerms;
+    QList<int>                  _lastSearchMatches;                 ///< Search index entry ids matching _lastSearchTerms, before the modified only filter
 };
@@ -0,0 +1,135 @@
+#include "ParameterSearchIndex.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QRegularExpression>
+#include <QtCore/QSet>
+
+#include <algorithm>
+#include <iterator>
+
+QGC_LOGGING_CATEGORY(ParameterSearchIndexLog, "QMLControls.ParameterSearchIndex")
+
+int ParameterSearchIndex::add(const QStringList &texts)
+{
+    const int id = count();
+    const QString text = texts.join(QLatin1Char('\n')).toCaseFolded();
+
+    QSet<quint64> trigrams;
+    for (qsizetype i = 0; (i + _trigramLength) <= text.length(); i++) {
+        trigrams.insert(_trigramKey(text.constData() + i));
+    }
+    for (const quint64 trigram: trigrams) {
+        // Ids are handed out in increasing order so the posting lists stay sorted
+        _postings[trigram].append(id);
+    }
+
+    _texts.append(text);
+
+    return id;
+}
+
+void ParameterSearchIndex::clear()
+{
+    _texts.clear();
+    _postings.clear();
+}
+
+QList<int> ParameterSearchIndex::search(const QStringList &terms, const QList<int> *candidates) const
+{
+    QStringList literals;
+    QList<QRegularExpression> regexList;
+    for (const QString &term: terms) {
+        if (isLiteral(term)) {
+            literals.append(term.toCaseFolded());
+            continue;
+        }
+
+        const QRegularExpression re(term, QRegularExpression::CaseInsensitiveOption | QRegularExpression::MultilineOption);
+        if (re.isValid()) {
+            regexList.append(re);
+        } else {
+            // Not usable as a regular expression, treat as a plain string
+            literals.append(term.toCaseFolded());
+        }
+    }
+
+    // Narrow down the candidates using the trigrams of the literal terms
+    bool haveCandidates = (candidates != nullptr);
+    QList<int> result = haveCandidates ? *candidates : QList<int>();
+    for (const QString &literal: literals) {
+        for (qsizetype i = 0; (i + _trigramLength) <= literal.length(); i++) {
+            const auto it = _postings.constFind(_trigramKey(literal.constData() + i));
+            if (it == _postings.constEnd()) {
+                return QList<int>();
+            }
+            result = haveCandidates ? _intersect(result, it.value()) : it.value();
+            haveCandidates = true;
+            if (result.isEmpty()) {
+                return result;
+            }
+        }
+    }
+
+    if (!haveCandidates) {
+        // Only short or regular expression terms, everything is a candidate
+        result.reserve(count());
+        for (int id = 0; id < count(); id++) {
+            result.append(id);
+        }
+    }
+
+    qCDebug(ParameterSearchIndexLog) << "search" << terms << "candidates:" << result.count() << "of" << count();
+
+    // Trigrams only tell us a term may be present, verify each candidate
+    QList<int> matches;
+    matches.reserve(result.count());
+    for (const int id: std::as_const(result)) {
+        if ((id < 0) || (id >= count())) {
+            continue;
+        }
+
+        const QString &text = _texts[id];
+        bool matched = true;
+        for (const QString &literal: std::as_const(literals)) {
+            if (!text.contains(literal)) {
+                matched = false;
+                break;
+            }
+        }
+        for (qsizetype i = 0; matched && (i < regexList.count()); i++) {
+            matched = regexList[i].match(text).hasMatch();
+        }
+
+        if (matched) {
+            matches.append(id);
+        }
+    }
+
+    return matches;
+}
+
+bool ParameterSearchIndex::isLiteral(const QString &term)
+{
+    static const QString regexChars = QStringLiteral("\\^$.|?*+()[]{}");
+
+    for (const QChar ch: term) {
+        if (regexChars.contains(ch)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+quint64 ParameterSearchIndex::_trigramKey(const QChar *chars)
+{
+    return (static_cast<quint64>(chars[0].unicode()) << 32) | (static_cast<quint64>(chars[1].unicode()) << 16) | static_cast<quint64>(chars[2].unicode());
+}
+
+QList<int> ParameterSearchIndex::_intersect(const QList<int> &a, const QList<int> &b)
+{
+    QList<int> result;
+    result.reserve(qMin(a.count(), b.count()));
+    (void) std::set_intersection(a.cbegin(), a.cend(), b.cbegin(), b.cend(), std::back_inserter(result));
+    return result;
+}
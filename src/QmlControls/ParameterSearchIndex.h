@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+Q_DECLARE_LOGGING_CATEGORY(ParameterSearchIndexLog)
+
+/// Trigram index over the searchable text of parameters (name and descriptions).
+///     Literal search terms are resolved by intersecting the posting lists of their trigrams, so only the few
+///     candidate entries which can possibly contain the term have their text checked. Terms containing regular
+///     expression syntax fall back to matching the text of each candidate. Entries can be added at any time.
+class ParameterSearchIndex
+{
+public:
+    /// Adds an entry to the index
+    ///     @param texts Searchable strings for the entry
+    /// @return Id of the new entry, ids are assigned in increasing order starting at 0
+    int add(const QStringList &texts);
+
+    void clear();
+    int count() const { return static_cast<int>(_texts.count()); }
+
+    /// Returns the ids of the entries which match all of the terms, in ascending order. Matching is case insensitive.
+    ///     @param terms Search terms, each one is a literal string or a regular expression
+    ///     @param candidates Ascending ids to restrict the search to, for example the results of a previous search
+    ///                       for a shorter prefix of the same search text. nullptr to search all entries.
+    QList<int> search(const QStringList &terms, const QList<int> *candidates = nullptr) const;
+
+    /// @return true: The term contains no regular expression syntax and is matched as a plain string
+    static bool isLiteral(const QString &term);
+
+private:
+    static quint64 _trigramKey(const QChar *chars);
+    static QList<int> _intersect(const QList<int> &a, const QList<int> &b);
+
+    QList<QString> _texts;                  ///< Case folded searchable text for each entry, fields separated by newlines
+    QHash<quint64, QList<int>> _postings;   ///< Trigram -> ascending ids of the entries which contain it
+
+    static constexpr int _trigramLength = 3;
+};
@@ -4,6 +4,8 @@
 #include "QGCQGeoCoordinate.h"
 #include "QGCApplication.h"
 #include "ShapeFileHelper.h"
+#include "SettingsManager.h"
+#include "PlanViewSettings.h"
 #include "QGCLoggingCategory.h"
 
 #include <QtCore/QLineF>
@@ -351,18 +353,38 @@ QList<QGeoCoordinate> QGCMapPolyline::offsetPolyline(double distance)
 
 bool QGCMapPolyline::loadKMLOrSHPFile(const QString &file)
 {
+    ShapeFileHelper::ImportOptions options;
+    options.maxShapes = 1;
+
+    // Optionally reduce large survey/boundary files to a vertex budget which keeps the map item editable
+    PlanViewSettings* planViewSettings = SettingsManager::instance()->planViewSettings();
+    const int maxVertices = planViewSettings->importMaxVertices()->rawValue().toInt();
+    QString simplifiedMessage;
+    if (maxVertices > 0) {
+        options.simplification = static_cast<ShapeFileHelper::SimplificationMethod>(planViewSettings->importSimplificationMethod()->rawValue().toInt());
+        options.maxVerticesPerShape = maxVertices;
+        options.shapeSimplified = [&simplifiedMessage](qsizetype originalCount, qsizetype importedCount) {
+            simplifiedMessage = tr("The imported polyline was simplified from %1 to %2 vertices. The vertex limit can be changed in Plan View settings.").arg(originalCount).arg(importedCount);
+        };
+    }
+
     QString errorString;
-    QList<QGeoCoordinate> rgCoords;
-    if (!ShapeFileHelper::loadPolylineFromFile(file, rgCoords, errorString)) {
+    QList<QList<QGeoCoordinate>> polylines;
+    if (!ShapeFileHelper::loadPolylinesFromFile(file, polylines, errorString, options)) {
         qgcApp()->showAppMessage(errorString);
         return false;
     }
+    const QList<QGeoCoordinate> &rgCoords = polylines.first();
 
     beginReset();
     clear();
     appendVertices(rgCoords);
     endReset();
 
+    if (!simplifiedMessage.isEmpty()) {
+        qgcApp()->showAppMessage(simplifiedMessage);
+    }
+
     return true;
 }
 
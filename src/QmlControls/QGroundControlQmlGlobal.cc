@@ -39,7 +39,6 @@ double QGroundControlQmlGlobal::_zoom = 2;
 
 QGroundControlQmlGlobal::QGroundControlQmlGlobal(QObject *parent)
     : QObject(parent)
-    , _mapEngineManager(QGCMapEngineManager::instance())
     , _adsbVehicleManager(ADSBVehicleManager::instance())
     , _qgcPositionManager(QGCPositionManager::instance())
     , _missionCommandTree(MissionCommandTree::instance())
@@ -55,13 +54,13 @@ QGroundControlQmlGlobal::QGroundControlQmlGlobal(QObject *parent)
 #ifndef QGC_AIRLINK_DISABLED
     , _airlinkManager(AirLinkManager::instance())
 #endif
-#ifdef QGC_UTM_ADAPTER
-    , _utmspManager(UTMSPManager::instance())
-#endif
 {
     // We clear the parent on this object since we run into shutdown problems caused by hybrid qml app. Instead we let it leak on shutdown.
     // setParent(nullptr);
 
+    // The manager itself is only created when the offline map settings are opened
+    QGCMapEngineManager::registerQmlTypes();
+
     // Load last coordinates and zoom from config file
     QSettings settings;
     settings.beginGroup(_flightMapPositionSettingsGroup);
@@ -90,6 +89,26 @@ QGroundControlQmlGlobal::QGroundControlQmlGlobal(QObject *parent)
     });
 }
 
+QGCMapEngineManager *QGroundControlQmlGlobal::mapEngineManager()
+{
+    if (!_mapEngineManager) {
+        _mapEngineManager = QGCMapEngineManager::instance();
+    }
+
+    return _mapEngineManager;
+}
+
+#ifdef QGC_UTM_ADAPTER
+UTMSPManager *QGroundControlQmlGlobal::utmspManager()
+{
+    if (!_utmspManager) {
+        _utmspManager = UTMSPManager::instance();
+    }
+
+    return _utmspManager;
+}
+#endif
+
 QGroundControlQmlGlobal::~QGroundControlQmlGlobal()
 {
 }
@@ -159,7 +159,7 @@ class QGroundControlQmlGlobal : public QObject
     static QString appName();
     LinkManager*            linkManager         ()  { return _linkManager; }
     MultiVehicleManager*    multiVehicleManager ()  { return _multiVehicleManager; }
-    QGCMapEngineManager*    mapEngineManager    ()  { return _mapEngineManager; }
+    QGCMapEngineManager*    mapEngineManager    ();
     QGCPositionManager*     qgcPositionManger   ()  { return _qgcPositionManager; }
     MissionCommandTree*     missionCommandTree  ()  { return _missionCommandTree; }
     VideoManager*           videoManager        ()  { return _videoManager; }
@@ -223,7 +223,7 @@ class QGroundControlQmlGlobal : public QObject
 #endif
 
 #ifdef QGC_UTM_ADAPTER
-    UTMSPManager* utmspManager() {return _utmspManager;}
+    UTMSPManager* utmspManager();
     bool utmspSupported() { return true; }
 #else
     bool utmspSupported() { return false; }
@@ -236,7 +236,7 @@ class QGroundControlQmlGlobal : public QObject
     void flightMapZoomChanged           (double flightMapZoom);
 
 private:
-    QGCMapEngineManager*    _mapEngineManager       = nullptr;
+    QGCMapEngineManager*    _mapEngineManager       = nullptr;  ///< Created on first use, only needed by the offline map settings
     ADSBVehicleManager*     _adsbVehicleManager     = nullptr;
     QGCPositionManager*     _qgcPositionManager     = nullptr;
     MissionCommandTree*     _missionCommandTree     = nullptr;
@@ -253,7 +253,7 @@ class QGroundControlQmlGlobal : public QObject
     AirLinkManager*         _airlinkManager         = nullptr;
 #endif
 #ifdef QGC_UTM_ADAPTER
-    UTMSPManager*           _utmspManager           = nullptr;
+    UTMSPManager*           _utmspManager           = nullptr;  ///< Created on first use
 #endif
 
     double                  _flightMapInitialZoom   = 17.0;
@@ -33,14 +33,17 @@ QGCMapEngineManager *QGCMapEngineManager::instance()
     return _mapEngineManager();
 }
 
+void QGCMapEngineManager::registerQmlTypes()
+{
+    (void) qmlRegisterUncreatableType<QGCMapEngineManager>("QGroundControl.QGCMapEngineManager", 1, 0, "QGCMapEngineManager", "Reference only");
+}
+
 QGCMapEngineManager::QGCMapEngineManager(QObject *parent)
     : QObject(parent)
     , _tileSets(new QmlObjectListModel(this))
 {
     qCDebug(QGCMapEngineManagerLog) << this;
 
-    (void) qmlRegisterUncreatableType<QGCMapEngineManager>("QGroundControl.QGCMapEngineManager", 1, 0, "QGCMapEngineManager", "Reference only");
-
     (void) connect(getQGCMapEngine(), &QGCMapEngine::updateTotals, this, &QGCMapEngineManager::_updateTotals, Qt::UniqueConnection);
 }
 
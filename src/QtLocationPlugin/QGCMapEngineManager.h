@@ -38,6 +38,7 @@ class QGCMapEngineManager : public QObject
     explicit QGCMapEngineManager(QObject *parent = nullptr);
     ~QGCMapEngineManager();
     static QGCMapEngineManager *instance();
+    static void registerQmlTypes();
 
     enum class ImportAction {
         ActionNone,
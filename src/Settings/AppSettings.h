@@ -34,6 +34,7 @@ class AppSettings : public SettingsGroup
     DEFINE_SETTINGFACT(useChecklist)
     DEFINE_SETTINGFACT(enforceChecklist)
     DEFINE_SETTINGFACT(enableMultiVehiclePanel)
+    DEFINE_SETTINGFACT(preloadViews)
     DEFINE_SETTINGFACT(tiandituToken)
     DEFINE_SETTINGFACT(mapboxToken)
     DEFINE_SETTINGFACT(mapboxAccount)
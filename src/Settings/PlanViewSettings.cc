@@ -11,3 +11,5 @@ DECLARE_SETTINGSFACT(PlanViewSettings, takeoffItemNotRequired)
 DECLARE_SETTINGSFACT(PlanViewSettings, allowMultipleLandingPatterns)
 DECLARE_SETTINGSFACT(PlanViewSettings, showGimbalOnlyWhenSet)
 DECLARE_SETTINGSFACT(PlanViewSettings, vtolTransitionDistance)
+DECLARE_SETTINGSFACT(PlanViewSettings, importMaxVertices)
+DECLARE_SETTINGSFACT(PlanViewSettings, importSimplificationMethod)
@@ -22,4 +22,6 @@ class PlanViewSettings : public SettingsGroup
     DEFINE_SETTINGFACT(allowMultipleLandingPatterns)
     DEFINE_SETTINGFACT(showGimbalOnlyWhenSet)
     DEFINE_SETTINGFACT(vtolTransitionDistance)
+    DEFINE_SETTINGFACT(importMaxVertices)
+    DEFINE_SETTINGFACT(importSimplificationMethod)
 };
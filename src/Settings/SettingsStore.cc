@@ -0,0 +1,173 @@
+#include "SettingsStore.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QApplicationStatic>
+#include <QtCore/QSettings>
+
+#include <memory>
+
+QGC_LOGGING_CATEGORY(SettingsStoreLog, "Settings.SettingsStore")
+
+Q_APPLICATION_STATIC(SettingsStore, _settingsStoreInstance);
+
+SettingsStore::SettingsStore(const QString &fileName, QObject *parent)
+    : QObject(parent)
+    , _fileName(fileName)
+{
+    // qCDebug(SettingsStoreLog) << Q_FUNC_INFO << this;
+
+    _flushTimer.setSingleShot(true);
+    _flushTimer.setInterval(kFlushDelayMs);
+    (void) connect(&_flushTimer, &QTimer::timeout, this, &SettingsStore::_flushAsync);
+}
+
+SettingsStore::~SettingsStore()
+{
+    flush();
+
+    qCDebug(SettingsStoreLog) << "Writes requested:" << _requestedWriteCount << "written:" << _flushedWriteCount << "saved by coalescing:" << coalescedWriteCount();
+
+    // qCDebug(SettingsStoreLog) << Q_FUNC_INFO << this;
+}
+
+SettingsStore *SettingsStore::instance()
+{
+    return _settingsStoreInstance();
+}
+
+QString SettingsStore::_path(const QString &group, const QString &key)
+{
+    return (group.isEmpty() ? key : QStringLiteral("%1/%2").arg(group, key));
+}
+
+QVariant SettingsStore::value(const QString &group, const QString &key, const QVariant &defaultValue) const
+{
+    const QString path = _path(group, key);
+
+    {
+        QMutexLocker locker(&_mutex);
+
+        auto it = _pending.constFind(path);
+        if (it != _pending.constEnd()) {
+            return it.value();
+        }
+        it = _inFlight.constFind(path);
+        if (it != _inFlight.constEnd()) {
+            return it.value();
+        }
+    }
+
+    if (_fileName.isEmpty()) {
+        return QSettings().value(path, defaultValue);
+    }
+    return QSettings(_fileName, QSettings::IniFormat).value(path, defaultValue);
+}
+
+void SettingsStore::setValue(const QString &group, const QString &key, const QVariant &value)
+{
+    {
+        QMutexLocker locker(&_mutex);
+        _pending[_path(group, key)] = value;
+        _requestedWriteCount++;
+    }
+
+    // Not restarted on each change, a continuous stream of changes is still written out every kFlushDelayMs
+    if (!_flushTimer.isActive()) {
+        _flushTimer.start();
+    }
+}
+
+int SettingsStore::pendingCount() const
+{
+    QMutexLocker locker(&_mutex);
+    return static_cast<int>(_pending.count());
+}
+
+quint64 SettingsStore::requestedWriteCount() const
+{
+    QMutexLocker locker(&_mutex);
+    return _requestedWriteCount;
+}
+
+quint64 SettingsStore::flushedWriteCount() const
+{
+    QMutexLocker locker(&_mutex);
+    return _flushedWriteCount;
+}
+
+quint64 SettingsStore::coalescedWriteCount() const
+{
+    QMutexLocker locker(&_mutex);
+    return _requestedWriteCount - _flushedWriteCount - static_cast<quint64>(_pending.count());
+}
+
+void SettingsStore::_flushAsync()
+{
+    if (_flushFuture.isRunning()) {
+        // Only one writer at a time, try again once the current batch is done
+        _flushTimer.start();
+        return;
+    }
+
+    QHash<QString, QVariant> values;
+    {
+        QMutexLocker locker(&_mutex);
+        if (_pending.isEmpty()) {
+            return;
+        }
+        values.swap(_pending);
+        _inFlight = values;
+        _flushedWriteCount += static_cast<quint64>(values.count());
+    }
+
+    qCDebug(SettingsStoreLog) << "Flushing" << values.count() << "values, saved by coalescing:" << coalescedWriteCount();
+
+    _flushFuture = QtConcurrent::run([this, values]() {
+        _write(_fileName, values);
+        {
+            QMutexLocker locker(&_mutex);
+            _inFlight.clear();
+        }
+        const int valueCount = static_cast<int>(values.count());
+        (void) QMetaObject::invokeMethod(this, [this, valueCount]() { emit flushComplete(valueCount); }, Qt::QueuedConnection);
+    });
+}
+
+void SettingsStore::flush()
+{
+    _flushTimer.stop();
+    _flushFuture.waitForFinished();
+
+    QHash<QString, QVariant> values;
+    {
+        QMutexLocker locker(&_mutex);
+        if (_pending.isEmpty()) {
+            return;
+        }
+        values.swap(_pending);
+        _inFlight = values;
+        _flushedWriteCount += static_cast<quint64>(values.count());
+    }
+
+    _write(_fileName, values);
+    {
+        QMutexLocker locker(&_mutex);
+        _inFlight.clear();
+    }
+    emit flushComplete(static_cast<int>(values.count()));
+}
+
+void SettingsStore::_write(const QString &fileName, const QHash<QString, QVariant> &values)
+{
+    std::unique_ptr<QSettings> settings = fileName.isEmpty() ? std::make_unique<QSettings>() : std::make_unique<QSettings>(fileName, QSettings::IniFormat);
+
+    for (auto it = values.constBegin(); it != values.constEnd(); ++it) {
+        settings->setValue(it.key(), it.value());
+    }
+
+    settings->sync();
+    if (settings->status() != QSettings::NoError) {
+        qCWarning(SettingsStoreLog) << "Failed to write settings" << settings->fileName() << settings->status();
+    }
+}
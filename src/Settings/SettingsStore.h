@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QtCore/QFuture>
+#include <QtCore/QHash>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+#include <QtCore/QVariant>
+
+Q_DECLARE_LOGGING_CATEGORY(SettingsStoreLog)
+
+/// Write-behind store for settings values.
+///     Values are held in memory and written to QSettings in batches on a background thread, so a slider bound to a
+///     setting causes a single write once the user lets go instead of one per step. Repeated changes to the same key
+///     before a flush are coalesced into one write. The file based QSettings formats write through QSaveFile, so a
+///     crash during a flush leaves the previous file intact rather than a partially written one.
+///     Reads through value() see pending changes. Code which reads the same keys through its own QSettings object
+///     sees them once the flush which is at most kFlushDelayMs away has completed.
+class SettingsStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// @param fileName Ini file to store values in, empty to use the application's default QSettings location
+    explicit SettingsStore(const QString &fileName = QString(), QObject *parent = nullptr);
+    ~SettingsStore();
+
+    static SettingsStore *instance();
+
+    /// @param group Settings group, empty for the top level
+    QVariant value(const QString &group, const QString &key, const QVariant &defaultValue = QVariant()) const;
+    void setValue(const QString &group, const QString &key, const QVariant &value);
+
+    /// Writes all pending values and waits for the write to complete
+    void flush();
+
+    int pendingCount() const;
+    quint64 requestedWriteCount() const;    ///< Calls to setValue
+    quint64 flushedWriteCount() const;      ///< Values actually written to QSettings
+    quint64 coalescedWriteCount() const;    ///< Writes saved by coalescing changes to the same key
+
+    static constexpr int kFlushDelayMs = 500;
+
+signals:
+    /// Emitted on the store's thread after a batch has been written
+    void flushComplete(int valueCount);
+
+private slots:
+    void _flushAsync();
+
+private:
+    static QString _path(const QString &group, const QString &key);
+    static void _write(const QString &fileName, const QHash<QString, QVariant> &values);
+
+    const QString _fileName;
+    mutable QMutex _mutex;
+    QHash<QString, QVariant> _pending;      ///< Changed since the last flush was started
+    QHash<QString, QVariant> _inFlight;     ///< Being written by the background flush
+    QFuture<void> _flushFuture;
+    QTimer _flushTimer;
+    quint64 _requestedWriteCount = 0;
+    quint64 _flushedWriteCount = 0;
+};
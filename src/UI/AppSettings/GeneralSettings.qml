@@ -56,6 +56,13 @@ SettingsPage {
             visible:    fact.visible
         }
 
+        FactCheckBoxSlider {
+            Layout.fillWidth: true
+            text:       fact.shortDescription
+            fact:       _appSettings.preloadViews
+            visible:    fact.visible
+        }
+
         QGCCheckBoxSlider {
             Layout.fillWidth: true
             text:       qsTr("Clear all settings on next start")
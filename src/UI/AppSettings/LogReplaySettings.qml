@@ -29,7 +29,7 @@ RowLayout {
     QGCFileDialog {
         id: filePicker
         title: qsTr("Select Telemetery Log")
-        nameFilters: [ qsTr("Telemetry Logs (*.%1)").arg(_logFileExtension), qsTr("All Files (*)") ]
+        nameFilters: [ qsTr("Telemetry Logs (*.%1 *.%1.zst)").arg(_logFileExtension), qsTr("All Files (*)") ]
         folder: QGroundControl.settingsManager.appSettings.telemetrySavePath
 
         property string _logFileExtension: QGroundControl.settingsManager.appSettings.telemetryFileExtension
@@ -380,6 +380,39 @@ Rectangle {
                             _mavlinkLogManager.deleteAfterUpload = checked
                         }
                     }
+                    //-----------------------------------------------------------------
+                    //-- Resumable upload
+                    QGCCheckBox {
+                        text:       qsTr("Resumable chunked uploads (server must support tus)")
+                        checked:    _mavlinkLogManager.resumableUpload
+                        enabled:    !_mavlinkLogManager.uploading && !_disableDataPersistence
+                        onClicked: {
+                            _mavlinkLogManager.resumableUpload = checked
+                        }
+                    }
+                    //-----------------------------------------------------------------
+                    //-- Upload rate limit
+                    Row {
+                        spacing:    ScreenTools.defaultFontPixelWidth
+                        visible:    _mavlinkLogManager.resumableUpload
+                        QGCLabel {
+                            width:              _labelWidth
+                            anchors.baseline:   rateLimitField.baseline
+                            text:               qsTr("Upload Limit (KB/s, 0 = none):")
+                        }
+                        QGCTextField {
+                            id:         rateLimitField
+                            text:       _mavlinkLogManager.uploadRateLimit
+                            width:      _valueWidth
+                            enabled:    !_disableDataPersistence
+                            inputMethodHints:       Qt.ImhDigitsOnly
+                            validator:  IntValidator { bottom: 0 }
+                            anchors.verticalCenter: parent.verticalCenter
+                            onEditingFinished: {
+                                _mavlinkLogManager.uploadRateLimit = parseInt(text)
+                            }
+                        }
+                    }
                 }
             }
             //-----------------------------------------------------------------
@@ -47,5 +47,21 @@ SettingsPage {
             fact:               _planViewSettings.allowMultipleLandingPatterns
             visible:            fact.visible
         }
+
+        LabelledFactTextField {
+            Layout.fillWidth:   true
+            label:              qsTr("Simplify imported shapes above vertex count (0 to disable)")
+            fact:               _planViewSettings.importMaxVertices
+            visible:            fact.visible
+        }
+
+        LabelledFactComboBox {
+            Layout.fillWidth:   true
+            label:              qsTr("Shape simplification method")
+            fact:               _planViewSettings.importSimplificationMethod
+            indexModel:         false
+            visible:            fact.visible
+            enabled:            _planViewSettings.importMaxVertices.rawValue > 0
+        }
     }
 }
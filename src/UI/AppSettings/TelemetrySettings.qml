@@ -121,6 +121,15 @@ SettingsPage {
             property Fact _telemetrySaveNotArmed: _mavlinkSettings.telemetrySaveNotArmed
         }
 
+        FactCheckBoxSlider {
+            Layout.fillWidth:   true
+            text:               qsTr("Compress saved logs")
+            fact:               _telemetryCompress
+            visible:            fact.visible
+            enabled:            _mavlinkSettings.telemetrySave.rawValue
+            property Fact _telemetryCompress: _mavlinkSettings.telemetryCompress
+        }
+
         FactCheckBoxSlider {
             Layout.fillWidth:   true
             text:               qsTr("Save CSV log of telemetry data")
@@ -106,13 +106,14 @@ ApplicationWindow {
 
     function showPlanView() {
         flyView.visible = false
-        planView.visible = true
+        planViewLoader.active = true
+        planViewLoader.visible = true
         toolDrawer.visible = false
     }
 
     function showFlyView() {
         flyView.visible = true
-        planView.visible = false
+        planViewLoader.visible = false
         toolDrawer.visible = false
     }
 
@@ -134,21 +135,21 @@ ApplicationWindow {
 
     function showVehicleConfigParametersPage() {
         showVehicleConfig()
-        toolDrawerLoader.item.showParametersPanel()
+        toolDrawerLoader.callWhenLoaded(function(item) { item.showParametersPanel() })
     }
 
     function showKnownVehicleComponentConfigPage(knownVehicleComponent) {
         showVehicleConfig()
         let vehicleComponent = globals.activeVehicle.autopilotPlugin.findKnownVehicleComponent(knownVehicleComponent)
         if (vehicleComponent) {
-            toolDrawerLoader.item.showVehicleComponentPanel(vehicleComponent)
+            toolDrawerLoader.callWhenLoaded(function(item) { item.showVehicleComponentPanel(vehicleComponent) })
         }
     }
 
     function showSettingsTool(settingsPage = "") {
         showTool(qsTr("Application Settings"), "qrc:/qml/QGroundControl/Controls/AppSettings.qml", "/res/QGCLogoWhite")
         if (settingsPage !== "") {
-            toolDrawerLoader.item.showSettingsPage(settingsPage)
+            toolDrawerLoader.callWhenLoaded(function(item) { item.showSettingsPage(settingsPage) })
         }
     }
 
@@ -206,7 +207,7 @@ ApplicationWindow {
     property string closeDialogTitle: qsTr("Close %1").arg(QGroundControl.appName)
 
     function checkForUnsavedMission() {
-        if (planView._planMasterController.dirty) {
+        if (planViewLoader.item && planViewLoader.item._planMasterController.dirty) {
             showMessageDialog(closeDialogTitle,
                               qsTr("You have a mission edit in progress which has not been saved/sent. If you close you will lose changes. Are you sure you want to close?"),
                               Dialog.Yes | Dialog.No,
@@ -259,10 +260,38 @@ ApplicationWindow {
         anchors.fill:           parent
     }
 
-    PlanView {
-        id:             planView
-        anchors.fill:   parent
-        visible:        false
+    // The Plan view is created the first time it is shown, or in the background after startup if views are preloaded
+    Loader {
+        id:                 planViewLoader
+        anchors.fill:       parent
+        visible:            false
+        active:             false
+        asynchronous:       true
+        sourceComponent:    PlanView { }
+    }
+
+    QGCLabel {
+        anchors.centerIn:   parent
+        text:               qsTr("Loading...")
+        font.pointSize:     ScreenTools.largeFontPointSize
+        visible:            planViewLoader.visible && planViewLoader.status !== Loader.Ready
+    }
+
+    /// Loads the views which aren't part of the Fly view in the background so they are ready when first opened
+    Timer {
+        id:         preloadViewsTimer
+        interval:   1000
+        running:    QGroundControl.settingsManager.appSettings.preloadViews.rawValue
+        onTriggered: {
+            planViewLoader.active = true
+            // Compiling the tool components fills the engine's type cache, opening them later only creates the objects
+            _preloadedComponents = [
+                Qt.createComponent("qrc:/qml/QGroundControl/AnalyzeView/AnalyzeView.qml", Component.Asynchronous),
+                Qt.createComponent("qrc:/qml/QGroundControl/VehicleSetup/SetupView.qml", Component.Asynchronous)
+            ]
+        }
+
+        property var _preloadedComponents: []
     }
 
     footer: LogReplayStatusBar {
@@ -373,6 +402,28 @@ ApplicationWindow {
             anchors.right:  parent.right
             anchors.top:    toolDrawerToolbar.bottom
             anchors.bottom: parent.bottom
+            asynchronous:   true
+
+            property var _pendingCalls: []
+
+            /// Calls func with the loaded tool, waiting for the tool to finish loading if needed
+            function callWhenLoaded(func) {
+                if (status === Loader.Ready) {
+                    func(item)
+                } else {
+                    _pendingCalls.push(func)
+                }
+            }
+
+            onSourceChanged: _pendingCalls = []
+
+            onLoaded: {
+                let pendingCalls = _pendingCalls
+                _pendingCalls = []
+                for (let i = 0; i < pendingCalls.length; i++) {
+                    pendingCalls[i](item)
+                }
+            }
 
             Connections {
                 target:                 toolDrawerLoader.item
@@ -0,0 +1,525 @@
+#include "QGCZstdSeekable.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QtEndian>
+
+#include <algorithm>
+#include <cstring>
+
+#include <zstd.h>
+
+QGC_LOGGING_CATEGORY(QGCZstdSeekableLog, "Utilities.QGCZstdSeekable")
+
+namespace {
+
+void appendLE32(QByteArray &out, quint32 value)
+{
+    const quint32 le = qToLittleEndian(value);
+    out.append(reinterpret_cast<const char*>(&le), sizeof(le));
+}
+
+quint32 readLE32(const char *data)
+{
+    return qFromLittleEndian<quint32>(data);
+}
+
+QString zstdError(size_t result)
+{
+    return QString::fromLatin1(ZSTD_getErrorName(result));
+}
+
+} // namespace
+
+bool QGCZstdSeekable::isZstdFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const QByteArray magic = file.read(sizeof(quint32));
+    return (magic.size() == sizeof(quint32)) && (readLE32(magic.constData()) == kFrameMagic);
+}
+
+// ============================================================================
+// QGCZstdSeekableWriter
+// ============================================================================
+
+QGCZstdSeekableWriter::QGCZstdSeekableWriter(QIODevice *target, QObject *parent)
+    : QIODevice(parent)
+    , _target(target)
+{
+}
+
+QGCZstdSeekableWriter::~QGCZstdSeekableWriter()
+{
+    close();
+
+    if (_cctx) {
+        (void) ZSTD_freeCCtx(_cctx);
+    }
+}
+
+void QGCZstdSeekableWriter::setFrameSize(qint64 bytes)
+{
+    _frameSize = qBound(static_cast<qint64>(1), bytes, QGCZstdSeekableDevice::kMaxFrameSize);
+}
+
+void QGCZstdSeekableWriter::setCompressionLevel(int level)
+{
+    _compressionLevel = qBound(ZSTD_minCLevel(), level, ZSTD_maxCLevel());
+}
+
+bool QGCZstdSeekableWriter::open(OpenMode mode)
+{
+    if ((mode & QIODevice::ReadOnly) || !(mode & QIODevice::WriteOnly)) {
+        setErrorString(tr("Seekable zstd writer is write-only"));
+        return false;
+    }
+
+    if (!_target || !_target->isWritable()) {
+        setErrorString(tr("Target device is not open for writing"));
+        return false;
+    }
+
+    if (!_cctx) {
+        _cctx = ZSTD_createCCtx();
+        if (!_cctx) {
+            setErrorString(tr("Could not create zstd compression context"));
+            return false;
+        }
+    }
+
+    _frame.clear();
+    _frame.reserve(_frameSize);
+    _seekTable.clear();
+    _failed = false;
+    _finished = false;
+
+    return QIODevice::open(mode | QIODevice::Unbuffered);
+}
+
+void QGCZstdSeekableWriter::close()
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    (void) finish();
+    QIODevice::close();
+}
+
+bool QGCZstdSeekableWriter::finish()
+{
+    if (_finished) {
+        return !_failed;
+    }
+    _finished = true;
+
+    if (!_failed && !_frame.isEmpty()) {
+        (void) _writeFrame();
+    }
+    if (!_failed) {
+        (void) _writeSeekTable();
+    }
+
+    qCDebug(QGCZstdSeekableLog) << "Wrote" << _seekTable.count() << "frames" << (_failed ? errorString() : QString());
+
+    return !_failed;
+}
+
+qint64 QGCZstdSeekableWriter::readData(char *data, qint64 maxSize)
+{
+    Q_UNUSED(data); Q_UNUSED(maxSize);
+    return -1;
+}
+
+qint64 QGCZstdSeekableWriter::writeData(const char *data, qint64 maxSize)
+{
+    if (_failed || _finished) {
+        return -1;
+    }
+
+    qint64 written = 0;
+    while (written < maxSize) {
+        const qint64 count = qMin(maxSize - written, _frameSize - _frame.size());
+        (void) _frame.append(data + written, count);
+        written += count;
+
+        if ((_frame.size() >= _frameSize) && !_writeFrame()) {
+            return -1;
+        }
+    }
+
+    return written;
+}
+
+bool QGCZstdSeekableWriter::_writeFrame()
+{
+    const size_t bound = ZSTD_compressBound(static_cast<size_t>(_frame.size()));
+    _compressed.resize(static_cast<qsizetype>(bound));
+
+    const size_t result = ZSTD_compressCCtx(_cctx, _compressed.data(), bound, _frame.constData(), static_cast<size_t>(_frame.size()), _compressionLevel);
+    if (ZSTD_isError(result)) {
+        setErrorString(tr("Compression failed: %1").arg(zstdError(result)));
+        _failed = true;
+        return false;
+    }
+
+    _compressed.resize(static_cast<qsizetype>(result));
+    if (!_writeTarget(_compressed)) {
+        return false;
+    }
+
+    Entry entry;
+    entry.compressedSize = static_cast<quint32>(result);
+    entry.decompressedSize = static_cast<quint32>(_frame.size());
+    _seekTable.append(entry);
+
+    // Keeps the allocation for the next frame
+    _frame.resize(0);
+    return true;
+}
+
+bool QGCZstdSeekableWriter::_writeSeekTable()
+{
+    const quint32 frameCount = static_cast<quint32>(_seekTable.count());
+    const quint32 tableSize = (frameCount * 2 * sizeof(quint32)) + QGCZstdSeekable::kSeekTableFooterSize;
+
+    QByteArray table;
+    table.reserve(QGCZstdSeekable::kSkippableHeaderSize + tableSize);
+    appendLE32(table, QGCZstdSeekable::kSeekTableMagic);
+    appendLE32(table, tableSize);
+    for (const Entry &entry : std::as_const(_seekTable)) {
+        appendLE32(table, entry.compressedSize);
+        appendLE32(table, entry.decompressedSize);
+    }
+    appendLE32(table, frameCount);
+    (void) table.append('\0');
+    appendLE32(table, QGCZstdSeekable::kSeekTableFooterMagic);
+
+    return _writeTarget(table);
+}
+
+bool QGCZstdSeekableWriter::_writeTarget(const QByteArray &data)
+{
+    if (!_target->isWritable()) {
+        setErrorString(tr("Target device is not open for writing"));
+        _failed = true;
+        return false;
+    }
+
+    if (_target->write(data) != data.size()) {
+        setErrorString(tr("Write failed: %1").arg(_target->errorString()));
+        _failed = true;
+        return false;
+    }
+
+    return true;
+}
+
+// ============================================================================
+// QGCZstdSeekableDevice
+// ============================================================================
+
+QGCZstdSeekableDevice::QGCZstdSeekableDevice(const QString &fileName, QObject *parent)
+    : QIODevice(parent)
+    , _file(fileName)
+{
+}
+
+QGCZstdSeekableDevice::~QGCZstdSeekableDevice()
+{
+    close();
+
+    if (_dctx) {
+        (void) ZSTD_freeDCtx(_dctx);
+    }
+}
+
+bool QGCZstdSeekableDevice::open(OpenMode mode)
+{
+    if (mode & QIODevice::WriteOnly) {
+        setErrorString(tr("Seekable zstd device is read-only"));
+        return false;
+    }
+
+    if (!_file.open(QIODevice::ReadOnly)) {
+        setErrorString(_file.errorString());
+        return false;
+    }
+
+    if (!_dctx) {
+        _dctx = ZSTD_createDCtx();
+        if (!_dctx) {
+            setErrorString(tr("Could not create zstd decompression context"));
+            _file.close();
+            return false;
+        }
+    }
+
+    _frames.clear();
+    _size = 0;
+    _loadedFrame = -1;
+    _hasSeekTable = _readSeekTable();
+    if (!_hasSeekTable && !_scanFrames()) {
+        _file.close();
+        return false;
+    }
+    _devicePos = 0;
+
+    qCDebug(QGCZstdSeekableLog) << "Opened" << _file.fileName() << "frames:" << _frames.count() << "size:" << _size << "seek table:" << _hasSeekTable;
+
+    // Reads are served straight from the current frame, a QIODevice buffer would only copy the data once more
+    return QIODevice::open(mode | QIODevice::Unbuffered);
+}
+
+void QGCZstdSeekableDevice::close()
+{
+    if (isOpen()) {
+        QIODevice::close();
+    }
+
+    _file.close();
+    _frames.clear();
+    _frameData.clear();
+    _compressed.clear();
+    _loadedFrame = -1;
+    _size = 0;
+    _devicePos = 0;
+}
+
+bool QGCZstdSeekableDevice::seek(qint64 pos)
+{
+    if (pos < 0) {
+        return false;
+    }
+
+    _devicePos = pos;
+    return QIODevice::seek(pos);
+}
+
+qint64 QGCZstdSeekableDevice::readData(char *data, qint64 maxSize)
+{
+    qint64 copied = 0;
+    while ((copied < maxSize) && (_devicePos < _size)) {
+        int index = _loadedFrame;
+        if ((index < 0) || (_devicePos < _frames[index].decompressedOffset) ||
+            (_devicePos >= (_frames[index].decompressedOffset + _frames[index].decompressedSize))) {
+            index = _frameIndex(_devicePos);
+            if (!_loadFrame(index)) {
+                return (copied > 0) ? copied : -1;
+            }
+        }
+
+        const Frame &frame = _frames[index];
+        const qint64 offset = _devicePos - frame.decompressedOffset;
+        const qint64 count = qMin(maxSize - copied, frame.decompressedSize - offset);
+        (void) memcpy(data + copied, _frameData.constData() + offset, static_cast<size_t>(count));
+        copied += count;
+        _devicePos += count;
+    }
+
+    return copied;
+}
+
+qint64 QGCZstdSeekableDevice::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data); Q_UNUSED(maxSize);
+    return -1;
+}
+
+bool QGCZstdSeekableDevice::_readSeekTable()
+{
+    using namespace QGCZstdSeekable;
+
+    const qint64 fileSize = _file.size();
+    if ((fileSize < (kSkippableHeaderSize + kSeekTableFooterSize)) || !_file.seek(fileSize - kSeekTableFooterSize)) {
+        return false;
+    }
+
+    const QByteArray footer = _file.read(kSeekTableFooterSize);
+    if ((footer.size() != kSeekTableFooterSize) || (readLE32(footer.constData() + 5) != kSeekTableFooterMagic)) {
+        return false;
+    }
+
+    // Bits 2-6 of the descriptor are reserved and must be zero
+    const quint8 descriptor = static_cast<quint8>(footer[4]);
+    if (descriptor & 0x7C) {
+        return false;
+    }
+
+    const qint64 frameCount = readLE32(footer.constData());
+    const qint64 entrySize = (descriptor & kChecksumFlag) ? 12 : 8;
+    const qint64 tableSize = kSkippableHeaderSize + (frameCount * entrySize) + kSeekTableFooterSize;
+    if ((tableSize > fileSize) || !_file.seek(fileSize - tableSize)) {
+        return false;
+    }
+
+    const QByteArray table = _file.read(tableSize - kSeekTableFooterSize);
+    if ((table.size() != (tableSize - kSeekTableFooterSize)) ||
+        (readLE32(table.constData()) != kSeekTableMagic) ||
+        (readLE32(table.constData() + 4) != static_cast<quint32>(tableSize - kSkippableHeaderSize))) {
+        return false;
+    }
+
+    qint64 compressedOffset = 0;
+    for (qint64 i = 0; i < frameCount; i++) {
+        const char *const entry = table.constData() + kSkippableHeaderSize + (i * entrySize);
+        const qint64 compressedSize = readLE32(entry);
+        if (!_addFrame(compressedOffset, compressedSize, readLE32(entry + 4))) {
+            break;
+        }
+        compressedOffset += compressedSize;
+    }
+
+    // The frames have to account for everything in front of the table, otherwise the table is not trusted
+    if (compressedOffset != (fileSize - tableSize)) {
+        qCWarning(QGCZstdSeekableLog) << "Seek table does not match file, indexing frames" << _file.fileName();
+        _frames.clear();
+        _size = 0;
+        return false;
+    }
+
+    return true;
+}
+
+bool QGCZstdSeekableDevice::_scanFrames()
+{
+    using namespace QGCZstdSeekable;
+
+    const qint64 fileSize = _file.size();
+    const qint64 maxCompressedSize = static_cast<qint64>(ZSTD_compressBound(kMaxFrameSize)) + kSkippableHeaderSize;
+
+    qint64 offset = 0;
+    while (offset < fileSize) {
+        if (!_file.seek(offset)) {
+            setErrorString(_file.errorString());
+            return false;
+        }
+
+        const QByteArray header = _file.read(kSkippableHeaderSize);
+        if (header.size() < kSkippableHeaderSize) {
+            break;
+        }
+
+        const quint32 magic = readLE32(header.constData());
+        if ((magic & kSkippableMagicMask) == kSkippableMagic) {
+            offset += kSkippableHeaderSize + readLE32(header.constData() + 4);
+            continue;
+        }
+
+        if (magic != kFrameMagic) {
+            if (offset == 0) {
+                setErrorString(tr("Not a zstd file"));
+                return false;
+            }
+            qCWarning(QGCZstdSeekableLog) << "Ignoring data which is not a zstd frame at offset" << offset << _file.fileName();
+            break;
+        }
+
+        // Grow the window until it holds the whole frame
+        qint64 windowSize = qMin(static_cast<qint64>(1024 * 1024), fileSize - offset);
+        QByteArray window;
+        size_t compressedSize = 0;
+        while (true) {
+            if (!_file.seek(offset)) {
+                setErrorString(_file.errorString());
+                return false;
+            }
+            window = _file.read(windowSize);
+            compressedSize = ZSTD_findFrameCompressedSize(window.constData(), static_cast<size_t>(window.size()));
+            if (!ZSTD_isError(compressedSize)) {
+                break;
+            }
+            if ((windowSize >= (fileSize - offset)) || (windowSize >= maxCompressedSize)) {
+                compressedSize = 0;
+                break;
+            }
+            windowSize = qMin(windowSize * 2, fileSize - offset);
+        }
+
+        if (compressedSize == 0) {
+            // Expected for a log whose writer was interrupted
+            qCWarning(QGCZstdSeekableLog) << "Ignoring truncated frame at offset" << offset << _file.fileName();
+            break;
+        }
+
+        const unsigned long long contentSize = ZSTD_getFrameContentSize(window.constData(), static_cast<size_t>(window.size()));
+        if ((contentSize == ZSTD_CONTENTSIZE_UNKNOWN) || (contentSize == ZSTD_CONTENTSIZE_ERROR)) {
+            setErrorString(tr("zstd frame at offset %1 has no content size, decompress the file first").arg(offset));
+            return false;
+        }
+
+        if (!_addFrame(offset, static_cast<qint64>(compressedSize), static_cast<qint64>(contentSize))) {
+            return false;
+        }
+        offset += static_cast<qint64>(compressedSize);
+    }
+
+    return true;
+}
+
+bool QGCZstdSeekableDevice::_addFrame(qint64 compressedOffset, qint64 compressedSize, qint64 decompressedSize)
+{
+    if (decompressedSize > kMaxFrameSize) {
+        setErrorString(tr("zstd frame of %1 bytes is too large to seek in, decompress the file first").arg(decompressedSize));
+        return false;
+    }
+
+    if (decompressedSize > 0) {
+        Frame frame;
+        frame.compressedOffset = compressedOffset;
+        frame.compressedSize = compressedSize;
+        frame.decompressedOffset = _size;
+        frame.decompressedSize = decompressedSize;
+        _frames.append(frame);
+        _size += decompressedSize;
+    }
+
+    return true;
+}
+
+int QGCZstdSeekableDevice::_frameIndex(qint64 pos) const
+{
+    const auto it = std::upper_bound(_frames.cbegin(), _frames.cend(), pos, [](qint64 value, const Frame &frame) {
+        return value < frame.decompressedOffset;
+    });
+
+    return static_cast<int>(std::distance(_frames.cbegin(), it)) - 1;
+}
+
+bool QGCZstdSeekableDevice::_loadFrame(int index)
+{
+    if (index == _loadedFrame) {
+        return true;
+    }
+
+    _loadedFrame = -1;
+    if ((index < 0) || (index >= _frames.count())) {
+        setErrorString(tr("Position outside of the file"));
+        return false;
+    }
+
+    const Frame &frame = _frames[index];
+    if (!_file.seek(frame.compressedOffset)) {
+        setErrorString(_file.errorString());
+        return false;
+    }
+
+    _compressed = _file.read(frame.compressedSize);
+    if (_compressed.size() != frame.compressedSize) {
+        setErrorString(tr("Unexpected end of file reading frame %1").arg(index));
+        return false;
+    }
+
+    _frameData.resize(frame.decompressedSize);
+    const size_t result = ZSTD_decompressDCtx(_dctx, _frameData.data(), static_cast<size_t>(_frameData.size()), _compressed.constData(), static_cast<size_t>(_compressed.size()));
+    if (ZSTD_isError(result) || (static_cast<qint64>(result) != frame.decompressedSize)) {
+        setErrorString(tr("Could not decompress frame %1: %2").arg(index).arg(ZSTD_isError(result) ? zstdError(result) : tr("size mismatch")));
+        return false;
+    }
+
+    _loadedFrame = index;
+    return true;
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+/// @file QGCZstdSeekable.h
+/// @brief Writer and random-access reader for the Zstandard seekable format
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QIODevice>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
+Q_DECLARE_LOGGING_CATEGORY(QGCZstdSeekableLog)
+
+/// Zstandard seekable format
+///
+/// Data is compressed as a series of independent zstd frames of a fixed uncompressed size, followed by a seek
+/// table in a skippable frame at the end of the file. Any zstd decoder reads such a file as a regular .zst file,
+/// while a reader which understands the seek table decompresses only the frame a position falls into.
+///
+/// Seek table layout (all values little endian):
+/// - Skippable frame header: magic 0x184D2A5E, u32 size of the rest of the table
+/// - Per frame: u32 compressed size, u32 decompressed size
+/// - Footer: u32 frame count, u8 descriptor (bit 7 set: entries carry a checksum), u32 magic 0x8F92EAB1
+namespace QGCZstdSeekable {
+
+constexpr quint32 kFrameMagic = 0xFD2FB528;
+constexpr quint32 kSkippableMagic = 0x184D2A50;         ///< Low four bits are user defined
+constexpr quint32 kSkippableMagicMask = 0xFFFFFFF0;
+constexpr quint32 kSeekTableMagic = 0x184D2A5E;
+constexpr quint32 kSeekTableFooterMagic = 0x8F92EAB1;
+constexpr int kSkippableHeaderSize = 8;
+constexpr int kSeekTableFooterSize = 9;
+constexpr quint8 kChecksumFlag = 0x80;
+
+/// @return true: File starts with a zstd frame
+bool isZstdFile(const QString &fileName);
+
+} // namespace QGCZstdSeekable
+
+/// Compresses data written to it into the seekable format
+/// Write-only, sequential. The seek table is written by finish() or close().
+///
+/// Example usage:
+/// @code
+/// QFile out("flight.tlog.zst");
+/// out.open(QIODevice::WriteOnly);
+/// QGCZstdSeekableWriter writer(&out);
+/// writer.open(QIODevice::WriteOnly);
+/// writer.write(data);
+/// if (!writer.finish()) qWarning() << writer.errorString();
+/// @endcode
+class QGCZstdSeekableWriter : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    /// @param target Device compressed data is written to (must be open for writing)
+    /// @param parent QObject parent
+    /// @note The target device must remain valid until this device is closed
+    explicit QGCZstdSeekableWriter(QIODevice *target, QObject *parent = nullptr);
+    ~QGCZstdSeekableWriter() override;
+
+    /// Uncompressed bytes per frame, larger frames compress better but make seeking more expensive
+    void setFrameSize(qint64 bytes);
+
+    /// zstd compression level
+    void setCompressionLevel(int level);
+
+    int frameCount() const { return static_cast<int>(_seekTable.count()); }
+
+    // QIODevice interface
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override { return true; }
+
+    /// Compresses remaining data and writes the seek table
+    /// @return false if any data could not be compressed or written, errorString() has the reason
+    bool finish();
+
+    static constexpr qint64 kDefaultFrameSize = 4 * 1024 * 1024;
+    static constexpr int kDefaultCompressionLevel = 3;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    bool _writeFrame();
+    bool _writeSeekTable();
+    bool _writeTarget(const QByteArray &data);
+
+    struct Entry {
+        quint32 compressedSize = 0;
+        quint32 decompressedSize = 0;
+    };
+
+    QIODevice *_target = nullptr;
+    ZSTD_CCtx_s *_cctx = nullptr;
+    qint64 _frameSize = kDefaultFrameSize;
+    int _compressionLevel = kDefaultCompressionLevel;
+    QByteArray _frame;              ///< Uncompressed data of the frame being filled
+    QByteArray _compressed;
+    QList<Entry> _seekTable;
+    bool _failed = false;
+    bool _finished = false;
+};
+
+/// Random-access reader for zstd files
+/// Read-only, seekable. Files without a seek table, such as a log whose writer never finished, are indexed by
+/// walking the frame headers instead. Only one frame is held in memory at a time.
+///
+/// Example usage:
+/// @code
+/// QGCZstdSeekableDevice device("flight.tlog.zst");
+/// device.open(QIODevice::ReadOnly);
+/// device.seek(device.size() / 2);
+/// const QByteArray data = device.read(1024);
+/// @endcode
+class QGCZstdSeekableDevice : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    explicit QGCZstdSeekableDevice(const QString &fileName, QObject *parent = nullptr);
+    ~QGCZstdSeekableDevice() override;
+
+    int frameCount() const { return static_cast<int>(_frames.count()); }
+
+    /// @return true: Index was read from the seek table, false: Rebuilt from the frame headers
+    bool hasSeekTable() const { return _hasSeekTable; }
+
+    // QIODevice interface
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override { return false; }
+    qint64 size() const override { return _size; }
+    bool seek(qint64 pos) override;
+
+    /// Frames larger than this are not decompressed as a whole, the file has to be decompressed up front
+    static constexpr qint64 kMaxFrameSize = 64 * 1024 * 1024;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    bool _readSeekTable();
+    bool _scanFrames();
+    bool _addFrame(qint64 compressedOffset, qint64 compressedSize, qint64 decompressedSize);
+    int _frameIndex(qint64 pos) const;
+    bool _loadFrame(int index);
+
+    struct Frame {
+        qint64 compressedOffset = 0;
+        qint64 compressedSize = 0;
+        qint64 decompressedOffset = 0;
+        qint64 decompressedSize = 0;
+    };
+
+    QFile _file;
+    ZSTD_DCtx_s *_dctx = nullptr;
+    QList<Frame> _frames;           ///< Frames with data, ordered by offset
+    qint64 _size = 0;
+    qint64 _devicePos = 0;          ///< Position of the next readData
+    bool _hasSeekTable = false;
+    int _loadedFrame = -1;
+    QByteArray _frameData;
+    QByteArray _compressed;
+};
@@ -36,9 +36,19 @@ QJsonDocument GeoJsonHelper::_loadFile(const QString &filePath, QString &errorSt
         return QJsonDocument();
     }
 
+    // QGeoJson works on a complete document so the file can't be streamed, but it can be parsed
+    // straight out of a mapping instead of first being copied into the heap.
     QJsonDocument jsonDoc;
-    const QByteArray bytes = file.readAll();
-    if (!JsonHelper::isJsonFile(bytes, jsonDoc, errorString)) {
+    bool isJson = false;
+    const qint64 fileSize = file.size();
+    uchar *mapped = (fileSize > 0) ? file.map(0, fileSize) : nullptr;
+    if (mapped) {
+        isJson = JsonHelper::isJsonFile(QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), fileSize), jsonDoc, errorString);
+        (void) file.unmap(mapped);
+    } else {
+        isJson = JsonHelper::isJsonFile(file.readAll(), jsonDoc, errorString);
+    }
+    if (!isJson) {
         errorString = QString(_errorPrefix).arg(errorString);
     }
 
@@ -3,7 +3,7 @@
 #include "QGCLoggingCategory.h"
 
 #include <QtCore/QFile>
-#include <QtXml/QDomDocument>
+#include <QtCore/QXmlStreamReader>
 
 #include <algorithm>
 
@@ -11,146 +11,286 @@ QGC_LOGGING_CATEGORY(KMLHelperLog, "Utilities.KMLHelper")
 
 namespace KMLHelper
 {
-    QDomDocument _loadFile(const QString &kmlFile, QString &errorString);
-    bool _parseCoordinateString(const QString &coordinatesString, QList<QGeoCoordinate> &coords, QString &errorString);
-    void _filterVertices(QList<QGeoCoordinate> &vertices, double filterMeters, int minVertices);
-    void _checkAltitudeMode(const QDomNode &geometryNode, const QString &geometryType, int index);
+    bool _openFile(QFile &file, QString &errorString);
+    QString _parseErrorString(const QString &kmlFile, const QXmlStreamReader &xml);
+    bool _isGeometryCoordinates(const QStringList &elementPath, const QString &geometryType);
+    void _parseCoordinateText(QStringView text, QString &pendingTuple, QList<QGeoCoordinate> &coords);
+    void _parseCoordinateTuple(QStringView tuple, QList<QGeoCoordinate> &coords);
+    void _checkAltitudeMode(const QString &mode, qint64 line, const QString &geometryType, int index);
+    bool _readGeometries(const QString &kmlFile, const QString &geometryType, QList<QList<QGeoCoordinate>> &geometries,
+                         QString &errorString, const ShapeFileHelper::ImportOptions &options);
 
     constexpr const char *_errorPrefix = QT_TR_NOOP("KML file load failed. %1");
 }
 
-QDomDocument KMLHelper::_loadFile(const QString &kmlFile, QString &errorString)
+bool KMLHelper::_openFile(QFile &file, QString &errorString)
 {
     errorString.clear();
 
-    QFile file(kmlFile);
     if (!file.exists()) {
-        errorString = QString(_errorPrefix).arg(QString(QT_TRANSLATE_NOOP("KML", "File not found: %1")).arg(kmlFile));
-        return QDomDocument();
+        errorString = QString(_errorPrefix).arg(QString(QT_TRANSLATE_NOOP("KML", "File not found: %1")).arg(file.fileName()));
+        return false;
     }
 
     if (!file.open(QIODevice::ReadOnly)) {
-        errorString = QString(_errorPrefix).arg(QString(QT_TRANSLATE_NOOP("KML", "Unable to open file: %1 error: %2")).arg(kmlFile, file.errorString()));
-        return QDomDocument();
+        errorString = QString(_errorPrefix).arg(QString(QT_TRANSLATE_NOOP("KML", "Unable to open file: %1 error: %2")).arg(file.fileName(), file.errorString()));
+        return false;
     }
 
-    QDomDocument doc;
-    const QDomDocument::ParseResult result = doc.setContent(&file, QDomDocument::ParseOption::Default);
-    if (!result) {
-        errorString = QString(_errorPrefix).arg(QString(QT_TRANSLATE_NOOP("KML", "Unable to parse KML file: %1 error: %2 line: %3")).arg(kmlFile).arg(result.errorMessage).arg(result.errorLine));
-        return QDomDocument();
+    return true;
+}
+
+QString KMLHelper::_parseErrorString(const QString &kmlFile, const QXmlStreamReader &xml)
+{
+    return QString(_errorPrefix).arg(QString(QT_TRANSLATE_NOOP("KML", "Unable to parse KML file: %1 error: %2 line: %3")).arg(kmlFile).arg(xml.errorString()).arg(xml.lineNumber()));
+}
+
+bool KMLHelper::_isGeometryCoordinates(const QStringList &elementPath, const QString &geometryType)
+{
+    // Polygons only use the outer boundary, inner boundaries (holes) are ignored
+    static const QStringList polygonPath = { QStringLiteral("Polygon"), QStringLiteral("outerBoundaryIs"), QStringLiteral("LinearRing"), QStringLiteral("coordinates") };
+
+    if (geometryType == polygonPath.first()) {
+        return (elementPath.count() >= polygonPath.count()) && std::equal(polygonPath.cbegin(), polygonPath.cend(), elementPath.cend() - polygonPath.count());
     }
 
-    return doc;
+    return (elementPath.count() >= 2) && (elementPath[elementPath.count() - 2] == geometryType);
 }
 
-bool KMLHelper::_parseCoordinateString(const QString &coordinatesString, QList<QGeoCoordinate> &coords, QString &errorString)
+void KMLHelper::_parseCoordinateTuple(QStringView tuple, QList<QGeoCoordinate> &coords)
 {
-    coords.clear();
-    const QString simplified = coordinatesString.simplified();
-    if (simplified.isEmpty()) {
-        errorString = QString(_errorPrefix).arg(QT_TRANSLATE_NOOP("KML", "Empty coordinates string"));
-        return false;
+    const QList<QStringView> rgValueStrings = tuple.split(u',');
+    if (rgValueStrings.size() < 2) {
+        qCWarning(KMLHelperLog) << "Invalid coordinate format, expected lon,lat[,alt]:" << tuple;
+        return;
+    }
+    bool lonOk = false, latOk = false;
+    const double lon = rgValueStrings[0].toDouble(&lonOk);
+    const double lat = rgValueStrings[1].toDouble(&latOk);
+    if (!lonOk || !latOk) {
+        qCWarning(KMLHelperLog) << "Failed to parse coordinate values:" << tuple;
+        return;
+    }
+    if (lat < -90.0 || lat > 90.0) {
+        qCWarning(KMLHelperLog) << "Latitude out of range [-90, 90]:" << lat << "in:" << tuple;
+        return;
+    }
+    if (lon < -180.0 || lon > 180.0) {
+        qCWarning(KMLHelperLog) << "Longitude out of range [-180, 180]:" << lon << "in:" << tuple;
+        return;
+    }
+    double alt = 0.0;
+    if (rgValueStrings.size() >= 3) {
+        alt = rgValueStrings[2].toDouble();
     }
+    coords.append(QGeoCoordinate(lat, lon, alt));
+}
 
-    const QStringList rgCoordinateStrings = simplified.split(' ');
-    for (const QString &coordinateString : rgCoordinateStrings) {
-        if (coordinateString.isEmpty()) {
-            continue;
-        }
-        const QStringList rgValueStrings = coordinateString.split(',');
-        if (rgValueStrings.size() < 2) {
-            qCWarning(KMLHelperLog) << "Invalid coordinate format, expected lon,lat[,alt]:" << coordinateString;
-            continue;
-        }
-        bool lonOk = false, latOk = false;
-        const double lon = rgValueStrings[0].toDouble(&lonOk);
-        const double lat = rgValueStrings[1].toDouble(&latOk);
-        if (!lonOk || !latOk) {
-            qCWarning(KMLHelperLog) << "Failed to parse coordinate values:" << coordinateString;
-            continue;
-        }
-        if (lat < -90.0 || lat > 90.0) {
-            qCWarning(KMLHelperLog) << "Latitude out of range [-90, 90]:" << lat << "in:" << coordinateString;
+/// Parses whitespace separated lon,lat[,alt] tuples. The reader can deliver the text of a coordinates element in
+/// more than one piece, so a tuple which may continue in the next piece is held back in pendingTuple.
+void KMLHelper::_parseCoordinateText(QStringView text, QString &pendingTuple, QList<QGeoCoordinate> &coords)
+{
+    qsizetype tupleStart = 0;
+    for (qsizetype i = 0; i <= text.size(); i++) {
+        if ((i < text.size()) && !text[i].isSpace()) {
             continue;
         }
-        if (lon < -180.0 || lon > 180.0) {
-            qCWarning(KMLHelperLog) << "Longitude out of range [-180, 180]:" << lon << "in:" << coordinateString;
-            continue;
+        if (i == text.size()) {
+            // Possibly incomplete, wait for more text or the end of the element
+            pendingTuple.append(text.mid(tupleStart));
+            break;
         }
-        double alt = 0.0;
-        if (rgValueStrings.size() >= 3) {
-            alt = rgValueStrings[2].toDouble();
+        if (!pendingTuple.isEmpty()) {
+            pendingTuple.append(text.mid(tupleStart, i - tupleStart));
+            _parseCoordinateTuple(pendingTuple, coords);
+            pendingTuple.clear();
+        } else if (i > tupleStart) {
+            _parseCoordinateTuple(text.mid(tupleStart, i - tupleStart), coords);
         }
-        coords.append(QGeoCoordinate(lat, lon, alt));
-    }
-
-    if (coords.isEmpty()) {
-        errorString = QString(_errorPrefix).arg(QT_TRANSLATE_NOOP("KML", "No valid coordinates found"));
-        return false;
+        tupleStart = i + 1;
     }
-    return true;
 }
 
-void KMLHelper::_filterVertices(QList<QGeoCoordinate> &vertices, double filterMeters, int minVertices)
+void KMLHelper::_checkAltitudeMode(const QString &mode, qint64 line, const QString &geometryType, int index)
 {
-    if (filterMeters <= 0 || vertices.count() <= minVertices) {
+    // Validate altitudeMode using schema-derived rules
+    // QGC treats all coordinates as absolute (AMSL), so warn if a different mode is specified
+    if (mode.isEmpty()) {
         return;
     }
-
-    int i = 0;
-    while (i < (vertices.count() - 1)) {
-        if ((vertices.count() > minVertices) && (vertices[i].distanceTo(vertices[i + 1]) < filterMeters)) {
-            vertices.removeAt(i + 1);
-        } else {
-            i++;
-        }
+    const auto *validator = KMLSchemaValidator::instance();
+    const QString location = QStringLiteral("(line %1)").arg(line);
+    if (!validator->isValidEnumValue("altitudeModeEnumType", mode)) {
+        qCWarning(KMLHelperLog) << geometryType << index << location << "has invalid altitudeMode:" << mode
+                                << "- valid values are:" << validator->validEnumValues("altitudeModeEnumType").join(", ");
+    } else if (mode != "absolute") {
+        qCWarning(KMLHelperLog) << geometryType << index << location << "uses altitudeMode:" << mode
+                                << "- QGC will treat coordinates as absolute (AMSL)";
     }
 }
 
-void KMLHelper::_checkAltitudeMode(const QDomNode &geometryNode, const QString &geometryType, int index)
+/// Streams the file collecting the coordinates of each geometry of the specified type.
+/// Polygons and polylines are filtered and simplified as soon as each one is complete, so only the reduced
+/// shapes are held in memory.
+bool KMLHelper::_readGeometries(const QString &kmlFile, const QString &geometryType, QList<QList<QGeoCoordinate>> &geometries,
+                                QString &errorString, const ShapeFileHelper::ImportOptions &options)
 {
-    // Validate altitudeMode using schema-derived rules
-    // QGC treats all coordinates as absolute (AMSL), so warn if a different mode is specified
-    const QDomNode altModeNode = geometryNode.namedItem("altitudeMode");
-    if (!altModeNode.isNull()) {
-        const QString mode = altModeNode.toElement().text();
-        if (mode.isEmpty()) {
-            return;
+    geometries.clear();
+
+    QFile file(kmlFile);
+    if (!_openFile(file, errorString)) {
+        return false;
+    }
+
+    const bool isPolygon = (geometryType == QStringLiteral("Polygon"));
+    const bool isPoint = (geometryType == QStringLiteral("Point"));
+    const int minVertices = isPolygon ? 3 : (isPoint ? 1 : 2);
+    const double fileSize = static_cast<double>(qMax(file.size(), qint64(1)));
+    ShapeFileHelper::ProgressReporter progress(options);
+
+    QXmlStreamReader xml(&file);
+    QStringList elementPath;
+    int geometryIndex = -1;
+    qint64 geometryLine = 0;
+    QString altitudeMode;
+    QString pendingTuple;
+    QList<QGeoCoordinate> coords;
+    bool inCoordinates = false;
+    bool foundCoordinates = false;
+
+    while (!xml.atEnd()) {
+        switch (xml.readNext()) {
+        case QXmlStreamReader::StartElement:
+            elementPath.append(xml.name().toString());
+            if (elementPath.last() == geometryType) {
+                geometryIndex++;
+                geometryLine = xml.lineNumber();
+                altitudeMode.clear();
+                coords.clear();
+                foundCoordinates = false;
+            } else if ((geometryIndex >= 0) && (elementPath.last() == QStringLiteral("coordinates")) && _isGeometryCoordinates(elementPath, geometryType)) {
+                inCoordinates = true;
+                foundCoordinates = true;
+                pendingTuple.clear();
+            } else if ((elementPath.last() == QStringLiteral("altitudeMode")) && (elementPath.count() >= 2) && (elementPath[elementPath.count() - 2] == geometryType)) {
+                // readElementText consumes the end element as well
+                altitudeMode = xml.readElementText();
+                elementPath.removeLast();
+            }
+            break;
+        case QXmlStreamReader::Characters:
+            if (inCoordinates) {
+                _parseCoordinateText(xml.text(), pendingTuple, coords);
+            }
+            break;
+        case QXmlStreamReader::EndElement:
+            if (inCoordinates) {
+                if (!pendingTuple.isEmpty()) {
+                    _parseCoordinateTuple(pendingTuple, coords);
+                    pendingTuple.clear();
+                }
+                inCoordinates = false;
+            } else if (elementPath.last() == geometryType) {
+                _checkAltitudeMode(altitudeMode, geometryLine, geometryType, geometryIndex);
+
+                const QString location = QStringLiteral("(line %1)").arg(geometryLine);
+                if (!foundCoordinates) {
+                    qCWarning(KMLHelperLog) << geometryType << geometryIndex << location << "missing coordinates node, skipping";
+                } else if (coords.isEmpty()) {
+                    qCWarning(KMLHelperLog) << geometryType << geometryIndex << location << "failed to parse coordinates: no valid coordinates found";
+                } else if (coords.count() < minVertices) {
+                    qCWarning(KMLHelperLog) << geometryType << geometryIndex << location << "has fewer than" << minVertices << "vertices, skipping";
+                } else {
+                    if (isPolygon) {
+                        // Remove duplicate closing vertex (KML polygons repeat first vertex at end)
+                        if (coords.count() > 3 && coords.first().latitude() == coords.last().latitude() &&
+                            coords.first().longitude() == coords.last().longitude()) {
+                            coords.removeLast();
+                        }
+
+                        // Determine winding, reverse if needed. QGC wants clockwise winding
+                        double sum = 0;
+                        for (int i = 0; i < coords.count(); i++) {
+                            const QGeoCoordinate &coord1 = coords[i];
+                            const QGeoCoordinate &coord2 = coords[(i + 1) % coords.count()];
+                            sum += (coord2.longitude() - coord1.longitude()) * (coord2.latitude() + coord1.latitude());
+                        }
+                        if (sum < 0.0) {
+                            std::reverse(coords.begin(), coords.end());
+                        }
+                    }
+
+                    if (isPoint) {
+                        coords.resize(1);
+                    } else {
+                        ShapeFileHelper::applyImportOptions(coords, isPolygon, options);
+                    }
+                    geometries.append(coords);
+
+                    if ((options.maxShapes > 0) && (geometries.count() >= options.maxShapes)) {
+                        break;
+                    }
+                }
+                coords.clear();
+            }
+            elementPath.removeLast();
+            progress.report(static_cast<double>(file.pos()) / fileSize);
+            break;
+        default:
+            break;
         }
-        const auto *validator = KMLSchemaValidator::instance();
-        const QString location = QStringLiteral("(line %1)").arg(altModeNode.lineNumber());
-        if (!validator->isValidEnumValue("altitudeModeEnumType", mode)) {
-            qCWarning(KMLHelperLog) << geometryType << index << location << "has invalid altitudeMode:" << mode
-                                    << "- valid values are:" << validator->validEnumValues("altitudeModeEnumType").join(", ");
-        } else if (mode != "absolute") {
-            qCWarning(KMLHelperLog) << geometryType << index << location << "uses altitudeMode:" << mode
-                                    << "- QGC will treat coordinates as absolute (AMSL)";
+
+        if ((options.maxShapes > 0) && (geometries.count() >= options.maxShapes)) {
+            break;
         }
     }
+
+    if (xml.hasError()) {
+        errorString = _parseErrorString(kmlFile, xml);
+        geometries.clear();
+        return false;
+    }
+
+    progress.finish();
+
+    return true;
 }
 
 ShapeFileHelper::ShapeType KMLHelper::determineShapeType(const QString &kmlFile, QString &errorString)
 {
     using ShapeType = ShapeFileHelper::ShapeType;
 
-    const QDomDocument domDocument = KMLHelper::_loadFile(kmlFile, errorString);
-    if (!errorString.isEmpty()) {
+    QFile file(kmlFile);
+    if (!_openFile(file, errorString)) {
         return ShapeType::Error;
     }
 
-    const QDomNodeList rgNodesPolygon = domDocument.elementsByTagName("Polygon");
-    if (!rgNodesPolygon.isEmpty()) {
-        return ShapeType::Polygon;
+    // Polygons take precedence, so the scan can stop at the first one
+    bool foundLineString = false;
+    bool foundPoint = false;
+    QXmlStreamReader xml(&file);
+    while (!xml.atEnd()) {
+        if (xml.readNext() == QXmlStreamReader::StartElement) {
+            const QStringView name = xml.name();
+            if (name == QStringLiteral("Polygon")) {
+                return ShapeType::Polygon;
+            } else if (name == QStringLiteral("LineString")) {
+                foundLineString = true;
+            } else if (name == QStringLiteral("Point")) {
+                foundPoint = true;
+            }
+        }
     }
 
-    const QDomNodeList rgNodesLineString = domDocument.elementsByTagName("LineString");
-    if (!rgNodesLineString.isEmpty()) {
-        return ShapeType::Polyline;
+    if (xml.hasError()) {
+        errorString = _parseErrorString(kmlFile, xml);
+        return ShapeType::Error;
     }
 
-    const QDomNodeList rgNodesPoint = domDocument.elementsByTagName("Point");
-    if (!rgNodesPoint.isEmpty()) {
+    if (foundLineString) {
+        return ShapeType::Polyline;
+    }
+    if (foundPoint) {
         return ShapeType::Point;
     }
 
@@ -160,94 +300,38 @@ ShapeFileHelper::ShapeType KMLHelper::determineShapeType(const QString &kmlFile,
 
 int KMLHelper::getEntityCount(const QString &kmlFile, QString &errorString)
 {
-    const QDomDocument domDocument = KMLHelper::_loadFile(kmlFile, errorString);
-    if (!errorString.isEmpty()) {
+    QFile file(kmlFile);
+    if (!_openFile(file, errorString)) {
         return 0;
     }
 
     int count = 0;
-    count += domDocument.elementsByTagName("Polygon").count();
-    count += domDocument.elementsByTagName("LineString").count();
-    count += domDocument.elementsByTagName("Point").count();
-    return count;
-}
-
-bool KMLHelper::loadPolygonFromFile(const QString &kmlFile, QList<QGeoCoordinate> &vertices, QString &errorString, double filterMeters)
-{
-    QList<QList<QGeoCoordinate>> polygons;
-    if (!loadPolygonsFromFile(kmlFile, polygons, errorString, filterMeters)) {
-        return false;
+    QXmlStreamReader xml(&file);
+    while (!xml.atEnd()) {
+        if (xml.readNext() == QXmlStreamReader::StartElement) {
+            const QStringView name = xml.name();
+            if ((name == QStringLiteral("Polygon")) || (name == QStringLiteral("LineString")) || (name == QStringLiteral("Point"))) {
+                count++;
+            }
+        }
     }
-    if (polygons.isEmpty()) {
-        errorString = QString(_errorPrefix).arg(QT_TRANSLATE_NOOP("KML", "No polygons found in KML file"));
-        return false;
+
+    if (xml.hasError()) {
+        errorString = _parseErrorString(kmlFile, xml);
+        return 0;
     }
-    vertices = polygons.first();
-    return true;
+
+    return count;
 }
 
-bool KMLHelper::loadPolygonsFromFile(const QString &kmlFile, QList<QList<QGeoCoordinate>> &polygons, QString &errorString, double filterMeters)
+bool KMLHelper::loadPolygonsFromFile(const QString &kmlFile, QList<QList<QGeoCoordinate>> &polygons, QString &errorString, const ShapeFileHelper::ImportOptions &options)
 {
     errorString.clear();
-    polygons.clear();
 
-    const QDomDocument domDocument = KMLHelper::_loadFile(kmlFile, errorString);
-    if (!errorString.isEmpty()) {
+    if (!_readGeometries(kmlFile, QStringLiteral("Polygon"), polygons, errorString, options)) {
         return false;
     }
 
-    const QDomNodeList rgNodes = domDocument.elementsByTagName("Polygon");
-    if (rgNodes.isEmpty()) {
-        errorString = QString(_errorPrefix).arg(QT_TRANSLATE_NOOP("KML", "Unable to find Polygon node in KML"));
-        return false;
-    }
-
-    for (int nodeIdx = 0; nodeIdx < rgNodes.count(); nodeIdx++) {
-        const QDomNode polygonNode = rgNodes.item(nodeIdx);
-        _checkAltitudeMode(polygonNode, "Polygon", nodeIdx);
-
-        const QDomNode coordinatesNode = polygonNode.namedItem("outerBoundaryIs").namedItem("LinearRing").namedItem("coordinates");
-        if (coordinatesNode.isNull()) {
-            qCWarning(KMLHelperLog) << "Polygon" << nodeIdx << QStringLiteral("(line %1)").arg(polygonNode.lineNumber())
-                                    << "missing coordinates node, skipping";
-            continue;
-        }
-
-        QList<QGeoCoordinate> rgCoords;
-        if (!_parseCoordinateString(coordinatesNode.toElement().text(), rgCoords, errorString)) {
-            qCWarning(KMLHelperLog) << "Polygon" << nodeIdx << QStringLiteral("(line %1)").arg(coordinatesNode.lineNumber())
-                                    << "failed to parse coordinates:" << errorString;
-            errorString.clear();
-            continue;
-        }
-
-        if (rgCoords.count() < 3) {
-            qCWarning(KMLHelperLog) << "Polygon" << nodeIdx << QStringLiteral("(line %1)").arg(polygonNode.lineNumber())
-                                    << "has fewer than 3 vertices, skipping";
-            continue;
-        }
-
-        // Remove duplicate closing vertex (KML polygons repeat first vertex at end)
-        if (rgCoords.count() > 3 && rgCoords.first().latitude() == rgCoords.last().latitude() &&
-            rgCoords.first().longitude() == rgCoords.last().longitude()) {
-            rgCoords.removeLast();
-        }
-
-        // Determine winding, reverse if needed. QGC wants clockwise winding
-        double sum = 0;
-        for (int i = 0; i < rgCoords.count(); i++) {
-            const QGeoCoordinate &coord1 = rgCoords[i];
-            const QGeoCoordinate &coord2 = rgCoords[(i + 1) % rgCoords.count()];
-            sum += (coord2.longitude() - coord1.longitude()) * (coord2.latitude() + coord1.latitude());
-        }
-        if (sum < 0.0) {
-            std::reverse(rgCoords.begin(), rgCoords.end());
-        }
-
-        _filterVertices(rgCoords, filterMeters, 3);
-        polygons.append(rgCoords);
-    }
-
     if (polygons.isEmpty()) {
         errorString = QString(_errorPrefix).arg(QT_TRANSLATE_NOOP("KML", "No valid polygons found in KML file"));
         return false;
@@ -256,65 +340,14 @@ bool KMLHelper::loadPolygonsFromFile(const QString &kmlFile, QList<QList<QGeoCoo
     return true;
 }
 
-bool KMLHelper::loadPolylineFromFile(const QString &kmlFile, QList<QGeoCoordinate> &coords, QString &errorString, double filterMeters)
-{
-    QList<QList<QGeoCoordinate>> polylines;
-    if (!loadPolylinesFromFile(kmlFile, polylines, errorString, filterMeters)) {
-        return false;
-    }
-    if (polylines.isEmpty()) {
-        errorString = QString(_errorPrefix).arg(QT_TRANSLATE_NOOP("KML", "No polylines found in KML file"));
-        return false;
-    }
-    coords = polylines.first();
-    return true;
-}
-
-bool KMLHelper::loadPolylinesFromFile(const QString &kmlFile, QList<QList<QGeoCoordinate>> &polylines, QString &errorString, double filterMeters)
+bool KMLHelper::loadPolylinesFromFile(const QString &kmlFile, QList<QList<QGeoCoordinate>> &polylines, QString &errorString, const ShapeFileHelper::ImportOptions &options)
 {
     errorString.clear();
-    polylines.clear();
-
-    const QDomDocument domDocument = KMLHelper::_loadFile(kmlFile, errorString);
-    if (!errorString.isEmpty()) {
-        return false;
-    }
 
-    const QDomNodeList rgNodes = domDocument.elementsByTagName("LineString");
-    if (rgNodes.isEmpty()) {
-        errorString = QString(_errorPrefix).arg(QT_TRANSLATE_NOOP("KML", "Unable to find LineString node in KML"));
+    if (!_readGeometries(kmlFile, QStringLiteral("LineString"), polylines, errorString, options)) {
         return false;
     }
 
-    for (int nodeIdx = 0; nodeIdx < rgNodes.count(); nodeIdx++) {
-        const QDomNode lineStringNode = rgNodes.item(nodeIdx);
-        _checkAltitudeMode(lineStringNode, "LineString", nodeIdx);
-
-        const QDomNode coordinatesNode = lineStringNode.namedItem("coordinates");
-        if (coordinatesNode.isNull()) {
-            qCWarning(KMLHelperLog) << "LineString" << nodeIdx << QStringLiteral("(line %1)").arg(lineStringNode.lineNumber())
-                                    << "missing coordinates node, skipping";
-            continue;
-        }
-
-        QList<QGeoCoordinate> rgCoords;
-        if (!_parseCoordinateString(coordinatesNode.toElement().text(), rgCoords, errorString)) {
-            qCWarning(KMLHelperLog) << "LineString" << nodeIdx << QStringLiteral("(line %1)").arg(coordinatesNode.lineNumber())
-                                    << "failed to parse coordinates:" << errorString;
-            errorString.clear();
-            continue;
-        }
-
-        if (rgCoords.count() < 2) {
-            qCWarning(KMLHelperLog) << "LineString" << nodeIdx << QStringLiteral("(line %1)").arg(lineStringNode.lineNumber())
-                                    << "has fewer than 2 vertices, skipping";
-            continue;
-        }
-
-        _filterVertices(rgCoords, filterMeters, 2);
-        polylines.append(rgCoords);
-    }
-
     if (polylines.isEmpty()) {
         errorString = QString(_errorPrefix).arg(QT_TRANSLATE_NOOP("KML", "No valid polylines found in KML file"));
         return false;
@@ -328,39 +361,13 @@ bool KMLHelper::loadPointsFromFile(const QString &kmlFile, QList<QGeoCoordinate>
     errorString.clear();
     points.clear();
 
-    const QDomDocument domDocument = KMLHelper::_loadFile(kmlFile, errorString);
-    if (!errorString.isEmpty()) {
+    QList<QList<QGeoCoordinate>> pointGeometries;
+    if (!_readGeometries(kmlFile, QStringLiteral("Point"), pointGeometries, errorString, ShapeFileHelper::ImportOptions())) {
         return false;
     }
 
-    const QDomNodeList rgNodes = domDocument.elementsByTagName("Point");
-    if (rgNodes.isEmpty()) {
-        errorString = QString(_errorPrefix).arg(QT_TRANSLATE_NOOP("KML", "Unable to find Point node in KML"));
-        return false;
-    }
-
-    for (int nodeIdx = 0; nodeIdx < rgNodes.count(); nodeIdx++) {
-        const QDomNode pointNode = rgNodes.item(nodeIdx);
-        _checkAltitudeMode(pointNode, "Point", nodeIdx);
-
-        const QDomNode coordinatesNode = pointNode.namedItem("coordinates");
-        if (coordinatesNode.isNull()) {
-            qCWarning(KMLHelperLog) << "Point" << nodeIdx << QStringLiteral("(line %1)").arg(pointNode.lineNumber())
-                                    << "missing coordinates node, skipping";
-            continue;
-        }
-
-        QList<QGeoCoordinate> coords;
-        if (!_parseCoordinateString(coordinatesNode.toElement().text(), coords, errorString)) {
-            qCWarning(KMLHelperLog) << "Point" << nodeIdx << QStringLiteral("(line %1)").arg(coordinatesNode.lineNumber())
-                                    << "failed to parse coordinates:" << errorString;
-            errorString.clear();
-            continue;
-        }
-
-        if (!coords.isEmpty()) {
-            points.append(coords.first());
-        }
+    for (const QList<QGeoCoordinate> &pointGeometry : pointGeometries) {
+        points.append(pointGeometry.first());
     }
 
     if (points.isEmpty()) {
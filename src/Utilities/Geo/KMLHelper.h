@@ -8,6 +8,8 @@
 
 Q_DECLARE_LOGGING_CATEGORY(KMLHelperLog)
 
+/// KML files are read with QXmlStreamReader. Shapes are processed one at a time as they are parsed instead
+/// of building a DOM for the whole document first.
 namespace KMLHelper
 {
     ShapeFileHelper::ShapeType determineShapeType(const QString &file, QString &errorString);
@@ -15,25 +17,13 @@ namespace KMLHelper
     /// Get the number of geometry entities in the KML file
     int getEntityCount(const QString &kmlFile, QString &errorString);
 
-    /// Load first polygon entity (convenience wrapper)
-    /// @param filterMeters Filter vertices closer than this distance (0 to disable)
-    bool loadPolygonFromFile(const QString &kmlFile, QList<QGeoCoordinate> &vertices, QString &errorString,
-                             double filterMeters = ShapeFileHelper::kDefaultVertexFilterMeters);
-
-    /// Load all polygon entities
-    /// @param filterMeters Filter vertices closer than this distance (0 to disable)
+    /// Load polygon entities, filtering and simplifying each as it is read
     bool loadPolygonsFromFile(const QString &kmlFile, QList<QList<QGeoCoordinate>> &polygons, QString &errorString,
-                              double filterMeters = ShapeFileHelper::kDefaultVertexFilterMeters);
-
-    /// Load first polyline entity (convenience wrapper)
-    /// @param filterMeters Filter vertices closer than this distance (0 to disable)
-    bool loadPolylineFromFile(const QString &kmlFile, QList<QGeoCoordinate> &coords, QString &errorString,
-                              double filterMeters = ShapeFileHelper::kDefaultVertexFilterMeters);
+                              const ShapeFileHelper::ImportOptions &options);
 
-    /// Load all polyline entities
-    /// @param filterMeters Filter vertices closer than this distance (0 to disable)
+    /// Load polyline entities, filtering and simplifying each as it is read
     bool loadPolylinesFromFile(const QString &kmlFile, QList<QList<QGeoCoordinate>> &polylines, QString &errorString,
-                               double filterMeters = ShapeFileHelper::kDefaultVertexFilterMeters);
+                               const ShapeFileHelper::ImportOptions &options);
 
     /// Load all point entities
     bool loadPointsFromFile(const QString &kmlFile, QList<QGeoCoordinate> &points, QString &errorString);
@@ -11,8 +11,14 @@
 #include "QGCLoggingCategory.h"
 
 #include <QtCore/QString>
+#include <QtCore/QtMath>
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <vector>
 
 #include <GeographicLib/Geocentric.hpp>
 #include <GeographicLib/Geodesic.hpp>
@@ -24,6 +30,67 @@
 
 QGC_LOGGING_CATEGORY(QGCGeoLog, "Utilities.QGCGeo")
 
+namespace
+{
+
+struct PlanarPoint
+{
+    double x;
+    double y;
+};
+
+/// Equirectangular projection about the first vertex. Good enough to rank vertices against each other.
+std::vector<PlanarPoint> _toPlanar(const QList<QGeoCoordinate> &path)
+{
+    constexpr double kMetersPerDegree = 111319.49079327357;
+
+    const double lat0 = path.first().latitude();
+    const double lon0 = path.first().longitude();
+    const double xScale = std::cos(qDegreesToRadians(lat0)) * kMetersPerDegree;
+
+    std::vector<PlanarPoint> points;
+    points.reserve(path.count());
+    for (const QGeoCoordinate &coord : path) {
+        points.push_back({(coord.longitude() - lon0) * xScale, (coord.latitude() - lat0) * kMetersPerDegree});
+    }
+
+    return points;
+}
+
+double _segmentDistance(const PlanarPoint &p, const PlanarPoint &a, const PlanarPoint &b)
+{
+    const double dx = b.x - a.x;
+    const double dy = b.y - a.y;
+    const double lengthSquared = (dx * dx) + (dy * dy);
+
+    double t = 0.0;
+    if (lengthSquared > 0.0) {
+        t = std::clamp((((p.x - a.x) * dx) + ((p.y - a.y) * dy)) / lengthSquared, 0.0, 1.0);
+    }
+
+    return std::hypot(p.x - (a.x + (t * dx)), p.y - (a.y + (t * dy)));
+}
+
+double _triangleArea(const PlanarPoint &a, const PlanarPoint &b, const PlanarPoint &c)
+{
+    return std::abs(((b.x - a.x) * (c.y - a.y)) - ((c.x - a.x) * (b.y - a.y))) * 0.5;
+}
+
+QList<QGeoCoordinate> _selectVertices(const QList<QGeoCoordinate> &path, const std::vector<bool> &keep, qsizetype keepCount)
+{
+    QList<QGeoCoordinate> result;
+    result.reserve(keepCount);
+    for (qsizetype i = 0; i < path.count(); i++) {
+        if (keep[i]) {
+            result.append(path[i]);
+        }
+    }
+
+    return result;
+}
+
+} // namespace
+
 namespace QGCGeo
 {
 
@@ -371,4 +438,170 @@ QGeoCoordinate interpolateAtDistance(const QGeoCoordinate &from, const QGeoCoord
     return QGeoCoordinate(lat, lon, alt);
 }
 
+// ============================================================================
+// Path and Polygon Simplification
+// ============================================================================
+
+void filterCloseVertices(QList<QGeoCoordinate> &vertices, double filterMeters, int minVertices)
+{
+    if ((filterMeters <= 0) || (vertices.count() <= minVertices)) {
+        return;
+    }
+
+    // Compact in place instead of removeAt, which made filtering large shapes quadratic
+    qsizetype remaining = vertices.count();
+    qsizetype lastKept = 0;
+    for (qsizetype i = 1; i < vertices.count(); i++) {
+        if ((remaining > minVertices) && (vertices[lastKept].distanceTo(vertices[i]) < filterMeters)) {
+            remaining--;
+        } else if (++lastKept != i) {
+            vertices[lastKept] = vertices[i];
+        }
+    }
+    vertices.resize(lastKept + 1);
+}
+
+QList<QGeoCoordinate> simplifyDouglasPeucker(const QList<QGeoCoordinate> &path, int maxVertices, bool closed)
+{
+    const qsizetype count = path.count();
+    if ((maxVertices <= 0) || (count <= maxVertices)) {
+        return path;
+    }
+    maxVertices = std::max(maxVertices, closed ? 3 : 2);
+
+    const std::vector<PlanarPoint> points = _toPlanar(path);
+
+    struct Segment
+    {
+        double distance;
+        qsizetype first;
+        qsizetype last;     ///< May be count for a closed ring, which wraps to vertex 0
+        qsizetype farthest;
+
+        bool operator<(const Segment &other) const { return distance < other.distance; }
+    };
+    std::priority_queue<Segment> segments;
+
+    const auto pushSegment = [&points, &segments, count](qsizetype first, qsizetype last) {
+        if ((last - first) < 2) {
+            return;
+        }
+        Segment segment{-1.0, first, last, -1};
+        const PlanarPoint &a = points[first];
+        const PlanarPoint &b = points[last % count];
+        for (qsizetype i = first + 1; i < last; i++) {
+            const double distance = _segmentDistance(points[i], a, b);
+            if (distance > segment.distance) {
+                segment.distance = distance;
+                segment.farthest = i;
+            }
+        }
+        segments.push(segment);
+    };
+
+    std::vector<bool> keep(count, false);
+    qsizetype keepCount = 2;
+    keep[0] = true;
+    if (closed) {
+        // Anchor the ring at the first vertex and the vertex farthest from it
+        qsizetype opposite = 1;
+        double maxDistance = -1.0;
+        for (qsizetype i = 1; i < count; i++) {
+            const double distance = std::hypot(points[i].x - points[0].x, points[i].y - points[0].y);
+            if (distance > maxDistance) {
+                maxDistance = distance;
+                opposite = i;
+            }
+        }
+        keep[opposite] = true;
+        pushSegment(0, opposite);
+        pushSegment(opposite, count);
+    } else {
+        keep[count - 1] = true;
+        pushSegment(0, count - 1);
+    }
+
+    while ((keepCount < maxVertices) && !segments.empty()) {
+        const Segment segment = segments.top();
+        segments.pop();
+
+        keep[segment.farthest] = true;
+        keepCount++;
+        pushSegment(segment.first, segment.farthest);
+        pushSegment(segment.farthest, segment.last);
+    }
+
+    return _selectVertices(path, keep, keepCount);
+}
+
+QList<QGeoCoordinate> simplifyVisvalingam(const QList<QGeoCoordinate> &path, int maxVertices, bool closed)
+{
+    const qsizetype count = path.count();
+    if ((maxVertices <= 0) || (count <= maxVertices)) {
+        return path;
+    }
+    maxVertices = std::max(maxVertices, closed ? 3 : 2);
+
+    const std::vector<PlanarPoint> points = _toPlanar(path);
+
+    // Doubly linked list over the remaining vertices
+    std::vector<qsizetype> prev(count);
+    std::vector<qsizetype> next(count);
+    for (qsizetype i = 0; i < count; i++) {
+        prev[i] = (i == 0) ? (count - 1) : (i - 1);
+        next[i] = (i == count - 1) ? 0 : (i + 1);
+    }
+
+    const auto isFixed = [closed, count](qsizetype index) {
+        return !closed && ((index == 0) || (index == count - 1));
+    };
+
+    struct Entry
+    {
+        double area;
+        qsizetype index;
+
+        bool operator>(const Entry &other) const { return area > other.area; }
+    };
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> entries;
+
+    std::vector<double> areas(count, std::numeric_limits<double>::infinity());
+    for (qsizetype i = 0; i < count; i++) {
+        if (!isFixed(i)) {
+            areas[i] = _triangleArea(points[prev[i]], points[i], points[next[i]]);
+            entries.push({areas[i], i});
+        }
+    }
+
+    std::vector<bool> keep(count, true);
+    qsizetype keepCount = count;
+    while ((keepCount > maxVertices) && !entries.empty()) {
+        const Entry entry = entries.top();
+        entries.pop();
+
+        // Skip entries made stale by a neighbor being removed
+        if (!keep[entry.index] || (entry.area != areas[entry.index])) {
+            continue;
+        }
+
+        keep[entry.index] = false;
+        keepCount--;
+
+        const qsizetype before = prev[entry.index];
+        const qsizetype after = next[entry.index];
+        next[before] = after;
+        prev[after] = before;
+
+        // Neighbor areas are never allowed to drop below the area just removed, so removal order stays monotonic
+        for (const qsizetype neighbor : {before, after}) {
+            if (!isFixed(neighbor)) {
+                areas[neighbor] = std::max(_triangleArea(points[prev[neighbor]], points[neighbor], points[next[neighbor]]), entry.area);
+                entries.push({areas[neighbor], neighbor});
+            }
+        }
+    }
+
+    return _selectVertices(path, keep, keepCount);
+}
+
 } // namespace QGCGeo
@@ -192,4 +192,33 @@ QList<QGeoCoordinate> interpolatePath(const QGeoCoordinate &from, const QGeoCoor
 /// @note Useful for midpoint: interpolateAtDistance(from, to, geodesicDistance(from, to) / 2)
 QGeoCoordinate interpolateAtDistance(const QGeoCoordinate &from, const QGeoCoordinate &to, double distance);
 
+// ============================================================================
+// Path and Polygon Simplification
+// ============================================================================
+
+/// Remove consecutive vertices which are closer together than a distance threshold.
+/// @param[in,out] vertices Path or polygon vertices to filter in place.
+/// @param filterMeters Vertices closer than this to the previous kept vertex are removed (0 to disable).
+/// @param minVertices Filtering stops once this many vertices remain.
+/// @note Runs in linear time, the first vertex is always kept.
+void filterCloseVertices(QList<QGeoCoordinate> &vertices, double filterMeters, int minVertices);
+
+/// Simplify a path or polygon to a vertex budget using Douglas-Peucker.
+/// Vertices are added back in order of their distance from the simplified shape until the budget is reached.
+/// @param path Path or polygon vertices.
+/// @param maxVertices Maximum number of vertices to keep (0 for no limit).
+/// @param closed True if path is a polygon ring (closing vertex not repeated).
+/// @return Simplified vertices, a subset of path in the original order.
+/// @note Distances are measured in a local equirectangular projection, which is only used to rank vertices.
+QList<QGeoCoordinate> simplifyDouglasPeucker(const QList<QGeoCoordinate> &path, int maxVertices, bool closed);
+
+/// Simplify a path or polygon to a vertex budget using Visvalingam-Whyatt.
+/// The vertex forming the smallest triangle with its neighbors is removed until the budget is reached.
+/// @param path Path or polygon vertices.
+/// @param maxVertices Maximum number of vertices to keep (0 for no limit).
+/// @param closed True if path is a polygon ring (closing vertex not repeated).
+/// @return Simplified vertices, a subset of path in the original order.
+/// @note Tends to keep the overall shape of boundaries better than Douglas-Peucker at small budgets.
+QList<QGeoCoordinate> simplifyVisvalingam(const QList<QGeoCoordinate> &path, int maxVertices, bool closed);
+
 } // namespace QGCGeo
@@ -291,27 +291,7 @@ int SHPFileHelper::getEntityCount(const QString &shpFile, QString &errorString)
     return cEntities;
 }
 
-bool SHPFileHelper::loadPolygonFromFile(const QString &shpFile, QList<QGeoCoordinate> &vertices, QString &errorString, double filterMeters)
-{
-    QList<QList<QGeoCoordinate>> polygons;
-    if (!loadPolygonsFromFile(shpFile, polygons, errorString, filterMeters)) {
-        return false;
-    }
-    vertices = polygons.first();
-    return true;
-}
-
-bool SHPFileHelper::loadPolylineFromFile(const QString &shpFile, QList<QGeoCoordinate> &vertices, QString &errorString, double filterMeters)
-{
-    QList<QList<QGeoCoordinate>> polylines;
-    if (!loadPolylinesFromFile(shpFile, polylines, errorString, filterMeters)) {
-        return false;
-    }
-    vertices = polylines.first();
-    return true;
-}
-
-bool SHPFileHelper::loadPolygonsFromFile(const QString &shpFile, QList<QList<QGeoCoordinate>> &polygons, QString &errorString, double filterMeters)
+bool SHPFileHelper::loadPolygonsFromFile(const QString &shpFile, QList<QList<QGeoCoordinate>> &polygons, QString &errorString, const ShapeFileHelper::ImportOptions &options)
 {
     int utmZone = 0;
     bool utmSouthernHemisphere = false;
@@ -339,7 +319,13 @@ bool SHPFileHelper::loadPolygonsFromFile(const QString &shpFile, QList<QList<QGe
 
     const bool hasAltitude = (shapeType == SHPT_POLYGONZ);
 
+    ShapeFileHelper::ImportOptions simplifyOptions = options;
+    simplifyOptions.filterMeters = 0;
+
+    ShapeFileHelper::ProgressReporter progress(options);
     for (int entityIdx = 0; entityIdx < cEntities; entityIdx++) {
+        progress.report(static_cast<double>(entityIdx) / cEntities);
+
         SHPObject *shpObject = SHPReadObject(shpHandle, entityIdx);
         if (!shpObject) {
             qCWarning(SHPFileHelperLog) << "Failed to read polygon entity" << entityIdx;
@@ -386,6 +372,7 @@ bool SHPFileHelper::loadPolygonsFromFile(const QString &shpFile, QList<QList<QGe
         }
 
         // Filter nearby vertices if enabled
+        const double filterMeters = options.filterMeters;
         if (filterMeters > 0) {
             const QGeoCoordinate firstVertex = vertices.first();
 
@@ -395,14 +382,7 @@ bool SHPFileHelper::loadPolygonsFromFile(const QString &shpFile, QList<QList<QGe
             const bool hadExplicitClosure = vertices.last().distanceTo(firstVertex) < kClosureThreshold;
 
             // Filter consecutive vertices that are too close together
-            int i = 0;
-            while (i < (vertices.count() - 1)) {
-                if ((vertices.count() > 3) && (vertices[i].distanceTo(vertices[i + 1]) < filterMeters)) {
-                    vertices.removeAt(i + 1);
-                } else {
-                    i++;
-                }
-            }
+            QGCGeo::filterCloseVertices(vertices, filterMeters, 3);
 
             // If the original polygon had an explicit closure vertex, remove a single trailing
             // duplicate after filtering, but do not strip distinct vertices that merely happen
@@ -413,9 +393,17 @@ bool SHPFileHelper::loadPolygonsFromFile(const QString &shpFile, QList<QList<QGe
             }
         }
 
+        // Filtering is already done above so the closure vertex can be handled in between
+        ShapeFileHelper::applyImportOptions(vertices, true, simplifyOptions);
+
         polygons.append(vertices);
+        if ((options.maxShapes > 0) && (polygons.count() >= options.maxShapes)) {
+            break;
+        }
     }
 
+    progress.finish();
+
     if (polygons.isEmpty()) {
         errorString = QString(_errorPrefix).arg(QT_TRANSLATE_NOOP("SHP", "No valid polygons found."));
         return false;
@@ -424,7 +412,7 @@ bool SHPFileHelper::loadPolygonsFromFile(const QString &shpFile, QList<QList<QGe
     return true;
 }
 
-bool SHPFileHelper::loadPolylinesFromFile(const QString &shpFile, QList<QList<QGeoCoordinate>> &polylines, QString &errorString, double filterMeters)
+bool SHPFileHelper::loadPolylinesFromFile(const QString &shpFile, QList<QList<QGeoCoordinate>> &polylines, QString &errorString, const ShapeFileHelper::ImportOptions &options)
 {
     int utmZone = 0;
     bool utmSouthernHemisphere = false;
@@ -452,7 +440,10 @@ bool SHPFileHelper::loadPolylinesFromFile(const QString &shpFile, QList<QList<QG
 
     const bool hasAltitude = (shapeType == SHPT_ARCZ);
 
+    ShapeFileHelper::ProgressReporter progress(options);
     for (int entityIdx = 0; entityIdx < cEntities; entityIdx++) {
+        progress.report(static_cast<double>(entityIdx) / cEntities);
+
         SHPObject *shpObject = SHPReadObject(shpHandle, entityIdx);
         if (!shpObject) {
             qCWarning(SHPFileHelperLog) << "Failed to read polyline entity" << entityIdx;
@@ -494,21 +485,16 @@ bool SHPFileHelper::loadPolylinesFromFile(const QString &shpFile, QList<QList<QG
             continue;
         }
 
-        // Filter nearby vertices if enabled
-        if (filterMeters > 0) {
-            int i = 0;
-            while (i < (vertices.count() - 1)) {
-                if ((vertices.count() > 2) && (vertices[i].distanceTo(vertices[i+1]) < filterMeters)) {
-                    vertices.removeAt(i+1);
-                } else {
-                    i++;
-                }
-            }
-        }
+        ShapeFileHelper::applyImportOptions(vertices, false, options);
 
         polylines.append(vertices);
+        if ((options.maxShapes > 0) && (polylines.count() >= options.maxShapes)) {
+            break;
+        }
     }
 
+    progress.finish();
+
     if (polylines.isEmpty()) {
         errorString = QString(_errorPrefix).arg(QT_TRANSLATE_NOOP("SHP", "No valid polylines found."));
         return false;
@@ -1,5 +1,6 @@
 #include "ShapeFileHelper.h"
 #include "KMLHelper.h"
+#include "QGCGeo.h"
 #include "SHPFileHelper.h"
 #include "QGCLoggingCategory.h"
 
@@ -42,20 +43,50 @@ ShapeFileHelper::ShapeType ShapeFileHelper::determineShapeType(const QString &fi
     }
 }
 
+void ShapeFileHelper::applyImportOptions(QList<QGeoCoordinate> &vertices, bool closed, const ImportOptions &options)
+{
+    const int minVertices = closed ? 3 : 2;
+    const qsizetype originalCount = vertices.count();
+
+    QGCGeo::filterCloseVertices(vertices, options.filterMeters, minVertices);
+    const qsizetype filteredCount = vertices.count();
+
+    switch (options.simplification) {
+    case SimplificationMethod::DouglasPeucker:
+        vertices = QGCGeo::simplifyDouglasPeucker(vertices, options.maxVerticesPerShape, closed);
+        break;
+    case SimplificationMethod::Visvalingam:
+        vertices = QGCGeo::simplifyVisvalingam(vertices, options.maxVerticesPerShape, closed);
+        break;
+    case SimplificationMethod::None:
+        break;
+    }
+
+    if (vertices.count() != originalCount) {
+        qCDebug(ShapeFileHelperLog) << "Shape reduced from" << originalCount << "to" << vertices.count() << "vertices";
+    }
+    if ((vertices.count() != filteredCount) && options.shapeSimplified) {
+        options.shapeSimplified(filteredCount, vertices.count());
+    }
+}
+
 bool ShapeFileHelper::loadPolygonFromFile(const QString &file, QList<QGeoCoordinate> &vertices, QString &errorString, double filterMeters)
 {
     errorString.clear();
     vertices.clear();
 
-    switch (_getShapeFileType(file, errorString)) {
-    case ShapeFileType::KML:
-        return KMLHelper::loadPolygonFromFile(file, vertices, errorString, filterMeters);
-    case ShapeFileType::SHP:
-        return SHPFileHelper::loadPolygonFromFile(file, vertices, errorString, filterMeters);
-    case ShapeFileType::None:
-    default:
+    // Stop after the first shape instead of reading every entity in the file
+    ImportOptions options;
+    options.filterMeters = filterMeters;
+    options.maxShapes = 1;
+
+    QList<QList<QGeoCoordinate>> polygons;
+    if (!loadPolygonsFromFile(file, polygons, errorString, options)) {
         return false;
     }
+    vertices = polygons.first();
+
+    return true;
 }
 
 bool ShapeFileHelper::loadPolylineFromFile(const QString &file, QList<QGeoCoordinate> &coords, QString &errorString, double filterMeters)
@@ -63,15 +94,17 @@ bool ShapeFileHelper::loadPolylineFromFile(const QString &file, QList<QGeoCoordi
     errorString.clear();
     coords.clear();
 
-    switch (_getShapeFileType(file, errorString)) {
-    case ShapeFileType::KML:
-        return KMLHelper::loadPolylineFromFile(file, coords, errorString, filterMeters);
-    case ShapeFileType::SHP:
-        return SHPFileHelper::loadPolylineFromFile(file, coords, errorString, filterMeters);
-    case ShapeFileType::None:
-    default:
+    ImportOptions options;
+    options.filterMeters = filterMeters;
+    options.maxShapes = 1;
+
+    QList<QList<QGeoCoordinate>> polylines;
+    if (!loadPolylinesFromFile(file, polylines, errorString, options)) {
         return false;
     }
+    coords = polylines.first();
+
+    return true;
 }
 
 int ShapeFileHelper::getEntityCount(const QString &file, QString &errorString)
@@ -90,15 +123,23 @@ int ShapeFileHelper::getEntityCount(const QString &file, QString &errorString)
 }
 
 bool ShapeFileHelper::loadPolygonsFromFile(const QString &file, QList<QList<QGeoCoordinate>> &polygons, QString &errorString, double filterMeters)
+{
+    ImportOptions options;
+    options.filterMeters = filterMeters;
+
+    return loadPolygonsFromFile(file, polygons, errorString, options);
+}
+
+bool ShapeFileHelper::loadPolygonsFromFile(const QString &file, QList<QList<QGeoCoordinate>> &polygons, QString &errorString, const ImportOptions &options)
 {
     errorString.clear();
     polygons.clear();
 
     switch (_getShapeFileType(file, errorString)) {
     case ShapeFileType::KML:
-        return KMLHelper::loadPolygonsFromFile(file, polygons, errorString, filterMeters);
+        return KMLHelper::loadPolygonsFromFile(file, polygons, errorString, options);
     case ShapeFileType::SHP:
-        return SHPFileHelper::loadPolygonsFromFile(file, polygons, errorString, filterMeters);
+        return SHPFileHelper::loadPolygonsFromFile(file, polygons, errorString, options);
     case ShapeFileType::None:
     default:
         return false;
@@ -106,15 +147,23 @@ bool ShapeFileHelper::loadPolygonsFromFile(const QString &file, QList<QList<QGeo
 }
 
 bool ShapeFileHelper::loadPolylinesFromFile(const QString &file, QList<QList<QGeoCoordinate>> &polylines, QString &errorString, double filterMeters)
+{
+    ImportOptions options;
+    options.filterMeters = filterMeters;
+
+    return loadPolylinesFromFile(file, polylines, errorString, options);
+}
+
+bool ShapeFileHelper::loadPolylinesFromFile(const QString &file, QList<QList<QGeoCoordinate>> &polylines, QString &errorString, const ImportOptions &options)
 {
     errorString.clear();
     polylines.clear();
 
     switch (_getShapeFileType(file, errorString)) {
     case ShapeFileType::KML:
-        return KMLHelper::loadPolylinesFromFile(file, polylines, errorString, filterMeters);
+        return KMLHelper::loadPolylinesFromFile(file, polylines, errorString, options);
     case ShapeFileType::SHP:
-        return SHPFileHelper::loadPolylinesFromFile(file, polylines, errorString, filterMeters);
+        return SHPFileHelper::loadPolylinesFromFile(file, polylines, errorString, options);
     case ShapeFileType::None:
     default:
         return false;
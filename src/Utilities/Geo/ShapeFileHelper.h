@@ -6,6 +6,8 @@
 #include <QtPositioning/QGeoCoordinate>
 #include <QtQmlIntegration/QtQmlIntegration>
 
+#include <functional>
+
 Q_DECLARE_LOGGING_CATEGORY(ShapeFileHelperLog)
 
 /// Routines for loading polygons or polylines from KML or SHP files.
@@ -31,6 +33,50 @@ class ShapeFileHelper : public QObject
     /// Default distance threshold for filtering nearby vertices (meters)
     static constexpr double kDefaultVertexFilterMeters = 5.0;
 
+    /// Values match the PlanView importSimplificationMethod setting
+    enum class SimplificationMethod {
+        None,
+        DouglasPeucker,
+        Visvalingam
+    };
+
+    /// Controls how shapes are read from a file
+    struct ImportOptions {
+        double filterMeters = kDefaultVertexFilterMeters;                   ///< Filter vertices closer than this distance (0 to disable)
+        SimplificationMethod simplification = SimplificationMethod::None;   ///< Applied to each shape after filtering
+        int maxVerticesPerShape = 0;                                        ///< Vertex budget for simplification (0 for no limit)
+        int maxShapes = 0;                                                  ///< Stop reading after this many valid shapes (0 for all)
+        std::function<void(qsizetype, qsizetype)> shapeSimplified;          ///< Called with the vertex count before and after for each shape simplification reduced
+        std::function<void(double)> progress;                               ///< Called with the 0-1 fraction of the file read and simplified, see ProgressReporter
+    };
+
+    /// Calls ImportOptions::progress when the fraction has advanced by at least kProgressStep, and with 1 once done
+    class ProgressReporter {
+    public:
+        explicit ProgressReporter(const ImportOptions &options) : _progress(options.progress) {}
+
+        void report(double progress) {
+            if (_progress && ((progress - _lastProgress) >= kProgressStep)) {
+                _lastProgress = progress;
+                _progress(progress);
+            }
+        }
+        void finish() {
+            if (_progress) {
+                _progress(1.0);
+            }
+        }
+
+        static constexpr double kProgressStep = 0.01;
+
+    private:
+        const std::function<void(double)> &_progress;
+        double _lastProgress = 0;
+    };
+
+    /// Filters and simplifies a single shape as specified by the options
+    static void applyImportOptions(QList<QGeoCoordinate> &vertices, bool closed, const ImportOptions &options);
+
     static ShapeType determineShapeType(const QString &file, QString &errorString);
 
     /// Get the number of geometry entities in the file
@@ -46,6 +92,10 @@ class ShapeFileHelper : public QObject
     static bool loadPolygonsFromFile(const QString &file, QList<QList<QGeoCoordinate>> &polygons, QString &errorString,
                                      double filterMeters = kDefaultVertexFilterMeters);
 
+    /// Load polygon entities one at a time, filtering and simplifying each as it is read
+    static bool loadPolygonsFromFile(const QString &file, QList<QList<QGeoCoordinate>> &polygons, QString &errorString,
+                                     const ImportOptions &options);
+
     /// Load first polyline entity (convenience wrapper)
     /// @param filterMeters Filter vertices closer than this distance (0 to disable)
     static bool loadPolylineFromFile(const QString &file, QList<QGeoCoordinate> &coords, QString &errorString,
@@ -56,6 +106,10 @@ class ShapeFileHelper : public QObject
     static bool loadPolylinesFromFile(const QString &file, QList<QList<QGeoCoordinate>> &polylines, QString &errorString,
                                       double filterMeters = kDefaultVertexFilterMeters);
 
+    /// Load polyline entities one at a time, filtering and simplifying each as it is read
+    static bool loadPolylinesFromFile(const QString &file, QList<QList<QGeoCoordinate>> &polylines, QString &errorString,
+                                      const ImportOptions &options);
+
     /// Load point entities
     static bool loadPointsFromFile(const QString &file, QList<QGeoCoordinate> &points, QString &errorString);
 
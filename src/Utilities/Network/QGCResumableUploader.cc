@@ -0,0 +1,572 @@
+#include "QGCResumableUploader.h"
+#include "QGCLoggingCategory.h"
+#include "QGCNetworkHelper.h"
+
+#include <QtCore/QByteArrayList>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+#include <QtCore/QTimer>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+
+QGC_LOGGING_CATEGORY(QGCResumableUploaderLog, "Utilities.QGCResumableUploader")
+
+namespace {
+
+/// Upload-Metadata header: comma separated "key base64(value)" pairs
+QByteArray encodeMetadata(const QMap<QString, QString> &metadata)
+{
+    QByteArrayList pairs;
+    for (auto it = metadata.cbegin(); it != metadata.cend(); ++it) {
+        pairs.append(it.key().toUtf8() + ' ' + it.value().toUtf8().toBase64());
+    }
+    return pairs.join(',');
+}
+
+/// @return true: Request may succeed when repeated (connection lost, timeout, server trouble)
+bool isTransient(int statusCode)
+{
+    return (statusCode <= 0) || (statusCode == 408) || (statusCode == 429) || QGCNetworkHelper::isHttpServerError(statusCode);
+}
+
+/// @return true: Server no longer knows the upload, it has to be created again
+bool isUploadGone(int statusCode)
+{
+    return (statusCode == 404) || (statusCode == 410);
+}
+
+} // namespace
+
+QGCResumableUploader::QGCResumableUploader(QObject *parent)
+    : QObject(parent)
+    , _networkManager(QGCNetworkHelper::createNetworkManager(this))
+{
+    _clock.start();
+
+    qCDebug(QGCResumableUploaderLog) << "Created" << this;
+}
+
+QGCResumableUploader::~QGCResumableUploader()
+{
+    // Receivers may already be gone, so uploads are dropped without emitting finished
+    for (Upload *upload : std::as_const(_uploads)) {
+        _abort(upload);
+    }
+    qDeleteAll(_uploads);
+
+    qCDebug(QGCResumableUploaderLog) << "Destroying" << this;
+}
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+void QGCResumableUploader::setEndpoint(const QUrl &endpoint)
+{
+    _endpoint = endpoint;
+}
+
+void QGCResumableUploader::setChunkSize(qint64 bytes)
+{
+    _chunkSize = qMax(bytes, static_cast<qint64>(1));
+}
+
+void QGCResumableUploader::setMaxConcurrent(int count)
+{
+    _maxConcurrent = qMax(count, 1);
+    _startQueued();
+}
+
+void QGCResumableUploader::setMaxBytesPerSecond(qint64 bytesPerSecond)
+{
+    _maxBytesPerSecond = qMax(bytesPerSecond, static_cast<qint64>(0));
+    _nextSendMs = 0;
+}
+
+void QGCResumableUploader::setMaxRetries(int retries)
+{
+    _maxRetries = qMax(retries, 0);
+}
+
+void QGCResumableUploader::setRetryDelayMs(int delayMs)
+{
+    _retryDelayMs = qMax(delayMs, 0);
+}
+
+void QGCResumableUploader::setRequestTimeoutMs(int timeoutMs)
+{
+    _requestTimeoutMs = qMax(timeoutMs, 0);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+bool QGCResumableUploader::upload(const QString &fileName, const QMap<QString, QString> &metadata)
+{
+    if (_find(fileName)) {
+        qCWarning(QGCResumableUploaderLog) << "Already uploading" << fileName;
+        return false;
+    }
+
+    if (!_endpoint.isValid() || _endpoint.isEmpty()) {
+        qCWarning(QGCResumableUploaderLog) << "Upload endpoint not set";
+        return false;
+    }
+
+    QFile *const file = new QFile(fileName, this);
+    if (!file->open(QIODevice::ReadOnly)) {
+        qCWarning(QGCResumableUploaderLog) << "Could not open" << fileName << file->errorString();
+        delete file;
+        return false;
+    }
+
+    const QFileInfo info(fileName);
+
+    Upload *const upload = new Upload;
+    upload->id = _nextId++;
+    upload->fileName = fileName;
+    upload->metadata = metadata;
+    upload->file = file;
+    upload->size = file->size();
+    upload->modified = info.lastModified().toMSecsSinceEpoch();
+    _uploads.append(upload);
+
+    qCDebug(QGCResumableUploaderLog) << "Queued" << fileName << upload->size << "bytes";
+
+    _startQueued();
+    return true;
+}
+
+void QGCResumableUploader::cancel(const QString &fileName)
+{
+    Upload *const upload = _find(fileName);
+    if (upload) {
+        _finish(upload, false, tr("Upload cancelled"));
+    }
+}
+
+void QGCResumableUploader::cancelAll()
+{
+    // Started uploads are always at the front of the list, cancelling from the back keeps queued uploads from
+    // being started while the active ones are cancelled
+    while (!_uploads.isEmpty()) {
+        _finish(_uploads.last(), false, tr("Upload cancelled"));
+    }
+}
+
+bool QGCResumableUploader::isUploading(const QString &fileName) const
+{
+    return (_find(fileName) != nullptr);
+}
+
+QString QGCResumableUploader::journalFileName(const QString &fileName)
+{
+    return fileName + QStringLiteral(".upload");
+}
+
+void QGCResumableUploader::removeJournal(const QString &fileName)
+{
+    QFile journal(journalFileName(fileName));
+    if (journal.exists()) {
+        (void) journal.remove();
+    }
+}
+
+// ============================================================================
+// Upload State Machine
+// ============================================================================
+
+void QGCResumableUploader::_startQueued()
+{
+    for (qsizetype i = 0; (i < _uploads.count()) && (_activeCount < _maxConcurrent); i++) {
+        Upload *const upload = _uploads[i];
+        if (!upload->started) {
+            upload->started = true;
+            _activeCount++;
+            _start(upload);
+        }
+    }
+}
+
+void QGCResumableUploader::_start(Upload *upload)
+{
+    if (_loadJournal(upload)) {
+        qCDebug(QGCResumableUploaderLog) << "Resuming" << upload->fileName << "at" << upload->location;
+        _requestOffset(upload);
+    } else {
+        _create(upload);
+    }
+}
+
+void QGCResumableUploader::_create(Upload *upload)
+{
+    QNetworkRequest request = _request(_endpoint);
+    request.setRawHeader("Upload-Length", QByteArray::number(upload->size));
+    if (!upload->metadata.isEmpty()) {
+        request.setRawHeader("Upload-Metadata", encodeMetadata(upload->metadata));
+    }
+
+    _track(upload, _networkManager->post(request, QByteArray()), &QGCResumableUploader::_createFinished);
+}
+
+void QGCResumableUploader::_requestOffset(Upload *upload)
+{
+    _track(upload, _networkManager->head(_request(upload->location)), &QGCResumableUploader::_offsetFinished);
+}
+
+void QGCResumableUploader::_scheduleChunk(Upload *upload)
+{
+    qint64 delayMs = 0;
+    if (_maxBytesPerSecond > 0) {
+        // Each chunk reserves the time it takes to send at the capped rate, so concurrent uploads share the cap
+        const qint64 length = qMin(_chunkSize, upload->size - upload->offset);
+        const qint64 now = _clock.elapsed();
+        const qint64 sendMs = qMax(now, _nextSendMs);
+        _nextSendMs = sendMs + ((length * 1000) / _maxBytesPerSecond);
+        delayMs = sendMs - now;
+    }
+
+    if (delayMs <= 0) {
+        _sendChunk(upload);
+        return;
+    }
+
+    const quint64 id = upload->id;
+    QTimer::singleShot(delayMs, this, [this, id]() {
+        Upload *const upload = _find(id);
+        if (upload) {
+            _sendChunk(upload);
+        }
+    });
+}
+
+void QGCResumableUploader::_sendChunk(Upload *upload)
+{
+    QByteArray data;
+    if (upload->file->seek(upload->offset)) {
+        data = upload->file->read(qMin(_chunkSize, upload->size - upload->offset));
+    }
+    if (data.isEmpty()) {
+        _finish(upload, false, tr("Could not read %1: %2").arg(upload->fileName, upload->file->errorString()));
+        return;
+    }
+
+    QNetworkRequest request = _request(upload->location);
+    request.setRawHeader("Upload-Offset", QByteArray::number(upload->offset));
+    request.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/offset+octet-stream"));
+
+    QNetworkReply *const reply = _networkManager->sendCustomRequest(request, "PATCH", data);
+    (void) connect(reply, &QNetworkReply::uploadProgress, this, [this, fileName = upload->fileName, offset = upload->offset, size = upload->size](qint64 bytesSent, qint64) {
+        emit progress(fileName, offset + bytesSent, size);
+    });
+    _track(upload, reply, &QGCResumableUploader::_chunkFinished);
+}
+
+void QGCResumableUploader::_createFinished(quint64 id)
+{
+    QNetworkReply *reply = nullptr;
+    Upload *const upload = _takeReply(id, reply);
+    if (!upload) {
+        return;
+    }
+
+    const int statusCode = QGCNetworkHelper::httpStatusCode(reply);
+    if ((reply->error() != QNetworkReply::NoError) || (statusCode != 201)) {
+        if (isTransient(statusCode)) {
+            _retry(upload, QGCNetworkHelper::errorMessage(reply));
+        } else {
+            _finish(upload, false, QGCNetworkHelper::errorMessage(reply));
+        }
+        return;
+    }
+
+    const QByteArray location = reply->rawHeader("Location");
+    if (location.isEmpty()) {
+        _finish(upload, false, tr("Server did not return an upload location"));
+        return;
+    }
+
+    upload->location = reply->url().resolved(QUrl::fromEncoded(location));
+    upload->offset = 0;
+    upload->retries = 0;
+    _saveJournal(upload);
+
+    qCDebug(QGCResumableUploaderLog) << "Created" << upload->fileName << "at" << upload->location;
+
+    if (upload->offset >= upload->size) {
+        _finish(upload, true, QString());
+    } else {
+        _scheduleChunk(upload);
+    }
+}
+
+void QGCResumableUploader::_offsetFinished(quint64 id)
+{
+    QNetworkReply *reply = nullptr;
+    Upload *const upload = _takeReply(id, reply);
+    if (!upload) {
+        return;
+    }
+
+    const int statusCode = QGCNetworkHelper::httpStatusCode(reply);
+    if (isUploadGone(statusCode)) {
+        qCDebug(QGCResumableUploaderLog) << "Upload no longer on server, starting over" << upload->fileName;
+        removeJournal(upload->fileName);
+        upload->location.clear();
+        upload->offset = 0;
+        _create(upload);
+        return;
+    }
+
+    if (reply->error() != QNetworkReply::NoError) {
+        if (isTransient(statusCode)) {
+            _retry(upload, QGCNetworkHelper::errorMessage(reply));
+        } else {
+            _finish(upload, false, QGCNetworkHelper::errorMessage(reply));
+        }
+        return;
+    }
+
+    bool ok = false;
+    const qint64 offset = reply->rawHeader("Upload-Offset").toLongLong(&ok);
+    if (!ok || (offset < 0) || (offset > upload->size)) {
+        _finish(upload, false, tr("Server returned an invalid upload offset"));
+        return;
+    }
+
+    // The server's offset is authoritative, the journal may lag behind by the chunk which was in flight
+    upload->offset = offset;
+    _saveJournal(upload);
+    emit progress(upload->fileName, upload->offset, upload->size);
+
+    if (upload->offset >= upload->size) {
+        _finish(upload, true, QString());
+    } else {
+        _scheduleChunk(upload);
+    }
+}
+
+void QGCResumableUploader::_chunkFinished(quint64 id)
+{
+    QNetworkReply *reply = nullptr;
+    Upload *const upload = _takeReply(id, reply);
+    if (!upload) {
+        return;
+    }
+
+    const int statusCode = QGCNetworkHelper::httpStatusCode(reply);
+    if (isUploadGone(statusCode)) {
+        qCDebug(QGCResumableUploaderLog) << "Upload expired on server, starting over" << upload->fileName;
+        removeJournal(upload->fileName);
+        upload->location.clear();
+        upload->offset = 0;
+        _create(upload);
+        return;
+    }
+
+    if (statusCode == 409) {
+        // Offset mismatch, the retry resynchronizes with the server
+        _retry(upload, tr("Upload offset mismatch"));
+        return;
+    }
+
+    if (reply->error() != QNetworkReply::NoError) {
+        if (isTransient(statusCode)) {
+            _retry(upload, QGCNetworkHelper::errorMessage(reply));
+        } else {
+            _finish(upload, false, QGCNetworkHelper::errorMessage(reply));
+        }
+        return;
+    }
+
+    bool ok = false;
+    const qint64 offset = reply->rawHeader("Upload-Offset").toLongLong(&ok);
+    if (!ok || (offset <= upload->offset) || (offset > upload->size)) {
+        _retry(upload, tr("Server returned an invalid upload offset"));
+        return;
+    }
+
+    upload->offset = offset;
+    upload->retries = 0;
+    _saveJournal(upload);
+    emit progress(upload->fileName, upload->offset, upload->size);
+
+    if (upload->offset >= upload->size) {
+        _finish(upload, true, QString());
+    } else {
+        _scheduleChunk(upload);
+    }
+}
+
+void QGCResumableUploader::_retry(Upload *upload, const QString &errorString)
+{
+    if (upload->retries >= _maxRetries) {
+        _finish(upload, false, errorString);
+        return;
+    }
+
+    const int delayMs = qMin(static_cast<qint64>(kMaxRetryDelayMs), static_cast<qint64>(_retryDelayMs) << qMin(upload->retries, 16));
+    upload->retries++;
+
+    qCDebug(QGCResumableUploaderLog) << "Retry" << upload->retries << "of" << upload->fileName << "in" << delayMs << "ms:" << errorString;
+
+    const quint64 id = upload->id;
+    QTimer::singleShot(delayMs, this, [this, id]() {
+        Upload *const upload = _find(id);
+        if (!upload) {
+            return;
+        }
+
+        // Part of the failed chunk may have reached the server, so continue from the offset it reports
+        if (upload->location.isEmpty()) {
+            _create(upload);
+        } else {
+            _requestOffset(upload);
+        }
+    });
+}
+
+void QGCResumableUploader::_finish(Upload *upload, bool success, const QString &errorString)
+{
+    _abort(upload);
+
+    // The journal is kept on failure so a later upload of the same file continues where this one stopped
+    if (success) {
+        removeJournal(upload->fileName);
+        qCDebug(QGCResumableUploaderLog) << "Uploaded" << upload->fileName;
+    } else {
+        qCWarning(QGCResumableUploaderLog) << "Upload failed" << upload->fileName << errorString;
+    }
+
+    if (upload->started) {
+        _activeCount--;
+    }
+    (void) _uploads.removeOne(upload);
+
+    const QString fileName = upload->fileName;
+    delete upload->file;
+    delete upload;
+
+    emit finished(fileName, success, errorString);
+
+    _startQueued();
+}
+
+void QGCResumableUploader::_abort(Upload *upload)
+{
+    QNetworkReply *const reply = upload->reply;
+    if (!reply) {
+        return;
+    }
+
+    upload->reply = nullptr;
+    (void) disconnect(reply, nullptr, this, nullptr);
+    reply->abort();
+    reply->deleteLater();
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+bool QGCResumableUploader::_loadJournal(Upload *upload) const
+{
+    QFile file(journalFileName(upload->fileName));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const QJsonObject journal = QJsonDocument::fromJson(file.readAll()).object();
+    const QUrl location(journal.value(QStringLiteral("url")).toString());
+
+    // A journal for a different server or an older version of the file can't be resumed
+    if (location.isEmpty() || !location.isValid() ||
+        (journal.value(QStringLiteral("endpoint")).toString() != _endpoint.toString()) ||
+        (journal.value(QStringLiteral("size")).toInteger() != upload->size) ||
+        (journal.value(QStringLiteral("modified")).toInteger() != upload->modified)) {
+        qCDebug(QGCResumableUploaderLog) << "Ignoring stale journal" << file.fileName();
+        return false;
+    }
+
+    upload->location = location;
+    upload->offset = journal.value(QStringLiteral("offset")).toInteger();
+    return true;
+}
+
+void QGCResumableUploader::_saveJournal(const Upload *upload) const
+{
+    QJsonObject journal;
+    journal[QStringLiteral("endpoint")] = _endpoint.toString();
+    journal[QStringLiteral("url")] = upload->location.toString();
+    journal[QStringLiteral("size")] = upload->size;
+    journal[QStringLiteral("modified")] = upload->modified;
+    journal[QStringLiteral("offset")] = upload->offset;
+
+    QSaveFile file(journalFileName(upload->fileName));
+    if (!file.open(QIODevice::WriteOnly) ||
+        (file.write(QJsonDocument(journal).toJson(QJsonDocument::Compact)) < 0) ||
+        !file.commit()) {
+        qCWarning(QGCResumableUploaderLog) << "Could not write upload journal" << file.fileName() << file.errorString();
+    }
+}
+
+void QGCResumableUploader::_track(Upload *upload, QNetworkReply *reply, void (QGCResumableUploader::*handler)(quint64))
+{
+    upload->reply = reply;
+
+    const quint64 id = upload->id;
+    (void) connect(reply, &QNetworkReply::finished, this, [this, id, handler]() {
+        (this->*handler)(id);
+    });
+}
+
+QGCResumableUploader::Upload *QGCResumableUploader::_takeReply(quint64 id, QNetworkReply *&reply)
+{
+    Upload *const upload = _find(id);
+    if (!upload || !upload->reply) {
+        return nullptr;
+    }
+
+    reply = upload->reply;
+    upload->reply = nullptr;
+    reply->deleteLater();
+    return upload;
+}
+
+QGCResumableUploader::Upload *QGCResumableUploader::_find(quint64 id) const
+{
+    for (Upload *upload : _uploads) {
+        if (upload->id == id) {
+            return upload;
+        }
+    }
+
+    return nullptr;
+}
+
+QGCResumableUploader::Upload *QGCResumableUploader::_find(const QString &fileName) const
+{
+    for (Upload *upload : _uploads) {
+        if (upload->fileName == fileName) {
+            return upload;
+        }
+    }
+
+    return nullptr;
+}
+
+QNetworkRequest QGCResumableUploader::_request(const QUrl &url) const
+{
+    QGCNetworkHelper::RequestConfig config;
+    config.timeoutMs = _requestTimeoutMs;
+    config.cacheEnabled = false;
+
+    QNetworkRequest request = QGCNetworkHelper::createRequest(url, config);
+    request.setRawHeader("Tus-Resumable", kTusVersion);
+    return request;
+}
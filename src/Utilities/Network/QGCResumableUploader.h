@@ -0,0 +1,167 @@
+#pragma once
+
+/// @file QGCResumableUploader.h
+/// @brief Chunked, resumable file uploads with concurrency and bandwidth limits
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QMap>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QUrl>
+#include <QtNetwork/QNetworkRequest>
+
+class QFile;
+class QNetworkAccessManager;
+class QNetworkReply;
+
+Q_DECLARE_LOGGING_CATEGORY(QGCResumableUploaderLog)
+
+/// Uploads files in chunks using the tus resumable upload protocol (core 1.0.0)
+///
+/// Features:
+/// - Each file is sent as a series of PATCH requests of at most chunkSize bytes, so a lost connection only
+///   costs the chunk in flight
+/// - Upload progress is journaled next to the file (<file>.upload), an interrupted upload continues from the
+///   offset reported by the server, also after an application restart
+/// - Failed requests are retried with exponential backoff, resynchronizing the offset with the server first
+/// - Several files upload at the same time, further files are queued
+/// - Optional bandwidth cap shared by all uploads
+///
+/// Protocol summary:
+/// - POST endpoint, Upload-Length, Upload-Metadata -> 201 Created, Location of the upload
+/// - HEAD location -> Upload-Offset
+/// - PATCH location, Upload-Offset, chunk data -> 204 No Content, new Upload-Offset
+///
+/// Example usage:
+/// @code
+/// auto *uploader = new QGCResumableUploader(this);
+/// uploader->setEndpoint(QUrl("https://example.com/files/"));
+/// uploader->setMaxBytesPerSecond(256 * 1024);
+/// connect(uploader, &QGCResumableUploader::finished, this,
+///         [](const QString &fileName, bool success, const QString &error) {
+///     qDebug() << fileName << (success ? "uploaded" : error);
+/// });
+/// uploader->upload("/path/to/log.ulg", {{"filename", "log.ulg"}});
+/// @endcode
+class QGCResumableUploader : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(QGCResumableUploader)
+
+public:
+    explicit QGCResumableUploader(QObject *parent = nullptr);
+    ~QGCResumableUploader() override;
+
+    QUrl endpoint() const { return _endpoint; }
+    qint64 chunkSize() const { return _chunkSize; }
+    int maxConcurrent() const { return _maxConcurrent; }
+    qint64 maxBytesPerSecond() const { return _maxBytesPerSecond; }
+    int maxRetries() const { return _maxRetries; }
+
+    /// URL new uploads are created at
+    void setEndpoint(const QUrl &endpoint);
+
+    /// Largest amount of data sent with a single request
+    void setChunkSize(qint64 bytes);
+
+    /// Number of files uploaded at the same time
+    void setMaxConcurrent(int count);
+
+    /// Bandwidth cap over all uploads, 0 for unlimited
+    void setMaxBytesPerSecond(qint64 bytesPerSecond);
+
+    /// Number of consecutive failed requests after which an upload gives up
+    void setMaxRetries(int retries);
+
+    /// Delay before the first retry, doubled for each further retry
+    void setRetryDelayMs(int delayMs);
+
+    /// Timeout for a single request
+    void setRequestTimeoutMs(int timeoutMs);
+
+    /// Queues a file for upload
+    /// @param fileName File to upload
+    /// @param metadata Sent with the request which creates the upload
+    /// @return false if the file can't be read or is already queued
+    bool upload(const QString &fileName, const QMap<QString, QString> &metadata = {});
+
+    /// Stops uploading a file, the journal is kept so the upload can be resumed later
+    void cancel(const QString &fileName);
+    void cancelAll();
+
+    bool isUploading(const QString &fileName) const;
+    bool isBusy() const { return !_uploads.isEmpty(); }
+
+    /// @return Journal file used to resume uploading fileName
+    static QString journalFileName(const QString &fileName);
+
+    /// Removes the journal of a file, the next upload of the file starts from the beginning
+    static void removeJournal(const QString &fileName);
+
+    static constexpr qint64 kDefaultChunkSize = 1024 * 1024;
+    static constexpr int kDefaultMaxConcurrent = 2;
+    static constexpr int kDefaultMaxRetries = 8;
+    static constexpr int kDefaultRetryDelayMs = 1000;
+    static constexpr int kMaxRetryDelayMs = 60 * 1000;
+    static constexpr int kDefaultRequestTimeoutMs = 30 * 1000;
+    static constexpr const char *kTusVersion = "1.0.0";
+
+signals:
+    /// Emitted as data is sent
+    /// @param bytesSent Bytes of the file which have been sent, including those sent before a resume
+    void progress(const QString &fileName, qint64 bytesSent, qint64 bytesTotal);
+
+    /// Emitted once for each queued file
+    void finished(const QString &fileName, bool success, const QString &errorString);
+
+private:
+    struct Upload {
+        quint64 id = 0;
+        QString fileName;
+        QMap<QString, QString> metadata;
+        QFile *file = nullptr;
+        qint64 size = 0;
+        qint64 modified = 0;            ///< Modification time of the file, msecs since epoch
+        qint64 offset = 0;              ///< Bytes the server has acknowledged
+        QUrl location;                  ///< Upload URL returned by the server, empty until created
+        int retries = 0;
+        bool started = false;
+        QNetworkReply *reply = nullptr;     ///< Request in flight, nullptr while waiting
+    };
+
+    void _startQueued();
+    void _start(Upload *upload);
+    void _create(Upload *upload);
+    void _requestOffset(Upload *upload);
+    void _scheduleChunk(Upload *upload);
+    void _sendChunk(Upload *upload);
+    void _createFinished(quint64 id);
+    void _offsetFinished(quint64 id);
+    void _chunkFinished(quint64 id);
+    void _retry(Upload *upload, const QString &errorString);
+    void _finish(Upload *upload, bool success, const QString &errorString);
+    void _abort(Upload *upload);
+    bool _loadJournal(Upload *upload) const;
+    void _saveJournal(const Upload *upload) const;
+    void _track(Upload *upload, QNetworkReply *reply, void (QGCResumableUploader::*handler)(quint64));
+    Upload *_takeReply(quint64 id, QNetworkReply *&reply);
+    Upload *_find(quint64 id) const;
+    Upload *_find(const QString &fileName) const;
+    QNetworkRequest _request(const QUrl &url) const;
+
+    QNetworkAccessManager *_networkManager = nullptr;
+    QList<Upload*> _uploads;            ///< Active and queued, in the order they were queued
+    int _activeCount = 0;
+    quint64 _nextId = 1;
+    QUrl _endpoint;
+    qint64 _chunkSize = kDefaultChunkSize;
+    int _maxConcurrent = kDefaultMaxConcurrent;
+    qint64 _maxBytesPerSecond = 0;
+    int _maxRetries = kDefaultMaxRetries;
+    int _retryDelayMs = kDefaultRetryDelayMs;
+    int _requestTimeoutMs = kDefaultRequestTimeoutMs;
+    QElapsedTimer _clock;
+    qint64 _nextSendMs = 0;             ///< Earliest time the next chunk may be sent under the bandwidth cap
+};
@@ -11,6 +11,9 @@ static const QString kOptClearCache      = QStringLiteral("clear-cache");
 static const QString kOptLogging         = QStringLiteral("logging");
 static const QString kOptLogOutput       = QStringLiteral("log-output");
 static const QString kOptSimpleBoot      = QStringLiteral("simple-boot-test");
+static const QString kOptStartupTrace    = QStringLiteral("startup-trace");
+static const QString kOptAnalyzeLogs     = QStringLiteral("analyze-logs");
+static const QString kOptAnalyzeReport   = QStringLiteral("analyze-report");
 static const QString kOptFakeMobile      = QStringLiteral("fake-mobile");
 static const QString kOptAllowMultiple   = QStringLiteral("allow-multiple");
 static const QString kOptUnittest        = QStringLiteral("unittest");
@@ -91,6 +94,24 @@ CommandLineParseResult parseCommandLine()
         QCoreApplication::translate("main", "Initialize subsystems and exit."));
     (void) parser.addOption(simpleBootOpt);
 
+    const QCommandLineOption startupTraceOpt(
+        kOptStartupTrace,
+        QCoreApplication::translate("main", "Write a Chrome trace of application startup to file."),
+        QCoreApplication::translate("main", "file"));
+    (void) parser.addOption(startupTraceOpt);
+
+    const QCommandLineOption analyzeLogsOpt(
+        kOptAnalyzeLogs,
+        QCoreApplication::translate("main", "Analyze all flight logs in directory without starting the user interface, then exit."),
+        QCoreApplication::translate("main", "directory"));
+    (void) parser.addOption(analyzeLogsOpt);
+
+    const QCommandLineOption analyzeReportOpt(
+        kOptAnalyzeReport,
+        QCoreApplication::translate("main", "Write the --analyze-logs report to file instead of stdout."),
+        QCoreApplication::translate("main", "file"));
+    (void) parser.addOption(analyzeReportOpt);
+
 #if defined(QGC_UNITTEST_BUILD)
     const QCommandLineOption unittestOpt(
         kOptUnittest,
@@ -205,6 +226,15 @@ CommandLineParseResult parseCommandLine()
     }
     out.logOutput = parser.isSet(logOutputOpt);
     out.simpleBootTest = parser.isSet(simpleBootOpt);
+    if (parser.isSet(startupTraceOpt)) {
+        out.startupTraceFile = parser.value(startupTraceOpt);
+    }
+    if (parser.isSet(analyzeLogsOpt)) {
+        out.analyzeLogsDirectory = parser.value(analyzeLogsOpt);
+    }
+    if (parser.isSet(analyzeReportOpt)) {
+        out.analyzeReportFile = parser.value(analyzeReportOpt);
+    }
 
 #if defined(QGC_UNITTEST_BUILD)
     if (parser.isSet(unittestOpt)) {
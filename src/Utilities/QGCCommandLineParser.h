@@ -31,6 +31,10 @@ struct CommandLineParseResult
     std::optional<QString> loggingOptions;
     bool logOutput = false;
     bool simpleBootTest = false;
+    std::optional<QString> startupTraceFile;
+
+    std::optional<QString> analyzeLogsDirectory;
+    std::optional<QString> analyzeReportFile;
 
     bool runningUnitTests = false;
     QStringList unitTests;
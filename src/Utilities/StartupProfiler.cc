@@ -0,0 +1,167 @@
+#include "StartupProfiler.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QThread>
+
+#include <algorithm>
+
+QGC_LOGGING_CATEGORY(StartupProfilerLog, "Utilities.StartupProfiler")
+
+Q_GLOBAL_STATIC(StartupProfiler, _startupProfilerInstance);
+
+StartupProfiler::StartupProfiler()
+{
+    _timer.start();
+}
+
+StartupProfiler *StartupProfiler::instance()
+{
+    return _startupProfilerInstance();
+}
+
+StartupProfiler::Span::Span(const QString &name, const QString &category)
+    : _name(name)
+    , _category(category)
+    , _startUs(StartupProfiler::instance()->elapsedUs())
+{
+
+}
+
+StartupProfiler::Span::~Span()
+{
+    end();
+}
+
+void StartupProfiler::Span::end()
+{
+    if (_ended) {
+        return;
+    }
+    _ended = true;
+
+    StartupProfiler *const profiler = StartupProfiler::instance();
+    if (profiler) {
+        profiler->addSpan(_name, _category, _startUs, profiler->elapsedUs() - _startUs);
+    }
+}
+
+void StartupProfiler::Span::next(const QString &name)
+{
+    StartupProfiler *const profiler = StartupProfiler::instance();
+    const qint64 nowUs = profiler->elapsedUs();
+    profiler->addSpan(_name, _category, _startUs, nowUs - _startUs);
+    _name = name;
+    _startUs = nowUs;
+}
+
+void StartupProfiler::setTraceFileName(const QString &traceFileName)
+{
+    QMutexLocker locker(&_mutex);
+    _traceFileName = traceFileName;
+}
+
+bool StartupProfiler::recording() const
+{
+    QMutexLocker locker(&_mutex);
+    return _recording;
+}
+
+quint64 StartupProfiler::_currentThreadId()
+{
+    return static_cast<quint64>(reinterpret_cast<quintptr>(QThread::currentThreadId()));
+}
+
+void StartupProfiler::addSpan(const QString &name, const QString &category, qint64 startUs, qint64 durationUs)
+{
+    QMutexLocker locker(&_mutex);
+    if (_recording) {
+        _events.append({ name, category, startUs, durationUs, _currentThreadId() });
+    }
+}
+
+void StartupProfiler::addInstant(const QString &name, const QString &category)
+{
+    const qint64 nowUs = elapsedUs();
+
+    QMutexLocker locker(&_mutex);
+    if (_recording) {
+        _events.append({ name, category, nowUs, -1, _currentThreadId() });
+    }
+}
+
+QJsonDocument StartupProfiler::trace() const
+{
+    QMutexLocker locker(&_mutex);
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+    for (const Event &event : _events) {
+        QJsonObject jsonEvent {
+            { "name",   event.name },
+            { "cat",    event.category },
+            { "ts",     event.startUs },
+            { "pid",    pid },
+            { "tid",    static_cast<qint64>(event.threadId) },
+        };
+        if (event.durationUs < 0) {
+            jsonEvent["ph"] = QStringLiteral("i");
+            jsonEvent["s"] = QStringLiteral("p");
+        } else {
+            jsonEvent["ph"] = QStringLiteral("X");
+            jsonEvent["dur"] = event.durationUs;
+        }
+        traceEvents.append(jsonEvent);
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = QStringLiteral("ms");
+    return QJsonDocument(root);
+}
+
+bool StartupProfiler::finish()
+{
+    const qint64 totalUs = elapsedUs();
+
+    QList<Event> events;
+    QString traceFileName;
+    {
+        QMutexLocker locker(&_mutex);
+        if (!_recording) {
+            return true;
+        }
+        events = _events;
+        traceFileName = _traceFileName;
+    }
+
+    // Summary, slowest first
+    std::sort(events.begin(), events.end(), [](const Event &a, const Event &b) { return a.durationUs > b.durationUs; });
+    qCInfo(StartupProfilerLog) << "Startup took" << (totalUs / 1000) << "ms";
+    for (const Event &event : std::as_const(events)) {
+        if (event.durationUs >= 0) {
+            qCDebug(StartupProfilerLog) << "   " << event.name << (event.durationUs / 1000.0) << "ms";
+        }
+    }
+
+    bool success = true;
+    if (!traceFileName.isEmpty()) {
+        QFile file(traceFileName);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            (void) file.write(trace().toJson(QJsonDocument::Compact));
+            qCInfo(StartupProfilerLog) << "Startup trace written to" << traceFileName;
+        } else {
+            qCWarning(StartupProfilerLog) << "Unable to write startup trace" << traceFileName << file.errorString();
+            success = false;
+        }
+    }
+
+    QMutexLocker locker(&_mutex);
+    _recording = false;
+    _events.clear();
+
+    return success;
+}
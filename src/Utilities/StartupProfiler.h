@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+Q_DECLARE_LOGGING_CATEGORY(StartupProfilerLog)
+
+/// Records timed spans for the application startup steps: subsystem creation and initialization, QML engine creation,
+/// creation of the QML root window (which includes the Fly view) and the initialization deferred until after the first
+/// frame. Views which are loaded later, such as Plan, Analyze and Setup, are not recorded.
+///     The clock starts with the first call to instance(), which main() makes before anything else. Recording stops
+///     when finish() is called once the main window has rendered its first frame. At that point a per span summary is
+///     logged and, if a trace file was requested with --startup-trace, the spans are written in the Chrome trace event
+///     format. The trace can be loaded into chrome://tracing or https://ui.perfetto.dev.
+///     Spans may be recorded from any thread.
+class StartupProfiler
+{
+public:
+    StartupProfiler();
+
+    static StartupProfiler *instance();
+
+    /// Times the enclosing scope. Use next() to time a sequence of steps with a single object.
+    class Span
+    {
+    public:
+        explicit Span(const QString &name, const QString &category = QStringLiteral("startup"));
+        ~Span();
+
+        /// Ends the current span and starts a new one in the same category
+        void next(const QString &name);
+
+        /// Ends the span before the end of the scope
+        void end();
+
+    private:
+        QString _name;
+        QString _category;
+        qint64 _startUs;
+        bool _ended = false;
+
+        Q_DISABLE_COPY(Span)
+    };
+
+    /// @param traceFileName Chrome trace json file to write from finish(), empty to only log the summary
+    void setTraceFileName(const QString &traceFileName);
+
+    /// @return Microseconds since the profiler was created
+    qint64 elapsedUs() const { return _timer.nsecsElapsed() / 1000; }
+
+    bool recording() const;
+    void addSpan(const QString &name, const QString &category, qint64 startUs, qint64 durationUs);
+    void addInstant(const QString &name, const QString &category = QStringLiteral("startup"));
+
+    /// Stops recording, logs the summary and writes the trace file if one was requested
+    /// @return false: Writing the trace file failed
+    bool finish();
+
+    /// @return The recorded events in the Chrome trace event format
+    QJsonDocument trace() const;
+
+private:
+    struct Event {
+        QString name;
+        QString category;
+        qint64 startUs;
+        qint64 durationUs;      ///< -1 for an instant event
+        quint64 threadId;
+    };
+
+    static quint64 _currentThreadId();
+
+    QElapsedTimer _timer;
+    mutable QMutex _mutex;
+    QList<Event> _events;
+    QString _traceFileName;
+    bool _recording = true;
+};
@@ -1,4 +1,5 @@
 #include "ComponentInformationCache.h"
+#include "QGC.h"
 #include "QGCFileHelper.h"
 #include "QGCLoggingCategory.h"
 
@@ -40,13 +41,21 @@ QString ComponentInformationCache::access(const QString &fileTag)
         return "";
     }
 
-    qCDebug(ComponentInformationCacheLog) << "Cache hit for" << fileTag;
-
     // mark access
     Meta m{};
     AccessCounterType previousCounter = -1;
     if (meta.open(QIODevice::ReadWrite)) {
         if (meta.read((char*)&m, sizeof(m)) == sizeof(m)) {
+            // validate the contents, so a truncated or modified file is downloaded again instead of being used
+            int64_t size = 0;
+            uint32_t crc = 0;
+            if (!fileCrc(data.fileName(), size, crc) || size != m.dataSize || crc != m.dataCrc) {
+                qCWarning(ComponentInformationCacheLog) << "Validation failed, removing cache entry" << fileTag;
+                meta.close();
+                removeEntry(fileTag);
+                return "";
+            }
+
             previousCounter = m.accessCounter;
             m.accessCounter = _nextAccessCounter;
             meta.seek(0);
@@ -61,6 +70,8 @@ QString ComponentInformationCache::access(const QString &fileTag)
         qCWarning(ComponentInformationCacheLog) << "Failed to open" << meta.fileName() << meta.errorString();
     }
 
+    qCDebug(ComponentInformationCacheLog) << "Cache hit for" << fileTag;
+
     _cachedFiles.remove(previousCounter);
     _cachedFiles[_nextAccessCounter] = fileTag;
     ++_nextAccessCounter;
@@ -88,6 +99,11 @@ QString ComponentInformationCache::insert(const QString &fileTag, const QString
     // write meta data
     Meta m{};
     m.accessCounter = _nextAccessCounter;
+    if (!fileCrc(data.fileName(), m.dataSize, m.dataCrc)) {
+        qCWarning(ComponentInformationCacheLog) << "Failed to read" << data.fileName();
+        data.remove();
+        return "";
+    }
     if (meta.open(QIODevice::WriteOnly)) {
         if (meta.write((const char*)&m, sizeof(m)) != sizeof(m)) {
             qCWarning(ComponentInformationCacheLog) << "Meta write failed" << meta.fileName() << meta.errorString();
@@ -180,3 +196,36 @@ void ComponentInformationCache::removeOldEntries()
         --_numFiles;
     }
 }
+
+void ComponentInformationCache::removeEntry(const QString& fileTag)
+{
+    QFile::remove(metaFileName(fileTag));
+    QFile::remove(dataFileName(fileTag));
+
+    for (auto iter = _cachedFiles.begin(); iter != _cachedFiles.end(); ++iter) {
+        if (iter.value() == fileTag) {
+            _cachedFiles.erase(iter);
+            --_numFiles;
+            break;
+        }
+    }
+}
+
+bool ComponentInformationCache::fileCrc(const QString& fileName, int64_t& size, uint32_t& crc)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    size = 0;
+    crc = 0;
+    char buffer[16 * 1024];
+    qint64 bytesRead;
+    while ((bytesRead = file.read(buffer, sizeof(buffer))) > 0) {
+        crc = QGC::crc32(reinterpret_cast<const quint8*>(buffer), static_cast<unsigned>(bytesRead), crc);
+        size += bytesRead;
+    }
+
+    return bytesRead == 0;
+}
@@ -10,7 +10,9 @@ Q_DECLARE_LOGGING_CATEGORY(ComponentInformationCacheLog)
 /**
  * Simple file cache with a maximum number of files and LRU retention policy based on last access
  * Notes:
- * - fileTag defines the cache keys and the format is up to the user
+ * - fileTag defines the cache keys and the format is up to the user. Component information uses the file crc
+ *   reported by the vehicle, so identical metadata is shared between vehicles and firmware versions.
+ * - the size and crc of each file are stored with it and checked on access, a corrupted entry is removed
  * - only one instance per directory must exist
  * - not thread-safe
  */
@@ -25,7 +27,7 @@ class ComponentInformationCache : public QObject
     /**
      * Try to access a file and set the access counter
      * @param fileTag
-     * @return empty string if not found, or file path
+     * @return empty string if not found or the file failed validation, or file path
      */
     QString access(const QString& fileTag);
 
@@ -46,12 +48,17 @@ class ComponentInformationCache : public QObject
 
     struct Meta {
         uint32_t magic{0x9a9cad0e};
-        uint32_t version{0};
+        uint32_t version{1};
         AccessCounterType accessCounter{0};
+        int64_t dataSize{0};
+        uint32_t dataCrc{0};
     };
 
     void initializeDirectory();
     void removeOldEntries();
+    void removeEntry(const QString& fileTag);
+
+    static bool fileCrc(const QString& fileName, int64_t& size, uint32_t& crc);
 
     QString metaFileName(const QString& fileTag);
     QString dataFileName(const QString& fileTag);
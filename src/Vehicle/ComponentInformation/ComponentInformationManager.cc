@@ -19,10 +19,7 @@ QGC_LOGGING_CATEGORY(ComponentInformationManagerLog, "Vehicle.ComponentInformati
 ComponentInformationManager::ComponentInformationManager(Vehicle *vehicle, QObject *parent)
     : StateMachine(parent)
     , _vehicle(vehicle)
-    , _requestTypeStateMachine(this, this)
-    , _cachedFileDownload(new QGCCachedFileDownload(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/QGCCompInfoFileDownloadCache"), this))
     , _fileCache(ComponentInformationCache::defaultInstance())
-    , _translation(new ComponentInformationTranslation(this, _cachedFileDownload))
 {
     // qCDebug(ComponentInformationManagerLog) << Q_FUNC_INFO << this;
 
@@ -30,6 +27,13 @@ ComponentInformationManager::ComponentInformationManager(Vehicle *vehicle, QObje
     _compInfoMap[MAV_COMP_ID_AUTOPILOT1][COMP_METADATA_TYPE_PARAMETER]  = new CompInfoParam     (MAV_COMP_ID_AUTOPILOT1, vehicle, this);
     _compInfoMap[MAV_COMP_ID_AUTOPILOT1][COMP_METADATA_TYPE_EVENTS]     = new CompInfoEvents    (MAV_COMP_ID_AUTOPILOT1, vehicle, this);
     _compInfoMap[MAV_COMP_ID_AUTOPILOT1][COMP_METADATA_TYPE_ACTUATORS]  = new CompInfoActuators (MAV_COMP_ID_AUTOPILOT1, vehicle, this);
+
+    // Each type downloads over http independently, the disk caches must not share a directory
+    const QString httpCacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/QGCCompInfoFileDownloadCache");
+    for (auto it = _compInfoMap[MAV_COMP_ID_AUTOPILOT1].cbegin(); it != _compInfoMap[MAV_COMP_ID_AUTOPILOT1].cend(); ++it) {
+        const QString typeCacheDir = (it.key() == COMP_METADATA_TYPE_GENERAL) ? httpCacheDir : QStringLiteral("%1_%2").arg(httpCacheDir).arg(it.key());
+        _requestTypeStateMachines[it.key()] = new RequestMetaDataTypeStateMachine(this, typeCacheDir, this);
+    }
 }
 
 ComponentInformationManager::~ComponentInformationManager()
@@ -52,7 +56,11 @@ float ComponentInformationManager::progress() const
     if (!_active)
         return 1.f;
     // here we could compute a more fine-grained progress, based on ftp download progress
-    return _stateIndex / (float)_cStates;
+    float typeProgress = 0.f;
+    if (_typeRequestCount > 0) {
+        typeProgress = _typeRequestCompleteCount / (float)_typeRequestCount;
+    }
+    return (_stateIndex + typeProgress) / (float)_cStates;
 }
 
 void ComponentInformationManager::advance()
@@ -72,7 +80,7 @@ void ComponentInformationManager::requestAllComponentInformation(RequestAllCompl
 void ComponentInformationManager::_stateRequestCompInfoGeneral(StateMachine* stateMachine)
 {
     ComponentInformationManager* compMgr = static_cast<ComponentInformationManager*>(stateMachine);
-    compMgr->_requestTypeStateMachine.request(compMgr->_compInfoMap[MAV_COMP_ID_AUTOPILOT1][COMP_METADATA_TYPE_GENERAL]);
+    compMgr->_requestTypeStateMachines[COMP_METADATA_TYPE_GENERAL]->request(compMgr->_compInfoMap[MAV_COMP_ID_AUTOPILOT1][COMP_METADATA_TYPE_GENERAL]);
 }
 
 void ComponentInformationManager::_stateRequestCompInfoGeneralComplete(StateMachine* stateMachine)
@@ -90,44 +98,77 @@ void ComponentInformationManager::_updateAllUri()
     }
 }
 
-void ComponentInformationManager::_stateRequestCompInfoComplete(void)
+void ComponentInformationManager::_stateRequestCompInfoComplete(CompInfo* compInfo)
 {
-    advance();
+    if (compInfo->type == COMP_METADATA_TYPE_GENERAL) {
+        advance();
+        return;
+    }
+
+    _typeRequestCompleteCount++;
+    qCDebug(ComponentInformationManagerLog) << "Request complete type:" << compInfo->type << _typeRequestCompleteCount << "of" << _typeRequestCount;
+    if (_typeRequestCompleteCount == _typeRequestCount) {
+        _typeRequestCount = 0;
+        _typeRequestCompleteCount = 0;
+        advance();
+    } else {
+        emit progressUpdate(progress());
+    }
 }
 
-void ComponentInformationManager::_stateRequestCompInfoParam(StateMachine* stateMachine)
+void ComponentInformationManager::_stateRequestCompInfoTypes(StateMachine* stateMachine)
 {
     ComponentInformationManager* compMgr = static_cast<ComponentInformationManager*>(stateMachine);
 
-    if (compMgr->_isCompTypeSupported(COMP_METADATA_TYPE_PARAMETER)) {
-        compMgr->_requestTypeStateMachine.request(compMgr->_compInfoMap[MAV_COMP_ID_AUTOPILOT1][COMP_METADATA_TYPE_PARAMETER]);
-    } else {
-        qCDebug(ComponentInformationManagerLog) << "_stateRequestCompInfoParam skipping, not supported";
+    QList<COMP_METADATA_TYPE> types;
+    for (const COMP_METADATA_TYPE type : _parallelTypes) {
+        if (compMgr->_isCompTypeSupported(type)) {
+            types.append(type);
+        } else {
+            qCDebug(ComponentInformationManagerLog) << "_stateRequestCompInfoTypes skipping, not supported" << type;
+        }
+    }
+
+    if (types.isEmpty()) {
         compMgr->advance();
+        return;
+    }
+
+    // Requests can complete synchronously (for example from the file cache), so the count must be set up front
+    compMgr->_typeRequestCount = types.count();
+    compMgr->_typeRequestCompleteCount = 0;
+    for (const COMP_METADATA_TYPE type : types) {
+        compMgr->_requestTypeStateMachines[type]->request(compMgr->_compInfoMap[MAV_COMP_ID_AUTOPILOT1][type]);
     }
 }
 
-void ComponentInformationManager::_stateRequestCompInfoEvents(StateMachine* stateMachine)
+void ComponentInformationManager::_queueFtpDownload(RequestMetaDataTypeStateMachine* requestMachine)
 {
-    ComponentInformationManager* compMgr = static_cast<ComponentInformationManager*>(stateMachine);
-
-    if (compMgr->_isCompTypeSupported(COMP_METADATA_TYPE_EVENTS)) {
-        compMgr->_requestTypeStateMachine.request(compMgr->_compInfoMap[MAV_COMP_ID_AUTOPILOT1][COMP_METADATA_TYPE_EVENTS]);
+    _ftpDownloadQueue.append(requestMachine);
+    if (!_activeFtpDownload) {
+        _startNextFtpDownload();
     } else {
-        qCDebug(ComponentInformationManagerLog) << "_stateRequestCompInfoEvents skipping, not supported";
-        compMgr->advance();
+        qCDebug(ComponentInformationManagerLog) << "FTP busy, queued download for" << requestMachine->typeToString();
     }
 }
 
-void ComponentInformationManager::_stateRequestCompInfoActuators(StateMachine* stateMachine)
+void ComponentInformationManager::_ftpDownloadComplete(RequestMetaDataTypeStateMachine* requestMachine)
 {
-    ComponentInformationManager* compMgr = static_cast<ComponentInformationManager*>(stateMachine);
+    if (_activeFtpDownload == requestMachine) {
+        _activeFtpDownload = nullptr;
+        _startNextFtpDownload();
+    }
+}
 
-    if (compMgr->_isCompTypeSupported(COMP_METADATA_TYPE_ACTUATORS)) {
-        compMgr->_requestTypeStateMachine.request(compMgr->_compInfoMap[MAV_COMP_ID_AUTOPILOT1][COMP_METADATA_TYPE_ACTUATORS]);
-    } else {
-        qCDebug(ComponentInformationManagerLog) << "_stateRequestCompInfoActuators skipping, not supported";
-        compMgr->advance();
+void ComponentInformationManager::_startNextFtpDownload(void)
+{
+    while (!_activeFtpDownload && !_ftpDownloadQueue.isEmpty()) {
+        RequestMetaDataTypeStateMachine* requestMachine = _ftpDownloadQueue.takeFirst();
+        _activeFtpDownload = requestMachine;
+        if (!requestMachine->_startFtpDownload()) {
+            _activeFtpDownload = nullptr;
+            requestMachine->advance();
+        }
     }
 }
 
@@ -164,9 +205,11 @@ QString ComponentInformationManager::_getFileCacheTag(int compInfoType, uint32_t
 }
 
 
-RequestMetaDataTypeStateMachine::RequestMetaDataTypeStateMachine(ComponentInformationManager *compMgr, QObject *parent)
+RequestMetaDataTypeStateMachine::RequestMetaDataTypeStateMachine(ComponentInformationManager *compMgr, const QString &httpCacheDirectory, QObject *parent)
     : StateMachine(parent)
     , _compMgr(compMgr)
+    , _cachedFileDownload(new QGCCachedFileDownload(httpCacheDirectory, this))
+    , _translation(new ComponentInformationTranslation(this, _cachedFileDownload))
 {
     // qCDebug(RequestMetaDataTypeStateMachineLog) << Q_FUNC_INFO << this;
 }
@@ -198,7 +241,7 @@ const RequestMetaDataTypeStateMachine::StateFn* RequestMetaDataTypeStateMachine:
 
 void RequestMetaDataTypeStateMachine::statesCompleted(void) const
 {
-    _compMgr->_stateRequestCompInfoComplete();
+    _compMgr->_stateRequestCompInfoComplete(_compInfo);
 }
 
 QString RequestMetaDataTypeStateMachine::typeToString(void)
@@ -348,6 +391,9 @@ void RequestMetaDataTypeStateMachine::_ftpDownloadComplete(const QString& fileNa
         qCWarning(ComponentInformationManagerLog) << "RequestMetaDataTypeStateMachine::_ftpDownloadComplete failed filename:errorMsg" << fileName << errorMsg;
     }
 
+    // The downloaded file has been dealt with, let the next queued request use FTP
+    _compMgr->_ftpDownloadComplete(this);
+
     advance();
 }
 
@@ -381,10 +427,27 @@ void RequestMetaDataTypeStateMachine::_httpDownloadComplete(QString remoteFile,
     advance();
 }
 
+bool RequestMetaDataTypeStateMachine::_startFtpDownload(void)
+{
+    FTPManager* ftpManager = _compInfo->vehicle->ftpManager();
+
+    qCDebug(ComponentInformationManagerLog) << "Downloading json" << _currentUri;
+    connect(ftpManager, &FTPManager::downloadComplete, this, &RequestMetaDataTypeStateMachine::_ftpDownloadComplete);
+    if (ftpManager->download(MAV_COMP_ID_AUTOPILOT1, _currentUri, QStandardPaths::writableLocation(QStandardPaths::TempLocation))) {
+        _downloadStartTime.start();
+        connect(ftpManager, &FTPManager::commandProgress, this, &RequestMetaDataTypeStateMachine::_ftpDownloadProgress);
+        return true;
+    }
+
+    qCWarning(ComponentInformationManagerLog) << "RequestMetaDataTypeStateMachine::_startFtpDownload FTPManager::download returned failure";
+    disconnect(ftpManager, &FTPManager::downloadComplete, this, &RequestMetaDataTypeStateMachine::_ftpDownloadComplete);
+    return false;
+}
+
 void RequestMetaDataTypeStateMachine::_requestFile(const QString& cacheFileTag, bool crcValid, const QString& uri, QString& outputFileName)
 {
-    FTPManager*                         ftpManager      = _compInfo->vehicle->ftpManager();
     _currentCacheFileTag = cacheFileTag;
+    _currentUri = uri;
     _currentFileName = &outputFileName;
     _currentFileValidCrc = crcValid;
     outputFileName.clear();
@@ -393,25 +456,18 @@ void RequestMetaDataTypeStateMachine::_requestFile(const QString& cacheFileTag,
         const QString cachedFile = crcValid ? _compMgr->fileCache().access(cacheFileTag) : "";
 
         if (cachedFile.isEmpty()) {
-            qCDebug(ComponentInformationManagerLog) << "Downloading json" << uri;
             if (_uriIsMAVLinkFTP(uri)) {
-                connect(ftpManager, &FTPManager::downloadComplete, this, &RequestMetaDataTypeStateMachine::_ftpDownloadComplete);
-                if (ftpManager->download(MAV_COMP_ID_AUTOPILOT1, uri, QStandardPaths::writableLocation(QStandardPaths::TempLocation))) {
-                    _downloadStartTime.start();
-                    connect(ftpManager, &FTPManager::commandProgress, this, &RequestMetaDataTypeStateMachine::_ftpDownloadProgress);
-                } else {
-                    qCWarning(ComponentInformationManagerLog) << "RequestMetaDataTypeStateMachine::_requestFile FTPManager::download returned failure";
-                    disconnect(ftpManager, &FTPManager::downloadComplete, this, &RequestMetaDataTypeStateMachine::_ftpDownloadComplete);
-                    advance();
-                }
+                // FTP downloads are serialized by the manager
+                _compMgr->_queueFtpDownload(this);
             } else {
-                connect(_compMgr->_cachedFileDownload, &QGCCachedFileDownload::downloadComplete, this,
+                qCDebug(ComponentInformationManagerLog) << "Downloading json" << uri;
+                connect(_cachedFileDownload, &QGCCachedFileDownload::downloadComplete, this,
                         &RequestMetaDataTypeStateMachine::_httpDownloadComplete);
-                if (_compMgr->_cachedFileDownload->download(uri, crcValid ? 0 : ComponentInformationManager::cachedFileMaxAgeSec)) {
+                if (_cachedFileDownload->download(uri, crcValid ? 0 : ComponentInformationManager::cachedFileMaxAgeSec)) {
                     _downloadStartTime.start();
                 } else {
                     qCWarning(ComponentInformationManagerLog) << "RequestMetaDataTypeStateMachine::_requestFile QGCCachedFileDownload::download returned failure";
-                    disconnect(_compMgr->_cachedFileDownload, &QGCCachedFileDownload::downloadComplete, this,
+                    disconnect(_cachedFileDownload, &QGCCachedFileDownload::downloadComplete, this,
                                &RequestMetaDataTypeStateMachine::_httpDownloadComplete);
                     advance();
                 }
@@ -471,12 +527,12 @@ void RequestMetaDataTypeStateMachine::_stateRequestTranslate(StateMachine* state
     if (requestMachine->_jsonTranslationFileName.isEmpty()) {
         requestMachine->advance();
     } else {
-        connect(requestMachine->_compMgr->translation(), &ComponentInformationTranslation::downloadComplete,
+        connect(requestMachine->_translation, &ComponentInformationTranslation::downloadComplete,
                 requestMachine, &RequestMetaDataTypeStateMachine::_downloadAndTranslationComplete);
-        if (!requestMachine->_compMgr->translation()->downloadAndTranslate(requestMachine->_jsonTranslationFileName,
+        if (!requestMachine->_translation->downloadAndTranslate(requestMachine->_jsonTranslationFileName,
                                                                            requestMachine->_jsonMetadataFileName,
                                                                            ComponentInformationManager::cachedFileMaxAgeSec)) {
-            disconnect(requestMachine->_compMgr->translation(), &ComponentInformationTranslation::downloadComplete,
+            disconnect(requestMachine->_translation, &ComponentInformationTranslation::downloadComplete,
                        requestMachine, &RequestMetaDataTypeStateMachine::_downloadAndTranslationComplete);
             qCDebug(ComponentInformationManagerLog) << "downloadAndTranslate() failed";
             requestMachine->advance();
@@ -486,7 +542,7 @@ void RequestMetaDataTypeStateMachine::_stateRequestTranslate(StateMachine* state
 
 void RequestMetaDataTypeStateMachine::_downloadAndTranslationComplete(QString translatedJsonTempFile, QString errorMsg)
 {
-    disconnect(_compMgr->translation(), &ComponentInformationTranslation::downloadComplete,
+    disconnect(_translation, &ComponentInformationTranslation::downloadComplete,
                this, &RequestMetaDataTypeStateMachine::_downloadAndTranslationComplete);
     _jsonMetadataTranslatedFileName = translatedJsonTempFile;
     if (!errorMsg.isEmpty()) {
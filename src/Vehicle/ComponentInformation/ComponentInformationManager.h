@@ -23,7 +23,7 @@ class RequestMetaDataTypeStateMachine : public StateMachine
     Q_OBJECT
 
 public:
-    RequestMetaDataTypeStateMachine(ComponentInformationManager *compMgr, QObject *parent = nullptr);
+    RequestMetaDataTypeStateMachine(ComponentInformationManager *compMgr, const QString &httpCacheDirectory, QObject *parent = nullptr);
     ~RequestMetaDataTypeStateMachine();
 
     void        request     (CompInfo* compInfo);
@@ -53,8 +53,11 @@ private slots:
     static bool _uriIsMAVLinkFTP                (const QString& uri);
 
     void _requestFile(const QString& cacheFileTag, bool crcValid, const QString& uri, QString& outputFileName);
+    bool _startFtpDownload(void);
 
     ComponentInformationManager*    _compMgr                    = nullptr;
+    QGCCachedFileDownload*          _cachedFileDownload         = nullptr;  ///< Each request has its own so http downloads can run in parallel
+    ComponentInformationTranslation* _translation               = nullptr;
     CompInfo*                       _compInfo                   = nullptr;
     QString                         _jsonMetadataFileName;
     QString                         _jsonMetadataTranslatedFileName;
@@ -64,6 +67,7 @@ private slots:
 
     QString*                        _currentFileName            = nullptr;
     QString                         _currentCacheFileTag;
+    QString                         _currentUri;
     bool                            _currentFileValidCrc        = false;
 
     QElapsedTimer                   _downloadStartTime;
@@ -79,8 +83,13 @@ private slots:
     };
 
     static constexpr int _cStates = sizeof(_rgStates) / sizeof(_rgStates[0]);
+
+    friend class ComponentInformationManager;
 };
 
+/// Requests the component information for the autopilot. The general metadata is requested first since it provides
+/// the uris for all other types. The remaining types are then requested in parallel. Http downloads run concurrently
+/// while MAVLink FTP downloads are queued, since FTPManager can only handle a single operation at a time.
 class ComponentInformationManager : public StateMachine
 {
     Q_OBJECT
@@ -101,7 +110,6 @@ class ComponentInformationManager : public StateMachine
     const StateFn *rgStates() const final;
 
     ComponentInformationCache &fileCache() { return _fileCache; }
-    ComponentInformationTranslation *translation() { return _translation; }
 
     float progress() const;
 
@@ -113,35 +121,43 @@ class ComponentInformationManager : public StateMachine
     void progressUpdate(float progress);
 
 private:
-    void _stateRequestCompInfoComplete  (void);
+    void _stateRequestCompInfoComplete  (CompInfo* compInfo);
     bool _isCompTypeSupported           (COMP_METADATA_TYPE type);
     void _updateAllUri                  ();
+    void _queueFtpDownload              (RequestMetaDataTypeStateMachine* requestMachine);
+    void _ftpDownloadComplete           (RequestMetaDataTypeStateMachine* requestMachine);
+    void _startNextFtpDownload          (void);
 
     static QString _getFileCacheTag(int compInfoType, uint32_t crc, bool isTranslation);
 
     static void _stateRequestCompInfoGeneral        (StateMachine* stateMachine);
     static void _stateRequestCompInfoGeneralComplete(StateMachine* stateMachine);
-    static void _stateRequestCompInfoParam          (StateMachine* stateMachine);
-    static void _stateRequestCompInfoEvents         (StateMachine* stateMachine);
-    static void _stateRequestCompInfoActuators      (StateMachine* stateMachine);
+    static void _stateRequestCompInfoTypes          (StateMachine* stateMachine);
     static void _stateRequestAllCompInfoComplete    (StateMachine* stateMachine);
 
     Vehicle*                        _vehicle                    = nullptr;
-    RequestMetaDataTypeStateMachine _requestTypeStateMachine;
     RequestAllCompleteFn            _requestAllCompleteFn       = nullptr;
     void*                           _requestAllCompleteFnData   = nullptr;
-    QGCCachedFileDownload*          _cachedFileDownload         = nullptr;
     ComponentInformationCache&      _fileCache;
-    ComponentInformationTranslation* _translation               = nullptr;
 
     QMap<uint8_t /* compId */, QMap<COMP_METADATA_TYPE, CompInfo*>> _compInfoMap;
+    QMap<COMP_METADATA_TYPE, RequestMetaDataTypeStateMachine*>      _requestTypeStateMachines;
+
+    int                                         _typeRequestCount           = 0;    ///< Number of types requested in parallel
+    int                                         _typeRequestCompleteCount   = 0;
+    QList<RequestMetaDataTypeStateMachine*>     _ftpDownloadQueue;                  ///< Requests waiting for FTPManager
+    RequestMetaDataTypeStateMachine*            _activeFtpDownload          = nullptr;
+
+    static constexpr COMP_METADATA_TYPE _parallelTypes[] = {
+        COMP_METADATA_TYPE_PARAMETER,
+        COMP_METADATA_TYPE_EVENTS,
+        COMP_METADATA_TYPE_ACTUATORS,
+    };
 
     static constexpr const StateFn _rgStates[]= {
         _stateRequestCompInfoGeneral,
         _stateRequestCompInfoGeneralComplete,
-        _stateRequestCompInfoParam,
-        _stateRequestCompInfoEvents,
-        _stateRequestCompInfoActuators,
+        _stateRequestCompInfoTypes,
         _stateRequestAllCompInfoComplete
     };
 
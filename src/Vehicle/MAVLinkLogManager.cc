@@ -10,9 +10,12 @@
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QSettings>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
 #include <QtNetwork/QNetworkReply>
 
 #include "QGCNetworkHelper.h"
+#include "QGCResumableUploader.h"
 
 QGC_LOGGING_CATEGORY(MAVLinkLogManagerLog, "Vehicle.MAVLinkLogManager")
 
@@ -49,6 +52,22 @@ void MAVLinkLogFiles::setSize(quint32 size)
     }
 }
 
+void MAVLinkLogFiles::setDrops(int drops)
+{
+    if (drops != _drops) {
+        _drops = drops;
+        emit dropsChanged();
+    }
+}
+
+void MAVLinkLogFiles::setWriteRate(qreal bytesPerSecond)
+{
+    if (bytesPerSecond != _writeRate) {
+        _writeRate = bytesPerSecond;
+        emit writeRateChanged();
+    }
+}
+
 void MAVLinkLogFiles::setSelected(bool selected)
 {
     if (selected != _selected) {
@@ -91,8 +110,14 @@ void MAVLinkLogFiles::setUploaded(bool uploaded)
 
 /*===========================================================================*/
 
-MAVLinkLogProcessor::MAVLinkLogProcessor()
+MAVLinkLogProcessor::MAVLinkLogProcessor(QObject *parent)
+    : QObject(parent)
+    , _file(new QFile(this))
+    , _flushTimer(new QTimer(this))
 {
+    // Child of the processor, so it moves to the worker thread along with it
+    _flushTimer->setInterval(kFlushIntervalMs);
+    (void) connect(_flushTimer, &QTimer::timeout, this, &MAVLinkLogProcessor::_flush);
     // qCDebug(MAVLinkLogManagerLog) << Q_FUNC_INFO << this;
 }
 
@@ -103,32 +128,49 @@ MAVLinkLogProcessor::~MAVLinkLogProcessor()
     // qCDebug(MAVLinkLogManagerLog) << Q_FUNC_INFO << this;
 }
 
+bool MAVLinkLogProcessor::isOpen() const
+{
+    return _file->isOpen();
+}
+
 void MAVLinkLogProcessor::close()
 {
-    if (_file.isOpen()) {
-        _file.close();
+    if (!_file->isOpen()) {
+        return;
     }
+
+    _flushTimer->stop();
+    _flush();
+    _file->close();
+
+    qCDebug(MAVLinkLogManagerLog) << "Closed" << _fileName << "bytes:" << _written << "drops:" << _numDrops
+                                  << "bytes/sec:" << (_written * 1000.0 / qMax<qint64>(_openTimer.elapsed(), 1));
+    emit closed(_fileName, !_error);
 }
 
-bool MAVLinkLogProcessor::create(MAVLinkLogManager *manager, QStringView path, uint8_t id)
+bool MAVLinkLogProcessor::create(const QString &fileName)
 {
-    _fileName = _fileName.asprintf(
-        "%s/%03d-%s%s",
-        path.toLatin1().constData(),
-        id,
-        QDateTime::currentDateTime().toString("yyyy-MM-dd-hh-mm-ss-zzz").toLocal8Bit().constData(),
-        manager->logExtension().toLocal8Bit().constData()
-    );
+    close();
 
-    _file.setFileName(_fileName);
-    if (!_file.open(QIODevice::WriteOnly)) {
-        qCWarning(MAVLinkLogManagerLog) << "Failed to open file for writing:" << _file.errorString();
+    _fileName = fileName;
+    _file->setFileName(_fileName);
+    if (!_file->open(QIODevice::WriteOnly)) {
+        qCWarning(MAVLinkLogManagerLog) << "Failed to open file for writing:" << _file->errorString();
         return false;
     }
 
-    _record = new MAVLinkLogFiles(manager, _fileName, true);
-    _record->setWriting(true);
+    _error = false;
+    _gotHeader = false;
+    _numDrops = 0;
     _sequence = -1;
+    _ulogMessage.clear();
+    _buffer.clear();
+    _buffer.reserve(kWriteBufferSize);
+    _written = 0;
+    _openTimer.start();
+    _lastFlushMs = 0;
+    // Keeps what is on disk current when the stream stalls or is too slow to fill the buffer
+    _flushTimer->start();
 
     return true;
 }
@@ -175,16 +217,46 @@ void MAVLinkLogProcessor::_writeData(const void *data, int len)
         return;
     }
 
-    const qint64 bytesWritten = _file.write(reinterpret_cast<const char*>(data), len);
-    if (bytesWritten != len) {
-        _error = true;
-        qCDebug(MAVLinkLogManagerLog) << "File IO error:" << len << "bytes into" << _fileName;
+    (void) _buffer.append(reinterpret_cast<const char*>(data), len);
+    if (_buffer.size() >= kWriteBufferSize) {
+        _flush();
+    }
+}
+
+void MAVLinkLogProcessor::_flush()
+{
+    _lastFlushMs = _openTimer.elapsed();
+
+    if (_error) {
         return;
     }
 
-    _written += len;
-    if (_record) {
-        _record->setSize(_written);
+    if (!_buffer.isEmpty()) {
+        const qint64 bytesWritten = _file->write(_buffer);
+        if (bytesWritten != _buffer.size()) {
+            qCDebug(MAVLinkLogManagerLog) << "File IO error:" << _buffer.size() << "bytes into" << _fileName;
+            _setError(_file->errorString());
+            return;
+        }
+
+        // QFile keeps small writes in its own buffer
+        if (!_file->flush()) {
+            _setError(_file->errorString());
+            return;
+        }
+
+        _written += _buffer.size();
+        _buffer.clear();
+    }
+
+    emit statsChanged(_fileName, _written, _numDrops, _written * 1000.0 / qMax<qint64>(_lastFlushMs, 1));
+}
+
+void MAVLinkLogProcessor::_setError(const QString &errorString)
+{
+    if (!_error) {
+        _error = true;
+        emit errorOccurred(_fileName, errorString);
     }
 }
 
@@ -206,17 +278,21 @@ QByteArray MAVLinkLogProcessor::_writeUlogMessage(QByteArray &data)
     return data;
 }
 
-bool MAVLinkLogProcessor::processStreamData(uint16_t sequence, uint8_t first_message, const QByteArray &in)
+void MAVLinkLogProcessor::processStreamData(uint16_t sequence, uint8_t first_message, const QByteArray &in)
 {
+    if (!_file->isOpen() || _error) {
+        return;
+    }
+
     int num_drops = 0;
-    _error = false;
 
     QByteArray data(in);
     while (_checkSequence(sequence, num_drops)) {
         if (!_gotHeader) {
             if (data.size() < 16) {
                 qCWarning(MAVLinkLogManagerLog) << "Corrupt log header. Canceling log download.";
-                return false;
+                _setError(QStringLiteral("Corrupt log header"));
+                return;
             }
 
             _writeData(data.constData(), 16);
@@ -272,7 +348,9 @@ bool MAVLinkLogProcessor::processStreamData(uint16_t sequence, uint8_t first_mes
         break;
     }
 
-    return !_error;
+    if (num_drops > 0) {
+        qCDebug(MAVLinkLogManagerLog) << "Dropped" << num_drops << "LOGGING_DATA messages before sequence" << sequence << "total:" << _numDrops;
+    }
 }
 
 /*===========================================================================*/
@@ -284,11 +362,15 @@ MAVLinkLogManager::MAVLinkLogManager(Vehicle *vehicle, QObject *parent)
     , _logFiles(new QmlObjectListModel(this))
     , _ulogExtension(QStringLiteral(".") + SettingsManager::instance()->appSettings()->logFileExtension)
     , _logPath(SettingsManager::instance()->appSettings()->logSavePath())
+    , _resumableUploader(new QGCResumableUploader(this))
 {
     qCDebug(MAVLinkLogManagerLog) << this;
 
     QGCNetworkHelper::configureProxy(_networkManager);
 
+    (void) connect(_resumableUploader, &QGCResumableUploader::progress, this, &MAVLinkLogManager::_resumableUploadProgress);
+    (void) connect(_resumableUploader, &QGCResumableUploader::finished, this, &MAVLinkLogManager::_resumableUploadFinished);
+
     QSettings settings;
     settings.beginGroup(kMAVLinkLogGroup);
 
@@ -302,6 +384,8 @@ MAVLinkLogManager::MAVLinkLogManager(Vehicle *vehicle, QObject *parent)
     setWindSpeed(settings.value(kWindSpeedKey, -1).toInt());
     setRating(settings.value(kRateKey, "notset").toString());
     setPublicLog(settings.value(kPublicLogKey, true).toBool());
+    setResumableUpload(settings.value(kResumableUploadKey, false).toBool());
+    setUploadRateLimit(settings.value(kUploadRateLimitKey, 0).toInt());
 
     settings.endGroup();
 
@@ -330,6 +414,18 @@ MAVLinkLogManager::MAVLinkLogManager(Vehicle *vehicle, QObject *parent)
 
 MAVLinkLogManager::~MAVLinkLogManager()
 {
+    if (_logThread) {
+        if (_logRecord) {
+            MAVLinkLogProcessor *const processor = _logProcessor;
+            (void) QMetaObject::invokeMethod(processor, [processor]() { processor->close(); }, Qt::BlockingQueuedConnection);
+        }
+
+        _logThread->quit();
+        if (!_logThread->wait()) {
+            qCWarning(MAVLinkLogManagerLog) << "Failed to wait for MAVLink log thread to close";
+        }
+    }
+
     _logFiles->clearAndDeleteContents();
 
     qCDebug(MAVLinkLogManagerLog) << this;
@@ -454,8 +550,42 @@ void MAVLinkLogManager::setPublicLog(bool pub)
     }
 }
 
+void MAVLinkLogManager::setResumableUpload(bool enable)
+{
+    if (enable != _resumableUpload) {
+        _resumableUpload = enable;
+        QSettings settings;
+        settings.beginGroup(kMAVLinkLogGroup);
+        settings.setValue(kResumableUploadKey, enable);
+        emit resumableUploadChanged();
+    }
+}
+
+void MAVLinkLogManager::setUploadRateLimit(int kilobytesPerSecond)
+{
+    kilobytesPerSecond = qMax(kilobytesPerSecond, 0);
+    if (kilobytesPerSecond != _uploadRateLimit) {
+        _uploadRateLimit = kilobytesPerSecond;
+        _resumableUploader->setMaxBytesPerSecond(static_cast<qint64>(kilobytesPerSecond) * 1024);
+        QSettings settings;
+        settings.beginGroup(kMAVLinkLogGroup);
+        settings.setValue(kUploadRateLimitKey, kilobytesPerSecond);
+        emit uploadRateLimitChanged();
+    }
+}
+
+bool MAVLinkLogManager::uploading() const
+{
+    return (_currentLogfile != nullptr) || _resumableUploader->isBusy();
+}
+
 void MAVLinkLogManager::uploadLog()
 {
+    if (_resumableUpload) {
+        _queueResumableUploads();
+        return;
+    }
+
     if (_currentLogfile) {
         _currentLogfile->setUploading(false);
     }
@@ -489,6 +619,50 @@ void MAVLinkLogManager::uploadLog()
     emit uploadingChanged();
 }
 
+void MAVLinkLogManager::_queueResumableUploads()
+{
+    _resumableUploader->setEndpoint(QUrl::fromUserInput(_uploadURL));
+
+    // Same fields as the multipart upload, sent as metadata when the upload is created
+    QMap<QString, QString> metadata;
+    metadata[QStringLiteral("email")] = _emailAddress;
+    metadata[QStringLiteral("description")] = _description.isEmpty() ? QString(kDefaultDescr) : _description;
+    metadata[QStringLiteral("source")] = QStringLiteral("QGroundControl");
+    metadata[QStringLiteral("version")] = QCoreApplication::applicationVersion();
+    metadata[QStringLiteral("type")] = QStringLiteral("flightreport");
+    metadata[QStringLiteral("windSpeed")] = QString::number(_windSpeed);
+    metadata[QStringLiteral("rating")] = _rating;
+    metadata[QStringLiteral("public")] = _publicLog ? QStringLiteral("true") : QStringLiteral("false");
+    metadata[QString(kFeedback)] = _feedback.isEmpty() ? QStringLiteral("None Given") : _feedback;
+    metadata[QString(kVideoURL)] = _videoURL.isEmpty() ? QStringLiteral("None") : _videoURL;
+
+    for (int i = 0; i < _logFiles->count(); i++) {
+        MAVLinkLogFiles *const log = qobject_cast<MAVLinkLogFiles*>(_logFiles->get(i));
+        if (!log) {
+            qCWarning(MAVLinkLogManagerLog) << "Internal error";
+            continue;
+        }
+
+        if (!log->selected()) {
+            continue;
+        }
+
+        log->setSelected(false);
+        if (log->uploaded() || log->uploading() || _emailAddress.isEmpty() || _uploadURL.isEmpty()) {
+            continue;
+        }
+
+        const QString filePath = _makeFilename(log->name());
+        metadata[QStringLiteral("filename")] = QFileInfo(filePath).fileName();
+        if (_resumableUploader->upload(filePath, metadata)) {
+            log->setUploading(true);
+            log->setProgress(0.0);
+        }
+    }
+
+    emit uploadingChanged();
+}
+
 void MAVLinkLogManager::_insertNewLog(MAVLinkLogFiles *newLog)
 {
     const int count = _logFiles->count();
@@ -541,6 +715,9 @@ void MAVLinkLogManager::deleteLog()
 void MAVLinkLogManager::_deleteLog(MAVLinkLogFiles *log)
 {
     QString filePath = _makeFilename(log->name());
+    _resumableUploader->cancel(filePath);
+    QGCResumableUploader::removeJournal(filePath);
+
     QFile gone(filePath);
     if (!gone.remove()) {
         qCWarning(MAVLinkLogManagerLog) << "Could not delete MAVLink log file:" << _logPath;
@@ -575,6 +752,8 @@ void MAVLinkLogManager::cancelUpload()
     if (_currentLogfile) {
         emit abortUpload();
     }
+
+    _resumableUploader->cancelAll();
 }
 
 void MAVLinkLogManager::startLogging()
@@ -603,23 +782,12 @@ void MAVLinkLogManager::stopLogging()
         _vehicle->stopMavlinkLog();
     }
 
-    if (!_logProcessor) {
+    if (!_logRecord) {
         return;
     }
 
-    _logProcessor->close();
-    if (_logProcessor->record()) {
-        _logProcessor->record()->setWriting(false);
-        if (_enableAutoUpload) {
-            _logProcessor->record()->setSelected(true);
-            if (!uploading()) {
-                uploadLog();
-            }
-        }
-    }
-
-    delete _logProcessor;
-    _logProcessor = nullptr;
+    // The record is finished and uploaded from _logClosed once buffered data has been written out
+    _closeLog();
     _logRunning = false;
     emit logRunningChanged();
 }
@@ -762,14 +930,7 @@ void MAVLinkLogManager::_uploadFinished()
                 _currentLogfile = nullptr;
             }
         } else if (_currentLogfile) {
-            _currentLogfile->setUploaded(true);
-            QString sideCar = _makeFilename(_currentLogfile->name());
-            (void) sideCar.replace(_ulogExtension, kSidecarExtension);
-
-            QFile file(sideCar.toLatin1().constData());
-            if (file.open(QIODevice::WriteOnly)) {
-                file.close();
-            }
+            _markUploaded(_currentLogfile);
         }
     } else {
         qCWarning(MAVLinkLogManagerLog) << QString("Log Upload Error: %1 status: %2").arg(reply->errorString(), reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toString());
@@ -780,6 +941,52 @@ void MAVLinkLogManager::_uploadFinished()
     uploadLog();
 }
 
+void MAVLinkLogManager::_markUploaded(MAVLinkLogFiles *log)
+{
+    log->setUploaded(true);
+    QString sideCar = _makeFilename(log->name());
+    (void) sideCar.replace(_ulogExtension, kSidecarExtension);
+
+    QFile file(sideCar.toLatin1().constData());
+    if (file.open(QIODevice::WriteOnly)) {
+        file.close();
+    }
+}
+
+void MAVLinkLogManager::_resumableUploadProgress(const QString &fileName, qint64 bytesSent, qint64 bytesTotal)
+{
+    MAVLinkLogFiles *const log = _findLog(fileName);
+    if (log && bytesTotal) {
+        log->setProgress(static_cast<qreal>(bytesSent) / static_cast<qreal>(bytesTotal));
+    }
+}
+
+void MAVLinkLogManager::_resumableUploadFinished(const QString &fileName, bool success, const QString &errorString)
+{
+    MAVLinkLogFiles *const log = _findLog(fileName);
+    if (log) {
+        log->setUploading(false);
+    }
+
+    if (success) {
+        qCDebug(MAVLinkLogManagerLog) << "Log uploaded:" << fileName;
+        emit succeed();
+        if (log) {
+            if (_deleteAfterUpload) {
+                _deleteLog(log);
+            } else {
+                _markUploaded(log);
+            }
+        }
+    } else {
+        // The upload journal is kept, uploading the log again continues where this attempt stopped
+        qCWarning(MAVLinkLogManagerLog) << "Log Upload Error:" << fileName << errorString;
+        emit failed();
+    }
+
+    emit uploadingChanged();
+}
+
 void MAVLinkLogManager::_uploadProgress(qint64 bytesSent, qint64 bytesTotal)
 {
     if (bytesTotal) {
@@ -794,23 +1001,61 @@ void MAVLinkLogManager::_uploadProgress(qint64 bytesSent, qint64 bytesTotal)
 
 void MAVLinkLogManager::_mavlinkLogData(Vehicle* /*vehicle*/, uint8_t /*target_system*/, uint8_t /*target_component*/, uint16_t sequence, uint8_t first_message, const QByteArray &data, bool /*acked*/)
 {
-    if (!_logProcessor || !_logProcessor->valid()) {
+    if (!_logRecord) {
         qCDebug(MAVLinkLogManagerLog) << "MAVLink log data received when not expected.";
         return;
     }
 
-    if (_logProcessor->processStreamData(sequence, first_message, data)) {
+    MAVLinkLogProcessor *const processor = _logProcessor;
+    (void) QMetaObject::invokeMethod(processor, [processor, sequence, first_message, data]() {
+        processor->processStreamData(sequence, first_message, data);
+    }, Qt::QueuedConnection);
+}
+
+void MAVLinkLogManager::_logStats(const QString &fileName, quint64 written, int numDrops, double bytesPerSecond)
+{
+    MAVLinkLogFiles *const log = _findLog(fileName);
+    if (!log) {
+        return;
+    }
+
+    log->setSize(static_cast<quint32>(written));
+    log->setDrops(numDrops);
+    log->setWriteRate(bytesPerSecond);
+}
+
+void MAVLinkLogManager::_logWriteError(const QString &fileName, const QString &errorString)
+{
+    qCWarning(MAVLinkLogManagerLog) << "Error writing MAVLink log file:" << fileName << errorString;
+
+    if (!_logRecord || (_findLog(fileName) != _logRecord)) {
         return;
     }
 
-    qCWarning(MAVLinkLogManagerLog) << "Error writing MAVLink log file:" << _logProcessor->fileName();
-    delete _logProcessor;
-    _logProcessor = nullptr;
+    _closeLog();
     _logRunning = false;
     _vehicle->stopMavlinkLog();
     emit logRunningChanged();
 }
 
+void MAVLinkLogManager::_logClosed(const QString &fileName, bool success)
+{
+    MAVLinkLogFiles *const log = _findLog(fileName);
+    if (!log) {
+        // Discarded
+        return;
+    }
+
+    log->setWriting(false);
+    if (success && _enableAutoUpload) {
+        log->setSelected(true);
+        // Resumable uploads are queued, multipart uploads pick up selected logs once the current one completes
+        if (_resumableUpload || !uploading()) {
+            uploadLog();
+        }
+    }
+}
+
 void MAVLinkLogManager::_mavCommandResult(int vehicleId, int component, int command, int result, int failureCode)
 {
     Q_UNUSED(vehicleId); Q_UNUSED(component); Q_UNUSED(failureCode)
@@ -840,13 +1085,12 @@ void MAVLinkLogManager::_mavCommandResult(int vehicleId, int component, int comm
 
 void MAVLinkLogManager::_discardLog()
 {
-    if (_logProcessor) {
-        _logProcessor->close();
-        if (_logProcessor->record()) {
-            _deleteLog(_logProcessor->record());
-        }
-        delete _logProcessor;
-        _logProcessor = nullptr;
+    if (_logRecord) {
+        // Wait for the file to be closed before deleting it
+        MAVLinkLogProcessor *const processor = _logProcessor;
+        (void) QMetaObject::invokeMethod(processor, [processor]() { processor->close(); }, Qt::BlockingQueuedConnection);
+        _deleteLog(_logRecord);
+        _logRecord = nullptr;
     }
 
     _logRunning = false;
@@ -855,19 +1099,63 @@ void MAVLinkLogManager::_discardLog()
 
 bool MAVLinkLogManager::_createNewLog()
 {
-    delete _logProcessor;
-    _logProcessor = new MAVLinkLogProcessor();
+    if (_logRecord) {
+        _closeLog();
+    }
 
-    if (_logProcessor->create(this, _logPath, static_cast<uint8_t>(_vehicle->id()))) {
-        _insertNewLog(_logProcessor->record());
-        emit logFilesChanged();
-    } else {
-        qCWarning(MAVLinkLogManagerLog) << "Could not create MAVLink log file:" << _logProcessor->fileName();
-        delete _logProcessor;
-        _logProcessor = nullptr;
+    if (!_logThread) {
+        _logProcessor = new MAVLinkLogProcessor();
+        _logThread = new QThread(this);
+        _logThread->setObjectName(QStringLiteral("MAVLinkLog_%1").arg(_vehicle->id()));
+
+        _logProcessor->moveToThread(_logThread);
+
+        (void) connect(_logThread, &QThread::finished, _logProcessor, &QObject::deleteLater);
+
+        (void) connect(_logProcessor, &MAVLinkLogProcessor::statsChanged, this, &MAVLinkLogManager::_logStats, Qt::QueuedConnection);
+        (void) connect(_logProcessor, &MAVLinkLogProcessor::errorOccurred, this, &MAVLinkLogManager::_logWriteError, Qt::QueuedConnection);
+        (void) connect(_logProcessor, &MAVLinkLogProcessor::closed, this, &MAVLinkLogManager::_logClosed, Qt::QueuedConnection);
+
+        _logThread->start();
+    }
+
+    const QString baseName = QStringLiteral("%1-%2").arg(_vehicle->id(), 3, 10, QLatin1Char('0')).arg(QDateTime::currentDateTime().toString("yyyy-MM-dd-hh-mm-ss-zzz"));
+    const QString fileName = _makeFilename(baseName);
+
+    bool created = false;
+    MAVLinkLogProcessor *const processor = _logProcessor;
+    (void) QMetaObject::invokeMethod(processor, [processor, fileName]() { return processor->create(fileName); }, Qt::BlockingQueuedConnection, &created);
+    if (!created) {
+        qCWarning(MAVLinkLogManagerLog) << "Could not create MAVLink log file:" << fileName;
+        return false;
+    }
+
+    _logRecord = new MAVLinkLogFiles(this, fileName, true);
+    _logRecord->setWriting(true);
+    _insertNewLog(_logRecord);
+    emit logFilesChanged();
+
+    return true;
+}
+
+void MAVLinkLogManager::_closeLog()
+{
+    MAVLinkLogProcessor *const processor = _logProcessor;
+    (void) QMetaObject::invokeMethod(processor, [processor]() { processor->close(); }, Qt::QueuedConnection);
+    _logRecord = nullptr;
+}
+
+MAVLinkLogFiles *MAVLinkLogManager::_findLog(const QString &fileName) const
+{
+    const QString name = QFileInfo(fileName).baseName();
+    for (int i = 0; i < _logFiles->count(); i++) {
+        MAVLinkLogFiles *const log = qobject_cast<MAVLinkLogFiles*>(_logFiles->get(i));
+        if (log && (log->name() == name)) {
+            return log;
+        }
     }
 
-    return (_logProcessor != nullptr);
+    return nullptr;
 }
 
 void MAVLinkLogManager::_armedChanged(bool armed)
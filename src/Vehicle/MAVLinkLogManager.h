@@ -1,6 +1,6 @@
 #pragma once
 
-#include <QtCore/QFile>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
 #include <QtNetwork/QHttpPart>
@@ -8,8 +8,12 @@
 
 Q_DECLARE_LOGGING_CATEGORY(MAVLinkLogManagerLog)
 
+class QFile;
+class QGCResumableUploader;
 class QmlObjectListModel;
 class QNetworkAccessManager;
+class QThread;
+class QTimer;
 class MAVLinkLogManager;
 class Vehicle;
 
@@ -24,6 +28,8 @@ class MAVLinkLogFiles : public QObject
     Q_PROPERTY(bool     writing     READ writing                         NOTIFY writingChanged)
     Q_PROPERTY(qreal    progress    READ progress                        NOTIFY progressChanged)
     Q_PROPERTY(quint32  size        READ size                            NOTIFY sizeChanged)
+    Q_PROPERTY(int      drops       READ drops                           NOTIFY dropsChanged)
+    Q_PROPERTY(qreal    writeRate   READ writeRate                       NOTIFY writeRateChanged)
 
 public:
     MAVLinkLogFiles(MAVLinkLogManager *manager, const QString &filePath, bool newFile = false);
@@ -36,21 +42,27 @@ class MAVLinkLogFiles : public QObject
     bool writing() const { return _writing; }
     qreal progress() const { return _progress; }
     quint32 size() const { return _size; }
+    int drops() const { return _drops; }
+    qreal writeRate() const { return _writeRate; }
 
+    void setDrops(int drops);
     void setProgress(qreal progress);
     void setSelected(bool selected);
     void setSize(quint32 size);
     void setUploaded(bool uploaded);
     void setUploading(bool uploading);
     void setWriting(bool writing);
+    void setWriteRate(qreal bytesPerSecond);
 
 signals:
+    void dropsChanged();
     void progressChanged();
     void selectedChanged();
     void sizeChanged();
     void uploadedChanged();
     void uploadingChanged();
     void writingChanged();
+    void writeRateChanged();
 
 private:
     bool _selected = false;
@@ -60,37 +72,65 @@ class MAVLinkLogFiles : public QObject
     qreal _progress = 0;
     QString _name;
     quint32 _size = 0;
+    int _drops = 0;                 ///< LOGGING_DATA messages lost while streaming
+    qreal _writeRate = 0;           ///< Bytes per second written while streaming
 };
 
 /*===========================================================================*/
 
-class MAVLinkLogProcessor
+/// Reassembles streamed LOGGING_DATA into a ULog file. Lives on a worker thread owned by MAVLinkLogManager so
+/// high rate log streaming doesn't compete with the GUI thread, all calls are queued to it. Data is collected in a
+/// large buffer which is written out when full and at least once per kFlushIntervalMs.
+class MAVLinkLogProcessor : public QObject
 {
+    Q_OBJECT
+
 public:
-    MAVLinkLogProcessor();
+    explicit MAVLinkLogProcessor(QObject *parent = nullptr);
     ~MAVLinkLogProcessor();
 
+    /// Opens a new log file, an open log is closed first
+    bool create(const QString &fileName);
+
+    /// Writes out buffered data and closes the file
     void close();
-    bool valid() const { return ((_file.exists()) && (_record != nullptr)); }
-    bool create(MAVLinkLogManager *manager, QStringView path, uint8_t id);
-    MAVLinkLogFiles *record() { return _record; }
-    QString fileName() const { return _fileName; }
-    bool processStreamData(uint16_t _sequence, uint8_t first_message, const QByteArray &in);
+
+    void processStreamData(uint16_t sequence, uint8_t first_message, const QByteArray &in);
+
+    bool isOpen() const;
+    quint64 written() const { return _written; }
+    int numDrops() const { return _numDrops; }
+
+    static constexpr qsizetype kWriteBufferSize = 1024 * 1024;
+    static constexpr int kFlushIntervalMs = 1000;     ///< Buffered data is written out at least this often while a log is open
+
+signals:
+    /// Emitted each time buffered data is written out
+    ///     @param bytesPerSecond Average since the log was opened
+    void statsChanged(const QString &fileName, quint64 written, int numDrops, double bytesPerSecond);
+    /// Emitted once per log on the first write error, further data is dropped
+    void errorOccurred(const QString &fileName, const QString &errorString);
+    void closed(const QString &fileName, bool success);
 
 private:
     bool _checkSequence(uint16_t seq, int &num_drops);
     QByteArray _writeUlogMessage(QByteArray &data);
     void _writeData(const void* data, int len);
+    void _flush();
+    void _setError(const QString &errorString);
 
     bool _error = false;
     bool _gotHeader = false;
     int _numDrops = 0;
     int _sequence = -1;
-    MAVLinkLogFiles *_record = nullptr;
     QByteArray _ulogMessage;
-    QFile _file;
+    QByteArray _buffer;             ///< Data not yet written to the file
+    QFile *_file = nullptr;
+    QTimer *_flushTimer = nullptr;  ///< Runs on the thread the processor lives on, independent of incoming data
     QString _fileName;
-    quint32 _written = 0;
+    quint64 _written = 0;
+    QElapsedTimer _openTimer;
+    qint64 _lastFlushMs = 0;
 
     static constexpr int kUlogMessageHeader = 3;
     static constexpr int kSequenceSize = 1 << 15;
@@ -114,6 +154,8 @@ class MAVLinkLogManager : public QObject
     Q_PROPERTY(bool                 enableAutoStart     READ enableAutoStart    WRITE setEnableAutoStart    NOTIFY enableAutoStartChanged)
     Q_PROPERTY(bool                 deleteAfterUpload   READ deleteAfterUpload  WRITE setDeleteAfterUpload  NOTIFY deleteAfterUploadChanged)
     Q_PROPERTY(bool                 publicLog           READ publicLog          WRITE setPublicLog          NOTIFY publicLogChanged)
+    Q_PROPERTY(bool                 resumableUpload     READ resumableUpload    WRITE setResumableUpload    NOTIFY resumableUploadChanged)
+    Q_PROPERTY(int                  uploadRateLimit     READ uploadRateLimit    WRITE setUploadRateLimit    NOTIFY uploadRateLimitChanged)
     Q_PROPERTY(bool                 uploading           READ uploading                                      NOTIFY uploadingChanged)
     Q_PROPERTY(bool                 logRunning          READ logRunning                                     NOTIFY logRunningChanged)
     Q_PROPERTY(bool                 canStartLog         READ canStartLog                                    NOTIFY canStartLogChanged)
@@ -142,11 +184,13 @@ class MAVLinkLogManager : public QObject
     QString videoURL() const { return _videoURL; }
     bool enableAutoUpload() const { return _enableAutoUpload; }
     bool enableAutoStart() const { return _enableAutoStart; }
-    bool uploading() const { return (_currentLogfile != nullptr); }
+    bool uploading() const;
     bool logRunning() const { return _logRunning; }
     bool canStartLog() const { return !_loggingDenied; }
     bool deleteAfterUpload() const { return _deleteAfterUpload; }
     bool publicLog() const { return _publicLog; }
+    bool resumableUpload() const { return _resumableUpload; }
+    int uploadRateLimit() const { return _uploadRateLimit; }
     int windSpeed() const { return _windSpeed; }
     QString rating() const { return _rating; }
     QString logExtension() const { return _ulogExtension; }
@@ -161,6 +205,8 @@ class MAVLinkLogManager : public QObject
     void setFeedback(const QString &feedback);
     void setPublicLog(bool publicLog);
     void setRating(const QString &rate);
+    void setResumableUpload(bool enable);
+    void setUploadRateLimit(int kilobytesPerSecond);
     void setUploadURL(const QString &url);
     void setVideoURL(const QString &url);
     void setWindSpeed(int speed);
@@ -180,9 +226,11 @@ class MAVLinkLogManager : public QObject
     void publicLogChanged();
     void ratingChanged();
     void readyRead(const QByteArray &data);
+    void resumableUploadChanged();
     void selectedCountChanged();
     void succeed();
     void uploadingChanged();
+    void uploadRateLimitChanged();
     void uploadURLChanged();
     void videoURLChanged();
     void windSpeedChanged();
@@ -194,11 +242,20 @@ private slots:
     void _mavlinkLogData(Vehicle *vehicle, uint8_t target_system, uint8_t target_component, uint16_t sequence, uint8_t first_message, const QByteArray &data, bool acked);
     void _armedChanged(bool armed);
     void _mavCommandResult(int vehicleId, int component, int command, int result, int failureCode);
+    void _logStats(const QString &fileName, quint64 written, int numDrops, double bytesPerSecond);
+    void _logWriteError(const QString &fileName, const QString &errorString);
+    void _logClosed(const QString &fileName, bool success);
+    void _resumableUploadProgress(const QString &fileName, qint64 bytesSent, qint64 bytesTotal);
+    void _resumableUploadFinished(const QString &fileName, bool success, const QString &errorString);
 
 private:
     bool _sendLog(const QString &logFile);
+    void _queueResumableUploads();
+    void _markUploaded(MAVLinkLogFiles *log);
     bool _processUploadResponse(int http_code, const QByteArray &data);
     bool _createNewLog();
+    void _closeLog();
+    MAVLinkLogFiles *_findLog(const QString &fileName) const;
     int  _getFirstSelected() const;
     void _insertNewLog(MAVLinkLogFiles *newLog);
     void _deleteLog(MAVLinkLogFiles *log);
@@ -220,9 +277,14 @@ private slots:
     bool _loggingDenied = false;
     bool _logRunning = false;
     bool _publicLog = false;
+    bool _resumableUpload = false;
+    int _uploadRateLimit = 0;       ///< KB/s, 0 for unlimited
     int _windSpeed = -1;
     MAVLinkLogFiles *_currentLogfile = nullptr;
-    MAVLinkLogProcessor *_logProcessor = nullptr;
+    MAVLinkLogProcessor *_logProcessor = nullptr;    ///< Lives on _logThread, created with the first log
+    QThread *_logThread = nullptr;
+    QGCResumableUploader *_resumableUploader = nullptr;     ///< Used instead of the multipart POST when _resumableUpload is set
+    MAVLinkLogFiles *_logRecord = nullptr;          ///< Log being streamed, nullptr if none
     QString _description;
     QString _emailAddress;
     QString _feedback;
@@ -243,6 +305,8 @@ private slots:
     static constexpr const char *kWindSpeedKey = "WindSpeed";
     static constexpr const char *kRateKey = "RateKey";
     static constexpr const char *kPublicLogKey = "PublicLog";
+    static constexpr const char *kResumableUploadKey = "ResumableUpload";
+    static constexpr const char *kUploadRateLimitKey = "UploadRateLimit";
     static constexpr const char *kFeedback = "feedback";
     static constexpr const char *kVideoURL = "videoUrl";
 };
@@ -271,6 +271,11 @@ void Vehicle::_commonInit(LinkInterface* link)
         _vehicleLinkManager->_addLink(link);
     }
 
+    // The mission may have been changed by someone else while we could not hear the vehicle, or the vehicle rebooted
+    connect(_vehicleLinkManager, &VehicleLinkManager::communicationLostChanged, _missionManager, [this](bool communicationLost) {
+        _missionManager->invalidateVehicleItemStore(communicationLost ? QStringLiteral("communication lost") : QStringLiteral("communication regained"));
+    });
+
     connect(_standardModes, &StandardModes::modesUpdated, this, &Vehicle::flightModesChanged);
     // Re-emit flightModeChanged after available modes mapping updates so UI refreshes
     // the human-readable mode name even if HEARTBEAT arrived earlier.
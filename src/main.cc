@@ -1,11 +1,13 @@
 #include <QtQuick/QQuickWindow>
 #include <QtWidgets/QApplication>
 
+#include "LogBatchAnalyzer.h"
 #include "QGCApplication.h"
 #include "QGCCommandLineParser.h"
 #include "QGCLogging.h"
 #include "Platform.h"
 #include "NTRIP.h"
+#include "StartupProfiler.h"
 
 #if !defined(Q_OS_ANDROID) && !defined(Q_OS_IOS)
     #include <QtWidgets/QMessageBox>
@@ -23,6 +25,9 @@
 
 int main(int argc, char *argv[])
 {
+    // Starts the startup clock
+    StartupProfiler::Span startupSpan(QStringLiteral("Command line"));
+
 #if 0
     // Useful for debugging specific unit tests
     char argument1[] = "--unittest:FTPManagerTest";
@@ -57,6 +62,17 @@ int main(int argc, char *argv[])
             // TODO: QCommandLineParser::showMessageAndExit(QCommandLineParser::MessageType::Error) - Qt6.9
             return 1;
         }
+
+        if (args.analyzeLogsDirectory) {
+            // Headless batch run, none of the application is needed and it can run alongside a running instance
+            return LogBatchAnalyzer::runCommandLine(args.analyzeLogsDirectory.value(), args.analyzeReportFile.value_or(QString()));
+        }
+    }
+
+    if (args.startupTraceFile) {
+        StartupProfiler::instance()->setTraceFileName(args.startupTraceFile.value());
+    } else if (qEnvironmentVariableIsSet("QGC_STARTUP_TRACE")) {
+        StartupProfiler::instance()->setTraceFileName(qEnvironmentVariable("QGC_STARTUP_TRACE"));
     }
 
 #if !defined(Q_OS_ANDROID) && !defined(Q_OS_IOS)
@@ -75,16 +91,22 @@ int main(int argc, char *argv[])
 #endif
 
     // Early platform setup before Qt app construction
+    startupSpan.next(QStringLiteral("Platform pre app setup"));
     Platform::setupPreApp(args);
 
+    startupSpan.next(QStringLiteral("QGCApplication"));
     QGCApplication app(argc, argv, args);
 
+    startupSpan.next(QStringLiteral("Logging"));
     QGCLogging::installHandler();
 
     // Late platform setup after app and logging exist
+    startupSpan.next(QStringLiteral("Platform post app setup"));
     Platform::setupPostApp();
 
+    startupSpan.next(QStringLiteral("QGCApplication init"));
     app.init();
+    startupSpan.end();
 
     int exitCode = 0;
     if (args.runningUnitTests) {
@@ -44,3 +44,35 @@ void ExifParserTest::_writeTest()
     // QVERIFY(outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
     // QCOMPARE(outputFile.write(imageBuffer), imageBuffer.size());
 }
+
+void ExifParserTest::_headerOnlyTest()
+{
+    QFile file(":/unittest/DSCN0010.jpg");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    const QByteArray imageBuffer = file.readAll();
+    file.close();
+
+    const qsizetype headerSize = ExifParser::headerSize(imageBuffer);
+    QVERIFY(headerSize > 0);
+    QVERIFY(headerSize < imageBuffer.size());
+    QVERIFY(headerSize <= ExifParser::kMaxHeaderSize);
+    QCOMPARE(ExifParser::headerSize(imageBuffer.sliced(2)), -1);
+
+    // Parsing just the header gives the same result as parsing the whole file
+    const QByteArray header = imageBuffer.first(headerSize);
+    QCOMPARE(ExifParser::readTime(header), ExifParser::readTime(imageBuffer));
+
+    // Tagging just the header and appending the rest of the file gives the same result as tagging the whole file
+    GeoTagWorker::CameraFeedbackPacket data;
+    data.latitude = 37.225;
+    data.longitude = -80.425;
+    data.altitude = 618.4392;
+
+    QByteArray taggedImage = imageBuffer;
+    QVERIFY(ExifParser::write(taggedImage, data));
+
+    QByteArray taggedHeader = header;
+    QVERIFY(ExifParser::write(taggedHeader, data));
+    QCOMPARE(taggedHeader + imageBuffer.sliced(headerSize), taggedImage);
+}
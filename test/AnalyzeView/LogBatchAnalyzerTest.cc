@@ -0,0 +1,274 @@
+#include "LogBatchAnalyzerTest.h"
+#include "LogBatchAnalyzer.h"
+#include "MAVLinkLib.h"
+#include "QGCZstdSeekable.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QtEndian>
+#include <QtTest/QTest>
+
+#include <cstring>
+
+namespace {
+
+constexpr quint64 kStartTimeUs = Q_UINT64_C(1700000000000000);
+constexpr uint8_t kSystemId = 1;
+
+void appendRecord(QByteArray &log, quint64 timeOffsetSecs, const mavlink_message_t &message)
+{
+    uchar timestamp[sizeof(quint64)];
+    qToBigEndian<quint64>(kStartTimeUs + (timeOffsetSecs * 1000000), timestamp);
+    log.append(reinterpret_cast<const char*>(timestamp), sizeof(timestamp));
+
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t length = mavlink_msg_to_send_buffer(buffer, &message);
+    log.append(reinterpret_cast<const char*>(buffer), length);
+}
+
+void appendHeartbeat(QByteArray &log, quint64 timeOffsetSecs, bool armed)
+{
+    mavlink_heartbeat_t heartbeat{};
+    heartbeat.type = MAV_TYPE_QUADROTOR;
+    heartbeat.autopilot = MAV_AUTOPILOT_PX4;
+    heartbeat.base_mode = MAV_MODE_FLAG_CUSTOM_MODE_ENABLED | (armed ? MAV_MODE_FLAG_SAFETY_ARMED : 0);
+
+    mavlink_message_t message{};
+    (void) mavlink_msg_heartbeat_encode(kSystemId, MAV_COMP_ID_AUTOPILOT1, &message, &heartbeat);
+    appendRecord(log, timeOffsetSecs, message);
+}
+
+void appendBattery(QByteArray &log, quint64 timeOffsetSecs, int8_t remaining, int32_t consumedMah)
+{
+    mavlink_sys_status_t sysStatus{};
+    sysStatus.battery_remaining = remaining;
+
+    mavlink_message_t message{};
+    (void) mavlink_msg_sys_status_encode(kSystemId, MAV_COMP_ID_AUTOPILOT1, &message, &sysStatus);
+    appendRecord(log, timeOffsetSecs, message);
+
+    mavlink_battery_status_t batteryStatus{};
+    batteryStatus.id = 0;
+    batteryStatus.current_consumed = consumedMah;
+    batteryStatus.battery_remaining = remaining;
+    (void) mavlink_msg_battery_status_encode(kSystemId, MAV_COMP_ID_AUTOPILOT1, &message, &batteryStatus);
+    appendRecord(log, timeOffsetSecs, message);
+}
+
+/// 10 second flight to 12.5m in an 11 second log
+QByteArray flightTlog()
+{
+    QByteArray log;
+
+    appendHeartbeat(log, 0, false);
+    appendBattery(log, 0, 90, 0);
+    appendHeartbeat(log, 1, true);
+
+    mavlink_message_t message{};
+    for (int32_t altitudeMm : { 5000, 12500, 8000 }) {
+        mavlink_global_position_int_t position{};
+        position.relative_alt = altitudeMm;
+        (void) mavlink_msg_global_position_int_encode(kSystemId, MAV_COMP_ID_AUTOPILOT1, &message, &position);
+        appendRecord(log, 5, message);
+    }
+
+    // Corrupted record, must not throw the parser off the following records
+    QByteArray corrupted;
+    appendRecord(corrupted, 6, message);
+    corrupted[corrupted.size() - 1] = static_cast<char>(corrupted.at(corrupted.size() - 1) ^ 0xff);
+    log.append(corrupted);
+
+    mavlink_statustext_t statusText{};
+    statusText.severity = MAV_SEVERITY_ERROR;
+    (void) strncpy(statusText.text, "Motor failure", sizeof(statusText.text));
+    (void) mavlink_msg_statustext_encode(kSystemId, MAV_COMP_ID_AUTOPILOT1, &message, &statusText);
+    appendRecord(log, 7, message);
+
+    statusText.severity = MAV_SEVERITY_INFO;
+    (void) strncpy(statusText.text, "Landing", sizeof(statusText.text));
+    (void) mavlink_msg_statustext_encode(kSystemId, MAV_COMP_ID_AUTOPILOT1, &message, &statusText);
+    appendRecord(log, 8, message);
+
+    appendBattery(log, 10, 70, 450);
+    appendHeartbeat(log, 11, false);
+
+    return log;
+}
+
+bool writeFile(const QString &fileName, const QByteArray &data)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly) && (file.write(data) == data.size());
+}
+
+} // namespace
+
+void LogBatchAnalyzerTest::_tlogTest()
+{
+    QByteArray log = flightTlog();
+    QBuffer buffer(&log);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    LogBatchAnalyzer::Summary summary;
+    QVERIFY(LogBatchAnalyzer::analyzeTlog(buffer, summary));
+    QVERIFY(summary.ok);
+    QCOMPARE(summary.format, LogBatchAnalyzer::TlogFormat);
+    QCOMPARE(summary.durationSecs, 11.0);
+    QCOMPARE(summary.flightTimeSecs, 10.0);
+    QCOMPARE(summary.maxAltitudeM, 12.5);
+    QCOMPARE(summary.batteryUsedMah, 450.0);
+    QCOMPARE(summary.batteryStartPercent, 90.0);
+    QCOMPARE(summary.batteryEndPercent, 70.0);
+    QCOMPARE(summary.errorCount, 1);
+    QCOMPARE(summary.errors, QStringList({ QStringLiteral("Motor failure") }));
+
+    QByteArray garbage(1024, 'x');
+    QBuffer garbageBuffer(&garbage);
+    QVERIFY(garbageBuffer.open(QIODevice::ReadOnly));
+    LogBatchAnalyzer::Summary garbageSummary;
+    QVERIFY(!LogBatchAnalyzer::analyzeTlog(garbageBuffer, garbageSummary));
+    QVERIFY(!garbageSummary.ok);
+    QVERIFY(!garbageSummary.errorMessage.isEmpty());
+}
+
+void LogBatchAnalyzerTest::_truncatedTlogTest()
+{
+    // Record cut short after the first few bytes of its frame, as left by a logger which was killed mid write.
+    // Its payload length would otherwise swallow the battery records which follow.
+    mavlink_global_position_int_t position{};
+    position.relative_alt = 50000;
+    mavlink_message_t message{};
+    (void) mavlink_msg_global_position_int_encode(kSystemId, MAV_COMP_ID_AUTOPILOT1, &message, &position);
+    QByteArray truncated;
+    appendRecord(truncated, 0, message);
+    truncated.truncate(sizeof(quint64) + 6);
+
+    // Inserted right after the first record of the flight
+    QByteArray firstRecord;
+    appendHeartbeat(firstRecord, 0, false);
+    const QByteArray flight = flightTlog();
+    QByteArray log = firstRecord + truncated + flight.mid(firstRecord.size());
+
+    QBuffer buffer(&log);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    LogBatchAnalyzer::Summary summary;
+    QVERIFY(LogBatchAnalyzer::analyzeTlog(buffer, summary));
+    QVERIFY(summary.ok);
+    QCOMPARE(summary.durationSecs, 11.0);
+    QCOMPARE(summary.flightTimeSecs, 10.0);
+    QCOMPARE(summary.maxAltitudeM, 12.5);
+    QCOMPARE(summary.batteryStartPercent, 90.0);
+    QCOMPARE(summary.batteryEndPercent, 70.0);
+    QCOMPARE(summary.errorCount, 1);
+
+    // Truncated record at the very end of the log
+    QByteArray truncatedEnd = flight + truncated;
+    QBuffer endBuffer(&truncatedEnd);
+    QVERIFY(endBuffer.open(QIODevice::ReadOnly));
+    LogBatchAnalyzer::Summary endSummary;
+    QVERIFY(LogBatchAnalyzer::analyzeTlog(endBuffer, endSummary));
+    QCOMPARE(endSummary.maxAltitudeM, 12.5);
+    QCOMPARE(endSummary.durationSecs, 11.0);
+}
+
+void LogBatchAnalyzerTest::_compressedTlogTest()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    // Small frames so the log spans several of them
+    const QString fileName = dir.filePath(QStringLiteral("flight.tlog.zst"));
+    QFile out(fileName);
+    QVERIFY(out.open(QIODevice::WriteOnly));
+    QGCZstdSeekableWriter writer(&out);
+    writer.setFrameSize(256);
+    QVERIFY(writer.open(QIODevice::WriteOnly));
+    const QByteArray log = flightTlog();
+    QCOMPARE(writer.write(log), log.size());
+    QVERIFY(writer.finish());
+    QVERIFY(writer.frameCount() > 1);
+    out.close();
+
+    QCOMPARE(LogBatchAnalyzer::findLogs(dir.path()), QStringList({ fileName }));
+
+    const LogBatchAnalyzer::Summary summary = LogBatchAnalyzer::analyzeFile(fileName);
+    QVERIFY2(summary.ok, qPrintable(summary.errorMessage));
+    QCOMPARE(summary.format, LogBatchAnalyzer::TlogFormat);
+    QCOMPARE(summary.durationSecs, 11.0);
+    QCOMPARE(summary.flightTimeSecs, 10.0);
+    QCOMPARE(summary.maxAltitudeM, 12.5);
+    QCOMPARE(summary.batteryUsedMah, 450.0);
+}
+
+void LogBatchAnalyzerTest::_ulogTest()
+{
+    QFile file(":/unittest/SampleULog.ulg");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    LogBatchAnalyzer::Summary summary;
+    QVERIFY(LogBatchAnalyzer::analyzeULog(file, summary));
+    QVERIFY(summary.ok);
+    QCOMPARE(summary.format, LogBatchAnalyzer::ULogFormat);
+    QVERIFY(summary.durationSecs > 0);
+    QVERIFY(summary.flightTimeSecs <= summary.durationSecs);
+}
+
+void LogBatchAnalyzerTest::_analyzeFilesTest()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QByteArray log = flightTlog();
+    QVERIFY(writeFile(dir.filePath(QStringLiteral("a.tlog")), log));
+    QVERIFY(writeFile(dir.filePath(QStringLiteral("b.ulg")), QByteArray(64, 'x')));
+    QVERIFY(QDir(dir.path()).mkpath(QStringLiteral("sub")));
+    QVERIFY(writeFile(dir.filePath(QStringLiteral("sub/c.tlog")), log));
+    QVERIFY(writeFile(dir.filePath(QStringLiteral("notes.txt")), QByteArray("not a log")));
+
+    const QStringList fileNames = LogBatchAnalyzer::findLogs(dir.path());
+    QCOMPARE(fileNames.count(), 3);
+
+    const QList<LogBatchAnalyzer::Summary> summaries = LogBatchAnalyzer::analyzeFiles(fileNames, 2);
+    QCOMPARE(summaries.count(), 3);
+    for (qsizetype i = 0; i < summaries.count(); i++) {
+        QCOMPARE(summaries[i].fileName, fileNames[i]);
+    }
+
+    QVERIFY(summaries[0].ok);
+    QCOMPARE(summaries[0].flightTimeSecs, 10.0);
+    QVERIFY(!summaries[1].ok);
+    QCOMPARE(summaries[1].format, LogBatchAnalyzer::ULogFormat);
+    QVERIFY(summaries[2].ok);
+    QCOMPARE(summaries[2].maxAltitudeM, 12.5);
+}
+
+void LogBatchAnalyzerTest::_reportTest()
+{
+    LogBatchAnalyzer::Summary ok;
+    ok.fileName = QStringLiteral("flight, 1.tlog");
+    ok.format = LogBatchAnalyzer::TlogFormat;
+    ok.ok = true;
+    ok.durationSecs = 11;
+    ok.flightTimeSecs = 10;
+    ok.errorCount = 1;
+    ok.errors = QStringList({ QStringLiteral("Motor \"1\" failure") });
+
+    LogBatchAnalyzer::Summary failed;
+    failed.fileName = QStringLiteral("broken.ulg");
+    failed.format = LogBatchAnalyzer::ULogFormat;
+    failed.errorMessage = QStringLiteral("Could not parse ULog");
+
+    QByteArray report;
+    QBuffer buffer(&report);
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QString errorMessage;
+    QVERIFY(LogBatchAnalyzer::writeReport({ ok, failed }, buffer, errorMessage));
+
+    const QList<QByteArray> lines = report.split('\n');
+    QCOMPARE(lines.count(), 4);     // Header, two rows, empty after the final newline
+    QVERIFY(lines[0].startsWith("file,format,status,"));
+    QCOMPARE(lines[1], QByteArray("\"flight, 1.tlog\",tlog,ok,11.0,10.0,,,,,1,\"Motor \"\"1\"\" failure\""));
+    QCOMPARE(lines[2], QByteArray("broken.ulg,ulog,Could not parse ULog,0.0,0.0,,,,,0,"));
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class LogBatchAnalyzerTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    LogBatchAnalyzerTest() = default;
+
+private slots:
+    void _tlogTest();
+    void _truncatedTlogTest();
+    void _compressedTlogTest();
+    void _ulogTest();
+    void _analyzeFilesTest();
+    void _reportTest();
+};
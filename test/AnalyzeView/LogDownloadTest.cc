@@ -9,6 +9,7 @@
 #include "MAVLinkProtocol.h"
 
 #include <QtCore/QDir>
+#include <QtCore/QTemporaryFile>
 #include <QtTest/QTest>
 
 void LogDownloadTest::_downloadTest()
@@ -50,3 +51,64 @@ void LogDownloadTest::_downloadTest()
 
     (void) QFile::remove(downloadFile);
 }
+
+void LogDownloadTest::_downloadWindowTest()
+{
+    // Five full chunks and a partial last bin
+    const uint logSize = (LogDownloadData::kChunkSize * 5) + 10;
+    QByteArray logBytes(logSize, Qt::Uninitialized);
+    for (uint i = 0; i < logSize; i++) {
+        logBytes[i] = static_cast<char>(i * 7);
+    }
+
+    QGCLogEntry entry(0, QDateTime(), logSize, true);
+    LogDownloadData data(&entry);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    data.file.setFileName(file.fileName());
+    QVERIFY(data.file.open(QIODevice::WriteOnly));
+    QVERIFY(data.file.resize(logSize));
+
+    const uint32_t numBins = data.numBins();
+    QCOMPARE(numBins, (LogDownloadData::kTableBins * 5) + 1);
+
+    data.startWindow(LogDownloadData::kInitialWindowChunks);
+    QCOMPARE(data.window_start, 0U);
+    QCOMPARE(static_cast<uint32_t>(data.window_table.size()), LogDownloadData::kInitialWindowChunks * LogDownloadData::kTableBins);
+
+    // Data outside the window is rejected
+    const uint8_t *const bytes = reinterpret_cast<const uint8_t*>(logBytes.constData());
+    QVERIFY(!data.storeBin(data.window_table.size(), bytes, MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN));
+
+    // Receive the window out of order with duplicates
+    for (uint32_t bin = 1; bin < static_cast<uint32_t>(data.window_table.size()); bin += 2) {
+        QVERIFY(data.storeBin(bin, bytes + (bin * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN), MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN));
+    }
+    QVERIFY(!data.windowComplete());
+    for (uint32_t bin = 0; bin < static_cast<uint32_t>(data.window_table.size()); bin++) {
+        QVERIFY(data.storeBin(bin, bytes + (bin * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN), MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN));
+    }
+    QVERIFY(data.windowComplete());
+    QVERIFY(!data.logComplete());
+    QVERIFY(data.writeWindow());
+
+    // The last window is clipped to the end of the log
+    data.startWindow(LogDownloadData::kMaxWindowChunks * 2);
+    QCOMPARE(data.window_chunks, LogDownloadData::kMaxWindowChunks);
+    QCOMPARE(data.window_start, LogDownloadData::kInitialWindowChunks * LogDownloadData::kTableBins);
+    QCOMPARE(static_cast<uint32_t>(data.window_start + data.window_table.size()), numBins);
+    for (uint32_t bin = data.window_start; bin < numBins; bin++) {
+        const uint32_t offset = bin * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+        const uint8_t count = static_cast<uint8_t>(qMin<uint32_t>(MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN, logSize - offset));
+        QVERIFY(data.storeBin(bin, bytes + offset, count));
+    }
+    QVERIFY(data.logComplete());
+    QVERIFY(data.writeWindow());
+    QCOMPARE(data.written, logSize);
+    data.file.close();
+
+    QFile result(file.fileName());
+    QVERIFY(result.open(QIODevice::ReadOnly));
+    QCOMPARE(result.readAll(), logBytes);
+}
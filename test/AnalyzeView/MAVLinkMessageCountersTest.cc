@@ -0,0 +1,82 @@
+#include "MAVLinkMessageCountersTest.h"
+#include "MAVLinkMessageCounters.h"
+
+#include <QtCore/QThread>
+#include <QtTest/QTest>
+
+#include <memory>
+#include <vector>
+
+void MAVLinkMessageCountersTest::_countTest()
+{
+    MAVLinkMessageCounters counters;
+    QCOMPARE(counters.size(), 0);
+    QCOMPARE(counters.count(1, 1, 0), static_cast<quint64>(0));
+
+    for (int i = 0; i < 5; i++) {
+        QVERIFY(counters.increment(1, 1, 0));
+    }
+    QVERIFY(counters.increment(1, 2, 0));
+    QVERIFY(counters.increment(2, 1, 0));
+    // Message ids above 255 only exist in MAVLink 2
+    QVERIFY(counters.increment(1, 1, 12900));
+
+    QCOMPARE(counters.size(), 4);
+    QCOMPARE(counters.count(1, 1, 0), static_cast<quint64>(5));
+    QCOMPARE(counters.count(1, 2, 0), static_cast<quint64>(1));
+    QCOMPARE(counters.count(2, 1, 0), static_cast<quint64>(1));
+    QCOMPARE(counters.count(1, 1, 12900), static_cast<quint64>(1));
+    QCOMPARE(counters.count(2, 2, 0), static_cast<quint64>(0));
+}
+
+void MAVLinkMessageCountersTest::_entriesTest()
+{
+    MAVLinkMessageCounters counters;
+
+    // More keys than fit in a single probe sequence to exercise collisions
+    for (quint32 msgId = 0; msgId < 300; msgId++) {
+        for (quint32 i = 0; i <= msgId % 3; i++) {
+            QVERIFY(counters.increment(1, 1, msgId));
+        }
+    }
+    QCOMPARE(counters.size(), 300);
+
+    const QList<MAVLinkMessageCounters::Entry> entries = counters.entries();
+    QCOMPARE(entries.count(), 300);
+    for (const MAVLinkMessageCounters::Entry &entry : entries) {
+        QCOMPARE(entry.sysId, static_cast<quint8>(1));
+        QCOMPARE(entry.compId, static_cast<quint8>(1));
+        QVERIFY(entry.msgId < 300);
+        QCOMPARE(entry.count, static_cast<quint64>((entry.msgId % 3) + 1));
+    }
+}
+
+void MAVLinkMessageCountersTest::_concurrentTest()
+{
+    constexpr int kThreadCount = 4;
+    constexpr int kMessageIds = 64;
+    constexpr int kRepeats = 1000;
+
+    MAVLinkMessageCounters counters;
+
+    // All threads race to claim the same keys
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int t = 0; t < kThreadCount; t++) {
+        threads.emplace_back(QThread::create([&counters]() {
+            for (int r = 0; r < kRepeats; r++) {
+                for (quint32 msgId = 0; msgId < kMessageIds; msgId++) {
+                    (void) counters.increment(1, 1, msgId);
+                }
+            }
+        }));
+        threads.back()->start();
+    }
+    for (const std::unique_ptr<QThread> &thread : threads) {
+        QVERIFY(thread->wait());
+    }
+
+    QCOMPARE(counters.size(), kMessageIds);
+    for (quint32 msgId = 0; msgId < kMessageIds; msgId++) {
+        QCOMPARE(counters.count(1, 1, msgId), static_cast<quint64>(kThreadCount * kRepeats));
+    }
+}
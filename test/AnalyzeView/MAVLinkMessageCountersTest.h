@@ -0,0 +1,16 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class MAVLinkMessageCountersTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    MAVLinkMessageCountersTest() = default;
+
+private slots:
+    void _countTest();
+    void _entriesTest();
+    void _concurrentTest();
+};
@@ -2,8 +2,62 @@
 #include "PX4LogParser.h"
 #include "GeoTagWorker.h"
 
+#include <QtCore/QBuffer>
+#include <QtCore/QtEndian>
 #include <QtTest/QTest>
 
+namespace {
+
+constexpr char kGposType = 0x10;
+constexpr char kTriggerType = 0x37;
+constexpr char kFormatType = static_cast<char>(0x80);
+constexpr int kMessageLength = 15;
+constexpr int kFormatLength = 89;
+
+QByteArray messageHeader(char type)
+{
+    QByteArray message;
+    message.append(static_cast<char>(0xA3));
+    message.append(static_cast<char>(0x95));
+    message.append(type);
+    return message;
+}
+
+QByteArray formatMessage(char type, int length)
+{
+    QByteArray message = messageHeader(kFormatType);
+    message.append(type);
+    message.append(static_cast<char>(length));
+    message.append(kFormatLength - message.size(), '\0');
+    return message;
+}
+
+QByteArray triggerMessage(quint64 timeUs, quint32 sequence)
+{
+    QByteArray message = messageHeader(kTriggerType);
+    char buffer[8];
+    qToLittleEndian(timeUs, buffer);
+    message.append(buffer, sizeof(quint64));
+    qToLittleEndian(sequence, buffer);
+    message.append(buffer, sizeof(quint32));
+    return message;
+}
+
+QByteArray gposMessage(double lat, double lon, float alt)
+{
+    QByteArray message = messageHeader(kGposType);
+    char buffer[4];
+    qToLittleEndian(static_cast<qint32>(lat * 1e7), buffer);
+    message.append(buffer, sizeof(buffer));
+    qToLittleEndian(static_cast<qint32>(lon * 1e7), buffer);
+    message.append(buffer, sizeof(buffer));
+    qToLittleEndian(alt, buffer);
+    message.append(buffer, sizeof(buffer));
+    return message;
+}
+
+} // namespace
+
 void PX4LogParserTest::_getTagsFromLogTest()
 {
     /*QFile file("SamplePX4Log.");
@@ -20,3 +74,39 @@ void PX4LogParserTest::_getTagsFromLogTest()
     QVERIFY(!qFuzzyIsNull(firstCameraFeedback.timestamp));
     QVERIFY(firstCameraFeedback.imageSequence != 0);*/
 }
+
+void PX4LogParserTest::_getTagsFromDeviceTest()
+{
+    // Synthetic log with enough padding between the captures to span several read blocks
+    QByteArray log;
+    log.append(formatMessage(kGposType, kMessageLength));
+    log.append(formatMessage(kTriggerType, kMessageLength));
+    for (quint32 sequence = 1; sequence <= 3; sequence++) {
+        log.append(triggerMessage(sequence * 1000000ULL, sequence));
+        log.append(gposMessage(47.0 + sequence, 8.0 + sequence, 400.0F + sequence));
+        log.append(messageHeader(0x01));
+        log.append(static_cast<int>(PX4LogParser::kReadBlockSize * 3 / 2), '\0');
+    }
+    log.append(messageHeader(0x01));
+
+    QBuffer buffer(&log);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QList<GeoTagWorker::CameraFeedbackPacket> cameraFeedback;
+    QVERIFY(PX4LogParser::getTagsFromLog(buffer, cameraFeedback));
+    QCOMPARE(cameraFeedback.count(), 3);
+
+    for (int i = 0; i < cameraFeedback.count(); i++) {
+        const GeoTagWorker::CameraFeedbackPacket &feedback = cameraFeedback[i];
+        QCOMPARE(feedback.imageSequence, static_cast<uint32_t>(i + 1));
+        QCOMPARE(feedback.timestamp, static_cast<double>(i + 1));
+        QCOMPARE_LT(qAbs(feedback.latitude - (48.0 + i)), 1e-6);
+        QCOMPARE_LT(qAbs(feedback.longitude - (9.0 + i)), 1e-6);
+        QCOMPARE(feedback.altitude, 401.0F + i);
+    }
+
+    // Both overloads agree
+    QList<GeoTagWorker::CameraFeedbackPacket> bufferFeedback;
+    QVERIFY(PX4LogParser::getTagsFromLog(log, bufferFeedback));
+    QCOMPARE(bufferFeedback.count(), cameraFeedback.count());
+}
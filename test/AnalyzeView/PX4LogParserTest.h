@@ -11,4 +11,5 @@ class PX4LogParserTest : public UnitTest
 
 private slots:
     void _getTagsFromLogTest();
+    void _getTagsFromDeviceTest();
 };
@@ -0,0 +1,86 @@
+#include "TimeSeriesBufferTest.h"
+#include "TimeSeriesBuffer.h"
+
+#include <QtTest/QTest>
+
+#include <cmath>
+
+void TimeSeriesBufferTest::_wrapTest()
+{
+    TimeSeriesBuffer buffer(4);
+    QCOMPARE(buffer.capacity(), 4);
+    QCOMPARE(buffer.count(), 0);
+
+    for (int i = 0; i < 6; i++) {
+        buffer.append(i * 10, i);
+    }
+
+    // Oldest two samples have been overwritten
+    QCOMPARE(buffer.count(), 4);
+    for (int i = 0; i < 4; i++) {
+        QCOMPARE(buffer.timeAt(i), (i + 2) * 10);
+        QCOMPARE(buffer.valueAt(i), static_cast<double>(i + 2));
+    }
+
+    buffer.clear();
+    QCOMPARE(buffer.count(), 0);
+    buffer.append(100, 1.5);
+    QCOMPARE(buffer.count(), 1);
+    QCOMPARE(buffer.timeAt(0), 100);
+}
+
+void TimeSeriesBufferTest::_decimateTest()
+{
+    // 200Hz for 10 seconds into a 100 pixel chart
+    TimeSeriesBuffer buffer(2000);
+    for (int i = 0; i < 2000; i++) {
+        buffer.append(i * 5, std::sin(i * 0.05) * 10.0);
+    }
+    // Spike which has to survive decimation
+    buffer.append(10000, 100.0);
+
+    QList<QPointF> points;
+    double min = 0;
+    double max = 0;
+    const qsizetype samples = buffer.decimate(0, 10000, 100, points, min, max);
+    QCOMPARE(samples, 2000);
+    QVERIFY(points.count() <= 200);
+    QCOMPARE(max, 100.0);
+    QVERIFY(min < -9.9);
+
+    bool foundSpike = false;
+    for (qsizetype i = 0; i < points.count(); i++) {
+        if (i > 0) {
+            QVERIFY(points[i].x() >= points[i - 1].x());
+        }
+        foundSpike |= (points[i].y() == 100.0);
+    }
+    QVERIFY(foundSpike);
+}
+
+void TimeSeriesBufferTest::_decimateWindowTest()
+{
+    TimeSeriesBuffer buffer(100);
+    for (int i = 0; i < 100; i++) {
+        buffer.append(i, i);
+    }
+
+    // More buckets than samples returns every sample in the window
+    QList<QPointF> points;
+    double min = -1;
+    double max = -1;
+    QCOMPARE(buffer.decimate(20, 29, 1000, points, min, max), 10);
+    QCOMPARE(points.count(), 10);
+    QCOMPARE(points.first(), QPointF(20, 20));
+    QCOMPARE(points.last(), QPointF(29, 29));
+    QCOMPARE(min, 20.0);
+    QCOMPARE(max, 29.0);
+
+    // Window with no samples leaves the range alone
+    min = -1;
+    max = -1;
+    QCOMPARE(buffer.decimate(200, 300, 10, points, min, max), 0);
+    QVERIFY(points.isEmpty());
+    QCOMPARE(min, -1.0);
+    QCOMPARE(max, -1.0);
+}
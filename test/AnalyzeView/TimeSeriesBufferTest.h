@@ -0,0 +1,16 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class TimeSeriesBufferTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    TimeSeriesBufferTest() = default;
+
+private slots:
+    void _wrapTest();
+    void _decimateTest();
+    void _decimateWindowTest();
+};
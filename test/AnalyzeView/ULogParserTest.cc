@@ -2,8 +2,11 @@
 #include "ULogParser.h"
 #include "GeoTagWorker.h"
 
+#include <QtCore/QBuffer>
 #include <QtTest/QTest>
 
+#include <ulog_cpp/data_container.hpp>
+
 namespace {
 
 QByteArray loadSampleULog()
@@ -82,6 +85,50 @@ void ULogParserTest::_compareStreamedAndNonStreamedTest()
     }
 }
 
+void ULogParserTest::_getTagsFromDeviceTest()
+{
+    QList<GeoTagWorker::CameraFeedbackPacket> feedbackBuffer;
+    QString errorBuffer;
+    const QByteArray logBuffer = loadSampleULog();
+    QVERIFY(ULogParser::getTagsFromLogStreamed(logBuffer, feedbackBuffer, errorBuffer));
+
+    QFile file(":/unittest/SampleULog.ulg");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    QList<GeoTagWorker::CameraFeedbackPacket> feedbackDevice;
+    QString errorDevice;
+    QVERIFY(ULogParser::getTagsFromLogStreamed(file, feedbackDevice, errorDevice));
+    QVERIFY(errorDevice.isEmpty());
+
+    QCOMPARE(feedbackDevice.size(), feedbackBuffer.size());
+    for (int i = 0; i < feedbackDevice.size(); ++i) {
+        QVERIFY2(compareFeedbackPackets(feedbackDevice[i], feedbackBuffer[i]),
+                 qPrintable(QStringLiteral("Packet %1 differs between device and buffer").arg(i)));
+    }
+}
+
+void ULogParserTest::_parseTopicsTest()
+{
+    QByteArray logBuffer = loadSampleULog();
+    QVERIFY(!logBuffer.isEmpty());
+
+    QBuffer buffer(&logBuffer);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    int sampleCount = 0;
+    bool otherTopic = false;
+    QString errorMessage;
+    const bool success = ULogParser::parseTopics(buffer, {"camera_capture"}, [&](const std::string &topic, int, const ulog_cpp::TypedDataView &) {
+        sampleCount++;
+        otherTopic |= (topic != "camera_capture");
+    }, errorMessage);
+
+    QVERIFY(success);
+    QVERIFY(errorMessage.isEmpty());
+    QVERIFY(!otherTopic);
+    QCOMPARE_GT(sampleCount, 0);
+}
+
 void ULogParserTest::_benchmarkNonStreamed()
 {
     const QByteArray logBuffer = loadSampleULog();
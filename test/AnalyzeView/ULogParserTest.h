@@ -13,6 +13,8 @@ private slots:
     void _getTagsFromLogTest();
     void _getTagsFromLogStreamedTest();
     void _compareStreamedAndNonStreamedTest();
+    void _getTagsFromDeviceTest();
+    void _parseTopicsTest();
     void _benchmarkNonStreamed();
     void _benchmarkStreamed();
 };
@@ -0,0 +1,222 @@
+#include "ULogTopicExtractorTest.h"
+#include "ULogTopicExtractor.h"
+#include "ULogParser.h"
+#include "GeoTagWorker.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+namespace {
+
+const QString kSampleULog = QStringLiteral(":/unittest/SampleULog.ulg");
+const QString kTopic = QStringLiteral("camera_capture");
+constexpr quint64 kLargeCount = 0xFFFFFFFFFFFFFF00ULL;     ///< Above the qint64 range
+
+void appendMessage(QByteArray &log, char type, const QByteArray &body)
+{
+    QDataStream stream(&log, QIODevice::Append);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream << static_cast<quint16>(body.size()) << static_cast<qint8>(type);
+    (void) stream.writeRawData(body.constData(), body.size());
+}
+
+/// Minimal ULog with two instances of sensor_accel, instance 0 has 2 samples and instance 1 has 3
+QByteArray multiInstanceULog()
+{
+    QByteArray log("ULog\x01\x12\x35", 7);
+    log.append('\x01');                       // Version
+    log.append(QByteArray(8, '\0'));          // Timestamp
+    appendMessage(log, 'B', QByteArray(40, '\0'));
+    appendMessage(log, 'F', QByteArrayLiteral("sensor_accel:uint64_t timestamp;float x;uint64_t count;"));
+
+    for (quint8 multiId = 0; multiId < 2; multiId++) {
+        QByteArray body;
+        QDataStream stream(&body, QIODevice::WriteOnly);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        stream << multiId << static_cast<quint16>(multiId + 10);
+        body.append("sensor_accel");
+        appendMessage(log, 'A', body);
+    }
+
+    for (quint8 multiId = 0; multiId < 2; multiId++) {
+        for (int sample = 0; sample < multiId + 2; sample++) {
+            QByteArray body;
+            QDataStream stream(&body, QIODevice::WriteOnly);
+            stream.setByteOrder(QDataStream::LittleEndian);
+            stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+            stream << static_cast<quint16>(multiId + 10) << static_cast<quint64>(1000 * (sample + 1)) << static_cast<float>(multiId) << (kLargeCount + sample);
+            appendMessage(log, 'D', body);
+        }
+    }
+
+    return log;
+}
+
+bool extractSample(ULogTopicExtractor &extractor)
+{
+    QFile file(kSampleULog);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QString errorMessage;
+    return extractor.extract(file, errorMessage) && errorMessage.isEmpty();
+}
+
+} // namespace
+
+void ULogTopicExtractorTest::_extractTest()
+{
+    ULogTopicExtractor extractor;
+    extractor.addTopic(kTopic, { QStringLiteral("seq"), QStringLiteral("lat"), QStringLiteral("alt") });
+    extractor.addTopic(QStringLiteral("not_in_log"));
+    QVERIFY(extractSample(extractor));
+
+    QCOMPARE(extractor.tables().count(), 2);
+    QVERIFY(extractor.table(QStringLiteral("not_in_log"))->columns.isEmpty());
+
+    const ULogTopicExtractor::Table *table = extractor.table(kTopic);
+    QVERIFY(table);
+    QCOMPARE(table->columns.count(), 3);
+
+    const ULogTopicExtractor::Column *seq = table->column(QStringLiteral("seq"));
+    const ULogTopicExtractor::Column *lat = table->column(QStringLiteral("lat"));
+    const ULogTopicExtractor::Column *alt = table->column(QStringLiteral("alt"));
+    QVERIFY(seq && lat && alt);
+    QCOMPARE(seq->type, ULogTopicExtractor::IntegerColumn);
+    QCOMPARE(lat->type, ULogTopicExtractor::RealColumn);
+    QVERIFY(alt->singlePrecision);
+
+    // Same samples as the GeoTag parser finds
+    QFile file(kSampleULog);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QList<GeoTagWorker::CameraFeedbackPacket> cameraFeedback;
+    QString errorMessage;
+    QVERIFY(ULogParser::getTagsFromLogStreamed(file, cameraFeedback, errorMessage));
+
+    QCOMPARE(table->rowCount(), cameraFeedback.count());
+    QCOMPARE(seq->integers.count(), table->rowCount());
+    for (qsizetype i = 0; i < table->rowCount(); i++) {
+        QCOMPARE(static_cast<uint32_t>(seq->integers[i]), cameraFeedback[i].imageSequence);
+        QCOMPARE(lat->reals[i], cameraFeedback[i].latitude);
+        QCOMPARE(static_cast<float>(alt->reals[i]), cameraFeedback[i].altitude);
+        QCOMPARE(table->timestamps[i] / 1.0e6, cameraFeedback[i].timestamp);
+    }
+}
+
+void ULogTopicExtractorTest::_allFieldsTest()
+{
+    ULogTopicExtractor extractor;
+    extractor.addTopic(kTopic);
+    QVERIFY(extractSample(extractor));
+
+    const ULogTopicExtractor::Table *table = extractor.table(kTopic);
+    QVERIFY(table);
+    QVERIFY(table->column(QStringLiteral("seq")));
+    QVERIFY(table->column(QStringLiteral("ground_distance")));
+    // Timestamp is the row key, array fields are not columns
+    QVERIFY(!table->column(QStringLiteral("timestamp")));
+    QVERIFY(!table->column(QStringLiteral("q")));
+
+    for (const ULogTopicExtractor::Column &column : table->columns) {
+        qsizetype count = column.reals.count();
+        if (column.type == ULogTopicExtractor::IntegerColumn) {
+            count = column.integers.count();
+        } else if (column.type == ULogTopicExtractor::UnsignedColumn) {
+            count = column.unsignedIntegers.count();
+        }
+        QCOMPARE(count, table->rowCount());
+    }
+}
+
+void ULogTopicExtractorTest::_timeRangeTest()
+{
+    ULogTopicExtractor all;
+    all.addTopic(kTopic, { QStringLiteral("seq") });
+    QVERIFY(extractSample(all));
+
+    const ULogTopicExtractor::Table *allTable = all.table(kTopic);
+    QCOMPARE_GE(allTable->rowCount(), 3);
+
+    // Drop the first and last sample
+    const quint64 start = allTable->timestamps[1];
+    const quint64 end = allTable->timestamps[allTable->rowCount() - 2];
+
+    ULogTopicExtractor range;
+    range.addTopic(kTopic, { QStringLiteral("seq") });
+    range.setTimeRange(start, end);
+    QVERIFY(extractSample(range));
+
+    const ULogTopicExtractor::Table *rangeTable = range.table(kTopic);
+    QVERIFY(rangeTable->rowCount() < allTable->rowCount());
+    for (const quint64 timestamp : rangeTable->timestamps) {
+        QVERIFY((timestamp >= start) && (timestamp <= end));
+    }
+}
+
+void ULogTopicExtractorTest::_exportCsvTest()
+{
+    ULogTopicExtractor extractor;
+    extractor.addTopic(kTopic, { QStringLiteral("seq"), QStringLiteral("alt") });
+    QVERIFY(extractSample(extractor));
+
+    const ULogTopicExtractor::Table *table = extractor.table(kTopic);
+    QByteArray csv;
+    QBuffer buffer(&csv);
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QString errorMessage;
+    QVERIFY(ULogTopicExtractor::exportCsv(*table, buffer, errorMessage));
+
+    const QList<QByteArray> lines = csv.trimmed().split('\n');
+    QCOMPARE(lines.count(), table->rowCount() + 1);
+    QCOMPARE(lines.first(), QByteArray("timestamp,seq,alt"));
+
+    const QList<QByteArray> firstRow = lines[1].split(',');
+    QCOMPARE(firstRow.count(), 3);
+    QCOMPARE(firstRow[0].toULongLong(), table->timestamps.first());
+    QCOMPARE(firstRow[1].toLongLong(), table->column(QStringLiteral("seq"))->integers.first());
+    QCOMPARE(firstRow[2].toFloat(), static_cast<float>(table->column(QStringLiteral("alt"))->reals.first()));
+}
+
+void ULogTopicExtractorTest::_multiInstanceTest()
+{
+    QByteArray log = multiInstanceULog();
+    QBuffer buffer(&log);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    ULogTopicExtractor extractor;
+    extractor.addTopic(QStringLiteral("sensor_accel"));
+    QString errorMessage;
+    QVERIFY2(extractor.extract(buffer, errorMessage), qPrintable(errorMessage));
+
+    // One table per instance, samples are not mixed
+    QCOMPARE(extractor.tables().count(), 2);
+    const ULogTopicExtractor::Table *first = extractor.table(QStringLiteral("sensor_accel"), 0);
+    const ULogTopicExtractor::Table *second = extractor.table(QStringLiteral("sensor_accel"), 1);
+    QVERIFY(first && second);
+    QCOMPARE(first->name(), QStringLiteral("sensor_accel_0"));
+    QCOMPARE(second->name(), QStringLiteral("sensor_accel_1"));
+    QCOMPARE(first->rowCount(), 2);
+    QCOMPARE(second->rowCount(), 3);
+    QCOMPARE(second->column(QStringLiteral("x"))->reals.first(), 1.0);
+
+    // uint64 values above the qint64 range are kept
+    const ULogTopicExtractor::Column *count = second->column(QStringLiteral("count"));
+    QVERIFY(count);
+    QCOMPARE(count->type, ULogTopicExtractor::UnsignedColumn);
+    QCOMPARE(count->unsignedIntegers, QList<quint64>({ kLargeCount, kLargeCount + 1, kLargeCount + 2 }));
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QVERIFY(extractor.exportCsv(dir.path(), errorMessage));
+    QVERIFY(QFile::exists(dir.filePath(QStringLiteral("sensor_accel_0.csv"))));
+
+    QFile csv(dir.filePath(QStringLiteral("sensor_accel_1.csv")));
+    QVERIFY(csv.open(QIODevice::ReadOnly));
+    const QList<QByteArray> lines = csv.readAll().trimmed().split('\n');
+    QCOMPARE(lines.count(), 4);
+    QCOMPARE(lines[1], QByteArray("1000,1,") + QByteArray::number(kLargeCount));
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class ULogTopicExtractorTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    ULogTopicExtractorTest() = default;
+
+private slots:
+    void _extractTest();
+    void _allFieldsTest();
+    void _timeRangeTest();
+    void _exportCsvTest();
+    void _multiInstanceTest();
+};
@@ -1,11 +1,15 @@
 #include "ParameterManagerTest.h"
 #include "MultiVehicleManager.h"
+#include "ParameterEditorController.h"
 #include "Vehicle.h"
 #include "ParameterManager.h"
 #include "MockLinkFTP.h"
 #include "QGC.h"
 
+#include <QtCore/QDataStream>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
 #include <QtTest/QTest>
 #include <QtTest/QSignalSpy>
 
@@ -204,6 +208,391 @@ void ParameterManagerTest::_paramReadNoResponse(void)
     _disconnectMockLink();
 }
 
+void ParameterManagerTest::_paramChangeUpdatesCache(void)
+{
+    Q_ASSERT(!_mockLink);
+
+    _connectMockLink();
+    QVERIFY(_mockLink);
+    QVERIFY(_vehicle);
+
+    ParameterManager *const paramManager = _vehicle->parameterManager();
+    QVERIFY(paramManager);
+    QVERIFY(paramManager->timeToReadyMs() >= 0);
+
+    Fact *const fact = paramManager->getParameter(MAV_COMP_ID_AUTOPILOT1, QStringLiteral("BAT1_V_CHARGED"));
+    QVERIFY(fact);
+
+    const QString cacheFileName = ParameterManager::parameterCacheFile(_vehicle->id(), MAV_COMP_ID_AUTOPILOT1);
+    QVERIFY(QFile::exists(cacheFileName));
+
+    auto cachedValue = [&cacheFileName]() -> double {
+        QMap<QString, QPair<int, QVariant>> cacheMap;
+        QFile cacheFile(cacheFileName);
+        if (!cacheFile.open(QIODevice::ReadOnly)) {
+            return 0;
+        }
+        QDataStream ds(&cacheFile);
+        ds >> cacheMap;
+        return cacheMap.value(QStringLiteral("BAT1_V_CHARGED")).second.toDouble();
+    };
+
+    const double newValue = fact->rawValue().toDouble() + 0.1;
+    QVERIFY(!QGC::fuzzyCompare(cachedValue(), newValue, 0.00001));
+
+    QSignalSpy paramSetSuccessSpy(paramManager, &ParameterManager::_paramSetSuccess);
+    QVERIFY(paramSetSuccessSpy.isValid());
+
+    fact->setRawValue(newValue);
+    QVERIFY(paramSetSuccessSpy.wait(ParameterManager::kWaitForParamValueAckMs * (ParameterManager::kParamSetRetryCount + 1)));
+
+    // The change must reach the cache so the hash check matches on the next connect
+    QTRY_VERIFY_WITH_TIMEOUT(QGC::fuzzyCompare(cachedValue(), newValue, 0.00001), ParameterManager::kCacheWriteDelayMs * 3);
+
+    _disconnectMockLink();
+}
+
+void ParameterManagerTest::_parameterHandles(void)
+{
+    Q_ASSERT(!_mockLink);
+
+    _connectMockLink();
+    QVERIFY(_mockLink);
+    QVERIFY(_vehicle);
+
+    ParameterManager *const paramManager = _vehicle->parameterManager();
+    QVERIFY(paramManager);
+
+    const QStringList names = paramManager->parameterNames(ParameterManager::defaultComponentId);
+    QVERIFY(!names.isEmpty());
+
+    QList<ParameterManager::ParameterHandle> handles;
+    for (const QString &name: names) {
+        const ParameterManager::ParameterHandle handle = paramManager->parameterHandle(ParameterManager::defaultComponentId, name);
+        QVERIFY(handle != ParameterManager::invalidParameterHandle);
+        QVERIFY(!handles.contains(handle));
+        QCOMPARE(paramManager->parameter(handle), paramManager->getParameter(ParameterManager::defaultComponentId, name));
+        handles.append(handle);
+    }
+
+    QCOMPARE(paramManager->parameterHandle(ParameterManager::defaultComponentId, QStringLiteral("NOT_A_PARAM")), ParameterManager::invalidParameterHandle);
+    QVERIFY(!paramManager->parameter(ParameterManager::invalidParameterHandle));
+    QVERIFY(!paramManager->parameter(handles.count() + 1000));
+
+    // Handles must survive a full refresh
+    QSignalSpy spyProgress(paramManager, &ParameterManager::loadProgressChanged);
+    paramManager->refreshAllParameters();
+    QVERIFY(spyProgress.wait(2000));
+    for (int i = 0; i < names.count(); i++) {
+        QCOMPARE(paramManager->parameterHandle(ParameterManager::defaultComponentId, names[i]), handles[i]);
+    }
+
+    // Lookup cost of resolving every parameter by name, which is what the setup pages do on load
+    QBENCHMARK {
+        for (const QString &name: names) {
+            (void) paramManager->getParameter(ParameterManager::defaultComponentId, name);
+        }
+    }
+
+    _disconnectMockLink();
+}
+
+void ParameterManagerTest::_bulkWrite(void)
+{
+    Q_ASSERT(!_mockLink);
+
+    _connectMockLink();
+    QVERIFY(_mockLink);
+    QVERIFY(_vehicle);
+
+    ParameterManager *const paramManager = _vehicle->parameterManager();
+    QVERIFY(paramManager);
+
+    // Enough float parameters to need several windows of outstanding writes
+    constexpr int writeCount = ParameterManager::kParamSetWindowSize * 3 + 1;
+    QList<ParameterManager::ParamSetRequest> requests;
+    for (const QString &name: paramManager->parameterNames(MAV_COMP_ID_AUTOPILOT1)) {
+        Fact *const fact = paramManager->getParameter(MAV_COMP_ID_AUTOPILOT1, name);
+        if (fact->type() == FactMetaData::valueTypeFloat) {
+            requests.append({ MAV_COMP_ID_AUTOPILOT1, name, fact->type(), QVariant(fact->rawValue().toFloat() + 1.0f) });
+            if (requests.count() == writeCount) {
+                break;
+            }
+        }
+    }
+    QCOMPARE(requests.count(), writeCount);
+
+    QSignalSpy progressSpy(paramManager, &ParameterManager::bulkWriteProgressChanged);
+    QSignalSpy completeSpy(paramManager, &ParameterManager::bulkWriteComplete);
+    QVERIFY(progressSpy.isValid());
+    QVERIFY(completeSpy.isValid());
+
+    paramManager->writeParameters(requests);
+    QVERIFY(paramManager->bulkWriteActive());
+    QVERIFY(paramManager->pendingWrites());
+
+    QVERIFY(completeSpy.wait(ParameterManager::kWaitForParamValueAckMs * (ParameterManager::kParamSetRetryCount + 1) * 2));
+    QCOMPARE(completeSpy.count(), 1);
+    QVERIFY(completeSpy[0][0].toStringList().isEmpty());
+    QVERIFY(!paramManager->bulkWriteActive());
+    QVERIFY(!paramManager->pendingWrites());
+
+    // Initial report plus one per completed write
+    QCOMPARE(progressSpy.count(), writeCount + 1);
+    QCOMPARE(progressSpy.last()[0].toInt(), writeCount);
+    QCOMPARE(progressSpy.last()[1].toInt(), writeCount);
+
+    for (const ParameterManager::ParamSetRequest &request: requests) {
+        QVERIFY(QGC::fuzzyCompare(paramManager->getParameter(MAV_COMP_ID_AUTOPILOT1, request.name)->rawValue().toFloat(), request.rawValue.toFloat()));
+    }
+
+    _disconnectMockLink();
+}
+
+void ParameterManagerTest::_bulkWriteUnrelatedAck(void)
+{
+    Q_ASSERT(!_mockLink);
+
+    _connectMockLink();
+    QVERIFY(_mockLink);
+    QVERIFY(_vehicle);
+
+    ParameterManager *const paramManager = _vehicle->parameterManager();
+    QVERIFY(paramManager);
+
+    QList<ParameterManager::ParamSetRequest> requests;
+    for (const QString &name: paramManager->parameterNames(MAV_COMP_ID_AUTOPILOT1)) {
+        Fact *const fact = paramManager->getParameter(MAV_COMP_ID_AUTOPILOT1, name);
+        if (fact->type() == FactMetaData::valueTypeFloat) {
+            requests.append({ MAV_COMP_ID_AUTOPILOT1, name, fact->type(), QVariant(fact->rawValue().toFloat() + 1.0f) });
+            break;
+        }
+    }
+    QCOMPARE(requests.count(), 1);
+    const ParameterManager::ParamSetRequest &request = requests.first();
+
+    QSignalSpy progressSpy(paramManager, &ParameterManager::bulkWriteProgressChanged);
+    QSignalSpy completeSpy(paramManager, &ParameterManager::bulkWriteComplete);
+    QVERIFY(progressSpy.isValid());
+    QVERIFY(completeSpy.isValid());
+
+    paramManager->writeParameters(requests);
+    QCOMPARE(progressSpy.count(), 1);
+
+    // Acks for the same parameter with a different value or type belong to some other write
+    emit paramManager->_paramSetSuccess(request.componentId, request.name, QVariant(request.rawValue.toFloat() + 1.0f));
+    emit paramManager->_paramSetSuccess(request.componentId, request.name, QVariant(request.rawValue.toDouble()));
+    QCOMPARE(progressSpy.count(), 1);
+    QVERIFY(paramManager->bulkWriteActive());
+
+    QVERIFY(completeSpy.wait(ParameterManager::kWaitForParamValueAckMs * (ParameterManager::kParamSetRetryCount + 1) * 2));
+    QVERIFY(completeSpy[0][0].toStringList().isEmpty());
+    QCOMPARE(progressSpy.count(), 2);
+
+    _disconnectMockLink();
+}
+
+/// Connects an ArduPlane MockLink whose parameters are loaded through FTP, so bulk writes go through a parameter file upload
+void ParameterManagerTest::_connectFtpParamMockLink()
+{
+    Q_ASSERT(!_mockLink);
+
+    QSignalSpy spyVehicle(MultiVehicleManager::instance(), &MultiVehicleManager::activeVehicleChanged);
+    _mockLink = MockLink::startAPMArduPlaneMockLink(false);
+    _mockLink->mockLinkFTP()->enableBinParamFile(true);
+
+    QCOMPARE(spyVehicle.wait(10000), true);
+    _vehicle = MultiVehicleManager::instance()->activeVehicle();
+    QVERIFY(_vehicle);
+
+    QSignalSpy spyPlan(_vehicle, &Vehicle::initialConnectComplete);
+    QCOMPARE(spyPlan.wait(30000), true);
+}
+
+/// Float parameters known to both the FTP parameter file and the MockLink parameter set, each changed by one
+QList<ParameterManager::ParamSetRequest> ParameterManagerTest::_ftpWriteRequests(ParameterManager *paramManager, int count)
+{
+    QList<ParameterManager::ParamSetRequest> requests;
+    for (const QString &name: paramManager->parameterNames(MAV_COMP_ID_AUTOPILOT1)) {
+        Fact *const fact = paramManager->getParameter(MAV_COMP_ID_AUTOPILOT1, name);
+        const QVariant vehicleValue = _mockLink->paramValue(MAV_COMP_ID_AUTOPILOT1, name);
+        if ((fact->type() == FactMetaData::valueTypeFloat) && (vehicleValue.typeId() == QMetaType::Float)) {
+            requests.append({ MAV_COMP_ID_AUTOPILOT1, name, fact->type(), QVariant(vehicleValue.toFloat() + 1.0f) });
+            if (requests.count() == count) {
+                break;
+            }
+        }
+    }
+    return requests;
+}
+
+void ParameterManagerTest::_bulkWriteFtp(void)
+{
+    _connectFtpParamMockLink();
+    QVERIFY(_mockLink);
+    QVERIFY(_vehicle);
+
+    ParameterManager *const paramManager = _vehicle->parameterManager();
+    QVERIFY(paramManager);
+
+    // More writes than the window so the read back has to be windowed as well
+    constexpr int writeCount = ParameterManager::kParamSetWindowSize + 1;
+    const QList<ParameterManager::ParamSetRequest> requests = _ftpWriteRequests(paramManager, writeCount);
+    QCOMPARE(requests.count(), writeCount);
+
+    QSignalSpy progressSpy(paramManager, &ParameterManager::bulkWriteProgressChanged);
+    QSignalSpy completeSpy(paramManager, &ParameterManager::bulkWriteComplete);
+    QVERIFY(completeSpy.isValid());
+
+    _mockLink->mockLinkFTP()->clearUploadedFiles();
+    paramManager->writeParameters(requests);
+
+    QVERIFY(completeSpy.wait(ParameterManager::kWaitForParamValueAckMs * (ParameterManager::kParamSetRetryCount + 1) * 4));
+    QCOMPARE(completeSpy.count(), 1);
+    QVERIFY(completeSpy[0][0].toStringList().isEmpty());
+    QVERIFY(!paramManager->pendingWrites());
+    QVERIFY(_mockLink->mockLinkFTP()->uploadedFiles().contains(QStringLiteral("@PARAM/param.pck")));
+    QCOMPARE(progressSpy.last()[0].toInt(), writeCount);
+
+    for (const ParameterManager::ParamSetRequest &request: requests) {
+        QVERIFY(QGC::fuzzyCompare(_mockLink->paramValue(MAV_COMP_ID_AUTOPILOT1, request.name).toFloat(), request.rawValue.toFloat()));
+        QVERIFY(QGC::fuzzyCompare(paramManager->getParameter(MAV_COMP_ID_AUTOPILOT1, request.name)->rawValue().toFloat(), request.rawValue.toFloat()));
+    }
+
+    _disconnectMockLink();
+}
+
+void ParameterManagerTest::_bulkWriteFtpNotApplied(void)
+{
+    _connectFtpParamMockLink();
+    QVERIFY(_mockLink);
+    QVERIFY(_vehicle);
+
+    ParameterManager *const paramManager = _vehicle->parameterManager();
+    QVERIFY(paramManager);
+
+    constexpr int writeCount = 3;
+    const QList<ParameterManager::ParamSetRequest> requests = _ftpWriteRequests(paramManager, writeCount);
+    QCOMPARE(requests.count(), writeCount);
+
+    // Vehicle accepts the upload but keeps its values, the read back must report every write as failed
+    _mockLink->mockLinkFTP()->enableParamFileApply(false);
+
+    QSignalSpy completeSpy(paramManager, &ParameterManager::bulkWriteComplete);
+    QVERIFY(completeSpy.isValid());
+
+    paramManager->writeParameters(requests);
+
+    QVERIFY(completeSpy.wait(ParameterManager::kWaitForParamValueAckMs * (ParameterManager::kParamSetRetryCount + 1) * 4));
+    QCOMPARE(completeSpy.count(), 1);
+    QCOMPARE(completeSpy[0][0].toStringList().count(), writeCount);
+    QVERIFY(!paramManager->pendingWrites());
+
+    // Facts show the value read back from the vehicle, not the optimistic one
+    for (const ParameterManager::ParamSetRequest &request: requests) {
+        QVERIFY(QGC::fuzzyCompare(paramManager->getParameter(MAV_COMP_ID_AUTOPILOT1, request.name)->rawValue().toFloat(), request.rawValue.toFloat() - 1.0f));
+    }
+
+    _mockLink->mockLinkFTP()->enableParamFileApply(true);
+    _disconnectMockLink();
+}
+
+void ParameterManagerTest::_bulkWriteFtpFallback(void)
+{
+    _connectFtpParamMockLink();
+    QVERIFY(_mockLink);
+    QVERIFY(_vehicle);
+
+    ParameterManager *const paramManager = _vehicle->parameterManager();
+    QVERIFY(paramManager);
+
+    constexpr int writeCount = 3;
+    const QList<ParameterManager::ParamSetRequest> requests = _ftpWriteRequests(paramManager, writeCount);
+    QCOMPARE(requests.count(), writeCount);
+
+    // Failed upload falls back to PARAM_SET for every write
+    _mockLink->mockLinkFTP()->clearUploadedFiles();
+    _mockLink->mockLinkFTP()->setErrorMode(MockLinkFTP::errModeNakResponse);
+
+    QSignalSpy completeSpy(paramManager, &ParameterManager::bulkWriteComplete);
+    QVERIFY(completeSpy.isValid());
+
+    paramManager->writeParameters(requests);
+
+    QVERIFY(completeSpy.wait(ParameterManager::kWaitForParamValueAckMs * (ParameterManager::kParamSetRetryCount + 1) * 4));
+    QCOMPARE(completeSpy.count(), 1);
+    QVERIFY(completeSpy[0][0].toStringList().isEmpty());
+    QVERIFY(_mockLink->mockLinkFTP()->uploadedFiles().isEmpty());
+
+    for (const ParameterManager::ParamSetRequest &request: requests) {
+        QVERIFY(QGC::fuzzyCompare(_mockLink->paramValue(MAV_COMP_ID_AUTOPILOT1, request.name).toFloat(), request.rawValue.toFloat()));
+    }
+
+    _mockLink->mockLinkFTP()->setErrorMode(MockLinkFTP::errModeNone);
+    _disconnectMockLink();
+}
+
+void ParameterManagerTest::_lazyFacts(void)
+{
+    Q_ASSERT(!_mockLink);
+
+    _connectMockLink();
+    QVERIFY(_mockLink);
+    QVERIFY(_vehicle);
+
+    ParameterManager *const paramManager = _vehicle->parameterManager();
+    QVERIFY(paramManager);
+
+    const QStringList names = paramManager->parameterNames(ParameterManager::defaultComponentId);
+    QVERIFY(!names.isEmpty());
+
+    // Only the parameters used by the vehicle setup should have a Fact at this point
+    const int initialFactCount = paramManager->factCount();
+    QVERIFY(initialFactCount < names.count());
+
+    // Saving the parameters works from the raw values and must not create Facts
+    QString savedParams;
+    QTextStream stream(&savedParams);
+    paramManager->writeParametersToStream(stream);
+    QCOMPARE(paramManager->factCount(), initialFactCount);
+    for (const QString &name: names) {
+        QVERIFY(savedParams.contains(QStringLiteral("\t%1\t").arg(name)));
+    }
+
+    // The parameter editor lists and searches from the meta data, a Fact is only created when a row is shown
+    {
+        ParameterEditorController controller;
+        QCOMPARE(paramManager->factCount(), initialFactCount);
+
+        QVERIFY(controller.setProperty("searchText", names.last()));
+        QAbstractTableModel *const parameters = controller.property("parameters").value<QAbstractTableModel*>();
+        QVERIFY(parameters);
+        QVERIFY(parameters->rowCount() > 0);
+        QCOMPARE(paramManager->factCount(), initialFactCount);
+
+        const Fact *const fact = parameters->data(parameters->index(0, ParameterTableModel::NameColumn), ParameterTableModel::FactRole).value<Fact*>();
+        QVERIFY(fact);
+        QCOMPARE(fact->name(), parameters->data(parameters->index(0, ParameterTableModel::NameColumn)).toString());
+        QVERIFY(paramManager->factCount() <= initialFactCount + 1);
+    }
+
+    for (const QString &name: names) {
+        Fact *const fact = paramManager->getParameter(ParameterManager::defaultComponentId, name);
+        QCOMPARE(fact->name(), name);
+        QVERIFY(fact->rawValue().isValid());
+        QVERIFY(fact->metaData());
+    }
+    QVERIFY(paramManager->factCount() > initialFactCount);
+    QVERIFY(paramManager->factCount() >= names.count());
+
+    // Once created the same Fact is handed out again
+    const int factCount = paramManager->factCount();
+    QCOMPARE(paramManager->getParameter(ParameterManager::defaultComponentId, names.first()), paramManager->getParameter(ParameterManager::defaultComponentId, names.first()));
+    QCOMPARE(paramManager->factCount(), factCount);
+
+    _disconnectMockLink();
+}
+
 void ParameterManagerTest::_setParamWithFailureMode(MockLink::ParamSetFailureMode_t failureMode, bool expectSuccess)
 {
     Q_ASSERT(!_mockLink);
@@ -3,6 +3,7 @@
 #include "UnitTest.h"
 #include "MockConfiguration.h"
 #include "MockLink.h"
+#include "ParameterManager.h"
 
 class ParameterManagerTest : public UnitTest
 {
@@ -17,6 +18,14 @@ private slots:
     void _paramWriteNoAckPermanent(void);
     void _paramReadFirstAttemptNoResponseRetry(void);
     void _paramReadNoResponse(void);
+    void _paramChangeUpdatesCache(void);
+    void _parameterHandles(void);
+    void _bulkWrite(void);
+    void _bulkWriteUnrelatedAck(void);
+    void _bulkWriteFtp(void);
+    void _bulkWriteFtpNotApplied(void);
+    void _bulkWriteFtpFallback(void);
+    void _lazyFacts(void);
     // void _FTPnoFailure(void);
     // void _FTPChangeParam(void);
 
@@ -24,4 +33,6 @@ private slots:
 private:
     void _noFailureWorker(MockConfiguration::FailureMode_t failureMode);
     void _setParamWithFailureMode(MockLink::ParamSetFailureMode_t failureMode, bool expectSuccess);
+    void _connectFtpParamMockLink();
+    QList<ParameterManager::ParamSetRequest> _ftpWriteRequests(ParameterManager *paramManager, int count);
 };
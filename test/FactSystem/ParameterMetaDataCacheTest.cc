@@ -0,0 +1,121 @@
+#include "ParameterMetaDataCacheTest.h"
+#include "ParameterMetaDataCache.h"
+#include "PX4ParameterMetaData.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+#include <QtCore/QScopeGuard>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+void ParameterMetaDataCacheTest::_testBuildAndFind(void)
+{
+    const QByteArray sourceHash = QCryptographicHash::hash("ParameterMetaDataCacheTest", QCryptographicHash::Sha256);
+
+    QList<ParameterMetaDataCache::Record> records;
+
+    ParameterMetaDataCache::Record record;
+    record.section = QStringLiteral("ArduCopter");
+    record.name = QStringLiteral("RTL_ALT");
+    record.category = QStringLiteral("Standard");
+    record.group = QStringLiteral("RTL");
+    record.shortDescription = QStringLiteral("RTL Altitude");
+    record.units = QStringLiteral("cm");
+    record.min = QStringLiteral("30");
+    record.max = QStringLiteral("300000");
+    record.flags = ParameterMetaDataCache::RebootRequired;
+    records.append(record);
+
+    record = ParameterMetaDataCache::Record();
+    record.section = QStringLiteral("libraries");
+    record.name = QStringLiteral("RTL_ALT");
+    record.group = QStringLiteral("RTL");
+    records.append(record);
+
+    record = ParameterMetaDataCache::Record();
+    record.section = QStringLiteral("ArduCopter");
+    record.name = QStringLiteral("FS_OPTIONS");
+    record.values = { { QStringLiteral("0"), QStringLiteral("Disabled") }, { QStringLiteral("1"), QStringLiteral("Continue") } };
+    record.bitmask = { { QStringLiteral("0"), QStringLiteral("Continue if in auto") }, { QStringLiteral("4"), QStringLiteral("Continue if landing") } };
+    records.append(record);
+
+    const QByteArray blob = ParameterMetaDataCache::build(records, sourceHash);
+
+    ParameterMetaDataCache cache;
+    QVERIFY(!cache.openData(blob, QCryptographicHash::hash("other", QCryptographicHash::Sha256)));
+    QVERIFY(!cache.openData(blob.left(blob.size() - 1), sourceHash));
+    QVERIFY(cache.openData(blob, sourceHash));
+    QCOMPARE(cache.count(), 3);
+
+    ParameterMetaDataCache::Record found;
+    QVERIFY(cache.find(QStringLiteral("ArduCopter"), QStringLiteral("RTL_ALT"), found));
+    QCOMPARE(found.name, QStringLiteral("RTL_ALT"));
+    QCOMPARE(found.category, QStringLiteral("Standard"));
+    QCOMPARE(found.shortDescription, QStringLiteral("RTL Altitude"));
+    QCOMPARE(found.units, QStringLiteral("cm"));
+    QCOMPARE(found.max, QStringLiteral("300000"));
+    QCOMPARE(found.flags, static_cast<quint32>(ParameterMetaDataCache::RebootRequired));
+    QVERIFY(found.longDescription.isEmpty());
+
+    QVERIFY(cache.find(QStringLiteral("libraries"), QStringLiteral("RTL_ALT"), found));
+    QVERIFY(found.shortDescription.isEmpty());
+    QCOMPARE(found.flags, 0u);
+
+    QVERIFY(cache.find(QStringLiteral("ArduCopter"), QStringLiteral("FS_OPTIONS"), found));
+    QCOMPARE(found.values, records[2].values);
+    QCOMPARE(found.bitmask, records[2].bitmask);
+
+    QVERIFY(!cache.find(QStringLiteral("ArduPlane"), QStringLiteral("RTL_ALT"), found));
+    QVERIFY(!cache.find(QStringLiteral("ArduCopter"), QStringLiteral("RTL_ALTX"), found));
+}
+
+void ParameterMetaDataCacheTest::_testPX4MetaDataCache(void)
+{
+    const QString metaDataFile = QStringLiteral(":/FirmwarePlugin/PX4/PX4ParameterFactMetaData.xml");
+    const QByteArray sourceHash = ParameterMetaDataCache::hashFile(metaDataFile);
+    QVERIFY(!sourceHash.isEmpty());
+
+    // Keep the test away from the real cache, which the application may be using
+    const QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    ParameterMetaDataCache::setCacheDirectory(cacheDir.path());
+    const auto restoreCacheDir = qScopeGuard([]() { ParameterMetaDataCache::setCacheDirectory(QString()); });
+    QVERIFY(ParameterMetaDataCache::cacheFileName(sourceHash).startsWith(cacheDir.path()));
+    QVERIFY(!QFile::exists(ParameterMetaDataCache::cacheFileName(sourceHash)));
+
+    // First load parses the xml and writes the cache
+    PX4ParameterMetaData parsedMetaData;
+    parsedMetaData.loadParameterFactMetaDataFile(metaDataFile);
+    QVERIFY(!parsedMetaData.loadedFromCache());
+    QVERIFY(QFile::exists(ParameterMetaDataCache::cacheFileName(sourceHash)));
+
+    // Second load comes from the cache
+    PX4ParameterMetaData cachedMetaData;
+    cachedMetaData.loadParameterFactMetaDataFile(metaDataFile);
+    QVERIFY(cachedMetaData.loadedFromCache());
+
+    for (const QString &name : { QStringLiteral("RC_MAP_THROTTLE"), QStringLiteral("BAT1_N_CELLS") }) {
+        const FactMetaData *const parsed = parsedMetaData.getMetaDataForFact(name, MAV_TYPE_QUADROTOR, FactMetaData::valueTypeInt32);
+        const FactMetaData *const cached = cachedMetaData.getMetaDataForFact(name, MAV_TYPE_QUADROTOR, FactMetaData::valueTypeInt32);
+        QCOMPARE(cached->name(), name);
+        QCOMPARE(cached->type(), parsed->type());
+        QCOMPARE(cached->group(), parsed->group());
+        QCOMPARE(cached->category(), parsed->category());
+        QCOMPARE(cached->shortDescription(), parsed->shortDescription());
+        QCOMPARE(cached->longDescription(), parsed->longDescription());
+        QCOMPARE(cached->rawMin(), parsed->rawMin());
+        QCOMPARE(cached->rawMax(), parsed->rawMax());
+        QCOMPARE(cached->rawDefaultValue(), parsed->rawDefaultValue());
+        QCOMPARE(cached->enumStrings(), parsed->enumStrings());
+        QCOMPARE(cached->enumValues(), parsed->enumValues());
+        QVERIFY(!cached->enumStrings().isEmpty());
+    }
+
+    const FactMetaData *const throttle = cachedMetaData.getMetaDataForFact(QStringLiteral("RC_MAP_THROTTLE"), MAV_TYPE_QUADROTOR, FactMetaData::valueTypeInt32);
+    QCOMPARE(throttle->shortDescription(), QStringLiteral("Throttle control channel mapping"));
+    QCOMPARE(throttle->rawMax().toInt(), 18);
+
+    // Unknown parameters still get generic meta data
+    const FactMetaData *const unknown = cachedMetaData.getMetaDataForFact(QStringLiteral("NOT_A_PARAM"), MAV_TYPE_QUADROTOR, FactMetaData::valueTypeFloat);
+    QCOMPARE(unknown->type(), FactMetaData::valueTypeFloat);
+}
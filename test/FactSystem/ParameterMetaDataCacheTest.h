@@ -0,0 +1,12 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class ParameterMetaDataCacheTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testBuildAndFind(void);
+    void _testPX4MetaDataCache(void);
+};
@@ -0,0 +1,67 @@
+#include "ParameterSearchIndexTest.h"
+#include "ParameterSearchIndex.h"
+
+#include <QtTest/QTest>
+
+void ParameterSearchIndexTest::_testSearch(void)
+{
+    ParameterSearchIndex index;
+
+    QCOMPARE(index.add({ QStringLiteral("BAT1_V_CHARGED"), QStringLiteral("Full cell voltage"), QString(), QString() }), 0);
+    QCOMPARE(index.add({ QStringLiteral("COM_RC_LOSS_T"), QStringLiteral("RC loss time threshold"), QStringLiteral("After this amount of seconds without RC connection the failsafe is triggered"), QString() }), 1);
+    QCOMPARE(index.add({ QStringLiteral("NAV_RCL_ACT"), QStringLiteral("Set RC loss failsafe mode"), QString(), QStringLiteral("Hold mode\nReturn mode\nLand mode") }), 2);
+    QCOMPARE(index.count(), 3);
+
+    // Name, case insensitive
+    QCOMPARE(index.search({ QStringLiteral("bat1") }), QList<int>({ 0 }));
+
+    // Descriptions and enum strings
+    QCOMPARE(index.search({ QStringLiteral("failsafe") }), QList<int>({ 1, 2 }));
+    QCOMPARE(index.search({ QStringLiteral("Return") }), QList<int>({ 2 }));
+
+    // All terms must match
+    QCOMPARE(index.search({ QStringLiteral("failsafe"), QStringLiteral("seconds") }), QList<int>({ 1 }));
+    QCOMPARE(index.search({ QStringLiteral("failsafe"), QStringLiteral("voltage") }), QList<int>());
+
+    // Terms shorter than a trigram
+    QCOMPARE(index.search({ QStringLiteral("rc") }), QList<int>({ 1, 2 }));
+
+    // Regular expressions, anchors apply to each field
+    QCOMPARE(index.search({ QStringLiteral("^nav_") }), QList<int>({ 2 }));
+    QCOMPARE(index.search({ QStringLiteral("^return") }), QList<int>({ 2 }));
+    QCOMPARE(index.search({ QStringLiteral("_T$") }), QList<int>({ 1 }));
+
+    // Invalid regular expression is treated as a plain string
+    QCOMPARE(index.search({ QStringLiteral("(rc") }), QList<int>());
+
+    QCOMPARE(index.search({ QStringLiteral("nomatch") }), QList<int>());
+
+    index.clear();
+    QCOMPARE(index.count(), 0);
+    QCOMPARE(index.search({ QStringLiteral("bat") }), QList<int>());
+}
+
+void ParameterSearchIndexTest::_testIncrementalSearch(void)
+{
+    ParameterSearchIndex index;
+
+    for (int i = 0; i < 2000; i++) {
+        (void) index.add({ QStringLiteral("PARAM_%1").arg(i, 4, 10, QLatin1Char('0')), QStringLiteral("Description %1").arg(i) });
+    }
+
+    // Searching within previous results must give the same answer as a full search
+    const QList<int> previous = index.search({ QStringLiteral("param_01") });
+    QCOMPARE(previous.count(), 100);
+    const QList<int> refined = index.search({ QStringLiteral("param_012") }, &previous);
+    QCOMPARE(refined, index.search({ QStringLiteral("param_012") }));
+    QCOMPARE(refined.count(), 10);
+
+    // Entries added later are found
+    const int id = index.add({ QStringLiteral("LATE_PARAM") });
+    QCOMPARE(index.search({ QStringLiteral("late") }), QList<int>({ id }));
+
+    // Search cost for a typical keystroke against a large parameter set
+    QBENCHMARK {
+        (void) index.search({ QStringLiteral("descr"), QStringLiteral("199") });
+    }
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class ParameterSearchIndexTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testSearch(void);
+    void _testIncrementalSearch(void);
+};
@@ -0,0 +1,64 @@
+#include "SettingsStoreTest.h"
+#include "SettingsStore.h"
+
+#include <QtCore/QSettings>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+
+void SettingsStoreTest::_testCoalescing(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath(QStringLiteral("settings.ini"));
+
+    SettingsStore store(fileName);
+
+    // A slider drag, many changes to the same key
+    constexpr int changeCount = 100;
+    for (int i = 0; i < changeCount; i++) {
+        store.setValue(QStringLiteral("Group"), QStringLiteral("slider"), i);
+    }
+    store.setValue(QString(), QStringLiteral("topLevel"), QStringLiteral("value"));
+
+    // Pending values are visible before they are written
+    QCOMPARE(store.pendingCount(), 2);
+    QCOMPARE(store.value(QStringLiteral("Group"), QStringLiteral("slider")).toInt(), changeCount - 1);
+    QVERIFY(!QSettings(fileName, QSettings::IniFormat).contains(QStringLiteral("Group/slider")));
+
+    store.flush();
+    QCOMPARE(store.pendingCount(), 0);
+    QCOMPARE(store.requestedWriteCount(), static_cast<quint64>(changeCount + 1));
+    QCOMPARE(store.flushedWriteCount(), static_cast<quint64>(2));
+    QCOMPARE(store.coalescedWriteCount(), static_cast<quint64>(changeCount - 1));
+
+    QSettings settings(fileName, QSettings::IniFormat);
+    QCOMPARE(settings.value(QStringLiteral("Group/slider")).toInt(), changeCount - 1);
+    QCOMPARE(settings.value(QStringLiteral("topLevel")).toString(), QStringLiteral("value"));
+    QCOMPARE(store.value(QStringLiteral("Group"), QStringLiteral("slider")).toInt(), changeCount - 1);
+    QCOMPARE(store.value(QStringLiteral("Group"), QStringLiteral("missing"), 42).toInt(), 42);
+}
+
+void SettingsStoreTest::_testBackgroundFlush(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath(QStringLiteral("settings.ini"));
+
+    SettingsStore store(fileName);
+    QSignalSpy flushSpy(&store, &SettingsStore::flushComplete);
+    QVERIFY(flushSpy.isValid());
+
+    store.setValue(QStringLiteral("Group"), QStringLiteral("a"), 1);
+    store.setValue(QStringLiteral("Group"), QStringLiteral("b"), 2);
+    store.setValue(QStringLiteral("Group"), QStringLiteral("a"), 3);
+
+    QVERIFY(flushSpy.wait(SettingsStore::kFlushDelayMs * 4));
+    QCOMPARE(flushSpy.count(), 1);
+    QCOMPARE(flushSpy[0][0].toInt(), 2);
+    QCOMPARE(store.coalescedWriteCount(), static_cast<quint64>(1));
+
+    QSettings settings(fileName, QSettings::IniFormat);
+    QCOMPARE(settings.value(QStringLiteral("Group/a")).toInt(), 3);
+    QCOMPARE(settings.value(QStringLiteral("Group/b")).toInt(), 2);
+}
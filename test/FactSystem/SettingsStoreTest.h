@@ -0,0 +1,12 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class SettingsStoreTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testCoalescing(void);
+    void _testBackgroundFlush(void);
+};
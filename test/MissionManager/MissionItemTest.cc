@@ -2,6 +2,7 @@
 #include "SimpleMissionItem.h"
 #include "PlanMasterController.h"
 #include "MissionItem.h"
+#include "MissionItemStore.h"
 #include "MultiSignalSpy.h"
 
 #include <QtTest/QTest>
@@ -536,3 +537,58 @@ QJsonObject MissionItemTest::_createV3Json(bool allNaNs)
 
     return jsonObject;
 }
+
+void MissionItemTest::_testMissionItemStore(void)
+{
+    const double lat = 47.3977419;
+    const double lon = 8.5455938;
+
+    MissionItem waypoint(0, MAV_CMD_NAV_WAYPOINT, MAV_FRAME_GLOBAL_RELATIVE_ALT, 1, 2, 3, qQNaN(), lat, lon, 50, true, false);
+    MissionItem delay(1, MAV_CMD_CONDITION_DELAY, MAV_FRAME_MISSION, 10, 0, 0, 0, 5, 6, 0, false, false);
+    QList<MissionItem*> missionItems = { &waypoint, &delay };
+
+    MissionItemStore store(missionItems);
+    QCOMPARE(store.count(), 2);
+    QCOMPARE(store.command(0), MAV_CMD_NAV_WAYPOINT);
+    QCOMPARE(store.frame(1), MAV_FRAME_MISSION);
+    QCOMPARE(store.autoContinue(1), false);
+
+    // Global frames are sent as scaled integers
+    mavlink_mission_item_int_t missionItem;
+    store.encode(0, 7, true, missionItem);
+    QCOMPARE(missionItem.seq, static_cast<uint16_t>(7));
+    QCOMPARE(missionItem.current, static_cast<uint8_t>(1));
+    QCOMPARE(missionItem.command, static_cast<uint16_t>(MAV_CMD_NAV_WAYPOINT));
+    QCOMPARE(missionItem.frame, static_cast<uint8_t>(MAV_FRAME_GLOBAL_RELATIVE_ALT));
+    QCOMPARE(missionItem.autocontinue, static_cast<uint8_t>(1));
+    QCOMPARE(missionItem.param1, 1.0f);
+    QCOMPARE(missionItem.param3, 3.0f);
+    QVERIFY(qIsNaN(missionItem.param4));
+    QCOMPARE(missionItem.x, static_cast<int32_t>(lat * 1e7));
+    QCOMPARE(missionItem.y, static_cast<int32_t>(lon * 1e7));
+    QCOMPARE(missionItem.z, 50.0f);
+
+    // MAV_FRAME_MISSION params are sent unscaled
+    store.encode(1, 8, false, missionItem);
+    QCOMPARE(missionItem.current, static_cast<uint8_t>(0));
+    QCOMPARE(missionItem.x, 5);
+    QCOMPARE(missionItem.y, 6);
+
+    // Round trip through the wire representation compares equal, NaN params included
+    MissionItemStore decodedStore;
+    store.encode(0, 0, false, missionItem);
+    decodedStore.append(missionItem);
+    store.encode(1, 1, false, missionItem);
+    decodedStore.append(missionItem);
+    QVERIFY(store.isEqual(0, decodedStore, 0));
+    QVERIFY(store.isEqual(1, decodedStore, 1));
+    QVERIFY(!store.isEqual(0, decodedStore, 1));
+
+    waypoint.setParam7(51);
+    MissionItemStore changedStore(missionItems);
+    QVERIFY(!store.isEqual(0, changedStore, 0));
+    QVERIFY(store.isEqual(1, changedStore, 1));
+
+    store.clear();
+    QVERIFY(store.isEmpty());
+}
@@ -28,6 +28,7 @@ private slots:
     void _testLoadFromJsonV3NaN(void);
     void _testSimpleLoadFromJson(void);
     void _testSaveToJson(void);
+    void _testMissionItemStore(void);
 
 private:
     void _checkExpectedMissionItem(const MissionItem& missionItem, bool allNaNs = false) const;
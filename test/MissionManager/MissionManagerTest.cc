@@ -315,6 +315,82 @@ void MissionManagerTest::_testReadFailureHandlingPX4(void)
     _testReadFailureHandlingWorker();
 }
 
+void MissionManagerTest::_testPartialWriteAPM(void)
+{
+    _initForFirmwareType(MAV_AUTOPILOT_ARDUPILOTMEGA);
+
+    // First write is always a full write since the mission on the vehicle is not known yet
+    _writeItems(MockLinkMissionItemHandler::FailNone, MAV_MISSION_ERROR, false);
+    QCOMPARE(_mockLink->missionItemPartialWriteCount(), 0);
+
+    // Change the altitude of a single item and write again
+    const int changedIndex = 3;
+    const double changedAltitude = _missionManager->missionItems()[changedIndex]->param7() + 10;
+    QList<MissionItem*> missionItems;
+    for (const MissionItem* missionItem: _missionManager->missionItems()) {
+        missionItems.append(new MissionItem(*missionItem, this));
+    }
+    missionItems[changedIndex]->setParam7(changedAltitude);
+
+    _missionManager->writeMissionItems(missionItems);
+    QVERIFY(_missionManager->inProgress());
+    _multiSpyMissionManager->clearAllSignals();
+    _multiSpyMissionManager->waitForSignalByIndex(sendCompleteSignalIndex, _missionManagerSignalWaitTime);
+    QCOMPARE(_multiSpyMissionManager->checkSignalByMask(inProgressChangedSignalMask | sendCompleteSignalMask), true);
+    QCOMPARE(_mockLink->missionItemPartialWriteCount(), 1);
+    _multiSpyMissionManager->clearAllSignals();
+
+    // Vehicle must now have the full mission with the changed item
+    _missionManager->loadFromVehicle();
+    _multiSpyMissionManager->waitForSignalByIndex(inProgressChangedSignalIndex, _missionManagerSignalWaitTime);
+    QCOMPARE(_multiSpyMissionManager->checkSignalByMask(newMissionItemsAvailableSignalMask | inProgressChangedSignalMask), true);
+    QCOMPARE(_missionManager->missionItems().count(), static_cast<int>(_cTestCases) + 1);
+    QCOMPARE(static_cast<float>(_missionManager->missionItems()[changedIndex]->param7()), static_cast<float>(changedAltitude));
+    _multiSpyMissionManager->clearAllSignals();
+}
+
+void MissionManagerTest::_testPartialWriteAfterExternalChangeAPM(void)
+{
+    _initForFirmwareType(MAV_AUTOPILOT_ARDUPILOTMEGA);
+
+    _writeItems(MockLinkMissionItemHandler::FailNone, MAV_MISSION_ERROR, false);
+    QCOMPARE(_mockLink->missionItemPartialWriteCount(), 0);
+
+    const QList<MissionItem*>& vehicleItems = _missionManager->missionItems();
+    const int lastIndex = vehicleItems.count() - 1;
+    const double lastAltitude = vehicleItems[lastIndex]->param7();
+
+    // Another GCS changes the last item, the vehicle announces the new mission id through MISSION_CURRENT
+    QSignalSpy currentIndexSpy(_missionManager, &MissionManager::currentIndexChanged);
+    _mockLink->changeMissionExternally();
+    QVERIFY(currentIndexSpy.wait(_missionManagerSignalWaitTime));
+
+    // Change a different item. Patching only that item would leave the external change to the last item in place.
+    const int changedIndex = 3;
+    const double changedAltitude = vehicleItems[changedIndex]->param7() + 10;
+    QList<MissionItem*> missionItems;
+    for (const MissionItem* missionItem: vehicleItems) {
+        missionItems.append(new MissionItem(*missionItem, this));
+    }
+    missionItems[changedIndex]->setParam7(changedAltitude);
+
+    _multiSpyMissionManager->clearAllSignals();
+    _missionManager->writeMissionItems(missionItems);
+    QVERIFY(_missionManager->inProgress());
+    _multiSpyMissionManager->waitForSignalByIndex(sendCompleteSignalIndex, _missionManagerSignalWaitTime);
+    QCOMPARE(_multiSpyMissionManager->checkSignalByMask(inProgressChangedSignalMask | sendCompleteSignalMask), true);
+    QCOMPARE(_mockLink->missionItemPartialWriteCount(), 0);
+    _multiSpyMissionManager->clearAllSignals();
+
+    _missionManager->loadFromVehicle();
+    _multiSpyMissionManager->waitForSignalByIndex(inProgressChangedSignalIndex, _missionManagerSignalWaitTime);
+    QCOMPARE(_multiSpyMissionManager->checkSignalByMask(newMissionItemsAvailableSignalMask | inProgressChangedSignalMask), true);
+    QCOMPARE(_missionManager->missionItems().count(), lastIndex + 1);
+    QCOMPARE(static_cast<float>(_missionManager->missionItems()[changedIndex]->param7()), static_cast<float>(changedAltitude));
+    QCOMPARE(static_cast<float>(_missionManager->missionItems()[lastIndex]->param7()), static_cast<float>(lastAltitude));
+    _multiSpyMissionManager->clearAllSignals();
+}
+
 void MissionManagerTest::_testErrorAckFailureStrings(void)
 {
     _initForFirmwareType(MAV_AUTOPILOT_PX4);
@@ -13,6 +13,8 @@ private slots:
     //void _testWriteFailureHandlingPX4(void);
     //void _testWriteFailureHandlingAPM(void);
     void _testReadFailureHandlingPX4(void);
+    void _testPartialWriteAPM(void);
+    void _testPartialWriteAfterExternalChangeAPM(void);
     //void _testReadFailureHandlingAPM(void);
     //void _testErrorAckFailureStrings(void);
 
@@ -2,8 +2,13 @@
 #include "MultiSignalSpyV2.h"
 #include "MissionManager.h"
 #include "PlanMasterController.h"
+#include "PlanFileStream.h"
 #include "Vehicle.h"
 
+#include <QtCore/QBuffer>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QTemporaryDir>
 #include <QtTest/QTest>
 
 PlanMasterControllerTest::PlanMasterControllerTest(void)
@@ -63,3 +68,58 @@ void PlanMasterControllerTest::_testActiveVehicleChanged(void) {
     // we make sure it does.
     QVERIFY(spyMissionManager.checkOnlySignalByMask(missionManagerErrorSignalMask));
 }
+
+void PlanMasterControllerTest::_testPlanFileStreamRoundTrip(void)
+{
+    QJsonArray items;
+    for (int i=0; i<5000; i++) {
+        QJsonObject item;
+        item["command"]         = 16;
+        item["autoContinue"]    = (i % 2) == 0;
+        item["params"]          = QJsonArray({ 0, 0.5, QJsonValue(), -1e-7, 47.3977419 + i * 1e-6, 8.5455938, 50.25 });
+        item["type"]            = QStringLiteral("SimpleItem \"quoted\"\n\t\\");
+        items.append(item);
+    }
+    QJsonObject mission;
+    mission["items"]        = items;
+    mission["emptyObject"]  = QJsonObject();
+    mission["emptyArray"]   = QJsonArray();
+    QJsonObject plan;
+    plan["mission"] = mission;
+    plan["version"] = 1;
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QString errorString;
+    QVERIFY(PlanFileStream::writeJsonObject(buffer, plan, errorString));
+    buffer.close();
+
+    QJsonParseError parseError;
+    const QJsonDocument jsonDoc = QJsonDocument::fromJson(buffer.data(), &parseError);
+    QCOMPARE(parseError.error, QJsonParseError::NoError);
+    QCOMPARE(jsonDoc.object(), plan);
+}
+
+void PlanMasterControllerTest::_testPlanFileSaveLoad(void)
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    _masterController->loadFromFile(":/unittest/SectionTest.plan");
+    const int visualItemCount = _masterController->missionController()->visualItems()->count();
+    QVERIFY(visualItemCount > 1);
+
+    const QString planFile = tempDir.filePath(QStringLiteral("roundtrip.plan"));
+    _masterController->saveToFile(planFile);
+    // Normalize through QJsonDocument so NaN values compare as the null they are saved as
+    const QJsonObject savedJson = QJsonDocument::fromJson(_masterController->saveToJson().toJson()).object();
+
+    _masterController->removeAll();
+    _masterController->loadFromFile(planFile);
+    QCOMPARE(_masterController->missionController()->visualItems()->count(), visualItemCount);
+
+    QJsonObject reloadedJson;
+    QString errorString;
+    QVERIFY(PlanFileStream::readJsonObject(planFile, reloadedJson, errorString));
+    QCOMPARE(reloadedJson, savedJson);
+}
@@ -17,6 +17,8 @@ private slots:
 
     void _testMissionPlannerFileLoad(void);
     void _testActiveVehicleChanged(void);
+    void _testPlanFileStreamRoundTrip(void);
+    void _testPlanFileSaveLoad(void);
 
 private:
     PlanMasterController*   _masterController;
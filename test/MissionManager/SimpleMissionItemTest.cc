@@ -9,7 +9,10 @@
 #include "Vehicle.h"
 #include "MissionCommandTree.h"
 #include "MissionCommandUIInfo.h"
+#include "FactMetaData.h"
 
+#include <QtCore/QPointer>
+#include <QtCore/QSet>
 #include <QtTest/QTest>
 
 SimpleMissionItemTest::SimpleMissionItemTest(void)
@@ -367,3 +370,83 @@ void SimpleMissionItemTest::_testAltitudePropogation(void)
     QCOMPARE(_simpleItem->altitude()->rawValue().toDouble(), _simpleItem->missionItem().param7());
     QCOMPARE(_simpleItem->missionItem().frame(), MAV_FRAME_GLOBAL);
 }
+
+void SimpleMissionItemTest::_testSharedMetaData(void)
+{
+    MissionItem missionItem(2,              // sequence number
+                            MAV_CMD_NAV_WAYPOINT,
+                            MAV_FRAME_GLOBAL_RELATIVE_ALT,
+                            1, 2, 3, 4,     // param 1-4
+                            50.1234567,
+                            60.1234567,
+                            70.1234567,
+                            true,           // autoContinue
+                            false);         // isCurrentItem
+    SimpleMissionItem* otherItem = new SimpleMissionItem(_masterController, false /* flyView */, missionItem);
+
+    // Items with the same command must share the param meta data instead of each holding a copy
+    QVERIFY(_simpleItem->textFieldFacts()->count() > 0);
+    QCOMPARE(otherItem->textFieldFacts()->count(), _simpleItem->textFieldFacts()->count());
+    for (int i=0; i<_simpleItem->textFieldFacts()->count(); i++) {
+        Fact* fact = _simpleItem->textFieldFacts()->value<Fact*>(i);
+        Fact* otherFact = otherItem->textFieldFacts()->value<Fact*>(i);
+        QVERIFY(fact != otherFact);
+        QCOMPARE(fact->metaData(), otherFact->metaData());
+    }
+
+    // However many items use the command, the number of param meta data objects stays at one per param
+    QList<SimpleMissionItem*> moreItems;
+    QSet<FactMetaData*> metaDataObjects;
+    for (int i=0; i<20; i++) {
+        SimpleMissionItem* item = new SimpleMissionItem(_masterController, false /* flyView */, missionItem);
+        moreItems.append(item);
+        for (int j=0; j<item->textFieldFacts()->count(); j++) {
+            metaDataObjects.insert(item->textFieldFacts()->value<Fact*>(j)->metaData());
+        }
+    }
+    QCOMPARE(metaDataObjects.count(), _simpleItem->textFieldFacts()->count());
+    qDeleteAll(moreItems);
+
+    // Json file maps are shared per file and settings group
+    const QString jsonFile = QStringLiteral(":/json/CameraCalc.FactMetaData.json");
+    const QMap<QString, FactMetaData*>& map1 = FactMetaData::sharedMapFromJsonFile(jsonFile, QStringLiteral("Survey"));
+    const QMap<QString, FactMetaData*>& map2 = FactMetaData::sharedMapFromJsonFile(jsonFile, QStringLiteral("Survey"));
+    const QMap<QString, FactMetaData*>& map3 = FactMetaData::sharedMapFromJsonFile(jsonFile, QStringLiteral("CorridorScan"));
+    QVERIFY(!map1.isEmpty());
+    QCOMPARE(&map1, &map2);
+    QVERIFY(&map1 != &map3);
+    QVERIFY(FactMetaData::sharedMapMemoryReport().count() > 0);
+
+    delete otherItem;
+}
+
+void SimpleMissionItemTest::_testSharedMetaDataAssignment(void)
+{
+    bool showUI = false;
+    const MissionCommandUIInfo* uiInfo = MissionCommandTree::instance()->getUIInfo(_controllerVehicle, QGCMAVLink::VehicleClassGeneric, MAV_CMD_NAV_WAYPOINT);
+    QVERIFY(uiInfo);
+    const MissionCmdParamInfo* holdInfo = uiInfo->getParamInfo(1, showUI);
+    const MissionCmdParamInfo* acceptanceInfo = uiInfo->getParamInfo(2, showUI);
+    QVERIFY(holdInfo);
+    QVERIFY(acceptanceInfo);
+    QVERIFY(holdInfo->label() != acceptanceInfo->label());
+
+    MissionCmdParamInfo paramInfo(*holdInfo);
+    FactMetaData* oldMetaData = paramInfo.factMetaData();
+    QCOMPARE(paramInfo.factMetaData(), oldMetaData);
+    QPointer<FactMetaData> oldMetaDataGuard(oldMetaData);
+
+    Fact fact(0, QStringLiteral("param1"), FactMetaData::valueTypeDouble);
+    fact.setMetaData(oldMetaData);
+
+    // Assignment must not free meta data which existing Facts still point to
+    paramInfo = *acceptanceInfo;
+    QVERIFY(!oldMetaDataGuard.isNull());
+    QCOMPARE(fact.metaData(), oldMetaData);
+    QCOMPARE(fact.metaData()->name(), holdInfo->label());
+
+    // New users get meta data matching the assigned values
+    FactMetaData* newMetaData = paramInfo.factMetaData();
+    QVERIFY(newMetaData != oldMetaData);
+    QCOMPARE(newMetaData->name(), acceptanceInfo->label());
+}
@@ -27,6 +27,8 @@ private slots:
     void _testCameraSection         (void);
     void _testSpeedSection          (void);
     void _testAltitudePropogation   (void);
+    void _testSharedMetaData        (void);
+    void _testSharedMetaDataAssignment(void);
 
 private:
     enum {
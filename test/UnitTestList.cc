@@ -8,10 +8,14 @@
 // AnalyzeView
 #include "ExifParserTest.h"
 #include "GeoTagControllerTest.h"
+#include "LogBatchAnalyzerTest.h"
 // #include "MavlinkLogTest.h"
 #include "LogDownloadTest.h"
+#include "MAVLinkMessageCountersTest.h"
 #include "PX4LogParserTest.h"
+#include "TimeSeriesBufferTest.h"
 #include "ULogParserTest.h"
+#include "ULogTopicExtractorTest.h"
 
 // AutoPilotPlugins
 // #include "RadioConfigTest.h"
@@ -26,6 +30,9 @@
 #include "FactSystemTestGeneric.h"
 #include "FactSystemTestPX4.h"
 #include "ParameterManagerTest.h"
+#include "ParameterMetaDataCacheTest.h"
+#include "ParameterSearchIndexTest.h"
+#include "SettingsStoreTest.h"
 
 // FollowMe
 #include "FollowMeTest.h"
@@ -80,6 +87,7 @@
 #include "QGCArchiveModelTest.h"
 #include "QGCCompressionTest.h"
 #include "QGCStreamingDecompressionTest.h"
+#include "QGCZstdSeekableTest.h"
 // FileSystem
 #include "QGCArchiveWatcherTest.h"
 #include "QGCFileDownloadTest.h"
@@ -87,6 +95,8 @@
 #include "QGCFileWatcherTest.h"
 // Geo
 #include "GeoTest.h"
+// Network
+#include "QGCResumableUploaderTest.h"
 // Shape
 #include "ShapeTest.h"
 
@@ -116,10 +126,14 @@ int QGCUnitTest::runTests(bool stress, const QStringList& unitTests)
     // AnalyzeView
     UT_REGISTER_TEST(ExifParserTest)
     UT_REGISTER_TEST(GeoTagControllerTest)
+    UT_REGISTER_TEST(LogBatchAnalyzerTest)
     // UT_REGISTER_TEST(MavlinkLogTest)
     UT_REGISTER_TEST(LogDownloadTest)
+    UT_REGISTER_TEST(MAVLinkMessageCountersTest)
     UT_REGISTER_TEST(PX4LogParserTest)
+    UT_REGISTER_TEST(TimeSeriesBufferTest)
     UT_REGISTER_TEST(ULogParserTest)
+    UT_REGISTER_TEST(ULogTopicExtractorTest)
 
     // AutoPilotPlugins
     // UT_REGISTER_TEST(RadioConfigTest)
@@ -134,6 +148,9 @@ int QGCUnitTest::runTests(bool stress, const QStringList& unitTests)
     UT_REGISTER_TEST(FactSystemTestGeneric)
     UT_REGISTER_TEST(FactSystemTestPX4)
     UT_REGISTER_TEST(ParameterManagerTest)
+    UT_REGISTER_TEST(ParameterMetaDataCacheTest)
+    UT_REGISTER_TEST(ParameterSearchIndexTest)
+    UT_REGISTER_TEST(SettingsStoreTest)
 
     // FollowMe
     UT_REGISTER_TEST(FollowMeTest)
@@ -186,6 +203,7 @@ int QGCUnitTest::runTests(bool stress, const QStringList& unitTests)
     UT_REGISTER_TEST(QGCArchiveModelTest)
     UT_REGISTER_TEST(QGCCompressionTest)
     UT_REGISTER_TEST(QGCStreamingDecompressionTest)
+    UT_REGISTER_TEST(QGCZstdSeekableTest)
     // FileSystem
     UT_REGISTER_TEST(QGCArchiveWatcherTest)
     UT_REGISTER_TEST(QGCFileDownloadTest)
@@ -193,6 +211,8 @@ int QGCUnitTest::runTests(bool stress, const QStringList& unitTests)
     UT_REGISTER_TEST(QGCFileWatcherTest)
     // Geo
     UT_REGISTER_TEST(GeoTest)
+    // Network
+    UT_REGISTER_TEST(QGCResumableUploaderTest)
     // Shape
     UT_REGISTER_TEST(ShapeTest)
 
@@ -0,0 +1,210 @@
+#include "QGCZstdSeekableTest.h"
+#include "QGCDecompressDevice.h"
+#include "QGCZstdSeekable.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QRandomGenerator>
+#include <QtTest/QTest>
+
+namespace {
+constexpr qint64 kFrameSize = 64 * 1024;
+}
+
+void QGCZstdSeekableTest::init()
+{
+    UnitTest::init();
+    _tempDir = new QTemporaryDir();
+    QVERIFY(_tempDir->isValid());
+}
+
+void QGCZstdSeekableTest::cleanup()
+{
+    delete _tempDir;
+    _tempDir = nullptr;
+    UnitTest::cleanup();
+}
+
+QByteArray QGCZstdSeekableTest::_testData(qsizetype size)
+{
+    QRandomGenerator rng(42);
+    QByteArray data;
+    data.reserve(size);
+    quint64 timestamp = 1700000000000000ULL;
+    while (data.size() < size) {
+        timestamp += 1000 + rng.bounded(200);
+        (void) data.append(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp));
+        (void) data.append(QByteArray(16, static_cast<char>(rng.bounded(4))));
+        (void) data.append(static_cast<char>(rng.bounded(256)));
+    }
+    data.truncate(size);
+    return data;
+}
+
+QByteArray QGCZstdSeekableTest::_writeSeekable(const QString &fileName, const QByteArray &data, qint64 frameSize)
+{
+    QFile out(fileName);
+    if (!out.open(QIODevice::WriteOnly)) {
+        return QByteArray();
+    }
+
+    QGCZstdSeekableWriter writer(&out);
+    writer.setFrameSize(frameSize);
+    if (!writer.open(QIODevice::WriteOnly)) {
+        return QByteArray();
+    }
+
+    // Uneven chunks so frames are filled across several writes
+    constexpr qsizetype chunkSize = 10000;
+    for (qsizetype pos = 0; pos < data.size(); pos += chunkSize) {
+        const QByteArray chunk = data.mid(pos, chunkSize);
+        if (writer.write(chunk) != chunk.size()) {
+            return QByteArray();
+        }
+    }
+    if (!writer.finish()) {
+        return QByteArray();
+    }
+    writer.close();
+    out.close();
+
+    if (!out.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return out.readAll();
+}
+
+void QGCZstdSeekableTest::_testRoundTrip()
+{
+    const QByteArray data = _testData(1024 * 1024 + 123);
+    const QString fileName = _tempDir->filePath("roundtrip.tlog.zst");
+    const QByteArray compressed = _writeSeekable(fileName, data, kFrameSize);
+    QVERIFY(!compressed.isEmpty());
+    QVERIFY(compressed.size() < data.size());
+    QVERIFY(QGCZstdSeekable::isZstdFile(fileName));
+
+    QGCZstdSeekableDevice device(fileName);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QVERIFY(device.hasSeekTable());
+    QVERIFY(!device.isSequential());
+    QCOMPARE(device.frameCount(), static_cast<int>((data.size() + kFrameSize - 1) / kFrameSize));
+    QCOMPARE(device.size(), data.size());
+    QCOMPARE(device.readAll(), data);
+    QVERIFY(device.atEnd());
+}
+
+void QGCZstdSeekableTest::_testReadableAsPlainZstd()
+{
+    const QByteArray data = _testData(300 * 1024);
+    const QString fileName = _tempDir->filePath("plain.tlog.zst");
+    QVERIFY(!_writeSeekable(fileName, data, kFrameSize).isEmpty());
+
+    // A regular zstd decoder reads the frames back to back and skips the seek table
+    QGCDecompressDevice device(fileName);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QCOMPARE(device.readAll(), data);
+}
+
+void QGCZstdSeekableTest::_testRandomSeek()
+{
+    const QByteArray data = _testData(1024 * 1024);
+    const QString fileName = _tempDir->filePath("seek.tlog.zst");
+    QVERIFY(!_writeSeekable(fileName, data, kFrameSize).isEmpty());
+
+    QGCZstdSeekableDevice device(fileName);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+
+    QRandomGenerator rng(7);
+    for (int i = 0; i < 200; i++) {
+        const qint64 pos = rng.bounded(static_cast<int>(data.size()));
+        const qint64 length = rng.bounded(static_cast<int>(2 * kFrameSize));
+        QVERIFY(device.seek(pos));
+        QCOMPARE(device.pos(), pos);
+        QCOMPARE(device.read(length), data.mid(pos, length));
+    }
+
+    // Byte-wise reads across a frame boundary, as done by the replay parser
+    QVERIFY(device.seek(kFrameSize - 4));
+    for (qint64 pos = kFrameSize - 4; pos < kFrameSize + 4; pos++) {
+        char c = 0;
+        QVERIFY(device.getChar(&c));
+        QCOMPARE(c, data.at(pos));
+    }
+
+    QVERIFY(device.reset());
+    QCOMPARE(device.read(16), data.left(16));
+}
+
+void QGCZstdSeekableTest::_testWithoutSeekTable()
+{
+    const QByteArray data = _testData(500 * 1024);
+    const QString fileName = _tempDir->filePath("notable.tlog.zst");
+    const QByteArray compressed = _writeSeekable(fileName, data, kFrameSize);
+    QVERIFY(!compressed.isEmpty());
+
+    const int frames = static_cast<int>((data.size() + kFrameSize - 1) / kFrameSize);
+    const qsizetype tableSize = QGCZstdSeekable::kSkippableHeaderSize + (frames * 8) + QGCZstdSeekable::kSeekTableFooterSize;
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QCOMPARE(file.write(compressed.left(compressed.size() - tableSize)), compressed.size() - tableSize);
+    file.close();
+
+    QGCZstdSeekableDevice device(fileName);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QVERIFY(!device.hasSeekTable());
+    QCOMPARE(device.frameCount(), frames);
+    QCOMPARE(device.size(), data.size());
+
+    QVERIFY(device.seek(data.size() / 2));
+    QCOMPARE(device.read(1000), data.mid(data.size() / 2, 1000));
+}
+
+void QGCZstdSeekableTest::_testTruncatedFrame()
+{
+    const QByteArray data = _testData(500 * 1024);
+    const QString fileName = _tempDir->filePath("truncated.tlog.zst");
+    const QByteArray compressed = _writeSeekable(fileName, data, kFrameSize);
+    QVERIFY(!compressed.isEmpty());
+
+    // Cut into the last frame, as left behind by an interrupted writer
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QCOMPARE(file.write(compressed.left(compressed.size() - 100)), compressed.size() - 100);
+    file.close();
+
+    QGCZstdSeekableDevice device(fileName);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QVERIFY(!device.hasSeekTable());
+
+    const qint64 completeSize = (data.size() / kFrameSize) * kFrameSize;
+    QCOMPARE(device.size(), completeSize);
+    QCOMPARE(device.readAll(), data.left(completeSize));
+}
+
+void QGCZstdSeekableTest::_testEmpty()
+{
+    const QString fileName = _tempDir->filePath("empty.tlog.zst");
+    QVERIFY(!_writeSeekable(fileName, QByteArray(), kFrameSize).isEmpty());
+
+    QGCZstdSeekableDevice device(fileName);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QVERIFY(device.hasSeekTable());
+    QCOMPARE(device.size(), static_cast<qint64>(0));
+    QVERIFY(device.readAll().isEmpty());
+}
+
+void QGCZstdSeekableTest::_testNotZstd()
+{
+    const QString fileName = _tempDir->filePath("raw.tlog");
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QVERIFY(file.write(_testData(1024)) == 1024);
+    file.close();
+
+    QVERIFY(!QGCZstdSeekable::isZstdFile(fileName));
+    QVERIFY(!QGCZstdSeekable::isZstdFile(_tempDir->filePath("missing.tlog")));
+
+    QGCZstdSeekableDevice device(fileName);
+    QVERIFY(!device.open(QIODevice::ReadOnly));
+    QVERIFY(!device.errorString().isEmpty());
+}
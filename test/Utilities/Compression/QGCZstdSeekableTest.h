@@ -0,0 +1,37 @@
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QtCore/QTemporaryDir>
+
+/// Tests for QGCZstdSeekableWriter and QGCZstdSeekableDevice
+/// Seekable zstd format used for compressed telemetry logs
+class QGCZstdSeekableTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    QGCZstdSeekableTest() = default;
+
+private slots:
+    void init() override;
+    void cleanup() override;
+
+    void _testRoundTrip();
+    void _testReadableAsPlainZstd();
+    void _testRandomSeek();
+    void _testWithoutSeekTable();
+    void _testTruncatedFrame();
+    void _testEmpty();
+    void _testNotZstd();
+
+private:
+    /// Writes data as a seekable zstd file
+    /// @return Compressed file contents
+    QByteArray _writeSeekable(const QString &fileName, const QByteArray &data, qint64 frameSize);
+
+    /// Log-like test data which compresses but not trivially
+    static QByteArray _testData(qsizetype size);
+
+    QTemporaryDir *_tempDir = nullptr;
+};
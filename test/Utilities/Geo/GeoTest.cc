@@ -417,3 +417,76 @@ void GeoTest::_interpolateAtDistance_test()
     const auto same = QGCGeo::interpolateAtDistance(m_origin, m_origin, 100.0);
     QCOMPARE(same, m_origin);
 }
+
+void GeoTest::_filterCloseVertices_test()
+{
+    // Vertices ~1.1m apart are merged into the last kept vertex
+    QList<QGeoCoordinate> vertices = {
+        m_origin,
+        m_origin.atDistanceAndAzimuth(1.1, 90),
+        m_origin.atDistanceAndAzimuth(2.2, 90),
+        m_origin.atDistanceAndAzimuth(100, 90),
+        m_origin.atDistanceAndAzimuth(100, 0),
+    };
+    QGCGeo::filterCloseVertices(vertices, 5.0, 3);
+    QCOMPARE(vertices.count(), 3);
+    QCOMPARE(vertices[0], m_origin);
+
+    // Never filters below the minimum vertex count
+    vertices = { m_origin, m_origin.atDistanceAndAzimuth(1, 90), m_origin.atDistanceAndAzimuth(2, 90) };
+    QGCGeo::filterCloseVertices(vertices, 5.0, 2);
+    QCOMPARE(vertices.count(), 2);
+
+    // Disabled
+    vertices = { m_origin, m_origin.atDistanceAndAzimuth(1, 90), m_origin.atDistanceAndAzimuth(2, 90) };
+    QGCGeo::filterCloseVertices(vertices, 0, 2);
+    QCOMPARE(vertices.count(), 3);
+}
+
+void GeoTest::_simplifyPath_test()
+{
+    // Noisy circle of 10000 vertices with a 1km radius
+    QList<QGeoCoordinate> ring;
+    constexpr int cVertices = 10000;
+    for (int i = 0; i < cVertices; i++) {
+        const double radius = 1000.0 + (((i % 2) == 0) ? 0.5 : -0.5);
+        ring.append(m_origin.atDistanceAndAzimuth(radius, (360.0 * i) / cVertices));
+    }
+    const double originalArea = QGCGeo::polygonArea(ring);
+
+    for (const bool visvalingam : { false, true }) {
+        const QList<QGeoCoordinate> simplified = visvalingam ?
+            QGCGeo::simplifyVisvalingam(ring, 200, true) :
+            QGCGeo::simplifyDouglasPeucker(ring, 200, true);
+        QCOMPARE(simplified.count(), 200);
+
+        // Vertices are kept in their original order
+        int lastIndex = -1;
+        for (const QGeoCoordinate &coord : simplified) {
+            const int index = static_cast<int>(ring.indexOf(coord));
+            QVERIFY(index > lastIndex);
+            lastIndex = index;
+        }
+
+        // Shape is preserved
+        QVERIFY(compareDoubles(QGCGeo::polygonArea(simplified), originalArea, originalArea * 0.01));
+    }
+
+    // Open path keeps its end points
+    QList<QGeoCoordinate> path;
+    for (int i = 0; i < 1000; i++) {
+        path.append(m_origin.atDistanceAndAzimuth(i * 10.0, 90).atDistanceAndAzimuth((i % 2) ? 1 : 0, 0));
+    }
+    for (const bool visvalingam : { false, true }) {
+        const QList<QGeoCoordinate> simplified = visvalingam ?
+            QGCGeo::simplifyVisvalingam(path, 10, false) :
+            QGCGeo::simplifyDouglasPeucker(path, 10, false);
+        QCOMPARE(simplified.count(), 10);
+        QCOMPARE(simplified.first(), path.first());
+        QCOMPARE(simplified.last(), path.last());
+    }
+
+    // Already under budget
+    QCOMPARE(QGCGeo::simplifyVisvalingam(path, 2000, false).count(), path.count());
+    QCOMPARE(QGCGeo::simplifyDouglasPeucker(path, 0, false).count(), path.count());
+}
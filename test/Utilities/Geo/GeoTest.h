@@ -46,6 +46,9 @@ private slots:
     void _interpolatePath_test(void);
     void _interpolateAtDistance_test(void);
 
+    void _filterCloseVertices_test(void);
+    void _simplifyPath_test(void);
+
 private:
      /// Use ETH campus (47.3764° N, 8.5481° E)
     const QGeoCoordinate m_origin{47.3764, 8.5481, 0.0};
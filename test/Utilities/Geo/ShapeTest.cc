@@ -8,6 +8,8 @@
 #include <QtCore/QTextStream>
 #include <QtTest/QTest>
 
+#include <algorithm>
+
 QString ShapeTest::_copyRes(const QTemporaryDir &tmpDir, const QString &name)
 {
     const QString dstPath = tmpDir.filePath(name);
@@ -299,6 +301,66 @@ void ShapeTest::_testKMLVertexFiltering()
     QVERIFY(filteredCoords.count() >= 3);  // Minimum valid polygon
 }
 
+void ShapeTest::_testImportSimplification()
+{
+    const QTemporaryDir tmpDir;
+
+    // Two dense polygons, each with 20000 vertices
+    constexpr int cVertices = 20000;
+    QString kmlContent = QStringLiteral("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<kml xmlns=\"http://www.opengis.net/kml/2.2\"><Document>\n");
+    for (int polygon = 0; polygon < 2; polygon++) {
+        const QGeoCoordinate center(47.0 + polygon, 8.0);
+        kmlContent += QStringLiteral("<Placemark><Polygon><outerBoundaryIs><LinearRing><coordinates>\n");
+        for (int i = 0; i <= cVertices; i++) {
+            const QGeoCoordinate coord = center.atDistanceAndAzimuth(5000, (360.0 * (i % cVertices)) / cVertices);
+            kmlContent += QStringLiteral("%1,%2,0\n").arg(coord.longitude(), 0, 'f', 9).arg(coord.latitude(), 0, 'f', 9);
+        }
+        kmlContent += QStringLiteral("</coordinates></LinearRing></outerBoundaryIs></Polygon></Placemark>\n");
+    }
+    kmlContent += QStringLiteral("</Document></kml>\n");
+    const QString kmlFile = _writeKmlFile(tmpDir, "large_polygons.kml", kmlContent);
+
+    ShapeFileHelper::ImportOptions options;
+    options.filterMeters = 0;
+    options.simplification = ShapeFileHelper::SimplificationMethod::Visvalingam;
+    options.maxVerticesPerShape = 500;
+    QList<qsizetype> simplifiedCounts;
+    options.shapeSimplified = [&simplifiedCounts](qsizetype originalCount, qsizetype importedCount) {
+        simplifiedCounts << originalCount << importedCount;
+    };
+    QList<double> progressValues;
+    options.progress = [&progressValues](double progress) {
+        progressValues.append(progress);
+    };
+
+    QString errorString;
+    QList<QList<QGeoCoordinate>> polygons;
+    QVERIFY(ShapeFileHelper::loadPolygonsFromFile(kmlFile, polygons, errorString, options));
+    QVERIFY(errorString.isEmpty());
+    QCOMPARE(polygons.count(), 2);
+    QCOMPARE(polygons[0].count(), 500);
+    QCOMPARE(polygons[1].count(), 500);
+    QCOMPARE(simplifiedCounts, (QList<qsizetype>{ cVertices, 500, cVertices, 500 }));
+
+    // Progress only moves forward, is throttled and ends at 1
+    QVERIFY(!progressValues.isEmpty());
+    QVERIFY(std::is_sorted(progressValues.cbegin(), progressValues.cend()));
+    QVERIFY(progressValues.count() <= static_cast<int>(1.0 / ShapeFileHelper::ProgressReporter::kProgressStep) + 1);
+    QCOMPARE(progressValues.last(), 1.0);
+
+    // Reading stops once the requested number of shapes is found
+    options.maxShapes = 1;
+    options.simplification = ShapeFileHelper::SimplificationMethod::DouglasPeucker;
+    QVERIFY(ShapeFileHelper::loadPolygonsFromFile(kmlFile, polygons, errorString, options));
+    QCOMPARE(polygons.count(), 1);
+    QCOMPARE(polygons[0].count(), 500);
+
+    // No simplification keeps every vertex except the closing duplicate
+    options.simplification = ShapeFileHelper::SimplificationMethod::None;
+    QVERIFY(ShapeFileHelper::loadPolygonsFromFile(kmlFile, polygons, errorString, options));
+    QCOMPARE(polygons[0].count(), cVertices);
+}
+
 void ShapeTest::_testKMLAltitudeParsing()
 {
     const QTemporaryDir tmpDir;
@@ -23,6 +23,7 @@ private slots:
     void _testLoadFromQtResource();
     void _testVertexFiltering();
     void _testKMLVertexFiltering();
+    void _testImportSimplification();
     void _testKMLAltitudeParsing();
     void _testKMLCoordinateValidation();
     void _testKMLExportSchemaValidation();
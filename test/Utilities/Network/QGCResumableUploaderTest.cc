@@ -0,0 +1,360 @@
+#include "QGCResumableUploaderTest.h"
+#include "QGCResumableUploader.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QTemporaryDir>
+#include <QtHttpServer/QHttpServer>
+#include <QtHttpServer/QHttpServerRequest>
+#include <QtHttpServer/QHttpServerResponse>
+#include <QtNetwork/QHttpHeaders>
+#include <QtNetwork/QTcpServer>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+
+namespace {
+
+/// Minimal tus server: POST /files creates an upload, HEAD and PATCH /files/<id> query and append to it
+class TusServer
+{
+public:
+    struct Upload {
+        qint64 length = 0;
+        QByteArray data;
+        QHash<QString, QString> metadata;
+    };
+
+    TusServer()
+    {
+        _server.route(QStringLiteral("/files"), QHttpServerRequest::Method::Post, [this](const QHttpServerRequest &request) {
+            return _create(request);
+        });
+        _server.route(QStringLiteral("/files/<arg>"), QHttpServerRequest::Method::Head | QHttpServerRequest::Method::Patch, [this](const QString &id, const QHttpServerRequest &request) {
+            return _upload(id, request);
+        });
+    }
+
+    bool listen()
+    {
+        QTcpServer *const tcpServer = new QTcpServer(&_server);
+        if (!tcpServer->listen(QHostAddress::LocalHost) || !_server.bind(tcpServer)) {
+            return false;
+        }
+
+        _endpoint = QUrl(QStringLiteral("http://127.0.0.1:%1/files").arg(tcpServer->serverPort()));
+        return true;
+    }
+
+    QUrl endpoint() const { return _endpoint; }
+
+    QHash<QString, Upload> uploads;
+    int headCount = 0;
+    int patchCount = 0;             ///< Accepted PATCH requests
+    qint64 bytesReceived = 0;       ///< Data of accepted PATCH requests
+    int failPatchAfter = -1;        ///< PATCH requests fail once this many have been accepted, -1 for never
+    int activeCount = 0;            ///< Uploads created and not yet complete
+    int maxActiveCount = 0;
+
+private:
+    static QHttpServerResponse _response(QHttpServerResponse::StatusCode statusCode, qint64 offset = -1)
+    {
+        QHttpServerResponse response(statusCode);
+        QHttpHeaders headers;
+        (void) headers.append("Tus-Resumable", "1.0.0");
+        if (offset >= 0) {
+            (void) headers.append("Upload-Offset", QByteArray::number(offset));
+        }
+        response.setHeaders(std::move(headers));
+        return response;
+    }
+
+    QHttpServerResponse _create(const QHttpServerRequest &request)
+    {
+        const QHttpHeaders headers = request.headers();
+        bool ok = false;
+        const qint64 length = headers.value("Upload-Length").toByteArray().toLongLong(&ok);
+        if (!ok || (headers.value("Tus-Resumable").toByteArray() != QByteArrayLiteral("1.0.0"))) {
+            return QHttpServerResponse(QHttpServerResponse::StatusCode::BadRequest);
+        }
+
+        Upload upload;
+        upload.length = length;
+        const QByteArrayList pairs = headers.value("Upload-Metadata").toByteArray().split(',');
+        for (const QByteArray &pair : pairs) {
+            const QByteArrayList keyValue = pair.split(' ');
+            if (keyValue.count() == 2) {
+                upload.metadata.insert(QString::fromUtf8(keyValue[0]), QString::fromUtf8(QByteArray::fromBase64(keyValue[1])));
+            }
+        }
+
+        const QString id = QString::number(++_nextId);
+        uploads.insert(id, upload);
+        activeCount++;
+        maxActiveCount = qMax(maxActiveCount, activeCount);
+
+        // Relative location, the client resolves it against the endpoint
+        QHttpServerResponse response(QHttpServerResponse::StatusCode::Created);
+        QHttpHeaders responseHeaders;
+        (void) responseHeaders.append("Tus-Resumable", "1.0.0");
+        (void) responseHeaders.append("Location", QByteArrayLiteral("/files/") + id.toUtf8());
+        response.setHeaders(std::move(responseHeaders));
+        return response;
+    }
+
+    QHttpServerResponse _upload(const QString &id, const QHttpServerRequest &request)
+    {
+        const auto it = uploads.find(id);
+        if (it == uploads.end()) {
+            return QHttpServerResponse(QHttpServerResponse::StatusCode::NotFound);
+        }
+
+        if (request.method() == QHttpServerRequest::Method::Head) {
+            headCount++;
+            return _response(QHttpServerResponse::StatusCode::Ok, it->data.size());
+        }
+
+        if ((failPatchAfter >= 0) && (patchCount >= failPatchAfter)) {
+            return QHttpServerResponse(QHttpServerResponse::StatusCode::InternalServerError);
+        }
+
+        bool ok = false;
+        const qint64 offset = request.headers().value("Upload-Offset").toByteArray().toLongLong(&ok);
+        if (!ok || (offset != it->data.size())) {
+            return _response(QHttpServerResponse::StatusCode::Conflict);
+        }
+
+        const QByteArray body = request.body();
+        if ((offset + body.size()) > it->length) {
+            return QHttpServerResponse(QHttpServerResponse::StatusCode::BadRequest);
+        }
+
+        it->data.append(body);
+        patchCount++;
+        bytesReceived += body.size();
+        if (it->data.size() == it->length) {
+            activeCount--;
+        }
+
+        return _response(QHttpServerResponse::StatusCode::NoContent, it->data.size());
+    }
+
+    QHttpServer _server;
+    QUrl _endpoint;
+    int _nextId = 0;
+};
+
+QByteArray testData(qsizetype size, char seed)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (qsizetype i = 0; i < size; i++) {
+        data[i] = static_cast<char>(seed + (i * 7));
+    }
+    return data;
+}
+
+QString writeFile(const QTemporaryDir &dir, const QString &name, const QByteArray &data)
+{
+    const QString fileName = dir.filePath(name);
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly) || (file.write(data) != data.size())) {
+        return QString();
+    }
+    return fileName;
+}
+
+} // namespace
+
+void QGCResumableUploaderTest::_testChunkedUpload()
+{
+    TusServer server;
+    QVERIFY(server.listen());
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QByteArray data = testData((100 * 1024) + 17, 1);
+    const QString fileName = writeFile(dir, QStringLiteral("chunked.ulg"), data);
+    QVERIFY(!fileName.isEmpty());
+
+    QGCResumableUploader uploader;
+    uploader.setEndpoint(server.endpoint());
+    uploader.setChunkSize(16 * 1024);
+
+    QSignalSpy progressSpy(&uploader, &QGCResumableUploader::progress);
+    QSignalSpy finishedSpy(&uploader, &QGCResumableUploader::finished);
+
+    QVERIFY(uploader.upload(fileName, {{QStringLiteral("filename"), QStringLiteral("chunked.ulg")}}));
+    QVERIFY(uploader.isUploading(fileName));
+    QVERIFY(!uploader.upload(fileName));
+
+    QVERIFY(finishedSpy.wait(10000));
+    QCOMPARE(finishedSpy.first().at(0).toString(), fileName);
+    QVERIFY(finishedSpy.first().at(1).toBool());
+    QVERIFY(!uploader.isBusy());
+
+    QCOMPARE(server.uploads.count(), 1);
+    const TusServer::Upload &upload = server.uploads.cbegin().value();
+    QCOMPARE(upload.data, data);
+    QCOMPARE(upload.metadata.value(QStringLiteral("filename")), QStringLiteral("chunked.ulg"));
+    QCOMPARE(server.patchCount, 7);
+
+    QVERIFY(!progressSpy.isEmpty());
+    QCOMPARE(progressSpy.last().at(1).toLongLong(), data.size());
+    QCOMPARE(progressSpy.last().at(2).toLongLong(), data.size());
+
+    QVERIFY(!QFile::exists(QGCResumableUploader::journalFileName(fileName)));
+}
+
+void QGCResumableUploaderTest::_testResumeFromJournal()
+{
+    TusServer server;
+    QVERIFY(server.listen());
+    server.failPatchAfter = 3;
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QByteArray data = testData(128 * 1024, 2);
+    const QString fileName = writeFile(dir, QStringLiteral("resume.ulg"), data);
+    QVERIFY(!fileName.isEmpty());
+
+    {
+        QGCResumableUploader uploader;
+        uploader.setEndpoint(server.endpoint());
+        uploader.setChunkSize(16 * 1024);
+        uploader.setMaxRetries(0);
+
+        QSignalSpy finishedSpy(&uploader, &QGCResumableUploader::finished);
+        QVERIFY(uploader.upload(fileName));
+        QVERIFY(finishedSpy.wait(10000));
+        QVERIFY(!finishedSpy.first().at(1).toBool());
+    }
+
+    // The interrupted upload leaves a journal behind
+    QVERIFY(QFile::exists(QGCResumableUploader::journalFileName(fileName)));
+    QCOMPARE(server.uploads.count(), 1);
+    QCOMPARE(server.bytesReceived, 3 * 16 * 1024);
+
+    // A new uploader, as after an application restart, continues at the offset the server has
+    server.failPatchAfter = -1;
+    QGCResumableUploader uploader;
+    uploader.setEndpoint(server.endpoint());
+    uploader.setChunkSize(16 * 1024);
+
+    QSignalSpy finishedSpy(&uploader, &QGCResumableUploader::finished);
+    QVERIFY(uploader.upload(fileName));
+    QVERIFY(finishedSpy.wait(10000));
+    QVERIFY(finishedSpy.first().at(1).toBool());
+
+    QCOMPARE(server.uploads.count(), 1);
+    QCOMPARE(server.uploads.cbegin().value().data, data);
+    QCOMPARE(server.headCount, 1);
+    QCOMPARE(server.bytesReceived, data.size());
+    QVERIFY(!QFile::exists(QGCResumableUploader::journalFileName(fileName)));
+}
+
+void QGCResumableUploaderTest::_testRestartWhenUploadGone()
+{
+    TusServer server;
+    QVERIFY(server.listen());
+    server.failPatchAfter = 2;
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QByteArray data = testData(64 * 1024, 3);
+    const QString fileName = writeFile(dir, QStringLiteral("gone.ulg"), data);
+    QVERIFY(!fileName.isEmpty());
+
+    QGCResumableUploader uploader;
+    uploader.setEndpoint(server.endpoint());
+    uploader.setChunkSize(16 * 1024);
+    uploader.setMaxRetries(0);
+
+    QSignalSpy finishedSpy(&uploader, &QGCResumableUploader::finished);
+    QVERIFY(uploader.upload(fileName));
+    QVERIFY(finishedSpy.wait(10000));
+    QVERIFY(!finishedSpy.first().at(1).toBool());
+    QVERIFY(QFile::exists(QGCResumableUploader::journalFileName(fileName)));
+
+    // The server discards the partial upload, the journal no longer leads anywhere
+    server.uploads.clear();
+    server.failPatchAfter = -1;
+    finishedSpy.clear();
+
+    QVERIFY(uploader.upload(fileName));
+    QVERIFY(finishedSpy.wait(10000));
+    QVERIFY(finishedSpy.first().at(1).toBool());
+
+    QCOMPARE(server.uploads.count(), 1);
+    QCOMPARE(server.uploads.cbegin().value().data, data);
+}
+
+void QGCResumableUploaderTest::_testConcurrentUploads()
+{
+    TusServer server;
+    QVERIFY(server.listen());
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QGCResumableUploader uploader;
+    uploader.setEndpoint(server.endpoint());
+    uploader.setChunkSize(8 * 1024);
+    uploader.setMaxConcurrent(2);
+
+    QSignalSpy finishedSpy(&uploader, &QGCResumableUploader::finished);
+
+    QList<QByteArray> files;
+    for (int i = 0; i < 4; i++) {
+        const QByteArray data = testData((48 * 1024) + i, static_cast<char>(i));
+        const QString fileName = writeFile(dir, QStringLiteral("log%1.ulg").arg(i), data);
+        QVERIFY(!fileName.isEmpty());
+        QVERIFY(uploader.upload(fileName));
+        files.append(data);
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(finishedSpy.count(), 4, 20000);
+    for (const QList<QVariant> &arguments : std::as_const(finishedSpy)) {
+        QVERIFY(arguments.at(1).toBool());
+    }
+
+    // Two uploads ran side by side, the others waited for a free slot
+    QCOMPARE(server.maxActiveCount, 2);
+    QCOMPARE(server.activeCount, 0);
+
+    QCOMPARE(server.uploads.count(), files.count());
+    for (const TusServer::Upload &upload : std::as_const(server.uploads)) {
+        QVERIFY(files.contains(upload.data));
+    }
+}
+
+void QGCResumableUploaderTest::_testBandwidthLimit()
+{
+    TusServer server;
+    QVERIFY(server.listen());
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    // 64 KB in 8 KB chunks over two uploads at 64 KB/s, the cap is shared so the last chunk may not be sent
+    // before 7 * 125 ms have passed
+    QGCResumableUploader uploader;
+    uploader.setEndpoint(server.endpoint());
+    uploader.setChunkSize(8 * 1024);
+    uploader.setMaxBytesPerSecond(64 * 1024);
+
+    QSignalSpy finishedSpy(&uploader, &QGCResumableUploader::finished);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < 2; i++) {
+        const QString fileName = writeFile(dir, QStringLiteral("capped%1.ulg").arg(i), testData(32 * 1024, static_cast<char>(i)));
+        QVERIFY(!fileName.isEmpty());
+        QVERIFY(uploader.upload(fileName));
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(finishedSpy.count(), 2, 20000);
+    QVERIFY(finishedSpy.at(0).at(1).toBool());
+    QVERIFY(finishedSpy.at(1).at(1).toBool());
+    QCOMPARE(server.patchCount, 8);
+    QVERIFY(timer.elapsed() >= 850);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "UnitTest.h"
+
+/// Tests for QGCResumableUploader against a local tus server
+class QGCResumableUploaderTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testChunkedUpload();
+    void _testResumeFromJournal();
+    void _testRestartWhenUploadGone();
+    void _testConcurrentUploads();
+    void _testBandwidthLimit();
+};
@@ -148,3 +148,41 @@ void ComponentInformationCacheTest::_multi_test()
 
     _cleanup();
 }
+
+void ComponentInformationCacheTest::_validation_test()
+{
+    _setup();
+    ComponentInformationCache cache(_cacheDir, 10);
+
+    for (int i = 0; i < 3; ++i) {
+        _tmpFiles[i].cachedPath = cache.insert(_tmpFiles[i].cacheTag, _tmpFiles[i].path);
+        QVERIFY(!_tmpFiles[i].cachedPath.isEmpty());
+    }
+
+    // modified contents
+    {
+        QFile f(_tmpFiles[0].cachedPath);
+        QVERIFY(f.open(QIODevice::WriteOnly));
+        (void) f.write("corrupted");
+    }
+    // truncated contents
+    {
+        QFile f(_tmpFiles[1].cachedPath);
+        QVERIFY(f.resize(0));
+    }
+
+    QVERIFY(cache.access(_tmpFiles[0].cacheTag) == "");
+    QVERIFY(!QFile(_tmpFiles[0].cachedPath).exists());
+    QVERIFY(cache.access(_tmpFiles[1].cacheTag) == "");
+    QVERIFY(cache.access(_tmpFiles[2].cacheTag) == _tmpFiles[2].cachedPath);
+
+    // a removed entry can be inserted again
+    QFile f(_tmpFilesDir + "/replacement.txt");
+    QVERIFY(f.open(QIODevice::WriteOnly));
+    (void) f.write(_tmpFiles[0].content.toUtf8());
+    f.close();
+    QVERIFY(cache.insert(_tmpFiles[0].cacheTag, f.fileName()) == _tmpFiles[0].cachedPath);
+    QVERIFY(cache.access(_tmpFiles[0].cacheTag) == _tmpFiles[0].cachedPath);
+
+    _cleanup();
+}
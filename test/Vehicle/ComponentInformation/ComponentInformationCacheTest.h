@@ -16,6 +16,7 @@ private slots:
     void _basic_test();
     void _lru_test();
     void _multi_test();
+    void _validation_test();
 private:
     void _setup();
     void _cleanup();
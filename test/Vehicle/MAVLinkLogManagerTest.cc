@@ -3,9 +3,27 @@
 #include "MultiVehicleManager.h"
 #include "Vehicle.h"
 
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QStandardPaths>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QSignalSpy>
 #include <QtTest/QTest>
 
+namespace {
+
+QByteArray ulogMessage(char type, int payloadLength)
+{
+    QByteArray message;
+    message.append(static_cast<char>(payloadLength & 0xff));
+    message.append(static_cast<char>(payloadLength >> 8));
+    message.append(type);
+    message.append(QByteArray(payloadLength, type));
+    return message;
+}
+
+} // namespace
+
 void MAVLinkLogManagerTest::_testInitMAVLinkLogManager()
 {
     _connectMockLinkNoInitialConnectSequence();
@@ -15,3 +33,80 @@ void MAVLinkLogManagerTest::_testInitMAVLinkLogManager()
     MAVLinkLogManager *const mavlinkLogManager = new MAVLinkLogManager(vehicle, this);
     QVERIFY(mavlinkLogManager);
 }
+
+void MAVLinkLogManagerTest::_testLogProcessor()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QStringLiteral("test.ulg"));
+
+    MAVLinkLogProcessor processor;
+    QVERIFY(!processor.create(dir.filePath(QStringLiteral("missing/test.ulg"))));
+    QVERIFY(processor.create(fileName));
+    QVERIFY(processor.isOpen());
+
+    QSignalSpy spyStats(&processor, &MAVLinkLogProcessor::statsChanged);
+    QSignalSpy spyError(&processor, &MAVLinkLogProcessor::errorOccurred);
+    QSignalSpy spyClosed(&processor, &MAVLinkLogProcessor::closed);
+
+    const QByteArray header(16, 'H');
+    const QByteArray messageA = ulogMessage('A', 4);
+    const QByteArray messageB = ulogMessage('B', 6);
+    const QByteArray messageC = ulogMessage('C', 2);
+    const QByteArray messageD = ulogMessage('D', 3);
+
+    processor.processStreamData(0, 0, header + messageA);
+    // B is split across two LOGGING_DATA messages, C starts within the second one
+    processor.processStreamData(1, 0, messageB.left(5));
+    processor.processStreamData(2, static_cast<uint8_t>(messageB.size() - 5), messageB.mid(5) + messageC);
+    // Sequence 3 and 4 are lost
+    processor.processStreamData(5, 0, messageD);
+    // Duplicate, ignored
+    processor.processStreamData(5, 0, messageD);
+
+    QCOMPARE(processor.numDrops(), 2);
+
+    // Everything is still buffered
+    QCOMPARE(QFileInfo(fileName).size(), 0);
+    QCOMPARE(processor.written(), static_cast<quint64>(0));
+
+    processor.close();
+    QVERIFY(!processor.isOpen());
+
+    const QByteArray dropout("\x02\x00\x4f\x14\x00", 5);   // 2 drops * 10ms
+    const QByteArray expected = header + messageA + messageB + messageC + dropout + messageD;
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), expected);
+
+    QCOMPARE(spyError.count(), 0);
+    QCOMPARE(spyClosed.count(), 1);
+    QCOMPARE(spyClosed.at(0).at(0).toString(), fileName);
+    QVERIFY(spyClosed.at(0).at(1).toBool());
+    QCOMPARE(spyStats.count(), 1);
+    QCOMPARE(spyStats.at(0).at(1).toULongLong(), static_cast<quint64>(expected.size()));
+    QCOMPARE(spyStats.at(0).at(2).toInt(), 2);
+}
+
+void MAVLinkLogManagerTest::_testLogProcessorTimedFlush()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QStringLiteral("test.ulg"));
+
+    MAVLinkLogProcessor processor;
+    QVERIFY(processor.create(fileName));
+    QSignalSpy spyStats(&processor, &MAVLinkLogProcessor::statsChanged);
+
+    const QByteArray data = QByteArray(16, 'H') + ulogMessage('A', 4);
+    processor.processStreamData(0, 0, data);
+    QCOMPARE(QFileInfo(fileName).size(), 0);
+
+    // No further data arrives, the buffered data still has to reach the file
+    QVERIFY(spyStats.wait(MAVLinkLogProcessor::kFlushIntervalMs * 3));
+    QCOMPARE(processor.written(), static_cast<quint64>(data.size()));
+    QCOMPARE(QFileInfo(fileName).size(), data.size());
+
+    processor.close();
+}
@@ -8,4 +8,6 @@ class MAVLinkLogManagerTest : public UnitTest
 
 private slots:
     void _testInitMAVLinkLogManager();
+    void _testLogProcessor();
+    void _testLogProcessorTimedFlush();
 };